@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Atomic.h>
 #include <AK/Badge.h>
 #include <AK/Format.h>
 #include <AK/Forward.h>
@@ -16,6 +17,7 @@
 #include <LibGC/Forward.h>
 #include <LibGC/Internals.h>
 #include <LibGC/Ptr.h>
+#include <LibGC/WriteBarrier.h>
 
 namespace GC {
 
@@ -36,6 +38,17 @@ public:                                            \
     }                                              \
     friend class GC::Heap;
 
+// Cells whose destructor has no side effects beyond releasing memory they own can opt into lazy sweeping.
+// When such a cell dies, it is finalized during the collection, but its destruction is deferred until
+// its HeapBlock is swept, which happens when the block is needed for allocation (or during idle time).
+// NOTE: This must be declared by each class that opts in, as it does not carry over to subclasses.
+#define GC_ALLOW_LAZY_SWEEP(class_) \
+public:                             \
+    using LazilySweptCellType = class_
+
+template<typename T>
+concept LazilySweepableCell = IsSame<typename T::LazilySweptCellType, T>;
+
 class Cell : public Weakable<Cell> {
     AK_MAKE_NONCOPYABLE(Cell);
     AK_MAKE_NONMOVABLE(Cell);
@@ -46,9 +59,14 @@ public:
     bool is_marked() const { return m_mark; }
     void set_marked(bool b) { m_mark = b; }
 
-    enum class State : bool {
+    // Used by parallel marking, where multiple visitors may race to mark the same cell.
+    // Returns true if this call was the one that marked the cell.
+    bool try_set_marked_atomically() { return !AK::atomic_exchange(&m_mark, true, AK::memory_order_relaxed); }
+
+    enum class State : u8 {
         Live,
         Dead,
+        PendingSweep,
     };
 
     State state() const { return m_state; }
@@ -177,6 +195,19 @@ public:
 
     bool overrides_must_survive_garbage_collection(Badge<Heap>) const { return m_overrides_must_survive_garbage_collection; }
 
+    bool can_be_swept_lazily() const { return m_can_be_swept_lazily; }
+    void set_can_be_swept_lazily(Badge<Heap>) { m_can_be_swept_lazily = true; }
+
+    // With generational collection, cells start out young and are promoted by surviving a collection.
+    // Old cells that young cells have been stored into are remembered until the next collection.
+    bool is_young() const { return m_is_young; }
+    void set_young(Badge<Heap>, bool b) { m_is_young = b; }
+    bool is_remembered() const { return m_is_remembered; }
+    void set_remembered(Badge<Heap>, bool b) { m_is_remembered = b; }
+
+    // Called when a lazily swept cell dies, so that weak pointers don't observe it while its destruction is pending.
+    void revoke_weak_pointers(Badge<Heap>) { revoke_weak_ptrs(); }
+
     ALWAYS_INLINE Heap& heap() const { return HeapBlockBase::from_cell(this)->heap(); }
 
 protected:
@@ -187,9 +218,13 @@ protected:
     void set_overrides_must_survive_garbage_collection(bool b) { m_overrides_must_survive_garbage_collection = b; }
 
 private:
-    bool m_mark : 1 { false };
+    // NOTE: The mark bit lives in its own byte so that it can be set atomically during parallel marking.
+    bool m_mark { false };
     bool m_overrides_must_survive_garbage_collection : 1 { false };
-    State m_state : 1 { State::Live };
+    bool m_can_be_swept_lazily : 1 { false };
+    bool m_is_young : 1 { false };
+    bool m_is_remembered : 1 { false };
+    State m_state : 2 { State::Live };
 };
 
 }
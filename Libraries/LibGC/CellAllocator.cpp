@@ -23,13 +23,13 @@ Cell* CellAllocator::allocate_cell(Heap& heap)
     if (!m_list_node.is_in_list())
         heap.register_cell_allocator({}, *this);
 
+    // Prefer reusing blocks with cells pending sweep over allocating new blocks.
+    while (m_usable_blocks.is_empty() && sweep_next_pending_block())
+        ;
+
     if (m_usable_blocks.is_empty()) {
         auto block = HeapBlock::create_with_cell_size(heap, *this, m_cell_size, m_class_name);
-        auto block_ptr = reinterpret_cast<FlatPtr>(block.ptr());
-        if (m_min_block_address > block_ptr)
-            m_min_block_address = block_ptr;
-        if (m_max_block_address < block_ptr)
-            m_max_block_address = block_ptr;
+        heap.did_create_heap_block({}, *block);
         m_usable_blocks.append(*block.leak_ptr());
     }
 
@@ -42,8 +42,14 @@ Cell* CellAllocator::allocate_cell(Heap& heap)
 }
 
 void CellAllocator::block_did_become_empty(Badge<Heap>, HeapBlock& block)
+{
+    destroy_block(block);
+}
+
+void CellAllocator::destroy_block(HeapBlock& block)
 {
     block.m_list_node.remove();
+    block.heap().did_destroy_heap_block({}, block);
     // NOTE: HeapBlocks are managed by the BlockAllocator, so we don't want to `delete` the block here.
     block.~HeapBlock();
     m_block_allocator.deallocate_block(&block);
@@ -55,4 +61,33 @@ void CellAllocator::block_did_become_usable(Badge<Heap>, HeapBlock& block)
     m_usable_blocks.append(block);
 }
 
+void CellAllocator::block_did_become_pending_sweep(Badge<Heap>, HeapBlock& block)
+{
+    m_blocks_pending_sweep.append(block);
+}
+
+bool CellAllocator::sweep_next_pending_block()
+{
+    auto* block = m_blocks_pending_sweep.first();
+    if (!block)
+        return false;
+
+    bool block_has_live_cells = false;
+    block->for_each_cell([&](Cell* cell) {
+        if (cell->state() == Cell::State::PendingSweep)
+            block->deallocate(cell);
+        else if (cell->state() == Cell::State::Live)
+            block_has_live_cells = true;
+    });
+
+    if (!block_has_live_cells) {
+        destroy_block(*block);
+        return true;
+    }
+
+    VERIFY(!block->is_full());
+    m_usable_blocks.append(*block);
+    return true;
+}
+
 }
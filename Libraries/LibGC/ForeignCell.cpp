@@ -41,6 +41,12 @@ Ref<ForeignCell> ForeignCell::create(Heap& heap, size_t size, ForeignCell::Vtabl
     auto& allocator = heap.allocator_for_size(sizeof(ForeignCell) + round_up_to_power_of_two(size, vtable.alignment));
     auto* memory = allocator.allocate_cell(heap);
     auto* foreign_cell = new (memory) ForeignCell(move(vtable));
+    if (heap.is_incremental_marking_in_progress())
+        heap.did_allocate_cell_during_incremental_marking(*foreign_cell);
+    if (heap.is_generational_collection_enabled())
+        heap.did_allocate_young_cell(*foreign_cell);
+    if (heap.m_allocation_sampling_interval)
+        heap.did_allocate_cell_while_sampling(*foreign_cell);
     return *foreign_cell;
 }
 
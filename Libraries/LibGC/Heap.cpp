@@ -7,19 +7,25 @@
 
 #include <AK/Badge.h>
 #include <AK/Debug.h>
+#include <AK/Endian.h>
 #include <AK/Function.h>
 #include <AK/HashTable.h>
 #include <AK/JsonArray.h>
 #include <AK/JsonObject.h>
 #include <AK/Platform.h>
 #include <AK/StackInfo.h>
+#include <AK/Stream.h>
 #include <AK/TemporaryChange.h>
 #include <LibCore/ElapsedTimer.h>
+#include <LibCore/System.h>
 #include <LibGC/CellAllocator.h>
+#include <LibGC/DeferGC.h>
 #include <LibGC/Heap.h>
 #include <LibGC/HeapBlock.h>
 #include <LibGC/NanBoxedValue.h>
 #include <LibGC/Root.h>
+#include <LibGC/WorkStealingDeque.h>
+#include <LibThreading/WorkerThread.h>
 #include <setjmp.h>
 
 #ifdef HAS_ADDRESS_SANITIZER
@@ -28,6 +34,8 @@
 
 namespace GC {
 
+Atomic<size_t, AK::memory_order_relaxed> g_heaps_needing_write_barrier { 0 };
+
 Heap::Heap(void* private_data, AK::Function<void(HashMap<Cell*, GC::HeapRoot>&)> gather_embedder_roots)
     : HeapBase(private_data)
     , m_gather_embedder_roots(move(gather_embedder_roots))
@@ -44,7 +52,26 @@ Heap::Heap(void* private_data, AK::Function<void(HashMap<Cell*, GC::HeapRoot>&)>
 
 Heap::~Heap()
 {
+    set_generational_collection_enabled(false);
     collect_garbage(CollectionType::CollectEverything);
+    VERIFY(!m_needs_write_barrier);
+}
+
+Span<NonnullOwnPtr<Threading::WorkerThread<Error>>> Heap::ensure_marking_threads()
+{
+    if (m_marking_threads.is_empty()) {
+        // NOTE: The thread running the collection takes part in marking as well.
+        auto thread_count = min<size_t>(Core::System::hardware_concurrency(), MAX_MARKING_THREADS);
+        for (size_t i = 1; i < thread_count; ++i) {
+            auto thread = Threading::WorkerThread<Error>::create("GC marking"sv);
+            if (thread.is_error()) {
+                dbgln("Failed to create GC marking thread: {}", thread.error());
+                break;
+            }
+            m_marking_threads.append(thread.release_value());
+        }
+    }
+    return m_marking_threads.span();
 }
 
 void Heap::will_allocate(size_t size)
@@ -54,10 +81,19 @@ void Heap::will_allocate(size_t size)
         collect_garbage();
     } else if (m_allocated_bytes_since_last_gc + size > m_gc_bytes_threshold) {
         m_allocated_bytes_since_last_gc = 0;
-        collect_garbage();
+        // NOTE: If we allocate another threshold's worth of memory before an incremental
+        //       marking cycle has completed, we finish the cycle synchronously instead.
+        if (m_incremental_marking_enabled && !is_incremental_marking_in_progress())
+            start_incremental_marking();
+        else
+            collect_garbage();
+    } else if (m_generational_collection_enabled && m_allocated_bytes_in_nursery + size > m_nursery_size) {
+        collect_young_garbage();
     }
 
     m_allocated_bytes_since_last_gc += size;
+    if (m_generational_collection_enabled)
+        m_allocated_bytes_in_nursery += size;
 }
 
 static void add_possible_value(HashMap<FlatPtr, HeapRoot>& possible_pointers, FlatPtr data, HeapRoot origin, FlatPtr min_block_address, FlatPtr max_block_address)
@@ -84,14 +120,10 @@ static void add_possible_value(HashMap<FlatPtr, HeapRoot>& possible_pointers, Fl
     }
 }
 
-void Heap::find_min_and_max_block_addresses(FlatPtr& min_address, FlatPtr& max_address)
+void Heap::find_min_and_max_block_addresses(FlatPtr& min_address, FlatPtr& max_address) const
 {
-    min_address = explode_byte(0xff);
-    max_address = 0;
-    for (auto& allocator : m_all_cell_allocators) {
-        min_address = min(min_address, allocator.min_block_address());
-        max_address = max(max_address, allocator.max_block_address() + HeapBlockBase::block_size);
-    }
+    min_address = m_min_block_address;
+    max_address = m_max_block_address + HeapBlockBase::block_size;
 }
 
 template<typename Callback>
@@ -113,12 +145,9 @@ class GraphConstructorVisitor final : public Cell::Visitor {
 public:
     explicit GraphConstructorVisitor(Heap& heap, HashMap<Cell*, HeapRoot> const& roots)
         : m_heap(heap)
+        , m_all_live_heap_blocks(heap.m_all_live_heap_blocks)
     {
         m_heap.find_min_and_max_block_addresses(m_min_block_address, m_max_block_address);
-        m_heap.for_each_block([&](auto& block) {
-            m_all_live_heap_blocks.set(&block);
-            return IterationDecision::Continue;
-        });
         m_work_queue.ensure_capacity(roots.size());
 
         for (auto& [root, root_origin] : roots) {
@@ -126,7 +155,7 @@ public:
             graph_node.class_name = root->class_name();
             graph_node.root_origin = root_origin;
 
-            m_work_queue.append(*root);
+            m_work_queue.append(root);
         }
     }
 
@@ -138,7 +167,7 @@ public:
         if (m_graph.get(reinterpret_cast<FlatPtr>(&cell)).has_value())
             return;
 
-        m_work_queue.append(cell);
+        m_work_queue.append(&cell);
     }
 
     virtual void visit_possible_values(ReadonlyBytes bytes) override
@@ -155,15 +184,15 @@ public:
 
             if (m_graph.get(reinterpret_cast<FlatPtr>(&cell)).has_value())
                 return;
-            m_work_queue.append(*cell);
+            m_work_queue.append(cell);
         });
     }
 
     void visit_all_cells()
     {
         while (!m_work_queue.is_empty()) {
-            auto cell = m_work_queue.take_last();
-            m_node_being_visited = &m_graph.ensure(bit_cast<FlatPtr>(cell.ptr()));
+            auto* cell = m_work_queue.take_last();
+            m_node_being_visited = &m_graph.ensure(bit_cast<FlatPtr>(cell));
             m_node_being_visited->class_name = cell->class_name();
             cell->visit_edges(*this);
             m_node_being_visited = nullptr;
@@ -219,11 +248,11 @@ private:
     };
 
     GraphNode* m_node_being_visited { nullptr };
-    Vector<Ref<Cell>> m_work_queue;
+    Vector<Cell*> m_work_queue;
     HashMap<FlatPtr, GraphNode> m_graph;
 
     Heap& m_heap;
-    HashTable<HeapBlock*> m_all_live_heap_blocks;
+    HashTable<HeapBlock*> const& m_all_live_heap_blocks;
     FlatPtr m_min_block_address;
     FlatPtr m_max_block_address;
 };
@@ -237,6 +266,165 @@ AK::JsonObject Heap::dump_graph()
     return visitor.dump();
 }
 
+class SnapshotEdgeVisitor final : public Cell::Visitor {
+public:
+    SnapshotEdgeVisitor(HashTable<HeapBlock*> const& all_live_heap_blocks, FlatPtr min_block_address, FlatPtr max_block_address)
+        : m_all_live_heap_blocks(all_live_heap_blocks)
+        , m_min_block_address(min_block_address)
+        , m_max_block_address(max_block_address)
+    {
+    }
+
+    virtual void visit_impl(Cell& cell) override
+    {
+        m_edges.set(&cell);
+    }
+
+    virtual void visit_possible_values(ReadonlyBytes bytes) override
+    {
+        HashMap<FlatPtr, HeapRoot> possible_pointers;
+
+        auto* raw_pointer_sized_values = reinterpret_cast<FlatPtr const*>(bytes.data());
+        for (size_t i = 0; i < (bytes.size() / sizeof(FlatPtr)); ++i)
+            add_possible_value(possible_pointers, raw_pointer_sized_values[i], HeapRoot { .type = HeapRoot::Type::HeapFunctionCapturedPointer }, m_min_block_address, m_max_block_address);
+
+        for_each_cell_among_possible_pointers(m_all_live_heap_blocks, possible_pointers, [&](Cell* cell, FlatPtr) {
+            if (cell->state() == Cell::State::Live)
+                m_edges.set(cell);
+        });
+    }
+
+    HashTable<Cell*> const& edges() const { return m_edges; }
+    void clear() { m_edges.clear_with_capacity(); }
+
+private:
+    HashTable<HeapBlock*> const& m_all_live_heap_blocks;
+    FlatPtr m_min_block_address;
+    FlatPtr m_max_block_address;
+    HashTable<Cell*> m_edges;
+};
+
+// Heap snapshot format, with all integers in little-endian byte order:
+//
+//   "LGCS" magic, u32 version
+//   u32 string count, followed by that many strings, each as a u32 byte length and UTF-8 data
+//   u64 cell count, followed by that many cells, each as:
+//     u64 address
+//     u32 class name (string index)
+//     u32 cell size in bytes
+//     u8 root type (HeapRoot::Type), or 0xff if the cell is not a root
+//     u32 allocation site (string index), or 0xffffffff if the allocation was not sampled
+//     u32 edge count, followed by the u64 address of each cell that this cell references
+//
+// Class names come from the cell's TypeIsolatingCellAllocator where it has one, and from the cell itself otherwise.
+static constexpr u32 heap_snapshot_version = 1;
+static constexpr u8 heap_snapshot_not_a_root = 0xff;
+static constexpr u32 heap_snapshot_no_allocation_site = 0xffffffff;
+
+ErrorOr<void> Heap::write_snapshot(Stream& stream)
+{
+    // NOTE: Nothing here should allocate cells, but make sure no collection changes the heap under our feet.
+    DeferGC defer_gc(*this);
+
+    HashMap<Cell*, HeapRoot> roots;
+    gather_roots(roots);
+
+    FlatPtr min_block_address, max_block_address;
+    find_min_and_max_block_addresses(min_block_address, max_block_address);
+
+    auto class_name_of = [](HeapBlock& block, Cell& cell) {
+        if (auto const* allocator_class_name = block.cell_allocator().class_name())
+            return StringView { allocator_class_name, strlen(allocator_class_name) };
+        return cell.class_name();
+    };
+
+    Vector<StringView> strings;
+    HashMap<StringView, u32> string_indices;
+    auto intern = [&](StringView string) {
+        return string_indices.ensure(string, [&] {
+            strings.append(string);
+            return static_cast<u32>(strings.size() - 1);
+        });
+    };
+
+    u64 cell_count = 0;
+    for_each_block([&](auto& block) {
+        block.template for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
+            intern(class_name_of(block, *cell));
+            ++cell_count;
+        });
+        return IterationDecision::Continue;
+    });
+    for (auto const& it : m_sampled_allocation_sites)
+        intern(it.value);
+
+    TRY(stream.write_until_depleted("LGCS"sv.bytes()));
+    TRY(stream.write_value<LittleEndian<u32>>(heap_snapshot_version));
+
+    TRY(stream.write_value<LittleEndian<u32>>(strings.size()));
+    for (auto string : strings) {
+        TRY(stream.write_value<LittleEndian<u32>>(string.length()));
+        TRY(stream.write_until_depleted(string.bytes()));
+    }
+
+    TRY(stream.write_value<LittleEndian<u64>>(cell_count));
+
+    SnapshotEdgeVisitor visitor(m_all_live_heap_blocks, min_block_address, max_block_address);
+    ErrorOr<void> result;
+    for_each_block([&](auto& block) {
+        block.template for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
+            if (result.is_error())
+                return;
+            visitor.clear();
+            cell->visit_edges(visitor);
+
+            result = [&]() -> ErrorOr<void> {
+                TRY(stream.write_value<LittleEndian<u64>>(bit_cast<FlatPtr>(cell)));
+                TRY(stream.write_value<LittleEndian<u32>>(*string_indices.get(class_name_of(block, *cell))));
+                TRY(stream.write_value<LittleEndian<u32>>(block.cell_size()));
+
+                auto root = roots.get(cell);
+                TRY(stream.write_value<u8>(root.has_value() ? to_underlying(root->type) : heap_snapshot_not_a_root));
+
+                auto allocation_site = m_sampled_allocation_sites.get(cell);
+                TRY(stream.write_value<LittleEndian<u32>>(allocation_site.has_value() ? *string_indices.get(*allocation_site) : heap_snapshot_no_allocation_site));
+
+                TRY(stream.write_value<LittleEndian<u32>>(visitor.edges().size()));
+                for (auto* edge : visitor.edges())
+                    TRY(stream.write_value<LittleEndian<u64>>(bit_cast<FlatPtr>(edge)));
+                return {};
+            }();
+        });
+        return result.is_error() ? IterationDecision::Break : IterationDecision::Continue;
+    });
+    return result;
+}
+
+void Heap::set_allocation_sampling(size_t interval, AK::Function<String()> capture_allocation_site)
+{
+    m_allocation_sampling_interval = interval;
+    m_allocations_until_next_sample = interval;
+    m_capture_allocation_site = move(capture_allocation_site);
+    if (!interval)
+        m_sampled_allocation_sites.clear();
+}
+
+void Heap::did_allocate_cell_while_sampling(Cell& cell)
+{
+    if (--m_allocations_until_next_sample > 0)
+        return;
+    m_allocations_until_next_sample = m_allocation_sampling_interval;
+    m_sampled_allocation_sites.set(&cell, m_capture_allocation_site());
+}
+
+void Heap::remove_dead_cells_from_allocation_samples()
+{
+    // NOTE: This must happen before any dead cell's memory can be reused.
+    m_sampled_allocation_sites.remove_all_matching([](Cell* cell, String const&) {
+        return cell->state() != Cell::State::Live;
+    });
+}
+
 void Heap::collect_garbage(CollectionType collection_type, bool print_report)
 {
     VERIFY(!m_collecting_garbage);
@@ -244,21 +432,34 @@ void Heap::collect_garbage(CollectionType collection_type, bool print_report)
     {
         TemporaryChange change(m_collecting_garbage, true);
 
-        Core::ElapsedTimer collection_measurement_timer;
-        if (print_report)
-            collection_measurement_timer.start();
+        auto collection_measurement_timer = Core::ElapsedTimer::start_new(Core::TimerType::Precise);
 
         if (collection_type == CollectionType::CollectGarbage) {
             if (m_gc_deferrals) {
                 m_should_gc_when_deferral_ends = true;
                 return;
             }
-            HashMap<Cell*, HeapRoot> roots;
-            gather_roots(roots);
-            mark_live_cells(roots);
+            if (is_incremental_marking_in_progress()) {
+                finish_incremental_marking();
+            } else {
+                m_incremental_marking_steps = 0;
+                HashMap<Cell*, HeapRoot> roots;
+                gather_roots(roots);
+                mark_live_cells(roots);
+            }
+        } else if (is_incremental_marking_in_progress()) {
+            abort_incremental_marking();
         }
+        // NOTE: Cells that were left pending sweep by the previous collection are destroyed now at the latest.
+        sweep_all_pending_blocks();
         finalize_unmarked_cells();
-        sweep_dead_cells(print_report, collection_measurement_timer);
+        // NOTE: Every young cell has either survived this collection or is about to be swept.
+        promote_all_young_cells();
+        bool sweep_lazily = m_lazy_sweeping_enabled && collection_type == CollectionType::CollectGarbage;
+        sweep_dead_cells(print_report, collection_measurement_timer, sweep_lazily);
+
+        ++m_major_collection_statistics.count;
+        m_major_collection_statistics.time_spent += collection_measurement_timer.elapsed_time();
     }
 
     auto tasks = move(m_post_gc_tasks);
@@ -344,16 +545,11 @@ NO_SANITIZE_ADDRESS void Heap::gather_conservative_roots(HashMap<Cell*, HeapRoot
         }
     }
 
-    HashTable<HeapBlock*> all_live_heap_blocks;
-    for_each_block([&](auto& block) {
-        all_live_heap_blocks.set(&block);
-        return IterationDecision::Continue;
-    });
-
-    for_each_cell_among_possible_pointers(all_live_heap_blocks, possible_pointers, [&](Cell* cell, FlatPtr possible_pointer) {
+    for_each_cell_among_possible_pointers(m_all_live_heap_blocks, possible_pointers, [&](Cell* cell, FlatPtr possible_pointer) {
         if (cell->state() == Cell::State::Live) {
             dbgln_if(HEAP_DEBUG, "  ?-> {}", (void const*)cell);
-            roots.set(cell, *possible_pointers.get(possible_pointer));
+            // NOTE: Precise roots gathered by the embedder take precedence, so that we know which roots are only conservative.
+            roots.ensure(cell, [&] { return *possible_pointers.get(possible_pointer); });
         } else {
             dbgln_if(HEAP_DEBUG, "  #-> {}", (void const*)cell);
         }
@@ -362,15 +558,21 @@ NO_SANITIZE_ADDRESS void Heap::gather_conservative_roots(HashMap<Cell*, HeapRoot
 
 class MarkingVisitor final : public Cell::Visitor {
 public:
-    explicit MarkingVisitor(Heap& heap, HashMap<Cell*, HeapRoot> const& roots)
+    enum class Scope {
+        AllCells,
+        // Used by minor collections, which treat every old cell as live and don't trace through them.
+        YoungCells,
+    };
+
+    explicit MarkingVisitor(Heap& heap, HashMap<Cell*, HeapRoot> const& roots, Scope scope = Scope::AllCells)
         : m_heap(heap)
+        , m_scope(scope)
     {
-        m_heap.find_min_and_max_block_addresses(m_min_block_address, m_max_block_address);
-        m_heap.for_each_block([&](auto& block) {
-            m_all_live_heap_blocks.set(&block);
-            return IterationDecision::Continue;
-        });
+        visit_roots(roots);
+    }
 
+    void visit_roots(HashMap<Cell*, HeapRoot> const& roots)
+    {
         for (auto* root : roots.keys()) {
             visit(root);
         }
@@ -380,27 +582,35 @@ public:
     {
         if (cell.is_marked())
             return;
+        if (m_scope == Scope::YoungCells && !cell.is_young())
+            return;
         dbgln_if(HEAP_DEBUG, "  ! {}", &cell);
 
         cell.set_marked(true);
-        m_work_queue.append(cell);
+        m_work_queue.append(&cell);
     }
 
     virtual void visit_possible_values(ReadonlyBytes bytes) override
     {
         HashMap<FlatPtr, HeapRoot> possible_pointers;
 
+        // NOTE: Blocks may be created between the steps of an incremental marking cycle, so we always look at the heap's current set.
+        FlatPtr min_block_address, max_block_address;
+        m_heap.find_min_and_max_block_addresses(min_block_address, max_block_address);
+
         auto* raw_pointer_sized_values = reinterpret_cast<FlatPtr const*>(bytes.data());
         for (size_t i = 0; i < (bytes.size() / sizeof(FlatPtr)); ++i)
-            add_possible_value(possible_pointers, raw_pointer_sized_values[i], HeapRoot { .type = HeapRoot::Type::HeapFunctionCapturedPointer }, m_min_block_address, m_max_block_address);
+            add_possible_value(possible_pointers, raw_pointer_sized_values[i], HeapRoot { .type = HeapRoot::Type::HeapFunctionCapturedPointer }, min_block_address, max_block_address);
 
-        for_each_cell_among_possible_pointers(m_all_live_heap_blocks, possible_pointers, [&](Cell* cell, FlatPtr) {
+        for_each_cell_among_possible_pointers(m_heap.m_all_live_heap_blocks, possible_pointers, [&](Cell* cell, FlatPtr) {
             if (cell->is_marked())
                 return;
             if (cell->state() != Cell::State::Live)
                 return;
+            if (m_scope == Scope::YoungCells && !cell->is_young())
+                return;
             cell->set_marked(true);
-            m_work_queue.append(*cell);
+            m_work_queue.append(cell);
         });
     }
 
@@ -408,25 +618,253 @@ public:
     {
         while (!m_work_queue.is_empty()) {
             m_work_queue.take_last()->visit_edges(*this);
+            ++m_visited_cells;
         }
     }
 
+    size_t visited_cells() const { return m_visited_cells; }
+
+    // Returns true if marking completed within the given budget.
+    bool mark_live_cells_for(AK::Duration budget)
+    {
+        // Reading the clock is relatively expensive, so we only check it every so often.
+        static constexpr size_t cells_between_deadline_checks = 256;
+
+        auto timer = Core::ElapsedTimer::start_new(Core::TimerType::Precise);
+        size_t visited_cells = 0;
+        while (!m_work_queue.is_empty()) {
+            m_work_queue.take_last()->visit_edges(*this);
+            if (++visited_cells % cells_between_deadline_checks == 0 && timer.elapsed_time() >= budget)
+                return false;
+        }
+        return true;
+    }
+
+    void mark_all_live_cells_in_parallel(Span<NonnullOwnPtr<Threading::WorkerThread<Error>>>, Vector<Heap::MarkingThreadStatistics>&);
+
 private:
     Heap& m_heap;
-    Vector<Ref<Cell>> m_work_queue;
-    HashTable<HeapBlock*> m_all_live_heap_blocks;
-    FlatPtr m_min_block_address;
-    FlatPtr m_max_block_address;
+    Scope m_scope { Scope::AllCells };
+    Vector<Cell*> m_work_queue;
+    size_t m_visited_cells { 0 };
+};
+
+struct ParallelMarkingContext {
+    HashTable<HeapBlock*> const& all_live_heap_blocks;
+    FlatPtr min_block_address { 0 };
+    FlatPtr max_block_address { 0 };
+    Vector<NonnullOwnPtr<WorkStealingDeque<Cell*>>> deques;
+    Atomic<size_t> idle_thread_count { 0 };
+};
+
+// Each marking thread owns one of these. Newly discovered cells go onto a thread-local stack,
+// and surplus work is published to the thread's deque where idle threads can steal it.
+// Cells are claimed with an atomic test-and-set of the mark bit, so every cell is visited exactly once.
+class ParallelMarkingVisitor final : public Cell::Visitor {
+public:
+    ParallelMarkingVisitor(ParallelMarkingContext& context, size_t thread_index)
+        : m_context(context)
+        , m_own_deque(*context.deques[thread_index])
+        , m_thread_index(thread_index)
+    {
+    }
+
+    virtual void visit_impl(Cell& cell) override
+    {
+        if (!cell.try_set_marked_atomically())
+            return;
+        m_local_work.append(&cell);
+    }
+
+    virtual void visit_possible_values(ReadonlyBytes bytes) override
+    {
+        HashMap<FlatPtr, HeapRoot> possible_pointers;
+
+        auto* raw_pointer_sized_values = reinterpret_cast<FlatPtr const*>(bytes.data());
+        for (size_t i = 0; i < (bytes.size() / sizeof(FlatPtr)); ++i)
+            add_possible_value(possible_pointers, raw_pointer_sized_values[i], HeapRoot { .type = HeapRoot::Type::HeapFunctionCapturedPointer }, m_context.min_block_address, m_context.max_block_address);
+
+        for_each_cell_among_possible_pointers(m_context.all_live_heap_blocks, possible_pointers, [&](Cell* cell, FlatPtr) {
+            if (cell->state() != Cell::State::Live)
+                return;
+            if (!cell->try_set_marked_atomically())
+                return;
+            m_local_work.append(cell);
+        });
+    }
+
+    Heap::MarkingThreadStatistics mark_all_reachable_cells()
+    {
+        auto timer = Core::ElapsedTimer::start_new(Core::TimerType::Precise);
+        do {
+            drain_work();
+        } while (wait_for_more_work());
+        return { timer.elapsed_time(), m_visited_cells };
+    }
+
+private:
+    // Once a thread has this many cells queued locally, it starts sharing them with the other threads.
+    static constexpr size_t work_sharing_threshold = 64;
+
+    void drain_work()
+    {
+        while (true) {
+            Cell* cell = nullptr;
+            if (!m_local_work.is_empty()) {
+                cell = m_local_work.take_last();
+            } else if (auto popped_cell = m_own_deque.pop(); popped_cell.has_value()) {
+                cell = *popped_cell;
+            } else if (try_steal_work()) {
+                continue;
+            } else {
+                return;
+            }
+
+            cell->visit_edges(*this);
+            ++m_visited_cells;
+
+            if (m_local_work.size() >= work_sharing_threshold && m_own_deque.is_empty())
+                m_own_deque.push_half_of(m_local_work);
+        }
+    }
+
+    bool try_steal_work()
+    {
+        auto thread_count = m_context.deques.size();
+        for (size_t i = 1; i < thread_count; ++i) {
+            if (m_context.deques[(m_thread_index + i) % thread_count]->steal_into(m_local_work))
+                return true;
+        }
+        return false;
+    }
+
+    // NOTE: Only the owning thread pushes to a deque, so once every thread is idle, all deques
+    //       are empty and no more work can appear. Returns false when that happens.
+    bool wait_for_more_work()
+    {
+        auto thread_count = m_context.deques.size();
+        ++m_context.idle_thread_count;
+        while (m_context.idle_thread_count.load() < thread_count) {
+            bool any_work_available = any_of(m_context.deques, [](auto& deque) { return !deque->is_empty(); });
+            if (any_work_available) {
+                --m_context.idle_thread_count;
+                if (try_steal_work())
+                    return true;
+                ++m_context.idle_thread_count;
+            }
+            AK::atomic_pause();
+        }
+        return false;
+    }
+
+    ParallelMarkingContext& m_context;
+    WorkStealingDeque<Cell*>& m_own_deque;
+    size_t m_thread_index { 0 };
+    Vector<Cell*> m_local_work;
+    size_t m_visited_cells { 0 };
 };
 
+void MarkingVisitor::mark_all_live_cells_in_parallel(Span<NonnullOwnPtr<Threading::WorkerThread<Error>>> marking_threads, Vector<Heap::MarkingThreadStatistics>& statistics)
+{
+    // NOTE: The calling thread takes part in marking as thread 0.
+    auto thread_count = marking_threads.size() + 1;
+
+    ParallelMarkingContext context { .all_live_heap_blocks = m_heap.m_all_live_heap_blocks };
+    m_heap.find_min_and_max_block_addresses(context.min_block_address, context.max_block_address);
+    for (size_t i = 0; i < thread_count; ++i)
+        context.deques.append(make<WorkStealingDeque<Cell*>>());
+
+    // Seed the deques with the roots (which were already marked when they were visited).
+    for (size_t i = 0; i < m_work_queue.size(); ++i)
+        context.deques[i % thread_count]->push(m_work_queue[i]);
+    m_work_queue.clear();
+
+    statistics.resize(thread_count);
+    for (size_t i = 0; i < marking_threads.size(); ++i) {
+        auto thread_index = i + 1;
+        bool started = marking_threads[i]->start_task([&context, &statistics, thread_index]() -> ErrorOr<void> {
+            ParallelMarkingVisitor visitor(context, thread_index);
+            statistics[thread_index] = visitor.mark_all_reachable_cells();
+            return {};
+        });
+        VERIFY(started);
+    }
+
+    ParallelMarkingVisitor visitor(context, 0);
+    statistics[0] = visitor.mark_all_reachable_cells();
+
+    for (auto& thread : marking_threads)
+        MUST(thread->wait_until_task_is_finished());
+}
+
 void Heap::mark_live_cells(HashMap<Cell*, HeapRoot> const& roots)
 {
     dbgln_if(HEAP_DEBUG, "mark_live_cells:");
 
+    if (m_conservative_retention_measurement_enabled) {
+        mark_live_cells_measuring_conservative_retention(roots);
+        return;
+    }
+
     MarkingVisitor visitor(*this, roots);
 
+    m_last_marking_thread_statistics.clear();
+    if (should_mark_in_parallel())
+        visitor.mark_all_live_cells_in_parallel(ensure_marking_threads(), m_last_marking_thread_statistics);
+    else
+        visitor.mark_all_live_cells();
+
+    mark_cells_that_must_survive(visitor);
+}
+
+static bool is_conservative_root(HeapRoot const& root)
+{
+    switch (root.type) {
+    case HeapRoot::Type::ConservativeVector:
+    case HeapRoot::Type::RegisterPointer:
+    case HeapRoot::Type::StackPointer:
+        return true;
+    default:
+        return false;
+    }
+}
+
+void Heap::mark_live_cells_measuring_conservative_retention(HashMap<Cell*, HeapRoot> const& roots)
+{
+    HashMap<Cell*, HeapRoot> precise_roots;
+    Vector<Cell*> conservative_roots;
+    for (auto& [cell, origin] : roots) {
+        if (is_conservative_root(origin))
+            conservative_roots.append(cell);
+        else
+            precise_roots.set(cell, origin);
+    }
+
+    MarkingVisitor visitor(*this, precise_roots);
+    visitor.mark_all_live_cells();
+    auto precisely_reachable_cells = visitor.visited_cells();
+
+    auto& statistics = m_last_conservative_retention_statistics;
+    statistics = { .conservative_roots = conservative_roots.size() };
+    for (auto* cell : conservative_roots) {
+        if (cell->is_marked())
+            continue;
+        dbgln_if(HEAP_DEBUG, "  Only conservatively reachable: {}", cell);
+        ++statistics.conservative_roots_not_reachable_precisely;
+        visitor.visit(cell);
+    }
     visitor.mark_all_live_cells();
+    statistics.cells_retained_only_conservatively = visitor.visited_cells() - precisely_reachable_cells;
 
+    dbgln("Conservative roots: {} ({} not reachable from precise roots), retaining {} cells",
+        statistics.conservative_roots, statistics.conservative_roots_not_reachable_precisely, statistics.cells_retained_only_conservatively);
+
+    m_last_marking_thread_statistics.clear();
+    mark_cells_that_must_survive(visitor);
+}
+
+void Heap::mark_cells_that_must_survive(MarkingVisitor& visitor)
+{
     for (auto& inverse_root : m_uprooted_cells)
         inverse_root->set_marked(false);
 
@@ -441,6 +879,315 @@ void Heap::mark_live_cells(HashMap<Cell*, HeapRoot> const& roots)
     m_uprooted_cells.clear();
 }
 
+void Heap::set_lazy_sweeping_enabled(bool enabled)
+{
+    m_lazy_sweeping_enabled = enabled;
+    if (!enabled)
+        sweep_all_pending_blocks();
+}
+
+void Heap::sweep_all_pending_blocks()
+{
+    if (!m_may_have_blocks_pending_sweep)
+        return;
+
+    for (auto& allocator : m_all_cell_allocators) {
+        while (allocator.sweep_next_pending_block())
+            ;
+    }
+    m_may_have_blocks_pending_sweep = false;
+}
+
+void Heap::sweep_pending_blocks(AK::Duration budget)
+{
+    if (!m_may_have_blocks_pending_sweep || m_collecting_garbage)
+        return;
+
+    auto timer = Core::ElapsedTimer::start_new(Core::TimerType::Precise);
+    for (auto& allocator : m_all_cell_allocators) {
+        while (allocator.sweep_next_pending_block()) {
+            if (timer.elapsed_time() >= budget)
+                return;
+        }
+    }
+    m_may_have_blocks_pending_sweep = false;
+}
+
+void Heap::set_incremental_marking_enabled(bool enabled)
+{
+    m_incremental_marking_enabled = enabled;
+    if (!enabled && is_incremental_marking_in_progress())
+        collect_garbage();
+}
+
+void Heap::start_incremental_marking()
+{
+    VERIFY(!is_incremental_marking_in_progress());
+    VERIFY(!m_collecting_garbage);
+
+    if (m_gc_deferrals) {
+        m_should_gc_when_deferral_ends = true;
+        return;
+    }
+
+    dbgln_if(HEAP_DEBUG, "start_incremental_marking:");
+
+    HashMap<Cell*, HeapRoot> roots;
+    gather_roots(roots);
+    m_incremental_marking_visitor = make<MarkingVisitor>(*this, roots);
+    m_incremental_marking_steps = 0;
+    m_incremental_marking_time_spent = {};
+    update_write_barrier_state();
+}
+
+void Heap::perform_incremental_marking_step(AK::Duration budget)
+{
+    if (!is_incremental_marking_in_progress() || m_collecting_garbage || m_gc_deferrals)
+        return;
+
+    auto timer = Core::ElapsedTimer::start_new(Core::TimerType::Precise);
+    ++m_incremental_marking_steps;
+
+    bool marking_is_complete = m_incremental_marking_visitor->mark_live_cells_for(budget);
+    m_incremental_marking_time_spent += timer.elapsed_time();
+
+    if (marking_is_complete)
+        collect_garbage();
+}
+
+void Heap::finish_incremental_marking()
+{
+    dbgln_if(HEAP_DEBUG, "finish_incremental_marking: after {} steps", m_incremental_marking_steps);
+
+    // The rest of marking happens in this pause, so there is no need for the marking barrier anymore.
+    auto visitor = m_incremental_marking_visitor.release_nonnull();
+    update_write_barrier_state();
+
+    // Roots may have changed arbitrarily since the cycle started (e.g. the stack and registers
+    // are not covered by write barriers), so we have to gather and mark them again.
+    HashMap<Cell*, HeapRoot> roots;
+    gather_roots(roots);
+    visitor->visit_roots(roots);
+    visitor->mark_all_live_cells();
+
+    m_last_marking_thread_statistics.clear();
+    mark_cells_that_must_survive(*visitor);
+}
+
+void Heap::abort_incremental_marking()
+{
+    m_incremental_marking_visitor = nullptr;
+    update_write_barrier_state();
+
+    for_each_block([&](auto& block) {
+        block.template for_each_cell_in_state<Cell::State::Live>([](Cell* cell) {
+            cell->set_marked(false);
+        });
+        return IterationDecision::Continue;
+    });
+}
+
+void Heap::did_allocate_cell_during_incremental_marking(Cell& cell)
+{
+    // NOTE: Cells allocated during a marking cycle are queued for marking rather than being marked
+    //       right away, since their initial contents were written without going through barriers.
+    m_incremental_marking_visitor->visit(cell);
+}
+
+void Heap::update_write_barrier_state()
+{
+    bool needs_write_barrier = is_incremental_marking_in_progress() || m_generational_collection_enabled;
+    if (needs_write_barrier == m_needs_write_barrier)
+        return;
+    m_needs_write_barrier = needs_write_barrier;
+    if (needs_write_barrier)
+        g_heaps_needing_write_barrier.fetch_add(1);
+    else
+        g_heaps_needing_write_barrier.fetch_sub(1);
+}
+
+void write_barrier_slow_path(Cell const& owner, void const* pointer)
+{
+    auto& heap = HeapBlock::from_cell(&owner)->heap();
+
+    // The barrier may only be enabled for another heap, and stores made by the collector itself don't need it.
+    if (!heap.m_needs_write_barrier || heap.m_collecting_garbage)
+        return;
+
+    auto* cell = HeapBlock::from_cell(reinterpret_cast<Cell const*>(pointer))->cell_from_possible_pointer(reinterpret_cast<FlatPtr>(pointer));
+    if (!cell || cell->state() != Cell::State::Live)
+        return;
+
+    if (heap.is_incremental_marking_in_progress()) {
+        // NOTE: No minor collections happen during an incremental marking cycle, and every young cell
+        //       is promoted at the end of it, so there is no need to remember anything here.
+        if (!cell->is_marked())
+            heap.m_incremental_marking_visitor->visit(*cell);
+        return;
+    }
+
+    // Young owners are traced by the next minor collection anyway.
+    if (cell->is_young() && !owner.is_young() && !owner.is_remembered())
+        heap.remember_cell(const_cast<Cell&>(owner));
+}
+
+void write_barrier_slow_path(Cell const& owner)
+{
+    auto& heap = HeapBlock::from_cell(&owner)->heap();
+    if (!heap.m_needs_write_barrier || heap.m_collecting_garbage)
+        return;
+
+    auto& mutable_owner = const_cast<Cell&>(owner);
+    if (heap.is_incremental_marking_in_progress()) {
+        // Visiting the owner again marks whatever was stored into it since it was last visited.
+        if (owner.is_marked())
+            mutable_owner.visit_edges(*heap.m_incremental_marking_visitor);
+        return;
+    }
+
+    if (!owner.is_young() && !owner.is_remembered())
+        heap.remember_cell(mutable_owner);
+}
+
+void Heap::set_generational_collection_enabled(bool enabled)
+{
+    m_generational_collection_enabled = enabled;
+    if (!enabled)
+        promote_all_young_cells();
+    update_write_barrier_state();
+}
+
+void Heap::did_allocate_young_cell(Cell& cell)
+{
+    cell.set_young({}, true);
+    m_young_cells.append(&cell);
+}
+
+void Heap::remember_cell(Cell& cell)
+{
+    cell.set_remembered({}, true);
+    m_remembered_cells.append(&cell);
+}
+
+void Heap::forget_remembered_cells()
+{
+    for (auto* cell : m_remembered_cells)
+        cell->set_remembered({}, false);
+    m_remembered_cells.clear_with_capacity();
+}
+
+void Heap::promote_all_young_cells()
+{
+    for (auto* cell : m_young_cells)
+        cell->set_young({}, false);
+    m_young_cells.clear_with_capacity();
+    forget_remembered_cells();
+    m_allocated_bytes_in_nursery = 0;
+}
+
+void Heap::collect_young_garbage(bool print_report)
+{
+    VERIFY(!m_collecting_garbage);
+
+    // NOTE: A minor collection is never required for correctness, so we simply skip it if now is not a good time.
+    //       Any young cells that are still around will be dealt with by the next minor or major collection.
+    if (m_gc_deferrals || is_incremental_marking_in_progress())
+        return;
+
+    TemporaryChange change(m_collecting_garbage, true);
+    auto timer = Core::ElapsedTimer::start_new(Core::TimerType::Precise);
+
+    dbgln_if(HEAP_DEBUG, "collect_young_garbage: {} young cells, {} remembered", m_young_cells.size(), m_remembered_cells.size());
+
+    HashMap<Cell*, HeapRoot> roots;
+    gather_roots(roots);
+    MarkingVisitor visitor(*this, roots, MarkingVisitor::Scope::YoungCells);
+    // Old cells that young cells were stored into since the last collection are the only other way to reach them.
+    for (auto* cell : m_remembered_cells)
+        cell->visit_edges(visitor);
+    visitor.mark_all_live_cells();
+
+    for (auto* cell : m_young_cells) {
+        if (!cell->is_marked() && cell_must_survive_garbage_collection(*cell))
+            visitor.visit(cell);
+    }
+    visitor.mark_all_live_cells();
+
+    // Uprooted cells that are about to be swept must not be touched by the next major collection.
+    m_uprooted_cells.remove_all_matching([](auto& cell) { return cell->is_young() && !cell->is_marked(); });
+
+    for (auto* cell : m_young_cells) {
+        if (!cell->is_marked())
+            cell->finalize();
+    }
+
+    // Remember which blocks were full before sweeping them, so that we can put them back into circulation afterwards.
+    HashMap<HeapBlock*, bool> swept_blocks;
+    size_t promoted_cells = 0;
+    size_t collected_cells = 0;
+    size_t collected_cell_bytes = 0;
+    for (auto* cell : m_young_cells) {
+        cell->set_young({}, false);
+        if (cell->is_marked()) {
+            cell->set_marked(false);
+            ++promoted_cells;
+            continue;
+        }
+        auto* block = HeapBlock::from_cell(cell);
+        swept_blocks.ensure(block, [&] { return block->is_full(); });
+        collected_cell_bytes += block->cell_size();
+        ++collected_cells;
+        block->deallocate(cell);
+    }
+    m_young_cells.clear_with_capacity();
+    forget_remembered_cells();
+    m_allocated_bytes_in_nursery = 0;
+
+    for (auto& weak_container : m_weak_containers)
+        weak_container.remove_dead_cells({});
+    remove_dead_cells_from_allocation_samples();
+
+    size_t freed_blocks = 0;
+    for (auto& [block, block_was_full] : swept_blocks) {
+        bool block_has_cells = false;
+        block->for_each_cell([&](Cell* cell) {
+            if (cell->state() != Cell::State::Dead)
+                block_has_cells = true;
+        });
+        if (!block_has_cells) {
+            block->cell_allocator().block_did_become_empty({}, *block);
+            ++freed_blocks;
+        } else if (block_was_full) {
+            block->cell_allocator().block_did_become_usable({}, *block);
+        }
+    }
+
+    // Only the promoted cells count towards the next major collection.
+    m_allocated_bytes_since_last_gc -= min(m_allocated_bytes_since_last_gc, collected_cell_bytes);
+
+    ++m_minor_collection_statistics.count;
+    m_minor_collection_statistics.time_spent += timer.elapsed_time();
+
+    if (print_report) {
+        dbgln("Minor garbage collection report");
+        dbgln("=============================================");
+        dbgln("     Time spent: {} ms", timer.elapsed_time().to_milliseconds());
+        dbgln(" Promoted cells: {}", promoted_cells);
+        dbgln("Collected cells: {} ({} bytes)", collected_cells, collected_cell_bytes);
+        dbgln("   Freed blocks: {} ({} bytes)", freed_blocks, freed_blocks * HeapBlock::block_size);
+        dbgln("=============================================");
+    }
+}
+
+bool Heap::should_mark_in_parallel() const
+{
+    if (!m_parallel_marking_enabled)
+        return false;
+    if (m_live_cell_bytes_after_last_gc < m_parallel_marking_threshold)
+        return false;
+    return Core::System::hardware_concurrency() > 1;
+}
+
 bool Heap::cell_must_survive_garbage_collection(Cell const& cell)
 {
     if (!cell.overrides_must_survive_garbage_collection({}))
@@ -459,11 +1206,12 @@ void Heap::finalize_unmarked_cells()
     });
 }
 
-void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measurement_timer)
+void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measurement_timer, bool sweep_lazily)
 {
     dbgln_if(HEAP_DEBUG, "sweep_dead_cells:");
     Vector<HeapBlock*, 32> empty_blocks;
     Vector<HeapBlock*, 32> full_blocks_that_became_usable;
+    Vector<HeapBlock*, 32> blocks_pending_sweep;
 
     size_t collected_cells = 0;
     size_t live_cells = 0;
@@ -472,11 +1220,18 @@ void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measure
 
     for_each_block([&](auto& block) {
         bool block_has_live_cells = false;
+        bool block_has_cells_pending_sweep = false;
         bool block_was_full = block.is_full();
         block.template for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
             if (!cell->is_marked()) {
                 dbgln_if(HEAP_DEBUG, "  ~ {}", cell);
-                block.deallocate(cell);
+                if (sweep_lazily && cell->can_be_swept_lazily()) {
+                    cell->revoke_weak_pointers({});
+                    cell->set_state(Cell::State::PendingSweep);
+                    block_has_cells_pending_sweep = true;
+                } else {
+                    block.deallocate(cell);
+                }
                 ++collected_cells;
                 collected_cell_bytes += block.cell_size();
             } else {
@@ -486,7 +1241,9 @@ void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measure
                 live_cell_bytes += block.cell_size();
             }
         });
-        if (!block_has_live_cells)
+        if (block_has_cells_pending_sweep)
+            blocks_pending_sweep.append(&block);
+        else if (!block_has_live_cells)
             empty_blocks.append(&block);
         else if (block_was_full != block.is_full())
             full_blocks_that_became_usable.append(&block);
@@ -495,6 +1252,7 @@ void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measure
 
     for (auto& weak_container : m_weak_containers)
         weak_container.remove_dead_cells({});
+    remove_dead_cells_from_allocation_samples();
 
     for (auto* block : empty_blocks) {
         dbgln_if(HEAP_DEBUG, " - HeapBlock empty @ {}: cell_size={}", block, block->cell_size());
@@ -506,6 +1264,13 @@ void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measure
         block->cell_allocator().block_did_become_usable({}, *block);
     }
 
+    for (auto* block : blocks_pending_sweep) {
+        dbgln_if(HEAP_DEBUG, " - HeapBlock pending sweep @ {}: cell_size={}", block, block->cell_size());
+        block->cell_allocator().block_did_become_pending_sweep({}, *block);
+    }
+    if (!blocks_pending_sweep.is_empty())
+        m_may_have_blocks_pending_sweep = true;
+
     if constexpr (HEAP_DEBUG) {
         for_each_block([&](auto& block) {
             dbgln(" > Live HeapBlock @ {}: cell_size={}", &block, block.cell_size());
@@ -514,6 +1279,7 @@ void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measure
     }
 
     m_gc_bytes_threshold = live_cell_bytes > GC_MIN_BYTES_THRESHOLD ? live_cell_bytes : GC_MIN_BYTES_THRESHOLD;
+    m_live_cell_bytes_after_last_gc = live_cell_bytes;
 
     if (print_report) {
         AK::Duration const time_spent = measurement_timer.elapsed_time();
@@ -530,6 +1296,21 @@ void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measure
         dbgln("Collected cells: {} ({} bytes)", collected_cells, collected_cell_bytes);
         dbgln("    Live blocks: {} ({} bytes)", live_block_count, live_block_count * HeapBlock::block_size);
         dbgln("   Freed blocks: {} ({} bytes)", empty_blocks.size(), empty_blocks.size() * HeapBlock::block_size);
+        if (!blocks_pending_sweep.is_empty())
+            dbgln(" Pending sweep: {} blocks", blocks_pending_sweep.size());
+        if (m_minor_collection_statistics.count > 0) {
+            dbgln("Minor collections: {} ({} ms)", m_minor_collection_statistics.count, m_minor_collection_statistics.time_spent.to_milliseconds());
+            dbgln("Major collections: {} ({} ms)", m_major_collection_statistics.count, m_major_collection_statistics.time_spent.to_milliseconds());
+        }
+        if (m_incremental_marking_steps > 0)
+            dbgln("Incremental marking: {} steps, {} ms", m_incremental_marking_steps, m_incremental_marking_time_spent.to_milliseconds());
+        if (!m_last_marking_thread_statistics.is_empty()) {
+            dbgln("Parallel marking: {} threads", m_last_marking_thread_statistics.size());
+            for (size_t i = 0; i < m_last_marking_thread_statistics.size(); ++i) {
+                auto const& statistics = m_last_marking_thread_statistics[i];
+                dbgln("    Thread {}: {} ms, {} cells", i, statistics.time_spent.to_milliseconds(), statistics.visited_cells);
+            }
+        }
         dbgln("=============================================");
     }
 }
@@ -12,8 +12,11 @@
 #include <AK/IntrusiveList.h>
 #include <AK/Noncopyable.h>
 #include <AK/NonnullOwnPtr.h>
+#include <AK/OwnPtr.h>
 #include <AK/StackInfo.h>
+#include <AK/String.h>
 #include <AK/Swift.h>
+#include <AK/Time.h>
 #include <AK/Types.h>
 #include <AK/Vector.h>
 #include <LibCore/Forward.h>
@@ -26,9 +29,12 @@
 #include <LibGC/Root.h>
 #include <LibGC/RootVector.h>
 #include <LibGC/WeakContainer.h>
+#include <LibThreading/Forward.h>
 
 namespace GC {
 
+class MarkingVisitor;
+
 class Heap : public HeapBase {
     AK_MAKE_NONCOPYABLE(Heap);
     AK_MAKE_NONMOVABLE(Heap);
@@ -43,6 +49,14 @@ public:
         auto* memory = allocate_cell<T>();
         defer_gc();
         new (memory) T(forward<Args>(args)...);
+        if constexpr (LazilySweepableCell<T>)
+            memory->set_can_be_swept_lazily({});
+        if (is_incremental_marking_in_progress()) [[unlikely]]
+            did_allocate_cell_during_incremental_marking(*memory);
+        if (m_generational_collection_enabled)
+            did_allocate_young_cell(*memory);
+        if (m_allocation_sampling_interval) [[unlikely]]
+            did_allocate_cell_while_sampling(*memory);
         undefer_gc();
         return *static_cast<T*>(memory);
     }
@@ -55,9 +69,79 @@ public:
     void collect_garbage(CollectionType = CollectionType::CollectGarbage, bool print_report = false);
     AK::JsonObject dump_graph();
 
+    // Writes every live cell with its class name, size, outgoing edges, root type and sampled allocation site
+    // (if any) to the stream, in the compact binary format described in Heap.cpp.
+    ErrorOr<void> write_snapshot(Stream&);
+
+    // Records the allocation site of every Nth allocated cell for as long as that cell is alive, as described
+    // by the embedder's callback (e.g. the JS stack). The callback must not allocate cells. An interval of 0
+    // disables sampling.
+    void set_allocation_sampling(size_t interval, AK::Function<String()> capture_allocation_site);
+
     bool should_collect_on_every_allocation() const { return m_should_collect_on_every_allocation; }
     void set_should_collect_on_every_allocation(bool b) { m_should_collect_on_every_allocation = b; }
 
+    // When enabled, marking is split across a pool of worker threads once the live heap
+    // (as measured by the previous collection) grows beyond the parallel marking threshold.
+    bool is_parallel_marking_enabled() const { return m_parallel_marking_enabled; }
+    void set_parallel_marking_enabled(bool b) { m_parallel_marking_enabled = b; }
+    void set_parallel_marking_threshold(size_t bytes) { m_parallel_marking_threshold = bytes; }
+
+    // Incremental marking splits the marking phase of allocation-triggered collections into bounded
+    // steps, which the embedder interleaves with other work by calling perform_incremental_marking_step().
+    // While a marking cycle is in progress, stores into existing cells must go through a write barrier
+    // (see WriteBarrier.h), and newly allocated cells are queued for marking.
+    bool is_incremental_marking_enabled() const { return m_incremental_marking_enabled; }
+    void set_incremental_marking_enabled(bool);
+    bool is_incremental_marking_in_progress() const { return m_incremental_marking_visitor; }
+
+    static constexpr AK::Duration DEFAULT_INCREMENTAL_MARKING_STEP_BUDGET = AK::Duration::from_milliseconds(2);
+    void perform_incremental_marking_step(AK::Duration budget = DEFAULT_INCREMENTAL_MARKING_STEP_BUDGET);
+
+    // With lazy sweeping, dead cells that allow it (see GC_ALLOW_LAZY_SWEEP) are only finalized during
+    // a collection. Their blocks are queued and swept when a CellAllocator needs a free cell, when the
+    // embedder calls sweep_pending_blocks() during idle time, or at the start of the next collection.
+    bool is_lazy_sweeping_enabled() const { return m_lazy_sweeping_enabled; }
+    void set_lazy_sweeping_enabled(bool);
+    bool may_have_blocks_pending_sweep() const { return m_may_have_blocks_pending_sweep; }
+    void sweep_pending_blocks(AK::Duration budget);
+
+    // Generational collection treats the cells allocated since the last collection as a nursery.
+    // Once the nursery has grown beyond its size, a minor collection marks only young cells, starting
+    // from the roots (which include the registers of every running execution context) and from the
+    // edges of the remembered set: the old cells that young cells were stored into (see WriteBarrier.h).
+    // Surviving young cells are promoted in place, since cells can't be moved while the stack is
+    // scanned conservatively.
+    // NOTE: This relies on every store of a cell pointer into the heap going through a write barrier.
+    bool is_generational_collection_enabled() const { return m_generational_collection_enabled; }
+    void set_generational_collection_enabled(bool);
+    void set_nursery_size(size_t bytes) { m_nursery_size = bytes; }
+    void collect_young_garbage(bool print_report = false);
+
+    struct CollectionStatistics {
+        size_t count { 0 };
+        AK::Duration time_spent;
+    };
+    CollectionStatistics const& minor_collection_statistics() const { return m_minor_collection_statistics; }
+    CollectionStatistics const& major_collection_statistics() const { return m_major_collection_statistics; }
+
+    // When enabled, non-incremental collections first mark from the precise roots only, and then count the
+    // cells that are retained only by conservative roots (the stack, registers and ConservativeVectors).
+    bool is_conservative_retention_measurement_enabled() const { return m_conservative_retention_measurement_enabled; }
+    void set_conservative_retention_measurement_enabled(bool b) { m_conservative_retention_measurement_enabled = b; }
+
+    struct ConservativeRetentionStatistics {
+        size_t conservative_roots { 0 };
+        size_t conservative_roots_not_reachable_precisely { 0 };
+        size_t cells_retained_only_conservatively { 0 };
+    };
+    ConservativeRetentionStatistics const& last_conservative_retention_statistics() const { return m_last_conservative_retention_statistics; }
+
+    struct MarkingThreadStatistics {
+        AK::Duration time_spent;
+        size_t visited_cells { 0 };
+    };
+
     void did_create_root(Badge<RootImpl>, RootImpl&);
     void did_destroy_root(Badge<RootImpl>, RootImpl&);
 
@@ -71,6 +155,8 @@ public:
     void did_destroy_weak_container(Badge<WeakContainer>, WeakContainer&);
 
     void register_cell_allocator(Badge<CellAllocator>, CellAllocator&);
+    void did_create_heap_block(Badge<CellAllocator>, HeapBlock&);
+    void did_destroy_heap_block(Badge<CellAllocator>, HeapBlock&);
 
     void uproot_cell(Cell* cell);
 
@@ -83,6 +169,8 @@ private:
     friend class GraphConstructorVisitor;
     friend class DeferGC;
     friend class ForeignCell;
+    friend void write_barrier_slow_path(Cell const&, void const*);
+    friend void write_barrier_slow_path(Cell const&);
 
     void defer_gc();
     void undefer_gc();
@@ -103,13 +191,29 @@ private:
 
     void will_allocate(size_t);
 
-    void find_min_and_max_block_addresses(FlatPtr& min_address, FlatPtr& max_address);
+    void find_min_and_max_block_addresses(FlatPtr& min_address, FlatPtr& max_address) const;
     void gather_roots(HashMap<Cell*, HeapRoot>&);
     void gather_conservative_roots(HashMap<Cell*, HeapRoot>&);
     void gather_asan_fake_stack_roots(HashMap<FlatPtr, HeapRoot>&, FlatPtr, FlatPtr min_block_address, FlatPtr max_block_address);
     void mark_live_cells(HashMap<Cell*, HeapRoot> const& live_cells);
+    void mark_live_cells_measuring_conservative_retention(HashMap<Cell*, HeapRoot> const& roots);
+    void mark_cells_that_must_survive(MarkingVisitor&);
+    void start_incremental_marking();
+    void finish_incremental_marking();
+    void abort_incremental_marking();
+    void did_allocate_cell_during_incremental_marking(Cell&);
+    void update_write_barrier_state();
+    void did_allocate_young_cell(Cell&);
+    void remember_cell(Cell&);
+    void forget_remembered_cells();
+    void promote_all_young_cells();
+    void did_allocate_cell_while_sampling(Cell&);
+    void remove_dead_cells_from_allocation_samples();
+    bool should_mark_in_parallel() const;
+    Span<NonnullOwnPtr<Threading::WorkerThread<Error>>> ensure_marking_threads();
     void finalize_unmarked_cells();
-    void sweep_dead_cells(bool print_report, Core::ElapsedTimer const&);
+    void sweep_dead_cells(bool print_report, Core::ElapsedTimer const&, bool sweep_lazily);
+    void sweep_all_pending_blocks();
 
     ALWAYS_INLINE CellAllocator& allocator_for_size(size_t cell_size)
     {
@@ -137,9 +241,48 @@ private:
 
     bool m_should_collect_on_every_allocation { false };
 
+    static constexpr size_t DEFAULT_PARALLEL_MARKING_THRESHOLD { 32 * 1024 * 1024 };
+    static constexpr size_t MAX_MARKING_THREADS { 8 };
+    bool m_parallel_marking_enabled { false };
+    size_t m_parallel_marking_threshold { DEFAULT_PARALLEL_MARKING_THRESHOLD };
+    size_t m_live_cell_bytes_after_last_gc { 0 };
+    Vector<NonnullOwnPtr<Threading::WorkerThread<Error>>> m_marking_threads;
+    Vector<MarkingThreadStatistics> m_last_marking_thread_statistics;
+
+    bool m_conservative_retention_measurement_enabled { false };
+    ConservativeRetentionStatistics m_last_conservative_retention_statistics;
+
+    bool m_lazy_sweeping_enabled { true };
+    bool m_may_have_blocks_pending_sweep { false };
+
+    bool m_incremental_marking_enabled { false };
+    OwnPtr<MarkingVisitor> m_incremental_marking_visitor;
+    size_t m_incremental_marking_steps { 0 };
+    AK::Duration m_incremental_marking_time_spent;
+
+    static constexpr size_t DEFAULT_NURSERY_SIZE { 1 * 1024 * 1024 };
+    bool m_generational_collection_enabled { false };
+    bool m_needs_write_barrier { false };
+    size_t m_nursery_size { DEFAULT_NURSERY_SIZE };
+    size_t m_allocated_bytes_in_nursery { 0 };
+    Vector<Cell*> m_young_cells;
+    Vector<Cell*> m_remembered_cells;
+    CollectionStatistics m_minor_collection_statistics;
+    CollectionStatistics m_major_collection_statistics;
+
+    size_t m_allocation_sampling_interval { 0 };
+    size_t m_allocations_until_next_sample { 0 };
+    AK::Function<String()> m_capture_allocation_site;
+    HashMap<Cell*, String> m_sampled_allocation_sites;
+
     Vector<NonnullOwnPtr<CellAllocator>> m_size_based_cell_allocators;
     CellAllocator::List m_all_cell_allocators;
 
+    // Kept up to date as blocks are created and destroyed, so that possible pointers can be checked cheaply.
+    HashTable<HeapBlock*> m_all_live_heap_blocks;
+    FlatPtr m_min_block_address { explode_byte(0xff) };
+    FlatPtr m_max_block_address { 0 };
+
     RootImpl::List m_roots;
     RootVectorBase::List m_root_vectors;
     ConservativeVectorBase::List m_conservative_vectors;
@@ -210,4 +353,16 @@ inline void Heap::register_cell_allocator(Badge<CellAllocator>, CellAllocator& a
     m_all_cell_allocators.append(allocator);
 }
 
+inline void Heap::did_create_heap_block(Badge<CellAllocator>, HeapBlock& block)
+{
+    m_all_live_heap_blocks.set(&block);
+    m_min_block_address = min(m_min_block_address, bit_cast<FlatPtr>(&block));
+    m_max_block_address = max(m_max_block_address, bit_cast<FlatPtr>(&block));
+}
+
+inline void Heap::did_destroy_heap_block(Badge<CellAllocator>, HeapBlock& block)
+{
+    m_all_live_heap_blocks.remove(&block);
+}
+
 }
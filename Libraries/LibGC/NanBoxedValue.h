@@ -9,6 +9,7 @@
 #include <AK/BitCast.h>
 #include <AK/Types.h>
 #include <LibGC/Cell.h>
+#include <LibGC/WriteBarrier.h>
 
 namespace GC {
 
@@ -117,4 +118,11 @@ protected:
 
 static_assert(sizeof(NanBoxedValue) == sizeof(double));
 
+// See WriteBarrier.h. Must be called after storing the value into the given cell, or into a container it owns.
+ALWAYS_INLINE void write_barrier(Cell const& owner, NanBoxedValue const& value)
+{
+    if (is_write_barrier_enabled() && value.is_cell()) [[unlikely]]
+        write_barrier_slow_path(owner, &value.as_cell());
+}
+
 }
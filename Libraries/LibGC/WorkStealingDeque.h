@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/Noncopyable.h>
+#include <AK/Optional.h>
+#include <AK/Vector.h>
+#include <LibThreading/Mutex.h>
+
+namespace GC {
+
+// A deque of pending work shared between marking threads.
+// The owning thread pushes and pops at the back, while other threads steal from the front.
+// This keeps the owner working depth-first on the cells it most recently discovered,
+// while thieves take the oldest entries, which tend to lead to the largest unexplored subgraphs.
+template<typename T>
+class WorkStealingDeque {
+    AK_MAKE_NONCOPYABLE(WorkStealingDeque);
+    AK_MAKE_NONMOVABLE(WorkStealingDeque);
+
+public:
+    WorkStealingDeque() = default;
+
+    bool is_empty() const { return m_size.load(AK::memory_order_relaxed) == 0; }
+
+    void push(T value)
+    {
+        Threading::MutexLocker locker(m_mutex);
+        m_items.append(move(value));
+        m_size.store(m_items.size(), AK::memory_order_relaxed);
+    }
+
+    // Moves the oldest half of `values` into this deque, leaving the rest with the caller.
+    void push_half_of(Vector<T>& values)
+    {
+        auto count = values.size() / 2;
+        if (count == 0)
+            return;
+
+        Threading::MutexLocker locker(m_mutex);
+        m_items.append(values.data(), count);
+        values.remove(0, count);
+        m_size.store(m_items.size(), AK::memory_order_relaxed);
+    }
+
+    Optional<T> pop()
+    {
+        if (is_empty())
+            return {};
+
+        Threading::MutexLocker locker(m_mutex);
+        if (m_items.is_empty())
+            return {};
+        auto value = m_items.take_last();
+        m_size.store(m_items.size(), AK::memory_order_relaxed);
+        return value;
+    }
+
+    // Moves up to half (but at least one) of the items from the front of this deque into `out`.
+    // Returns false if there was nothing to steal.
+    bool steal_into(Vector<T>& out)
+    {
+        if (is_empty())
+            return false;
+
+        Threading::MutexLocker locker(m_mutex);
+        if (m_items.is_empty())
+            return false;
+        auto count = max<size_t>(1, m_items.size() / 2);
+        out.append(m_items.data(), count);
+        m_items.remove(0, count);
+        m_size.store(m_items.size(), AK::memory_order_relaxed);
+        return true;
+    }
+
+private:
+    Threading::Mutex m_mutex;
+    Vector<T> m_items;
+    Atomic<size_t> m_size { 0 };
+};
+
+}
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/Platform.h>
+#include <LibGC/Forward.h>
+
+namespace GC {
+
+// The number of heaps that need to observe stores of cell pointers, i.e. that are in an incremental
+// marking cycle, or have generational collection enabled. Heaps may live on different threads, so
+// this is a count rather than a flag; the slow path ignores stores into heaps that don't need it.
+extern Atomic<size_t, AK::memory_order_relaxed> g_heaps_needing_write_barrier;
+
+ALWAYS_INLINE bool is_write_barrier_enabled()
+{
+    return g_heaps_needing_write_barrier.load() != 0;
+}
+
+void write_barrier_slow_path(Cell const& owner, void const* cell);
+void write_barrier_slow_path(Cell const& owner);
+
+// Must be called after storing a pointer to `cell` into `owner`, either into one of its members or into a
+// container that its visit_edges() visits. Takes a void pointer so that it can be used with incomplete types;
+// interior pointers are fine.
+//
+// GC::Ptr, GC::Ref and NanBoxedValue (and thus JS::Value) don't do this by themselves, as they are mostly
+// temporaries and should stay trivially copyable. Instead, the setters that store them into cells do, e.g.
+// JS::Object::put_direct(). Stores into the stack, into registers, into a cell that is still being constructed,
+// or into anything that is gathered as a root don't need the barrier.
+//
+// During incremental marking, this is an insertion (Dijkstra-style) barrier: the cell may have been
+// stored into a cell that has already been visited, so we make sure it gets marked.
+// With generational collection, old cells that young cells are stored into are added to the remembered
+// set, and the next minor collection traces their edges.
+ALWAYS_INLINE void write_barrier(Cell const& owner, void const* cell)
+{
+    if (is_write_barrier_enabled() && cell) [[unlikely]]
+        write_barrier_slow_path(owner, cell);
+}
+
+// Like the above, for when any number of cell pointers may have been stored into `owner` at once,
+// e.g. when a suspended function's registers are saved into it.
+ALWAYS_INLINE void write_barrier(Cell const& owner)
+{
+    if (is_write_barrier_enabled()) [[unlikely]]
+        write_barrier_slow_path(owner);
+}
+
+}
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJIT/Assembler.h>
+
+namespace JIT {
+
+void Assembler::bind(Label& label)
+{
+    VERIFY(!label.is_bound());
+    label.m_offset = offset();
+    for (auto slot : label.m_unresolved_jump_slots)
+        patch_relative_offset(slot, offset());
+    label.m_unresolved_jump_slots.clear();
+}
+
+void Assembler::emit_modrm_memory(u8 reg, Memory memory)
+{
+    auto base = to_underlying(memory.base) & 7;
+    auto emit_sib_if_needed = [&] {
+        // rsp and r12 can only be used as a base through a SIB byte.
+        if (base == 4)
+            emit8(0x24);
+    };
+    // With mod=00, rbp and r13 mean rip-relative addressing, so they always get a displacement.
+    if (memory.offset == 0 && base != 5) {
+        emit8(((reg & 7) << 3) | base);
+        emit_sib_if_needed();
+    } else if (memory.offset >= -128 && memory.offset <= 127) {
+        emit8(0x40 | ((reg & 7) << 3) | base);
+        emit_sib_if_needed();
+        emit8(static_cast<u8>(memory.offset));
+    } else {
+        emit8(0x80 | ((reg & 7) << 3) | base);
+        emit_sib_if_needed();
+        emit32(static_cast<u32>(memory.offset));
+    }
+}
+
+void Assembler::emit_jump_slot(Label& label)
+{
+    auto slot = offset();
+    emit32(0);
+    if (label.is_bound())
+        patch_relative_offset(slot, label.offset());
+    else
+        label.m_unresolved_jump_slots.append(slot);
+}
+
+void Assembler::patch_relative_offset(size_t slot, size_t target)
+{
+    auto relative_offset = static_cast<i32>(static_cast<i64>(target) - static_cast<i64>(slot + 4));
+    for (size_t i = 0; i < 4; ++i)
+        m_output[slot + i] = (static_cast<u32>(relative_offset) >> (i * 8)) & 0xff;
+}
+
+}
@@ -0,0 +1,380 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/NumericLimits.h>
+#include <AK/Optional.h>
+#include <AK/StdLibExtras.h>
+#include <AK/Types.h>
+#include <AK/Vector.h>
+
+namespace JIT {
+
+// A minimal x86-64 assembler, covering just the instructions used by the baseline compilers of LibJS and LibWasm.
+// Every memory operand is of the form [base + offset].
+class Assembler {
+public:
+    enum class Reg : u8 {
+        RAX = 0,
+        RCX = 1,
+        RDX = 2,
+        RBX = 3,
+        RSP = 4,
+        RBP = 5,
+        RSI = 6,
+        RDI = 7,
+        R8 = 8,
+        R9 = 9,
+        R10 = 10,
+        R11 = 11,
+        R12 = 12,
+        R13 = 13,
+        R14 = 14,
+        R15 = 15,
+    };
+
+    enum class Condition : u8 {
+        Overflow = 0x0,
+        UnsignedLessThan = 0x2,
+        UnsignedGreaterThanOrEqualTo = 0x3,
+        EqualTo = 0x4,
+        NotEqualTo = 0x5,
+        UnsignedLessThanOrEqualTo = 0x6,
+        UnsignedGreaterThan = 0x7,
+        SignedLessThan = 0xc,
+        SignedGreaterThanOrEqualTo = 0xd,
+        SignedLessThanOrEqualTo = 0xe,
+        SignedGreaterThan = 0xf,
+    };
+
+    struct Memory {
+        Reg base;
+        i32 offset { 0 };
+    };
+
+    class Label {
+    public:
+        bool is_bound() const { return m_offset.has_value(); }
+        size_t offset() const { return m_offset.value(); }
+
+    private:
+        friend class Assembler;
+
+        Optional<size_t> m_offset;
+        Vector<size_t> m_unresolved_jump_slots;
+    };
+
+    explicit Assembler(Vector<u8>& output)
+        : m_output(output)
+    {
+    }
+
+    size_t offset() const { return m_output.size(); }
+
+    void bind(Label&);
+
+    // mov dst, src
+    void mov(Reg dst, Reg src) { emit_reg_rm(true, 0x89, src, dst); }
+    // mov dst32, src32 (zero-extends into the upper half of dst)
+    void mov32(Reg dst, Reg src) { emit_reg_rm(false, 0x89, src, dst); }
+    // mov dst, qword [base + offset]
+    void mov(Reg dst, Memory src) { emit_reg_memory(true, 0x8b, dst, src); }
+    // mov qword [base + offset], src
+    void mov(Memory dst, Reg src) { emit_reg_memory(true, 0x89, src, dst); }
+    // mov dst32, dword [base + offset] (zero-extends into the upper half of dst)
+    void mov32(Reg dst, Memory src) { emit_reg_memory(false, 0x8b, dst, src); }
+    // mov dword [base + offset], src32
+    void mov32(Memory dst, Reg src) { emit_reg_memory(false, 0x89, src, dst); }
+    // mov word [base + offset], src16
+    void mov16(Memory dst, Reg src)
+    {
+        emit8(0x66);
+        emit_reg_memory(false, 0x89, src, dst);
+    }
+    // mov byte [base + offset], src8
+    void mov8(Memory dst, Reg src)
+    {
+        emit_rex(false, to_underlying(src), to_underlying(dst.base), needs_rex_for_byte_register(src));
+        emit8(0x88);
+        emit_modrm_memory(to_underlying(src), dst);
+    }
+    // mov qword [base + offset], imm32 (sign-extended)
+    void mov(Memory dst, i32 imm)
+    {
+        emit_reg_memory(true, 0xc7, 0, dst);
+        emit32(imm);
+    }
+    // mov dst32, imm32 (zero-extended)
+    void mov32(Reg dst, u32 imm)
+    {
+        emit_rex(false, 0, to_underlying(dst));
+        emit8(0xb8 + (to_underlying(dst) & 7));
+        emit32(imm);
+    }
+    // movabs dst, imm64
+    void mov(Reg dst, u64 imm)
+    {
+        if (imm <= NumericLimits<u32>::max()) {
+            mov32(dst, static_cast<u32>(imm));
+            return;
+        }
+        emit_rex(true, 0, to_underlying(dst));
+        emit8(0xb8 + (to_underlying(dst) & 7));
+        emit64(imm);
+    }
+    // movzx dst32, src8
+    void movzx8(Reg dst, Reg src)
+    {
+        emit_rex(false, to_underlying(dst), to_underlying(src), needs_rex_for_byte_register(src));
+        emit8(0x0f);
+        emit8(0xb6);
+        emit_modrm_reg(to_underlying(dst), to_underlying(src));
+    }
+    // movzx dst32, byte [base + offset]
+    void movzx8(Reg dst, Memory src) { emit_two_byte_reg_memory(false, 0xb6, dst, src); }
+    // movzx dst32, word [base + offset]
+    void movzx16(Reg dst, Memory src) { emit_two_byte_reg_memory(false, 0xb7, dst, src); }
+    // movsx dst, src8
+    void movsx8(Reg dst, Reg src)
+    {
+        emit_rex(true, to_underlying(dst), to_underlying(src));
+        emit8(0x0f);
+        emit8(0xbe);
+        emit_modrm_reg(to_underlying(dst), to_underlying(src));
+    }
+    // movsx dst, src16
+    void movsx16(Reg dst, Reg src)
+    {
+        emit_rex(true, to_underlying(dst), to_underlying(src));
+        emit8(0x0f);
+        emit8(0xbf);
+        emit_modrm_reg(to_underlying(dst), to_underlying(src));
+    }
+    // movsxd dst, src32
+    void movsx32(Reg dst, Reg src) { emit_reg_rm(true, 0x63, dst, src); }
+    // movsx dst, byte [base + offset]
+    void movsx8(Reg dst, Memory src) { emit_two_byte_reg_memory(true, 0xbe, dst, src); }
+    // movsx dst, word [base + offset]
+    void movsx16(Reg dst, Memory src) { emit_two_byte_reg_memory(true, 0xbf, dst, src); }
+    // movsxd dst, dword [base + offset]
+    void movsx32(Reg dst, Memory src) { emit_reg_memory(true, 0x63, dst, src); }
+
+    void add(Reg dst, Reg src) { emit_reg_rm(true, 0x01, src, dst); }
+    void add(Reg dst, Memory src) { emit_reg_memory(true, 0x03, dst, src); }
+    void add(Reg dst, i32 imm) { emit_group1_imm32(true, 0, dst, imm); }
+    void add32(Reg dst, Reg src) { emit_reg_rm(false, 0x01, src, dst); }
+    void sub(Reg dst, i32 imm) { emit_group1_imm32(true, 5, dst, imm); }
+    void sub(Reg dst, Reg src) { emit_reg_rm(true, 0x29, src, dst); }
+    void sub32(Reg dst, Reg src) { emit_reg_rm(false, 0x29, src, dst); }
+    void multiply(Reg dst, Reg src)
+    {
+        emit_rex(true, to_underlying(dst), to_underlying(src));
+        emit8(0x0f);
+        emit8(0xaf);
+        emit_modrm_reg(to_underlying(dst), to_underlying(src));
+    }
+    void multiply32(Reg dst, Reg src)
+    {
+        emit_rex(false, to_underlying(dst), to_underlying(src));
+        emit8(0x0f);
+        emit8(0xaf);
+        emit_modrm_reg(to_underlying(dst), to_underlying(src));
+    }
+    void bitwise_or(Reg dst, Reg src) { emit_reg_rm(true, 0x09, src, dst); }
+    void bitwise_or32(Reg dst, Reg src) { emit_reg_rm(false, 0x09, src, dst); }
+    void bitwise_and(Reg dst, Reg src) { emit_reg_rm(true, 0x21, src, dst); }
+    void bitwise_and32(Reg dst, Reg src) { emit_reg_rm(false, 0x21, src, dst); }
+    void bitwise_and32(Reg dst, u32 imm) { emit_group1_imm32(false, 4, dst, static_cast<i32>(imm)); }
+    void bitwise_xor(Reg dst, Reg src) { emit_reg_rm(true, 0x31, src, dst); }
+    void bitwise_xor32(Reg dst, Reg src) { emit_reg_rm(false, 0x31, src, dst); }
+
+    void shift_left(Reg dst, u8 amount) { emit_shift(4, dst, amount); }
+    void shift_right(Reg dst, u8 amount) { emit_shift(5, dst, amount); }
+    void arithmetic_shift_right(Reg dst, u8 amount) { emit_shift(7, dst, amount); }
+
+    // Shifts and rotates by cl, which the processor masks to the width of the operand.
+    void shift_left_by_cl(Reg dst) { emit_shift_by_cl(true, 4, dst); }
+    void shift_left32_by_cl(Reg dst) { emit_shift_by_cl(false, 4, dst); }
+    void shift_right_by_cl(Reg dst) { emit_shift_by_cl(true, 5, dst); }
+    void shift_right32_by_cl(Reg dst) { emit_shift_by_cl(false, 5, dst); }
+    void arithmetic_shift_right_by_cl(Reg dst) { emit_shift_by_cl(true, 7, dst); }
+    void arithmetic_shift_right32_by_cl(Reg dst) { emit_shift_by_cl(false, 7, dst); }
+    void rotate_left_by_cl(Reg dst) { emit_shift_by_cl(true, 0, dst); }
+    void rotate_left32_by_cl(Reg dst) { emit_shift_by_cl(false, 0, dst); }
+    void rotate_right_by_cl(Reg dst) { emit_shift_by_cl(true, 1, dst); }
+    void rotate_right32_by_cl(Reg dst) { emit_shift_by_cl(false, 1, dst); }
+
+    // cmp lhs, qword [base + offset]
+    void cmp(Reg lhs, Memory rhs) { emit_reg_memory(true, 0x3b, lhs, rhs); }
+    void cmp(Reg lhs, Reg rhs) { emit_reg_rm(true, 0x39, rhs, lhs); }
+    void cmp32(Reg lhs, Reg rhs) { emit_reg_rm(false, 0x39, rhs, lhs); }
+    void cmp32(Reg lhs, u32 imm) { emit_group1_imm32(false, 7, lhs, static_cast<i32>(imm)); }
+    // cmp byte [lhs], imm8
+    void cmp8(Memory lhs, u8 imm)
+    {
+        emit_reg_memory(false, 0x80, 7, lhs);
+        emit8(imm);
+    }
+    void test(Reg lhs, Reg rhs) { emit_reg_rm(true, 0x85, rhs, lhs); }
+    void test32(Reg lhs, Reg rhs) { emit_reg_rm(false, 0x85, rhs, lhs); }
+    void test32(Reg lhs, u32 imm)
+    {
+        emit_rex(false, 0, to_underlying(lhs));
+        emit8(0xf7);
+        emit_modrm_reg(0, to_underlying(lhs));
+        emit32(imm);
+    }
+
+    // setcc dst8
+    void set(Condition condition, Reg dst)
+    {
+        emit_rex(false, 0, to_underlying(dst), needs_rex_for_byte_register(dst));
+        emit8(0x0f);
+        emit8(0x90 | to_underlying(condition));
+        emit_modrm_reg(0, to_underlying(dst));
+    }
+
+    void jump(Label& label)
+    {
+        emit8(0xe9);
+        emit_jump_slot(label);
+    }
+
+    void jump_if(Condition condition, Label& label)
+    {
+        emit8(0x0f);
+        emit8(0x80 | to_underlying(condition));
+        emit_jump_slot(label);
+    }
+
+    void jump(Reg target)
+    {
+        emit_rex(false, 0, to_underlying(target));
+        emit8(0xff);
+        emit_modrm_reg(4, to_underlying(target));
+    }
+
+    void call(Reg target)
+    {
+        emit_rex(false, 0, to_underlying(target));
+        emit8(0xff);
+        emit_modrm_reg(2, to_underlying(target));
+    }
+
+    void push(Reg reg)
+    {
+        emit_rex(false, 0, to_underlying(reg));
+        emit8(0x50 + (to_underlying(reg) & 7));
+    }
+
+    void pop(Reg reg)
+    {
+        emit_rex(false, 0, to_underlying(reg));
+        emit8(0x58 + (to_underlying(reg) & 7));
+    }
+
+    void ret() { emit8(0xc3); }
+
+private:
+    static bool needs_rex_for_byte_register(Reg reg)
+    {
+        // Without a REX prefix, the encodings of spl, bpl, sil and dil refer to ah, ch, dh and bh.
+        return reg >= Reg::RSP && reg <= Reg::RDI;
+    }
+
+    void emit8(u8 value) { m_output.append(value); }
+
+    void emit32(u32 value)
+    {
+        for (size_t i = 0; i < 4; ++i)
+            emit8((value >> (i * 8)) & 0xff);
+    }
+
+    void emit64(u64 value)
+    {
+        for (size_t i = 0; i < 8; ++i)
+            emit8((value >> (i * 8)) & 0xff);
+    }
+
+    void emit_rex(bool is_64_bit, u8 reg, u8 rm, bool force = false)
+    {
+        u8 rex = 0x40;
+        if (is_64_bit)
+            rex |= 0x08;
+        if (reg & 8)
+            rex |= 0x04;
+        if (rm & 8)
+            rex |= 0x01;
+        if (rex != 0x40 || force)
+            emit8(rex);
+    }
+
+    void emit_modrm_reg(u8 reg, u8 rm)
+    {
+        emit8(0xc0 | ((reg & 7) << 3) | (rm & 7));
+    }
+
+    void emit_modrm_memory(u8 reg, Memory);
+
+    // An instruction of the form "opcode r/m, reg" (or "opcode reg, r/m", depending on the opcode) with a register r/m.
+    void emit_reg_rm(bool is_64_bit, u8 opcode, Reg reg, Reg rm)
+    {
+        emit_rex(is_64_bit, to_underlying(reg), to_underlying(rm));
+        emit8(opcode);
+        emit_modrm_reg(to_underlying(reg), to_underlying(rm));
+    }
+
+    void emit_reg_memory(bool is_64_bit, u8 opcode, Reg reg, Memory memory)
+    {
+        emit_reg_memory(is_64_bit, opcode, to_underlying(reg), memory);
+    }
+
+    void emit_reg_memory(bool is_64_bit, u8 opcode, u8 reg, Memory memory)
+    {
+        emit_rex(is_64_bit, reg, to_underlying(memory.base));
+        emit8(opcode);
+        emit_modrm_memory(reg, memory);
+    }
+
+    void emit_two_byte_reg_memory(bool is_64_bit, u8 opcode, Reg reg, Memory memory)
+    {
+        emit_rex(is_64_bit, to_underlying(reg), to_underlying(memory.base));
+        emit8(0x0f);
+        emit8(opcode);
+        emit_modrm_memory(to_underlying(reg), memory);
+    }
+
+    void emit_group1_imm32(bool is_64_bit, u8 extension, Reg dst, i32 imm)
+    {
+        emit_rex(is_64_bit, 0, to_underlying(dst));
+        emit8(0x81);
+        emit_modrm_reg(extension, to_underlying(dst));
+        emit32(static_cast<u32>(imm));
+    }
+
+    void emit_shift(u8 extension, Reg dst, u8 amount)
+    {
+        emit_rex(true, 0, to_underlying(dst));
+        emit8(0xc1);
+        emit_modrm_reg(extension, to_underlying(dst));
+        emit8(amount);
+    }
+
+    void emit_shift_by_cl(bool is_64_bit, u8 extension, Reg dst)
+    {
+        emit_rex(is_64_bit, 0, to_underlying(dst));
+        emit8(0xd3);
+        emit_modrm_reg(extension, to_underlying(dst));
+    }
+
+    void emit_jump_slot(Label&);
+    void patch_relative_offset(size_t slot, size_t target);
+
+    Vector<u8>& m_output;
+};
+
+}
@@ -16,6 +16,7 @@
 #include <LibGC/ConservativeVector.h>
 #include <LibGC/RootVector.h>
 #include <LibJS/AST.h>
+#include <LibJS/Parser.h>
 #include <LibJS/Runtime/AbstractOperations.h>
 #include <LibJS/Runtime/Accessor.h>
 #include <LibJS/Runtime/Array.h>
@@ -464,6 +465,26 @@ void ScopeNode::dump(int indent) const
     }
 }
 
+LazyFunctionBody::Parsed const* LazyFunctionBody::parsed() const
+{
+    if (!m_parsed.has_value() && !m_failed_to_parse) {
+        m_parsed = Parser::parse_lazy_function_body(*this);
+        m_failed_to_parse = !m_parsed.has_value();
+        m_free_identifiers.clear();
+    }
+    return m_parsed.has_value() ? &m_parsed.value() : nullptr;
+}
+
+void LazyFunctionBody::dump(int indent) const
+{
+    if (m_parsed.has_value()) {
+        m_parsed->body->dump(indent);
+        return;
+    }
+    print_indent(indent);
+    outln("{} (not parsed yet)", class_name());
+}
+
 void BinaryExpression::dump(int indent) const
 {
     char const* op_string = nullptr;
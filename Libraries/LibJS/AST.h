@@ -17,6 +17,7 @@
 #include <LibGC/Root.h>
 #include <LibJS/Bytecode/CodeGenerationError.h>
 #include <LibJS/Bytecode/Executable.h>
+#include <LibJS/Bytecode/ExecutableCache.h>
 #include <LibJS/Bytecode/IdentifierTable.h>
 #include <LibJS/Bytecode/Op.h>
 #include <LibJS/Bytecode/Operand.h>
@@ -99,6 +100,7 @@ public:
     virtual bool is_labelled_statement() const { return false; }
     virtual bool is_iteration_statement() const { return false; }
     virtual bool is_class_method() const { return false; }
+    virtual bool is_lazy_function_body() const { return false; }
 
 protected:
     explicit ASTNode(SourceRange);
@@ -333,10 +335,18 @@ public:
         return index;
     }
 
+    virtual ~ScopeNode() override
+    {
+        if (Bytecode::ExecutableCache::is_enabled())
+            Bytecode::ExecutableCache::will_destroy_node(*this);
+    }
+
 protected:
     explicit ScopeNode(SourceRange source_range)
         : Statement(move(source_range))
     {
+        if (Bytecode::ExecutableCache::is_enabled())
+            Bytecode::ExecutableCache::did_create_node(*this);
     }
 
 private:
@@ -699,6 +709,65 @@ struct FunctionParsingInsights {
     bool might_need_arguments_object { false };
 };
 
+// Stands in for the body of a function that the parser skipped. The PreParser has checked the body for syntax errors
+// and found the names it uses without declaring them, which is what the scope analysis of the code around it needs.
+// The function is parsed properly on its own when it's first called. See Parser::parse_lazy_function_body().
+class LazyFunctionBody final : public Statement {
+public:
+    // The parameters and insights that go with the body come from the second parse as well, as the first one only had
+    // a rough idea of what the body does.
+    struct Parsed {
+        NonnullRefPtr<FunctionBody const> body;
+        Vector<FunctionParameter> parameters;
+        FunctionParsingInsights parsing_insights;
+    };
+
+    LazyFunctionBody(SourceRange source_range, ByteString function_source_text, u32 function_start_offset, Position parameters_start, u16 parse_options, FunctionKind kind, bool starts_in_strict_mode, Program::Type program_type, Vector<NonnullRefPtr<Identifier const>> free_identifiers)
+        : Statement(move(source_range))
+        , m_function_source_text(move(function_source_text))
+        , m_function_start_offset(function_start_offset)
+        , m_parameters_start(parameters_start)
+        , m_free_identifiers(move(free_identifiers))
+        , m_parse_options(parse_options)
+        , m_kind(kind)
+        , m_starts_in_strict_mode(starts_in_strict_mode)
+        , m_program_type(program_type)
+    {
+    }
+
+    ByteString const& function_source_text() const { return m_function_source_text; }
+    u32 function_start_offset() const { return m_function_start_offset; }
+    Position const& parameters_start() const { return m_parameters_start; }
+    u16 parse_options() const { return m_parse_options; }
+    FunctionKind kind() const { return m_kind; }
+    bool starts_in_strict_mode() const { return m_starts_in_strict_mode; }
+    Program::Type program_type() const { return m_program_type; }
+
+    // One identifier for each name that the function uses but doesn't declare. Once the whole script has been parsed,
+    // these tell which of those names were resolved to global variables.
+    Vector<NonnullRefPtr<Identifier const>> const& free_identifiers() const { return m_free_identifiers; }
+
+    bool is_parsed() const { return m_parsed.has_value(); }
+    // Returns null if the function couldn't be parsed, which shouldn't happen for a body that the PreParser accepted.
+    Parsed const* parsed() const;
+
+    virtual void dump(int indent) const override;
+
+private:
+    virtual bool is_lazy_function_body() const override { return true; }
+
+    ByteString m_function_source_text;
+    u32 m_function_start_offset { 0 };
+    Position m_parameters_start;
+    mutable Vector<NonnullRefPtr<Identifier const>> m_free_identifiers;
+    mutable Optional<Parsed> m_parsed;
+    mutable bool m_failed_to_parse { false };
+    u16 m_parse_options { 0 };
+    FunctionKind m_kind { FunctionKind::Normal };
+    bool m_starts_in_strict_mode { false };
+    Program::Type m_program_type { Program::Type::Script };
+};
+
 class FunctionNode {
 public:
     StringView name() const { return m_name ? m_name->string().view() : ""sv; }
@@ -719,7 +788,11 @@ public:
     virtual bool has_name() const = 0;
     virtual Value instantiate_ordinary_function_expression(VM&, DeprecatedFlyString given_name) const = 0;
 
-    virtual ~FunctionNode() { }
+    virtual ~FunctionNode()
+    {
+        if (Bytecode::ExecutableCache::is_enabled())
+            Bytecode::ExecutableCache::will_destroy_node(*this);
+    }
 
 protected:
     FunctionNode(RefPtr<Identifier const> name, ByteString source_text, NonnullRefPtr<Statement const> body, Vector<FunctionParameter> parameters, i32 function_length, FunctionKind kind, bool is_strict_mode, FunctionParsingInsights parsing_insights, bool is_arrow_function, Vector<DeprecatedFlyString> local_variables_names)
@@ -736,6 +809,8 @@ protected:
     {
         if (m_is_arrow_function)
             VERIFY(!parsing_insights.might_need_arguments_object);
+        if (Bytecode::ExecutableCache::is_enabled())
+            Bytecode::ExecutableCache::did_create_node(*this);
     }
 
     void dump(int indent, ByteString const& class_name) const;
@@ -1431,6 +1506,14 @@ public:
         , m_super_class(move(super_class))
         , m_elements(move(elements))
     {
+        if (Bytecode::ExecutableCache::is_enabled())
+            Bytecode::ExecutableCache::did_create_node(*this);
+    }
+
+    virtual ~ClassExpression() override
+    {
+        if (Bytecode::ExecutableCache::is_enabled())
+            Bytecode::ExecutableCache::will_destroy_node(*this);
     }
 
     StringView name() const { return m_name ? m_name->string().view() : ""sv; }
@@ -2260,4 +2343,7 @@ inline bool ASTNode::fast_is<IterationStatement>() const { return is_iteration_s
 template<>
 inline bool ASTNode::fast_is<ClassMethod>() const { return is_class_method(); }
 
+template<>
+inline bool ASTNode::fast_is<LazyFunctionBody>() const { return is_lazy_function_body(); }
+
 }
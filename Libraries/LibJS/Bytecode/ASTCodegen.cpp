@@ -1114,7 +1114,17 @@ Bytecode::CodeGenerationErrorOr<Optional<ScopedOperand>> ObjectExpression::gener
 
     auto object = generator.allocate_register();
 
-    generator.emit<Bytecode::Op::NewObject>(object);
+    // OPTIMIZATION: If the literal always defines the same data properties in the same order, every object it creates
+    //               ends up with the same shape, so later objects can start out with that shape.
+    //               Past the transition limit, objects get a dictionary shape of their own, which can't be shared.
+    static constexpr size_t max_properties_for_shape_cache = 64;
+    Optional<u32> shape_cache_index;
+    if (!m_properties.is_empty() && m_properties.size() < max_properties_for_shape_cache
+        && all_of(m_properties, [](auto const& property) { return property->type() == ObjectProperty::Type::KeyValue && is<StringLiteral>(property->key()); })) {
+        shape_cache_index = generator.next_object_shape_cache();
+    }
+
+    generator.emit<Bytecode::Op::NewObject>(object, shape_cache_index);
     if (m_properties.is_empty())
         return object;
 
@@ -1166,6 +1176,9 @@ Bytecode::CodeGenerationErrorOr<Optional<ScopedOperand>> ObjectExpression::gener
         }
     }
 
+    if (shape_cache_index.has_value())
+        generator.emit<Bytecode::Op::CacheObjectShape>(object, *shape_cache_index);
+
     generator.pop_home_object();
     return object;
 }
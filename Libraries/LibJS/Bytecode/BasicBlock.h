@@ -30,6 +30,7 @@ public:
     ~BasicBlock();
 
     u32 index() const { return m_index; }
+    void set_index(Badge<Optimizer>, u32 index) { m_index = index; }
 
     ReadonlyBytes instruction_stream() const { return m_buffer.span(); }
     u8* data() { return m_buffer.data(); }
@@ -44,6 +45,10 @@ public:
 
     void grow(size_t additional_size);
 
+    // Takes ownership of the instructions in the given buffer. Every instruction in the current buffer
+    // must either have been copied into the new one or destroyed.
+    void replace_instruction_stream(Badge<Optimizer>, Vector<u8> buffer, HashMap<size_t, SourceRecord> source_map);
+
     void terminate(Badge<Generator>) { m_terminated = true; }
     bool is_terminated() const { return m_terminated; }
 
@@ -7,7 +7,10 @@
 #include <LibJS/Bytecode/BasicBlock.h>
 #include <LibJS/Bytecode/Executable.h>
 #include <LibJS/Bytecode/Instruction.h>
+#include <LibJS/Bytecode/Op.h>
 #include <LibJS/Bytecode/RegexTable.h>
+#include <LibJS/JIT/NativeExecutable.h>
+#include <LibJS/Runtime/Shape.h>
 #include <LibJS/Runtime/Value.h>
 #include <LibJS/SourceCode.h>
 
@@ -15,6 +18,62 @@ namespace JS::Bytecode {
 
 GC_DEFINE_ALLOCATOR(Executable);
 
+PropertyLookupCache::State PropertyLookupCache::state() const
+{
+    if (is_megamorphic)
+        return State::Megamorphic;
+    size_t number_of_shapes = 0;
+    for (auto const& entry : entries) {
+        if (entry.shape)
+            ++number_of_shapes;
+    }
+    if (number_of_shapes == 0)
+        return State::Uninitialized;
+    if (number_of_shapes == 1)
+        return State::Monomorphic;
+    return State::Polymorphic;
+}
+
+PropertyLookupCache::Entry* PropertyLookupCache::entry_to_update_for(Shape const& shape)
+{
+    Entry* free_entry = nullptr;
+    for (auto& entry : entries) {
+        if (entry.shape == &shape)
+            return &entry;
+        // Entries whose shape has been garbage collected can be reused.
+        if (!free_entry && !entry.shape)
+            free_entry = &entry;
+    }
+    return free_entry;
+}
+
+size_t MegamorphicPropertyCache::slot_index(Shape const& shape, StringOrSymbol const& key, AccessKind access_kind)
+{
+    auto hash = pair_int_hash(ptr_hash(&shape), key.hash());
+    hash = pair_int_hash(hash, to_underlying(access_kind));
+    return hash % number_of_slots;
+}
+
+PropertyLookupCache::Entry const* MegamorphicPropertyCache::find(Shape const& shape, StringOrSymbol const& key, AccessKind access_kind)
+{
+    auto& slot = m_slots[slot_index(shape, key, access_kind)];
+    if (slot.entry.shape == &shape && slot.access_kind == access_kind && slot.key == key) {
+        ++m_hit_count;
+        return &slot.entry;
+    }
+    ++m_miss_count;
+    return nullptr;
+}
+
+PropertyLookupCache::Entry& MegamorphicPropertyCache::entry_to_update_for(Shape const& shape, StringOrSymbol const& key, AccessKind access_kind)
+{
+    auto& slot = m_slots[slot_index(shape, key, access_kind)];
+    slot.entry = {};
+    slot.key = key;
+    slot.access_kind = access_kind;
+    return slot.entry;
+}
+
 Executable::Executable(
     Vector<u8> bytecode,
     NonnullOwnPtr<IdentifierTable> identifier_table,
@@ -24,6 +83,7 @@ Executable::Executable(
     NonnullRefPtr<SourceCode const> source_code,
     size_t number_of_property_lookup_caches,
     size_t number_of_global_variable_caches,
+    size_t number_of_object_shape_caches,
     size_t number_of_registers,
     bool is_strict_mode)
     : bytecode(move(bytecode))
@@ -37,6 +97,7 @@ Executable::Executable(
 {
     property_lookup_caches.resize(number_of_property_lookup_caches);
     global_variable_caches.resize(number_of_global_variable_caches);
+    object_shape_caches.resize(number_of_object_shape_caches);
 }
 
 Executable::~Executable() = default;
@@ -44,6 +105,13 @@ Executable::~Executable() = default;
 void Executable::dump() const
 {
     warnln("\033[37;1mJS bytecode executable\033[0m \"{}\"", name);
+    if (optimization_statistics.instruction_count_before != 0) {
+        warnln("Optimized from {} to {} instructions, and from {} to {} registers",
+            optimization_statistics.instruction_count_before,
+            optimization_statistics.instruction_count_after,
+            optimization_statistics.register_count_before,
+            optimization_statistics.register_count_after);
+    }
     InstructionStreamIterator it(bytecode, this);
 
     size_t basic_block_offset_index = 0;
@@ -84,10 +152,68 @@ void Executable::dump() const
     warnln("");
 }
 
+void Executable::dump_property_lookup_cache_statistics() const
+{
+    static constexpr auto state_name = [](PropertyLookupCache::State state) {
+        switch (state) {
+        case PropertyLookupCache::State::Uninitialized:
+            return "uninitialized"sv;
+        case PropertyLookupCache::State::Monomorphic:
+            return "monomorphic"sv;
+        case PropertyLookupCache::State::Polymorphic:
+            return "polymorphic"sv;
+        case PropertyLookupCache::State::Megamorphic:
+            return "megamorphic"sv;
+        }
+        VERIFY_NOT_REACHED();
+    };
+
+    warnln("\033[37;1mProperty lookup caches\033[0m \"{}\"", name);
+    InstructionStreamIterator it(bytecode, this);
+    while (!it.at_end()) {
+        auto const& instruction = *it;
+        Optional<u32> cache_index;
+        switch (instruction.type()) {
+#define __CACHING_OP(op)                                                     \
+    case Instruction::Type::op:                                              \
+        cache_index = static_cast<Op::op const&>(instruction).cache_index(); \
+        break;
+            __CACHING_OP(GetById)
+            __CACHING_OP(GetByIdWithThis)
+            __CACHING_OP(GetLength)
+            __CACHING_OP(GetLengthWithThis)
+            __CACHING_OP(PutById)
+            __CACHING_OP(PutByIdWithThis)
+#undef __CACHING_OP
+        default:
+            break;
+        }
+        if (cache_index.has_value()) {
+            auto const& cache = property_lookup_caches[*cache_index];
+            size_t number_of_shapes = 0;
+            for (auto const& entry : cache.entries) {
+                if (entry.shape)
+                    ++number_of_shapes;
+            }
+            warnln("[{:4x}] {:13} hits: {:6} misses: {:6} shapes: {} | {}",
+                it.offset(),
+                state_name(cache.state()),
+                cache.hit_count,
+                cache.miss_count,
+                number_of_shapes,
+                instruction.to_byte_string(*this));
+        }
+        ++it;
+    }
+    warnln("");
+}
+
 void Executable::visit_edges(Visitor& visitor)
 {
     Base::visit_edges(visitor);
     visitor.visit(constants);
+    if (native_executable)
+        native_executable->visit_edges(visitor);
 }
 
 Optional<Executable::ExceptionHandlers const&> Executable::exception_handlers_for_offset(size_t offset) const
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/DeprecatedFlyString.h>
 #include <AK/HashMap.h>
 #include <AK/NonnullOwnPtr.h>
@@ -18,20 +19,92 @@
 #include <LibJS/Forward.h>
 #include <LibJS/Heap/Cell.h>
 #include <LibJS/Runtime/EnvironmentCoordinate.h>
+#include <LibJS/Runtime/StringOrSymbol.h>
 #include <LibJS/SourceRange.h>
 
 namespace JS::Bytecode {
 
+// A polymorphic inline cache for a property access site, remembering where the property was found
+// for up to a few different receiver shapes.
 struct PropertyLookupCache {
+    static constexpr size_t max_number_of_shapes_to_remember = 4;
+
+    struct Entry {
+        WeakPtr<Shape> shape;
+        Optional<u32> property_offset;
+        // Set if the property was found on a prototype rather than on the receiver itself.
+        bool in_prototype_chain { false };
+        WeakPtr<Object> prototype;
+        WeakPtr<PrototypeChainValidity> prototype_chain_validity;
+        // Set if a put added the property to the receiver, moving it from `shape` to this shape.
+        WeakPtr<Shape> shape_after_put;
+    };
+
+    enum class State {
+        Uninitialized,
+        Monomorphic,
+        Polymorphic,
+        // The site has seen more shapes than it can remember, and now uses the MegamorphicPropertyCache.
+        Megamorphic,
+    };
+    State state() const;
+
+    // Returns the entry that a lookup on an object with the given shape should be cached in,
+    // or null if all entries are taken by other shapes.
+    Entry* entry_to_update_for(Shape const&);
+
+    AK::Array<Entry, max_number_of_shapes_to_remember> entries;
+    bool is_megamorphic { false };
+    u32 hit_count { 0 };
+    u32 miss_count { 0 };
+};
+
+// Shared by all megamorphic property access sites of an interpreter.
+// This is a direct-mapped table keyed on the receiver shape, the property key (a string or a symbol) and the kind of access.
+class MegamorphicPropertyCache {
+public:
+    enum class AccessKind : u8 {
+        Get,
+        Put,
+    };
+
+    PropertyLookupCache::Entry const* find(Shape const&, StringOrSymbol const& key, AccessKind);
+    // Evicts whatever occupied the slot for this key, and returns the (cleared) entry to fill in.
+    PropertyLookupCache::Entry& entry_to_update_for(Shape const&, StringOrSymbol const& key, AccessKind);
+
+    u64 hit_count() const { return m_hit_count; }
+    u64 miss_count() const { return m_miss_count; }
+
+private:
+    static constexpr size_t number_of_slots = 1024;
+
+    struct Slot {
+        PropertyLookupCache::Entry entry;
+        // NOTE: A symbol key can't be collected while the entry is usable, as the entry's shape (or for prototype
+        //       chain entries, the prototype's shape) has it as a property key.
+        StringOrSymbol key;
+        AccessKind access_kind { AccessKind::Get };
+    };
+
+    static size_t slot_index(Shape const&, StringOrSymbol const& key, AccessKind);
+
+    AK::Array<Slot, number_of_slots> m_slots;
+    u64 m_hit_count { 0 };
+    u64 m_miss_count { 0 };
+};
+
+// Remembers the shape that an object literal ended up with, so that the next object created by it can start out with
+// that shape, rather than transitioning through one shape per property.
+struct ObjectShapeCache {
     WeakPtr<Shape> shape;
-    Optional<u32> property_offset;
-    WeakPtr<Object> prototype;
-    WeakPtr<PrototypeChainValidity> prototype_chain_validity;
 };
 
-struct GlobalVariableCache : public PropertyLookupCache {
+struct GlobalVariableCache {
+    WeakPtr<Shape> shape;
+    Optional<u32> property_offset;
     u64 environment_serial_number { 0 };
     Optional<u32> environment_binding_index;
+    Optional<u32> module_binding_index;
 };
 
 struct SourceRecord {
@@ -39,6 +112,14 @@ struct SourceRecord {
     u32 source_end_offset {};
 };
 
+// How much the optimizer shrank an executable, counted before the basic blocks were linked together.
+struct OptimizationStatistics {
+    size_t instruction_count_before { 0 };
+    size_t instruction_count_after { 0 };
+    u32 register_count_before { 0 };
+    u32 register_count_after { 0 };
+};
+
 class Executable final : public Cell {
     GC_CELL(Executable, Cell);
     GC_DECLARE_ALLOCATOR(Executable);
@@ -53,6 +134,7 @@ public:
         NonnullRefPtr<SourceCode const>,
         size_t number_of_property_lookup_caches,
         size_t number_of_global_variable_caches,
+        size_t number_of_object_shape_caches,
         size_t number_of_registers,
         bool is_strict_mode);
 
@@ -62,6 +144,7 @@ public:
     Vector<u8> bytecode;
     Vector<PropertyLookupCache> property_lookup_caches;
     Vector<GlobalVariableCache> global_variable_caches;
+    Vector<ObjectShapeCache> object_shape_caches;
     NonnullOwnPtr<StringTable> string_table;
     NonnullOwnPtr<IdentifierTable> identifier_table;
     NonnullOwnPtr<RegexTable> regex_table;
@@ -88,6 +171,13 @@ public:
 
     Optional<IdentifierTableIndex> length_identifier;
 
+    OptimizationStatistics optimization_statistics;
+
+    // How many times this executable has been entered (saturating at the JIT compilation threshold),
+    // and the native code it was compiled to once that threshold was reached.
+    u32 execution_count { 0 };
+    OwnPtr<JIT::NativeExecutable> native_executable;
+
     ByteString const& get_string(StringTableIndex index) const { return string_table->get(index); }
     DeprecatedFlyString const& get_identifier(IdentifierTableIndex index) const { return identifier_table->get(index); }
 
@@ -103,6 +193,7 @@ public:
     [[nodiscard]] UnrealizedSourceRange source_range_at(size_t offset) const;
 
     void dump() const;
+    void dump_property_lookup_cache_statistics() const;
 
 private:
     virtual void visit_edges(Visitor&) override;
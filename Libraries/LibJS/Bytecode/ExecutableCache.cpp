@@ -0,0 +1,656 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Hex.h>
+#include <AK/MemoryStream.h>
+#include <LibCore/Directory.h>
+#include <LibCore/File.h>
+#include <LibCore/System.h>
+#include <LibCrypto/BigInt/SignedBigInteger.h>
+#include <LibCrypto/Checksum/CRC32.h>
+#include <LibCrypto/Hash/SHA2.h>
+#include <LibGC/DeferGC.h>
+#include <LibJS/AST.h>
+#include <LibJS/Bytecode/Executable.h>
+#include <LibJS/Bytecode/ExecutableCache.h>
+#include <LibJS/Bytecode/Instruction.h>
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/RegexTable.h>
+#include <LibJS/Runtime/BigInt.h>
+#include <LibJS/Runtime/PrimitiveString.h>
+#include <LibJS/Runtime/VM.h>
+#include <LibJS/SourceCode.h>
+#include <LibRegex/Regex.h>
+
+#if !defined(AK_OS_WINDOWS)
+#    include <dlfcn.h>
+#endif
+
+namespace JS::Bytecode {
+
+bool ExecutableCache::s_enabled = false;
+
+static ByteString s_directory;
+static ByteString s_build_identity;
+
+static constexpr u32 cache_file_magic = 0x4342534a; // "JSBC"
+static constexpr u32 cache_file_version = 3;
+
+// Small scripts are quick to compile, and not worth a file (and a hash) each.
+static constexpr size_t minimum_source_length_to_cache = 1024;
+
+enum class ConstantKind : u8 {
+    Primitive,
+    UTF8String,
+    UTF16String,
+    BigInt,
+};
+
+struct Link {
+    u32 bytecode_offset { 0 };
+    ExecutableCache::LinkKind kind { ExecutableCache::LinkKind::Scope };
+    u32 start_offset { 0 };
+    u32 end_offset { 0 };
+};
+
+// Cached bytecode is only valid for the LibJS it was generated by, so the cache files are tagged with the
+// path, size and modification time of the library (or executable) this code was loaded from.
+static ByteString build_identity()
+{
+#if !defined(AK_OS_WINDOWS)
+    Dl_info info {};
+    if (dladdr(reinterpret_cast<void const*>(&build_identity), &info) == 0 || !info.dli_fname)
+        return {};
+    StringView path { info.dli_fname, strlen(info.dli_fname) };
+    auto stat = Core::System::stat(path);
+    if (stat.is_error())
+        return {};
+    return ByteString::formatted("{}:{}:{}", path, stat.value().st_size, stat.value().st_mtime);
+#else
+    return {};
+#endif
+}
+
+void ExecutableCache::set_directory(ByteString directory)
+{
+    s_build_identity = build_identity();
+    if (s_build_identity.is_empty()) {
+        dbgln("Bytecode cache: Unable to identify this build of LibJS, not caching bytecode");
+        return;
+    }
+    if (auto result = Core::Directory::create(directory, Core::Directory::CreateDirectories::Yes, 0700); result.is_error()) {
+        dbgln("Bytecode cache: Unable to create {}: {}", directory, result.error());
+        return;
+    }
+    s_directory = move(directory);
+    s_enabled = true;
+}
+
+static void add_linkable_node(ExecutableCache::LinkKind kind, ASTNode const& range_node, void const* target)
+{
+    auto& state = range_node.source_code().executable_cache_state();
+    state.linkable_nodes[to_underlying(kind)].ensure(range_node.start_offset()).append({ &range_node, target });
+}
+
+static void remove_linkable_node(ExecutableCache::LinkKind kind, ASTNode const& range_node, void const* target)
+{
+    auto& state = range_node.source_code().executable_cache_state();
+    auto& nodes_by_start_offset = state.linkable_nodes[to_underlying(kind)];
+    auto nodes = nodes_by_start_offset.find(range_node.start_offset());
+    if (nodes == nodes_by_start_offset.end())
+        return;
+    nodes->value.remove_first_matching([&](auto const& node) { return node.target == target; });
+    if (nodes->value.is_empty())
+        nodes_by_start_offset.remove(nodes);
+}
+
+void ExecutableCache::did_create_node(ScopeNode const& node)
+{
+    add_linkable_node(ExecutableCache::LinkKind::Scope, node, &node);
+}
+
+// Functions are linked by the range of their body, as FunctionNode is not an ASTNode itself.
+void ExecutableCache::did_create_node(FunctionNode const& node)
+{
+    add_linkable_node(ExecutableCache::LinkKind::Function, node.body(), &node);
+}
+
+void ExecutableCache::did_create_node(ClassExpression const& node)
+{
+    add_linkable_node(ExecutableCache::LinkKind::Class, node, &node);
+}
+
+void ExecutableCache::will_destroy_node(ScopeNode const& node)
+{
+    remove_linkable_node(ExecutableCache::LinkKind::Scope, node, &node);
+}
+
+void ExecutableCache::will_destroy_node(FunctionNode const& node)
+{
+    remove_linkable_node(ExecutableCache::LinkKind::Function, node.body(), &node);
+}
+
+void ExecutableCache::will_destroy_node(ClassExpression const& node)
+{
+    remove_linkable_node(ExecutableCache::LinkKind::Class, node, &node);
+}
+
+// Returns the node of the given kind and range, unless there is more than one.
+void const* ExecutableCacheState::find_linkable_node(LinkKind kind, u32 start_offset, u32 end_offset) const
+{
+    auto nodes = linkable_nodes[to_underlying(kind)].get(start_offset);
+    if (!nodes.has_value())
+        return nullptr;
+    void const* found = nullptr;
+    for (auto const& node : *nodes) {
+        // NOTE: The end offset of a Program is only set once it has been parsed in full, so it is compared here rather than used as part of the key.
+        if (node.node->end_offset() != end_offset)
+            continue;
+        if (found)
+            return nullptr;
+        found = node.target;
+    }
+    return found;
+}
+
+static ErrorOr<void> write_string(Stream& stream, StringView string)
+{
+    TRY(stream.write_value<u32>(string.length()));
+    TRY(stream.write_until_depleted(string.bytes()));
+    return {};
+}
+
+static ErrorOr<ByteString> read_string(Stream& stream)
+{
+    auto length = TRY(stream.read_value<u32>());
+    auto buffer = TRY(ByteBuffer::create_uninitialized(length));
+    TRY(stream.read_until_filled(buffer));
+    return ByteString { buffer.bytes() };
+}
+
+static ErrorOr<void> write_optional_offset(Stream& stream, Optional<size_t> offset)
+{
+    return stream.write_value<u64>(offset.value_or(NumericLimits<u64>::max()));
+}
+
+static ErrorOr<Optional<size_t>> read_optional_offset(Stream& stream)
+{
+    auto offset = TRY(stream.read_value<u64>());
+    if (offset == NumericLimits<u64>::max())
+        return Optional<size_t> {};
+    return Optional<size_t> { offset };
+}
+
+static ErrorOr<void> write_key(Stream& stream, ExecutableCacheState::RecordKey const& key)
+{
+    TRY(stream.write_value(to_underlying(key.compilation_kind)));
+    TRY(stream.write_value(key.function_kind));
+    TRY(stream.write_value(key.start_offset));
+    TRY(stream.write_value(key.end_offset));
+    TRY(write_string(stream, key.node_class_name));
+    return {};
+}
+
+static ErrorOr<ExecutableCacheState::RecordKey> read_key(Stream& stream)
+{
+    ExecutableCacheState::RecordKey key;
+    key.compilation_kind = static_cast<ExecutableCache::CompilationKind>(TRY(stream.read_value<u8>()));
+    key.function_kind = TRY(stream.read_value<u8>());
+    key.start_offset = TRY(stream.read_value<u32>());
+    key.end_offset = TRY(stream.read_value<u32>());
+    key.node_class_name = TRY(read_string(stream));
+    return key;
+}
+
+static ExecutableCacheState::RecordKey key_for(ASTNode const& node, ExecutableCache::CompilationKind compilation_kind, FunctionKind function_kind)
+{
+    return {
+        .compilation_kind = compilation_kind,
+        .function_kind = to_underlying(function_kind),
+        .start_offset = node.start_offset(),
+        .end_offset = node.end_offset(),
+        .node_class_name = node.class_name(),
+    };
+}
+
+static ErrorOr<Vector<Link>> find_links(Executable const& executable, ExecutableCacheState const& state)
+{
+    Vector<Link> links;
+    auto add_link = [&](size_t bytecode_offset, ExecutableCache::LinkKind kind, ASTNode const& range_node, void const* target) -> ErrorOr<void> {
+        // The node must be found again when this executable is loaded for a fresh parse of the same source.
+        if (state.find_linkable_node(kind, range_node.start_offset(), range_node.end_offset()) != target)
+            return AK::Error::from_string_literal("Instruction refers to an AST node that can't be found by its source range");
+        TRY(links.try_append({ static_cast<u32>(bytecode_offset), kind, range_node.start_offset(), range_node.end_offset() }));
+        return {};
+    };
+
+    for (InstructionStreamIterator it(executable.bytecode); !it.at_end(); ++it) {
+        auto const& instruction = *it;
+        switch (instruction.type()) {
+        case Instruction::Type::NewFunction: {
+            auto const& function_node = static_cast<Op::NewFunction const&>(instruction).function_node();
+            TRY(add_link(it.offset(), ExecutableCache::LinkKind::Function, function_node.body(), &function_node));
+            break;
+        }
+        case Instruction::Type::NewClass: {
+            auto const& class_expression = static_cast<Op::NewClass const&>(instruction).class_expression();
+            TRY(add_link(it.offset(), ExecutableCache::LinkKind::Class, class_expression, &class_expression));
+            break;
+        }
+        case Instruction::Type::BlockDeclarationInstantiation: {
+            auto const& scope_node = static_cast<Op::BlockDeclarationInstantiation const&>(instruction).scope_node();
+            TRY(add_link(it.offset(), ExecutableCache::LinkKind::Scope, scope_node, &scope_node));
+            break;
+        }
+        case Instruction::Type::Dump:
+            return AK::Error::from_string_literal("Dump refers to a string outside of the executable");
+        case Instruction::Type::NewPrimitiveArray:
+            for (auto value : static_cast<Op::NewPrimitiveArray const&>(instruction).elements()) {
+                if (value.is_cell())
+                    return AK::Error::from_string_literal("NewPrimitiveArray holds a cell");
+            }
+            break;
+        case Instruction::Type::IteratorClose: {
+            auto const& completion_value = static_cast<Op::IteratorClose const&>(instruction).completion_value();
+            if (completion_value.has_value() && completion_value->is_cell())
+                return AK::Error::from_string_literal("IteratorClose holds a cell");
+            break;
+        }
+        case Instruction::Type::AsyncIteratorClose: {
+            auto const& completion_value = static_cast<Op::AsyncIteratorClose const&>(instruction).completion_value();
+            if (completion_value.has_value() && completion_value->is_cell())
+                return AK::Error::from_string_literal("AsyncIteratorClose holds a cell");
+            break;
+        }
+        default:
+            break;
+        }
+    }
+    return links;
+}
+
+static ErrorOr<ByteBuffer> serialize(Executable const& executable, ExecutableCacheState const& state)
+{
+    auto links = TRY(find_links(executable, state));
+
+    AllocatingMemoryStream stream;
+    TRY(stream.write_value<u32>(executable.property_lookup_caches.size()));
+    TRY(stream.write_value<u32>(executable.global_variable_caches.size()));
+    TRY(stream.write_value<u32>(executable.object_shape_caches.size()));
+    TRY(stream.write_value<u32>(executable.number_of_registers));
+    TRY(stream.write_value<u8>(executable.is_strict_mode));
+    TRY(stream.write_value<u64>(executable.local_index_base));
+    TRY(stream.write_value<u32>(executable.length_identifier.has_value() ? executable.length_identifier->value : NumericLimits<u32>::max()));
+
+    TRY(stream.write_value<u32>(executable.local_variable_names.size()));
+    for (auto const& name : executable.local_variable_names)
+        TRY(write_string(stream, name.view()));
+
+    TRY(stream.write_value<u32>(executable.bytecode.size()));
+    TRY(stream.write_until_depleted(executable.bytecode.span()));
+
+    auto const& strings = executable.string_table->strings();
+    TRY(stream.write_value<u32>(strings.size()));
+    for (auto const& string : strings)
+        TRY(write_string(stream, string));
+
+    auto const& identifiers = executable.identifier_table->identifiers();
+    TRY(stream.write_value<u32>(identifiers.size()));
+    for (auto const& identifier : identifiers)
+        TRY(write_string(stream, identifier.view()));
+
+    // Compiled regexes are not serializable, so only their pattern and flags are stored, and they are parsed again on load.
+    auto const& regexes = executable.regex_table->regexes();
+    TRY(stream.write_value<u32>(regexes.size()));
+    for (auto const& regex : regexes) {
+        TRY(write_string(stream, regex.pattern));
+        TRY(stream.write_value<u32>(to_underlying(regex.flags.value())));
+    }
+
+    TRY(stream.write_value<u32>(executable.constants.size()));
+    for (auto constant : executable.constants) {
+        if (!constant.is_cell()) {
+            TRY(stream.write_value(ConstantKind::Primitive));
+            TRY(stream.write_value<u64>(constant.encoded()));
+        } else if (constant.is_string() && constant.as_string().has_utf8_string()) {
+            TRY(stream.write_value(ConstantKind::UTF8String));
+            TRY(write_string(stream, constant.as_string().utf8_string()));
+        } else if (constant.is_string()) {
+            auto string = constant.as_string().utf16_string();
+            auto const& code_units = string.string();
+            TRY(stream.write_value(ConstantKind::UTF16String));
+            TRY(stream.write_value<u32>(code_units.size()));
+            TRY(stream.write_until_depleted({ code_units.data(), code_units.size() * sizeof(u16) }));
+        } else if (constant.is_bigint()) {
+            TRY(stream.write_value(ConstantKind::BigInt));
+            TRY(write_string(stream, constant.as_bigint().big_integer().to_base_deprecated(10)));
+        } else {
+            return AK::Error::from_string_literal("Unsupported constant");
+        }
+    }
+
+    TRY(stream.write_value<u32>(executable.exception_handlers.size()));
+    for (auto const& handler : executable.exception_handlers) {
+        TRY(stream.write_value<u64>(handler.start_offset));
+        TRY(stream.write_value<u64>(handler.end_offset));
+        TRY(write_optional_offset(stream, handler.handler_offset));
+        TRY(write_optional_offset(stream, handler.finalizer_offset));
+    }
+
+    TRY(stream.write_value<u32>(executable.basic_block_start_offsets.size()));
+    for (auto offset : executable.basic_block_start_offsets)
+        TRY(stream.write_value<u64>(offset));
+
+    TRY(stream.write_value<u32>(executable.source_map.size()));
+    for (auto const& [offset, record] : executable.source_map) {
+        TRY(stream.write_value<u64>(offset));
+        TRY(stream.write_value(record.source_start_offset));
+        TRY(stream.write_value(record.source_end_offset));
+    }
+
+    TRY(stream.write_value<u32>(links.size()));
+    for (auto const& link : links) {
+        TRY(stream.write_value(link.bytecode_offset));
+        TRY(stream.write_value(link.kind));
+        TRY(stream.write_value(link.start_offset));
+        TRY(stream.write_value(link.end_offset));
+    }
+
+    return stream.read_until_eof();
+}
+
+ErrorOr<GC::Ref<Executable>> ExecutableCache::deserialize(VM& vm, SourceCode const& source_code, ExecutableCacheState const& state, ReadonlyBytes payload)
+{
+    GC::DeferGC defer_gc(vm.heap());
+    FixedMemoryStream stream { payload };
+
+    auto number_of_property_lookup_caches = TRY(stream.read_value<u32>());
+    auto number_of_global_variable_caches = TRY(stream.read_value<u32>());
+    auto number_of_object_shape_caches = TRY(stream.read_value<u32>());
+    auto number_of_registers = TRY(stream.read_value<u32>());
+    auto is_strict_mode = TRY(stream.read_value<u8>()) != 0;
+    auto local_index_base = TRY(stream.read_value<u64>());
+    auto length_identifier = TRY(stream.read_value<u32>());
+
+    Vector<DeprecatedFlyString> local_variable_names;
+    auto number_of_local_variable_names = TRY(stream.read_value<u32>());
+    for (u32 i = 0; i < number_of_local_variable_names; ++i)
+        TRY(local_variable_names.try_append(TRY(read_string(stream))));
+
+    Vector<u8> bytecode;
+    TRY(bytecode.try_resize(TRY(stream.read_value<u32>())));
+    TRY(stream.read_until_filled(bytecode.span()));
+
+    auto string_table = make<StringTable>();
+    auto number_of_strings = TRY(stream.read_value<u32>());
+    for (u32 i = 0; i < number_of_strings; ++i)
+        string_table->insert(TRY(read_string(stream)));
+
+    auto identifier_table = make<IdentifierTable>();
+    auto number_of_identifiers = TRY(stream.read_value<u32>());
+    for (u32 i = 0; i < number_of_identifiers; ++i)
+        identifier_table->insert(TRY(read_string(stream)));
+
+    auto regex_table = make<RegexTable>();
+    auto number_of_regexes = TRY(stream.read_value<u32>());
+    for (u32 i = 0; i < number_of_regexes; ++i) {
+        auto pattern = TRY(read_string(stream));
+        regex::RegexOptions<ECMAScriptFlags> flags { static_cast<ECMAScriptFlags>(TRY(stream.read_value<u32>())) };
+        auto parsed_regex = Regex<ECMA262>::parse_pattern(pattern, flags);
+        if (parsed_regex.error != regex::Error::NoError)
+            return AK::Error::from_string_literal("Cached regex failed to parse");
+        regex_table->insert({ .regex = move(parsed_regex), .pattern = move(pattern), .flags = flags });
+    }
+
+    Vector<Value> constants;
+    auto number_of_constants = TRY(stream.read_value<u32>());
+    for (u32 i = 0; i < number_of_constants; ++i) {
+        switch (TRY(stream.read_value<ConstantKind>())) {
+        case ConstantKind::Primitive: {
+            auto constant = Value::from_encoded(TRY(stream.read_value<u64>()));
+            if (constant.is_cell())
+                return AK::Error::from_string_literal("Cached primitive constant is a cell");
+            TRY(constants.try_append(constant));
+            break;
+        }
+        case ConstantKind::UTF8String: {
+            auto string = TRY(String::from_byte_string(TRY(read_string(stream))));
+            TRY(constants.try_append(PrimitiveString::create(vm, move(string))));
+            break;
+        }
+        case ConstantKind::UTF16String: {
+            Utf16Data code_units;
+            TRY(code_units.try_resize(TRY(stream.read_value<u32>())));
+            TRY(stream.read_until_filled({ code_units.data(), code_units.size() * sizeof(u16) }));
+            TRY(constants.try_append(PrimitiveString::create(vm, Utf16String::create(move(code_units)))));
+            break;
+        }
+        case ConstantKind::BigInt: {
+            auto digits = TRY(read_string(stream));
+            TRY(constants.try_append(BigInt::create(vm, TRY(Crypto::SignedBigInteger::from_base(10, digits)))));
+            break;
+        }
+        default:
+            return AK::Error::from_string_literal("Unknown constant kind");
+        }
+    }
+
+    Vector<Executable::ExceptionHandlers> exception_handlers;
+    auto number_of_exception_handlers = TRY(stream.read_value<u32>());
+    for (u32 i = 0; i < number_of_exception_handlers; ++i) {
+        Executable::ExceptionHandlers handler;
+        handler.start_offset = TRY(stream.read_value<u64>());
+        handler.end_offset = TRY(stream.read_value<u64>());
+        handler.handler_offset = TRY(read_optional_offset(stream));
+        handler.finalizer_offset = TRY(read_optional_offset(stream));
+        TRY(exception_handlers.try_append(handler));
+    }
+
+    Vector<size_t> basic_block_start_offsets;
+    auto number_of_basic_blocks = TRY(stream.read_value<u32>());
+    for (u32 i = 0; i < number_of_basic_blocks; ++i)
+        TRY(basic_block_start_offsets.try_append(TRY(stream.read_value<u64>())));
+
+    HashMap<size_t, SourceRecord> source_map;
+    auto number_of_source_records = TRY(stream.read_value<u32>());
+    for (u32 i = 0; i < number_of_source_records; ++i) {
+        auto offset = TRY(stream.read_value<u64>());
+        SourceRecord record;
+        record.source_start_offset = TRY(stream.read_value<u32>());
+        record.source_end_offset = TRY(stream.read_value<u32>());
+        TRY(source_map.try_set(offset, record));
+    }
+
+    // Point the instructions that refer to the AST at the nodes of this parse.
+    auto number_of_links = TRY(stream.read_value<u32>());
+    for (u32 i = 0; i < number_of_links; ++i) {
+        Link link;
+        link.bytecode_offset = TRY(stream.read_value<u32>());
+        link.kind = TRY(stream.read_value<LinkKind>());
+        link.start_offset = TRY(stream.read_value<u32>());
+        link.end_offset = TRY(stream.read_value<u32>());
+        if (link.bytecode_offset >= bytecode.size())
+            return AK::Error::from_string_literal("Cached link is out of bounds");
+
+        auto const* target = state.find_linkable_node(link.kind, link.start_offset, link.end_offset);
+        if (!target)
+            return AK::Error::from_string_literal("Cached link refers to an AST node that doesn't exist");
+
+        auto& instruction = *reinterpret_cast<Instruction*>(bytecode.data() + link.bytecode_offset);
+        if (link.kind == LinkKind::Function && instruction.type() == Instruction::Type::NewFunction)
+            static_cast<Op::NewFunction&>(instruction).link_function_node({}, *static_cast<FunctionNode const*>(target));
+        else if (link.kind == LinkKind::Class && instruction.type() == Instruction::Type::NewClass)
+            static_cast<Op::NewClass&>(instruction).link_class_expression({}, *static_cast<ClassExpression const*>(target));
+        else if (link.kind == LinkKind::Scope && instruction.type() == Instruction::Type::BlockDeclarationInstantiation)
+            static_cast<Op::BlockDeclarationInstantiation&>(instruction).link_scope_node({}, *static_cast<ScopeNode const*>(target));
+        else
+            return AK::Error::from_string_literal("Cached link doesn't match its instruction");
+    }
+
+    if (!stream.is_eof())
+        return AK::Error::from_string_literal("Trailing data after cached executable");
+
+    auto executable = vm.heap().allocate<Executable>(
+        move(bytecode),
+        move(identifier_table),
+        move(string_table),
+        move(regex_table),
+        move(constants),
+        source_code,
+        number_of_property_lookup_caches,
+        number_of_global_variable_caches,
+        number_of_object_shape_caches,
+        number_of_registers,
+        is_strict_mode);
+
+    executable->exception_handlers = move(exception_handlers);
+    executable->basic_block_start_offsets = move(basic_block_start_offsets);
+    executable->source_map = move(source_map);
+    executable->local_variable_names = move(local_variable_names);
+    executable->local_index_base = local_index_base;
+    if (length_identifier != NumericLimits<u32>::max())
+        executable->length_identifier = IdentifierTableIndex { length_identifier };
+
+    return executable;
+}
+
+static ByteString cache_file_path(ExecutableCacheState const& state)
+{
+    return ByteString::formatted("{}/{}.jsbc", s_directory, state.source_hash);
+}
+
+static ErrorOr<void> write_header(Stream& stream)
+{
+    TRY(stream.write_value(cache_file_magic));
+    TRY(stream.write_value(cache_file_version));
+    TRY(write_string(stream, s_build_identity));
+    return {};
+}
+
+static ErrorOr<void> read_cache_file(ExecutableCacheState& state)
+{
+    auto file = TRY(Core::File::open(cache_file_path(state), Core::File::OpenMode::Read));
+    auto contents = TRY(file->read_until_eof());
+    FixedMemoryStream stream { contents.bytes() };
+
+    if (TRY(stream.read_value<u32>()) != cache_file_magic || TRY(stream.read_value<u32>()) != cache_file_version || TRY(read_string(stream)) != s_build_identity)
+        return AK::Error::from_string_literal("Cache file was written by a different build");
+    state.cache_file_is_valid = true;
+
+    // Each record is a checksummed key and payload.
+    auto read_record = [&]() -> ErrorOr<void> {
+        auto record_size = TRY(stream.read_value<u32>());
+        auto checksum = TRY(stream.read_value<u32>());
+        auto offset = TRY(stream.tell());
+        if (record_size > contents.size() - offset)
+            return AK::Error::from_string_literal("Record is truncated");
+        auto record = contents.bytes().slice(offset, record_size);
+        TRY(stream.discard(record_size));
+        if (Crypto::Checksum::CRC32 { record }.digest() != checksum)
+            return AK::Error::from_string_literal("Record is corrupted");
+
+        FixedMemoryStream record_stream { record };
+        auto key = TRY(read_key(record_stream));
+        auto payload = TRY(ByteBuffer::copy(record.slice(TRY(record_stream.tell()))));
+        TRY(state.records.try_set(move(key), move(payload)));
+        return {};
+    };
+
+    // Reading stops at the first broken record (e.g. a partially written one). Records appended after it would never
+    // be read, so the next store() rewrites the file instead.
+    while (!stream.is_eof()) {
+        if (auto result = read_record(); result.is_error()) {
+            state.cache_file_is_valid = false;
+            return result.release_error();
+        }
+    }
+    return {};
+}
+
+static ErrorOr<void> write_record(Stream& stream, ExecutableCacheState::RecordKey const& key, ReadonlyBytes payload)
+{
+    AllocatingMemoryStream record_stream;
+    TRY(write_key(record_stream, key));
+    TRY(record_stream.write_until_depleted(payload));
+    auto record = TRY(record_stream.read_until_eof());
+
+    TRY(stream.write_value<u32>(record.size()));
+    TRY(stream.write_value(Crypto::Checksum::CRC32 { record }.digest()));
+    TRY(stream.write_until_depleted(record));
+    return {};
+}
+
+static ExecutableCacheState& state_for(SourceCode const& source_code)
+{
+    auto& state = source_code.executable_cache_state();
+    if (state.has_read_cache_file)
+        return state;
+    state.has_read_cache_file = true;
+    state.source_hash = encode_hex(Crypto::Hash::SHA256::hash(source_code.code().bytes_as_string_view()).bytes());
+    // A missing, outdated or broken file is simply (re)written by the next store().
+    (void)read_cache_file(state);
+    return state;
+}
+
+GC::Ptr<Executable> ExecutableCache::load(VM& vm, ASTNode const& node, CompilationKind compilation_kind, FunctionKind function_kind)
+{
+    if (!s_enabled || node.source_code().code().bytes().size() < minimum_source_length_to_cache)
+        return {};
+
+    auto& state = state_for(node.source_code());
+    auto payload = state.records.get(key_for(node, compilation_kind, function_kind));
+    if (!payload.has_value())
+        return {};
+
+    auto executable = deserialize(vm, node.source_code(), state, payload->bytes());
+    if (executable.is_error()) {
+        dbgln("Bytecode cache: Unable to load cached bytecode for {}: {}", node.source_code().filename(), executable.error());
+        return {};
+    }
+    return executable.release_value();
+}
+
+void ExecutableCache::store(Executable const& executable, ASTNode const& node, CompilationKind compilation_kind, FunctionKind function_kind)
+{
+    if (!s_enabled || node.source_code().code().bytes().size() < minimum_source_length_to_cache)
+        return;
+
+    auto& state = state_for(node.source_code());
+    auto key = key_for(node, compilation_kind, function_kind);
+    if (state.records.contains(key))
+        return;
+
+    // Executables that can't be cached are compiled again each time.
+    auto payload = serialize(executable, state);
+    if (payload.is_error())
+        return;
+
+    auto write_to_file = [&]() -> ErrorOr<void> {
+        // Everything is written at once, so that appends from other processes caching the same source don't interleave with it.
+        AllocatingMemoryStream stream;
+        if (!state.cache_file_is_valid) {
+            // The records that could be read from a broken file are kept.
+            TRY(write_header(stream));
+            for (auto const& [existing_key, existing_payload] : state.records)
+                TRY(write_record(stream, existing_key, existing_payload));
+        }
+        TRY(write_record(stream, key, payload.value()));
+        auto bytes = TRY(stream.read_until_eof());
+
+        auto open_mode = Core::File::OpenMode::Write | (state.cache_file_is_valid ? Core::File::OpenMode::Append : Core::File::OpenMode::Truncate);
+        auto file = TRY(Core::File::open(cache_file_path(state), open_mode, 0600));
+        TRY(file->write_until_depleted(bytes));
+        state.cache_file_is_valid = true;
+        return {};
+    };
+    if (auto result = write_to_file(); result.is_error()) {
+        dbgln("Bytecode cache: Unable to write to {}: {}", cache_file_path(state), result.error());
+        return;
+    }
+    state.records.set(move(key), payload.release_value());
+}
+
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/ByteString.h>
+#include <AK/Error.h>
+#include <AK/HashMap.h>
+#include <AK/Optional.h>
+#include <AK/Vector.h>
+#include <LibGC/Ptr.h>
+#include <LibJS/Forward.h>
+#include <LibJS/Runtime/FunctionKind.h>
+
+namespace JS::Bytecode {
+
+// An on-disk cache of bytecode executables, keyed by a hash of the source code they were generated from.
+//
+// The AST is still needed to run a script (declaration instantiation and function objects are built from it),
+// so a cache hit skips bytecode generation, not parsing. The few instructions that point into the AST
+// (NewFunction, NewClass and BlockDeclarationInstantiation) are stored as source ranges, and relinked to the
+// nodes of the same range in the freshly parsed AST when the executable is loaded.
+//
+// The cache files are only valid for the exact build of LibJS that wrote them, and are trusted as-is,
+// so the cache directory must not be writable by anyone the process doesn't trust.
+class ExecutableCache {
+public:
+    enum class CompilationKind : u8 {
+        ASTNode,
+        Function,
+    };
+
+    enum class LinkKind : u8 {
+        Scope,
+        Function,
+        Class,
+    };
+
+    static bool is_enabled() { return s_enabled; }
+    static void set_directory(ByteString directory);
+
+    static GC::Ptr<Executable> load(VM&, ASTNode const&, CompilationKind, FunctionKind);
+    static void store(Executable const&, ASTNode const&, CompilationKind, FunctionKind);
+
+    // The AST nodes that bytecode can refer to register themselves while the cache is enabled, so that cached
+    // executables can be relinked to them.
+    static void did_create_node(ScopeNode const&);
+    static void did_create_node(FunctionNode const&);
+    static void did_create_node(ClassExpression const&);
+    static void will_destroy_node(ScopeNode const&);
+    static void will_destroy_node(FunctionNode const&);
+    static void will_destroy_node(ClassExpression const&);
+
+private:
+    static ErrorOr<GC::Ref<Executable>> deserialize(VM&, SourceCode const&, ExecutableCacheState const&, ReadonlyBytes);
+
+    static bool s_enabled;
+};
+
+// The cache's state for one SourceCode: the records read from its cache file, and the nodes that have been parsed from it.
+class ExecutableCacheState {
+public:
+    using LinkKind = ExecutableCache::LinkKind;
+
+    struct RecordKey {
+        ExecutableCache::CompilationKind compilation_kind;
+        u8 function_kind;
+        u32 start_offset;
+        u32 end_offset;
+        ByteString node_class_name;
+
+        bool operator==(RecordKey const&) const = default;
+    };
+
+    struct LinkableNode {
+        ASTNode const* node { nullptr };
+        void const* target { nullptr };
+    };
+
+    ByteString source_hash;
+    bool has_read_cache_file { false };
+    bool cache_file_is_valid { false };
+    HashMap<RecordKey, ByteBuffer> records;
+    HashMap<u32, Vector<LinkableNode>> linkable_nodes[3];
+
+    void const* find_linkable_node(LinkKind, u32 start_offset, u32 end_offset) const;
+};
+
+}
+
+namespace AK {
+
+template<>
+struct Traits<JS::Bytecode::ExecutableCacheState::RecordKey> : public DefaultTraits<JS::Bytecode::ExecutableCacheState::RecordKey> {
+    static unsigned hash(JS::Bytecode::ExecutableCacheState::RecordKey const& key)
+    {
+        auto hash = pair_int_hash(to_underlying(key.compilation_kind), key.function_kind);
+        hash = pair_int_hash(hash, pair_int_hash(key.start_offset, key.end_offset));
+        return pair_int_hash(hash, key.node_class_name.hash());
+    }
+};
+
+}
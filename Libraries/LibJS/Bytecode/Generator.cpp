@@ -8,9 +8,11 @@
 #include <AK/TemporaryChange.h>
 #include <LibJS/AST.h>
 #include <LibJS/Bytecode/BasicBlock.h>
+#include <LibJS/Bytecode/ExecutableCache.h>
 #include <LibJS/Bytecode/Generator.h>
 #include <LibJS/Bytecode/Instruction.h>
 #include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/Optimizer.h>
 #include <LibJS/Bytecode/Register.h>
 #include <LibJS/Runtime/ECMAScriptFunctionObject.h>
 #include <LibJS/Runtime/VM.h>
@@ -243,6 +245,8 @@ CodeGenerationErrorOr<GC::Ref<Executable>> Generator::compile(VM& vm, ASTNode co
         }
     }
 
+    auto optimization_statistics = Optimizer::optimize(generator, g_optimization_level);
+
     bool is_strict_mode = false;
     if (is<Program>(node))
         is_strict_mode = static_cast<Program const&>(node).is_strict_mode();
@@ -431,6 +435,7 @@ CodeGenerationErrorOr<GC::Ref<Executable>> Generator::compile(VM& vm, ASTNode co
         node.source_code(),
         generator.m_next_property_lookup_cache,
         generator.m_next_global_variable_cache,
+        generator.m_next_object_shape_cache,
         generator.m_next_register,
         is_strict_mode);
 
@@ -454,6 +459,7 @@ CodeGenerationErrorOr<GC::Ref<Executable>> Generator::compile(VM& vm, ASTNode co
     executable->local_variable_names = move(local_variable_names);
     executable->local_index_base = number_of_registers + number_of_constants;
     executable->length_identifier = generator.m_length_identifier;
+    executable->optimization_statistics = optimization_statistics;
 
     generator.m_finished = true;
 
@@ -462,15 +468,26 @@ CodeGenerationErrorOr<GC::Ref<Executable>> Generator::compile(VM& vm, ASTNode co
 
 CodeGenerationErrorOr<GC::Ref<Executable>> Generator::generate_from_ast_node(VM& vm, ASTNode const& node, FunctionKind enclosing_function_kind)
 {
+    if (auto executable = ExecutableCache::load(vm, node, ExecutableCache::CompilationKind::ASTNode, enclosing_function_kind))
+        return GC::Ref { *executable };
+
     Vector<DeprecatedFlyString> local_variable_names;
     if (is<ScopeNode>(node))
         local_variable_names = static_cast<ScopeNode const&>(node).local_variables_names();
-    return compile(vm, node, enclosing_function_kind, {}, MustPropagateCompletion::Yes, move(local_variable_names));
+    auto executable = TRY(compile(vm, node, enclosing_function_kind, {}, MustPropagateCompletion::Yes, move(local_variable_names)));
+    ExecutableCache::store(*executable, node, ExecutableCache::CompilationKind::ASTNode, enclosing_function_kind);
+    return executable;
 }
 
 CodeGenerationErrorOr<GC::Ref<Executable>> Generator::generate_from_function(VM& vm, ECMAScriptFunctionObject const& function)
 {
-    return compile(vm, function.ecmascript_code(), function.kind(), &function, MustPropagateCompletion::No, function.local_variables_names());
+    auto const& node = function.ecmascript_code();
+    if (auto executable = ExecutableCache::load(vm, node, ExecutableCache::CompilationKind::Function, function.kind()))
+        return GC::Ref { *executable };
+
+    auto executable = TRY(compile(vm, node, function.kind(), &function, MustPropagateCompletion::No, function.local_variables_names()));
+    ExecutableCache::store(*executable, node, ExecutableCache::CompilationKind::Function, function.kind());
+    return executable;
 }
 
 void Generator::grow(size_t additional_size)
@@ -862,6 +879,9 @@ void Generator::emit_set_variable(JS::Identifier const& identifier, ScopedOperan
             return;
         }
         emit<Bytecode::Op::Mov>(local(identifier.local_variable_index()), value);
+    } else if (identifier.is_global() && initialization_mode == Bytecode::Op::BindingInitializationMode::Set) {
+        // NOTE: A global identifier resolves to the same binding from the lexical and the variable environment.
+        emit<Bytecode::Op::SetGlobal>(intern_identifier(identifier.string()), value, next_global_variable_cache());
     } else {
         auto identifier_index = intern_identifier(identifier.string());
         if (environment_mode == Bytecode::Op::EnvironmentMode::Lexical) {
@@ -321,6 +321,7 @@ public:
 
     [[nodiscard]] size_t next_global_variable_cache() { return m_next_global_variable_cache++; }
     [[nodiscard]] size_t next_property_lookup_cache() { return m_next_property_lookup_cache++; }
+    [[nodiscard]] u32 next_object_shape_cache() { return m_next_object_shape_cache++; }
 
     enum class DeduplicateConstant {
         Yes,
@@ -341,6 +342,8 @@ public:
     [[nodiscard]] bool must_propagate_completion() const { return m_must_propagate_completion; }
 
 private:
+    friend class Optimizer;
+
     VM& m_vm;
 
     static CodeGenerationErrorOr<GC::Ref<Executable>> compile(VM&, ASTNode const&, FunctionKind, GC::Ptr<ECMAScriptFunctionObject const>, MustPropagateCompletion, Vector<DeprecatedFlyString> local_variable_names);
@@ -390,6 +393,7 @@ private:
     u32 m_next_block { 1 };
     u32 m_next_property_lookup_cache { 0 };
     u32 m_next_global_variable_cache { 0 };
+    u32 m_next_object_shape_cache { 0 };
     FunctionKind m_enclosing_function_kind { FunctionKind::Normal };
     Vector<LabelableScope> m_continuable_scopes;
     Vector<LabelableScope> m_breakable_scopes;
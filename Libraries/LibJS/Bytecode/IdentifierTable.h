@@ -28,6 +28,7 @@ public:
     DeprecatedFlyString const& get(IdentifierTableIndex) const;
     void dump() const;
     bool is_empty() const { return m_identifiers.is_empty(); }
+    Vector<DeprecatedFlyString> const& identifiers() const { return m_identifiers; }
 
 private:
     Vector<DeprecatedFlyString> m_identifiers;
@@ -24,6 +24,7 @@
     O(BitwiseOr)                       \
     O(BitwiseXor)                      \
     O(BlockDeclarationInstantiation)   \
+    O(CacheObjectShape)                \
     O(Call)                            \
     O(CallBuiltin)                     \
     O(CallConstruct)                   \
@@ -131,6 +132,7 @@
     O(RightShift)                      \
     O(ScheduleJump)                    \
     O(SetArgument)                     \
+    O(SetGlobal)                       \
     O(SetLexicalBinding)               \
     O(SetVariableBinding)              \
     O(StrictlyEquals)                  \
@@ -14,6 +14,8 @@
 #include <LibJS/Bytecode/Interpreter.h>
 #include <LibJS/Bytecode/Label.h>
 #include <LibJS/Bytecode/Op.h>
+#include <LibJS/JIT/Compiler.h>
+#include <LibJS/JIT/NativeExecutable.h>
 #include <LibJS/Runtime/AbstractOperations.h>
 #include <LibJS/Runtime/Accessor.h>
 #include <LibJS/Runtime/Array.h>
@@ -155,14 +157,16 @@ Interpreter::~Interpreter()
 {
 }
 
-ALWAYS_INLINE Value Interpreter::get(Operand op) const
+void Interpreter::gather_roots(HashMap<GC::Cell*, GC::HeapRoot>& roots) const
 {
-    return m_registers_and_constants_and_locals.data()[op.index()];
-}
-
-ALWAYS_INLINE void Interpreter::set(Operand op, Value value)
-{
-    m_registers_and_constants_and_locals.data()[op.index()] = value;
+    auto add_root = [&](GC::Cell* cell) {
+        if (cell)
+            roots.set(cell, GC::HeapRoot { .type = GC::HeapRoot::Type::VM });
+    };
+    add_root(m_current_executable);
+    add_root(m_realm);
+    add_root(m_global_object);
+    add_root(m_global_declarative_environment);
 }
 
 ALWAYS_INLINE Value Interpreter::do_yield(Value value, Optional<Label> continuation)
@@ -337,6 +341,49 @@ Interpreter::HandleExceptionResponse Interpreter::handle_exception(size_t& progr
 #    define FLATTEN_ON_CLANG
 #endif
 
+Interpreter::HandleExceptionResponse Interpreter::continue_pending_unwind(size_t& program_counter, Label resume_target)
+{
+    if (auto exception = reg(Register::exception()); !exception.is_empty())
+        return handle_exception(program_counter, exception);
+
+    auto& running_execution_context = this->running_execution_context();
+    if (!saved_return_value().is_empty()) {
+        do_return(saved_return_value());
+        if (auto handlers = current_executable().exception_handlers_for_offset(program_counter); handlers.has_value()) {
+            if (auto finalizer = handlers.value().finalizer_offset; finalizer.has_value()) {
+                VERIFY(!running_execution_context.unwind_contexts.is_empty());
+                auto& unwind_context = running_execution_context.unwind_contexts.last();
+                VERIFY(unwind_context.executable == m_current_executable);
+                reg(Register::saved_return_value()) = reg(Register::return_value());
+                reg(Register::return_value()) = {};
+                program_counter = finalizer.value();
+                // the unwind_context will be pop'ed when entering the finally block
+                return HandleExceptionResponse::ContinueInThisExecutable;
+            }
+        }
+        return HandleExceptionResponse::ExitFromExecutable;
+    }
+    auto const old_scheduled_jump = running_execution_context.previously_scheduled_jumps.take_last();
+    if (m_scheduled_jump.has_value()) {
+        program_counter = m_scheduled_jump.value();
+        m_scheduled_jump = {};
+    } else {
+        program_counter = resume_target.address();
+        // set the scheduled jump to the old value if we continue
+        // where we left it
+        m_scheduled_jump = old_scheduled_jump;
+    }
+    return HandleExceptionResponse::ContinueInThisExecutable;
+}
+
+void Interpreter::schedule_jump(size_t& program_counter, Label target)
+{
+    m_scheduled_jump = target.address();
+    auto finalizer = current_executable().exception_handlers_for_offset(program_counter).value().finalizer_offset;
+    VERIFY(finalizer.has_value());
+    program_counter = finalizer.value();
+}
+
 FLATTEN_ON_CLANG void Interpreter::run_bytecode(size_t entry_point)
 {
     if (vm().did_reach_stack_space_limit()) {
@@ -354,6 +401,11 @@ FLATTEN_ON_CLANG void Interpreter::run_bytecode(size_t entry_point)
 
     TemporaryChange change(m_program_counter, Optional<size_t&>(program_counter));
 
+    if (executable.native_executable) {
+        executable.native_executable->run(*this, program_counter);
+        return;
+    }
+
     // Declare a lookup table for computed goto with each of the `handle_*` labels
     // to avoid the overhead of a switch statement.
     // This is a GCC extension, but it's also supported by Clang.
@@ -495,46 +547,14 @@ FLATTEN_ON_CLANG void Interpreter::run_bytecode(size_t entry_point)
 
         handle_ContinuePendingUnwind: {
             auto& instruction = *reinterpret_cast<Op::ContinuePendingUnwind const*>(&bytecode[program_counter]);
-            if (auto exception = reg(Register::exception()); !exception.is_empty()) {
-                if (handle_exception(program_counter, exception) == HandleExceptionResponse::ExitFromExecutable)
-                    return;
-                goto start;
-            }
-            if (!saved_return_value().is_empty()) {
-                do_return(saved_return_value());
-                if (auto handlers = executable.exception_handlers_for_offset(program_counter); handlers.has_value()) {
-                    if (auto finalizer = handlers.value().finalizer_offset; finalizer.has_value()) {
-                        VERIFY(!running_execution_context.unwind_contexts.is_empty());
-                        auto& unwind_context = running_execution_context.unwind_contexts.last();
-                        VERIFY(unwind_context.executable == m_current_executable);
-                        reg(Register::saved_return_value()) = reg(Register::return_value());
-                        reg(Register::return_value()) = {};
-                        program_counter = finalizer.value();
-                        // the unwind_context will be pop'ed when entering the finally block
-                        goto start;
-                    }
-                }
+            if (continue_pending_unwind(program_counter, instruction.resume_target()) == HandleExceptionResponse::ExitFromExecutable)
                 return;
-            }
-            auto const old_scheduled_jump = running_execution_context.previously_scheduled_jumps.take_last();
-            if (m_scheduled_jump.has_value()) {
-                program_counter = m_scheduled_jump.value();
-                m_scheduled_jump = {};
-            } else {
-                program_counter = instruction.resume_target().address();
-                // set the scheduled jump to the old value if we continue
-                // where we left it
-                m_scheduled_jump = old_scheduled_jump;
-            }
             goto start;
         }
 
         handle_ScheduleJump: {
             auto& instruction = *reinterpret_cast<Op::ScheduleJump const*>(&bytecode[program_counter]);
-            m_scheduled_jump = instruction.target().address();
-            auto finalizer = executable.exception_handlers_for_offset(program_counter).value().finalizer_offset;
-            VERIFY(finalizer.has_value());
-            program_counter = finalizer.value();
+            schedule_jump(program_counter, instruction.target());
             goto start;
         }
 
@@ -570,6 +590,7 @@ FLATTEN_ON_CLANG void Interpreter::run_bytecode(size_t entry_point)
             HANDLE_INSTRUCTION(BitwiseOr);
             HANDLE_INSTRUCTION(BitwiseXor);
             HANDLE_INSTRUCTION_WITHOUT_EXCEPTION_CHECK(BlockDeclarationInstantiation);
+            HANDLE_INSTRUCTION_WITHOUT_EXCEPTION_CHECK(CacheObjectShape);
             HANDLE_INSTRUCTION(Call);
             HANDLE_INSTRUCTION(CallBuiltin);
             HANDLE_INSTRUCTION(CallConstruct);
@@ -655,6 +676,7 @@ FLATTEN_ON_CLANG void Interpreter::run_bytecode(size_t entry_point)
             HANDLE_INSTRUCTION(ResolveThisBinding);
             HANDLE_INSTRUCTION_WITHOUT_EXCEPTION_CHECK(RestoreScheduledJump);
             HANDLE_INSTRUCTION(RightShift);
+            HANDLE_INSTRUCTION(SetGlobal);
             HANDLE_INSTRUCTION(SetLexicalBinding);
             HANDLE_INSTRUCTION(SetVariableBinding);
             HANDLE_INSTRUCTION(StrictlyEquals);
@@ -734,6 +756,9 @@ Interpreter::ResultAndReturnRegister Interpreter::run_executable(Executable& exe
         running_execution_context.registers_and_constants_and_locals[executable.number_of_registers + i] = executable.constants[i];
     }
 
+    if (JIT::g_jit_enabled && executable.execution_count <= JIT::g_compilation_threshold && executable.execution_count++ == JIT::g_compilation_threshold)
+        executable.native_executable = JIT::Compiler::compile(executable);
+
     run_bytecode(entry_point.value_or(0));
 
     dbgln_if(JS_BYTECODE_DEBUG, "Bytecode::Interpreter did run unit {:p}", &executable);
@@ -955,6 +980,97 @@ ALWAYS_INLINE ThrowCompletionOr<GC::Ref<Object>> base_object_for_get(VM& vm, Val
     return throw_null_or_undefined_property_get(vm, base_value, base_identifier, property, executable);
 }
 
+// Returns the object that holds the cached property if the entry applies to the given receiver, or null otherwise.
+static Object* holder_for_cached_property(PropertyLookupCache::Entry const& entry, Shape const& shape, Object& base_object)
+{
+    if (&shape != entry.shape)
+        return nullptr;
+    if (!entry.in_prototype_chain)
+        return &base_object;
+    // OPTIMIZATION: If the prototype chain hasn't been mutated in a way that would invalidate the cache, we can use it.
+    if (!entry.prototype || !entry.prototype_chain_validity || !entry.prototype_chain_validity->is_valid())
+        return nullptr;
+    return entry.prototype.ptr();
+}
+
+// Returns whether a lookup on an object of the given shape can be cached, given where the property was found.
+static bool can_cache_property_lookup(Shape const& shape, CacheablePropertyMetadata const& metadata)
+{
+    switch (metadata.type) {
+    case CacheablePropertyMetadata::Type::NotCacheable:
+    case CacheablePropertyMetadata::Type::AddedOwnProperty:
+        return false;
+    case CacheablePropertyMetadata::Type::OwnProperty:
+        return true;
+    case CacheablePropertyMetadata::Type::InPrototypeChain:
+        // Dictionary shapes gain properties without changing identity, so the receiver could later shadow the
+        // prototype's property without the shape check noticing.
+        if (shape.is_dictionary())
+            return false;
+        return shape.prototype() && shape.prototype()->shape().prototype_chain_validity();
+    }
+    VERIFY_NOT_REACHED();
+}
+
+static void fill_cache_entry(PropertyLookupCache::Entry& entry, Shape& shape, CacheablePropertyMetadata const& metadata)
+{
+    entry = {};
+    entry.shape = shape;
+    entry.property_offset = metadata.property_offset.value();
+    if (metadata.type == CacheablePropertyMetadata::Type::InPrototypeChain) {
+        entry.in_prototype_chain = true;
+        entry.prototype = *metadata.prototype;
+        // NOTE: The receiver's shape pins down its prototype, and the validity of that prototype's shape covers every
+        //       shape further up the chain, including those between it and the object that holds the property.
+        entry.prototype_chain_validity = *shape.prototype()->shape().observe_prototype_chain_validity();
+    }
+}
+
+// Returns the validity of the receiver's prototype chain if a put that added a property to an object of the given shape
+// can be replayed on other objects of that shape, or null if it can't.
+// The put only reached the receiver if nothing in its prototype chain had a setter for the property or made it read-only.
+// That stays true for as long as the chain doesn't change, if every prototype uses the ordinary internal methods.
+static GC::Ptr<PrototypeChainValidity> prototype_chain_validity_for_added_property(Realm& realm, Shape& shape)
+{
+    auto* prototype = shape.prototype();
+    if (!prototype)
+        return nullptr;
+    if (!prototype->shape().prototype_chain_validity())
+        return nullptr;
+    for (auto const* object = prototype; object; object = object->prototype()) {
+        if (!object->is_plain_object() && object != realm.intrinsics().object_prototype().ptr())
+            return nullptr;
+    }
+    return prototype->shape().observe_prototype_chain_validity();
+}
+
+// Returns whether a cached put transition applies to the given receiver.
+static bool can_replay_put_transition(PropertyLookupCache::Entry const& entry, Object const& object, Value this_value)
+{
+    if (!entry.shape_after_put)
+        return false;
+    if (!this_value.is_object() || &this_value.as_object() != &object)
+        return false;
+    // NOTE: Only plain objects add a property with nothing but a put transition, and only if they are still extensible.
+    if (!object.is_plain_extensible_object())
+        return false;
+    if (object.shape().prototype())
+        return entry.prototype_chain_validity && entry.prototype_chain_validity->is_valid();
+    return true;
+}
+
+// Once a site has seen more shapes than it can remember, it gives up on its own entries and shares the megamorphic cache.
+static PropertyLookupCache::Entry& cache_entry_to_update(VM& vm, PropertyLookupCache& cache, Shape& shape, StringOrSymbol const& key, MegamorphicPropertyCache::AccessKind access_kind)
+{
+    if (!cache.is_megamorphic) {
+        if (auto* entry = cache.entry_to_update_for(shape))
+            return *entry;
+        cache.is_megamorphic = true;
+        cache.entries = {};
+    }
+    return vm.bytecode_interpreter().megamorphic_property_cache().entry_to_update_for(shape, key, access_kind);
+}
+
 enum class GetByIdMode {
     Normal,
     Length,
@@ -965,7 +1081,7 @@ inline ThrowCompletionOr<Value> get_by_id(VM& vm, Optional<IdentifierTableIndex>
 {
     if constexpr (mode == GetByIdMode::Length) {
         if (base_value.is_string()) {
-            return Value(base_value.as_string().utf16_string().length_in_code_units());
+            return Value(base_value.as_string().length_in_utf16_code_units());
         }
     }
 
@@ -979,45 +1095,37 @@ inline ThrowCompletionOr<Value> get_by_id(VM& vm, Optional<IdentifierTableIndex>
     }
 
     auto& shape = base_obj->shape();
+    auto const& name = executable.get_identifier(property);
 
-    if (cache.prototype) {
-        // OPTIMIZATION: If the prototype chain hasn't been mutated in a way that would invalidate the cache, we can use it.
-        bool can_use_cache = [&]() -> bool {
-            if (&shape != cache.shape)
-                return false;
-            if (!cache.prototype_chain_validity)
-                return false;
-            if (!cache.prototype_chain_validity->is_valid())
-                return false;
-            return true;
-        }();
-        if (can_use_cache) {
-            auto value = cache.prototype->get_direct(cache.property_offset.value());
-            if (value.is_accessor())
-                return TRY(call(vm, value.as_accessor().getter(), this_value));
-            return value;
-        }
-    } else if (&shape == cache.shape) {
-        // OPTIMIZATION: If the shape of the object hasn't changed, we can use the cached property offset.
-        auto value = base_obj->get_direct(cache.property_offset.value());
+    auto get_cached_value = [&](Object& holder, PropertyLookupCache::Entry const& entry) -> ThrowCompletionOr<Value> {
+        auto value = holder.get_direct(entry.property_offset.value());
         if (value.is_accessor())
             return TRY(call(vm, value.as_accessor().getter(), this_value));
         return value;
+    };
+
+    // OPTIMIZATION: If we've seen an object of this shape at this site before, we can use the cached property offset.
+    if (!cache.is_megamorphic) {
+        for (auto const& entry : cache.entries) {
+            if (auto* holder = holder_for_cached_property(entry, shape, *base_obj)) {
+                ++cache.hit_count;
+                return get_cached_value(*holder, entry);
+            }
+        }
+    } else if (auto const* entry = vm.bytecode_interpreter().megamorphic_property_cache().find(shape, name, MegamorphicPropertyCache::AccessKind::Get)) {
+        if (auto* holder = holder_for_cached_property(*entry, shape, *base_obj)) {
+            ++cache.hit_count;
+            return get_cached_value(*holder, *entry);
+        }
     }
+    ++cache.miss_count;
 
     CacheablePropertyMetadata cacheable_metadata;
-    auto value = TRY(base_obj->internal_get(executable.get_identifier(property), this_value, &cacheable_metadata));
+    auto value = TRY(base_obj->internal_get(name, this_value, &cacheable_metadata));
 
-    if (cacheable_metadata.type == CacheablePropertyMetadata::Type::OwnProperty) {
-        cache = {};
-        cache.shape = shape;
-        cache.property_offset = cacheable_metadata.property_offset.value();
-    } else if (cacheable_metadata.type == CacheablePropertyMetadata::Type::InPrototypeChain) {
-        cache = {};
-        cache.shape = &base_obj->shape();
-        cache.property_offset = cacheable_metadata.property_offset.value();
-        cache.prototype = *cacheable_metadata.prototype;
-        cache.prototype_chain_validity = *cacheable_metadata.prototype->shape().prototype_chain_validity();
+    if (can_cache_property_lookup(base_obj->shape(), cacheable_metadata)) {
+        auto& entry = cache_entry_to_update(vm, cache, base_obj->shape(), name, MegamorphicPropertyCache::AccessKind::Get);
+        fill_cache_entry(entry, base_obj->shape(), cacheable_metadata);
     }
 
     return value;
@@ -1035,6 +1143,12 @@ inline ThrowCompletionOr<Value> get_by_value(VM& vm, Optional<IdentifierTableInd
         // For "non-typed arrays":
         if (!object.may_interfere_with_indexed_property_access()
             && object_storage) {
+            // Packed storage has no holes or accessors below its array-like size.
+            if (object_storage->is_simple_storage()) {
+                auto const& simple_storage = static_cast<SimpleIndexedPropertyStorage const&>(*object_storage);
+                if (simple_storage.is_packed() && index < simple_storage.array_like_size())
+                    return simple_storage.elements().data()[index];
+            }
             auto maybe_value = [&] {
                 if (object_storage->is_simple_storage())
                     return static_cast<SimpleIndexedPropertyStorage const*>(object_storage)->inline_get(index);
@@ -1104,12 +1218,22 @@ inline ThrowCompletionOr<Value> get_by_value(VM& vm, Optional<IdentifierTableInd
     return TRY(object->internal_get(property_key, base_value));
 }
 
+static DeclarativeEnvironment& running_module_environment(VM& vm)
+{
+    return static_cast<DeclarativeEnvironment&>(*vm.running_execution_context().script_or_module.get<GC::Ref<Module>>()->environment());
+}
+
 inline ThrowCompletionOr<Value> get_global(Interpreter& interpreter, IdentifierTableIndex identifier_index, GlobalVariableCache& cache)
 {
     auto& vm = interpreter.vm();
     auto& binding_object = interpreter.global_object();
     auto& declarative_record = interpreter.global_declarative_environment();
 
+    // OPTIMIZATION: The bindings of a module environment are all created before any code in the module runs,
+    //               so a direct binding stays at the same index.
+    if (cache.module_binding_index.has_value())
+        return running_module_environment(vm).get_binding_value_direct(vm, cache.module_binding_index.value());
+
     auto& shape = binding_object.shape();
     if (cache.environment_serial_number == declarative_record.environment_serial_number()) {
 
@@ -1135,9 +1259,12 @@ inline ThrowCompletionOr<Value> get_global(Interpreter& interpreter, IdentifierT
     if (vm.running_execution_context().script_or_module.has<GC::Ref<Module>>()) {
         // NOTE: GetGlobal is used to access variables stored in the module environment and global environment.
         //       The module environment is checked first since it precedes the global environment in the environment chain.
-        auto& module_environment = *vm.running_execution_context().script_or_module.get<GC::Ref<Module>>()->environment();
-        if (TRY(module_environment.has_binding(identifier))) {
-            // TODO: Cache offset of binding value
+        auto& module_environment = running_module_environment(vm);
+        Optional<size_t> offset;
+        if (TRY(module_environment.has_binding(identifier, &offset))) {
+            // NOTE: Imported bindings are indirect, and have no index of their own.
+            if (offset.has_value())
+                cache.module_binding_index = static_cast<u32>(offset.value());
             return TRY(module_environment.get_binding_value(vm, identifier, vm.in_strict_mode()));
         }
     }
@@ -1161,6 +1288,72 @@ inline ThrowCompletionOr<Value> get_global(Interpreter& interpreter, IdentifierT
     return vm.throw_completion<ReferenceError>(ErrorType::UnknownIdentifier, identifier);
 }
 
+// Assignment to an identifier that resolves to the module or global environment, with the same caching as get_global().
+inline ThrowCompletionOr<void> set_global(Interpreter& interpreter, IdentifierTableIndex identifier_index, Value value, GlobalVariableCache& cache)
+{
+    auto& vm = interpreter.vm();
+    auto& binding_object = interpreter.global_object();
+    auto& declarative_record = interpreter.global_declarative_environment();
+    auto strict = vm.in_strict_mode();
+
+    if (cache.module_binding_index.has_value())
+        return running_module_environment(vm).set_mutable_binding_direct(vm, cache.module_binding_index.value(), value, true);
+
+    if (cache.environment_serial_number == declarative_record.environment_serial_number()) {
+        // OPTIMIZATION: We only cache writable data properties of the global object, which stay that way while its shape doesn't change.
+        if (&binding_object.shape() == cache.shape) {
+            binding_object.put_direct(cache.property_offset.value(), value);
+            return {};
+        }
+
+        if (cache.environment_binding_index.has_value())
+            return declarative_record.set_mutable_binding_direct(vm, cache.environment_binding_index.value(), value, strict);
+    }
+
+    cache.environment_serial_number = declarative_record.environment_serial_number();
+
+    auto& identifier = interpreter.current_executable().get_identifier(identifier_index);
+
+    if (vm.running_execution_context().script_or_module.has<GC::Ref<Module>>()) {
+        auto& module_environment = running_module_environment(vm);
+        Optional<size_t> offset;
+        if (TRY(module_environment.has_binding(identifier, &offset))) {
+            if (offset.has_value())
+                cache.module_binding_index = static_cast<u32>(offset.value());
+            return module_environment.set_mutable_binding(vm, identifier, value, true);
+        }
+    }
+
+    Optional<size_t> offset;
+    if (TRY(declarative_record.has_binding(identifier, &offset))) {
+        cache.environment_binding_index = static_cast<u32>(offset.value());
+        return declarative_record.set_mutable_binding(vm, identifier, value, strict);
+    }
+
+    // NOTE: This is what PutValue() does for a binding of the global object environment (see ObjectEnvironment::set_mutable_binding()),
+    //       or for an unresolvable reference, which assigns to the global object in sloppy mode.
+    if (!TRY(binding_object.has_property(identifier))) {
+        if (strict)
+            return vm.throw_completion<ReferenceError>(ErrorType::UnknownIdentifier, identifier);
+        return binding_object.set(identifier, value, Object::ShouldThrowExceptions::No);
+    }
+
+    CacheablePropertyMetadata cacheable_metadata;
+    auto succeeded = TRY(binding_object.internal_set(identifier, value, &binding_object, &cacheable_metadata));
+    if (!succeeded && strict) {
+        auto property = binding_object.internal_get_own_property(identifier);
+        if (!property.is_error() && property.value().has_value() && !property.value()->writable.value_or(true))
+            return vm.throw_completion<TypeError>(ErrorType::DescWriteNonWritable, identifier);
+        return vm.throw_completion<TypeError>(ErrorType::ObjectSetReturnedFalse);
+    }
+
+    if (succeeded && cacheable_metadata.type == CacheablePropertyMetadata::Type::OwnProperty) {
+        cache.shape = binding_object.shape();
+        cache.property_offset = cacheable_metadata.property_offset.value();
+    }
+    return {};
+}
+
 inline ThrowCompletionOr<void> put_by_property_key(VM& vm, Value base, Value this_value, Value value, Optional<DeprecatedFlyString const&> const& base_identifier, PropertyKey name, Op::PropertyKind kind, PropertyLookupCache* cache = nullptr)
 {
     // Better error message than to_object would give
@@ -1193,17 +1386,60 @@ inline ThrowCompletionOr<void> put_by_property_key(VM& vm, Value base, Value thi
         break;
     }
     case Op::PropertyKind::KeyValue: {
-        if (cache && cache->shape == &object->shape()) {
-            object->put_direct(*cache->property_offset, value);
-            return {};
+        // NOTE: Indexed properties don't live in the shape, so only puts with string and symbol keys are cached.
+        if (cache && !name.is_number()) {
+            auto& shape = object->shape();
+            PropertyLookupCache::Entry const* matching_entry = nullptr;
+            if (!cache->is_megamorphic) {
+                for (auto const& entry : cache->entries) {
+                    if (entry.shape == &shape && !entry.in_prototype_chain) {
+                        matching_entry = &entry;
+                        break;
+                    }
+                }
+            } else {
+                matching_entry = vm.bytecode_interpreter().megamorphic_property_cache().find(shape, name.to_string_or_symbol(), MegamorphicPropertyCache::AccessKind::Put);
+            }
+            if (matching_entry && !matching_entry->shape_after_put) {
+                // OPTIMIZATION: If we've seen an object of this shape at this site before, we can use the cached property offset.
+                ++cache->hit_count;
+                object->put_direct(*matching_entry->property_offset, value);
+                return {};
+            }
+            if (matching_entry && can_replay_put_transition(*matching_entry, *object, this_value)) {
+                // OPTIMIZATION: If this site added the property to an object of this shape before, we can add it the same way,
+                //               without looking through the prototype chain or the transition table again.
+                ++cache->hit_count;
+                object->put_direct_with_transition(*matching_entry->shape_after_put, value);
+                return {};
+            }
+            ++cache->miss_count;
         }
 
+        auto& shape_before_put = object->shape();
         CacheablePropertyMetadata cacheable_metadata;
         bool succeeded = TRY(object->internal_set(name, value, this_value, &cacheable_metadata));
 
-        if (succeeded && cache && cacheable_metadata.type == CacheablePropertyMetadata::Type::OwnProperty) {
-            cache->shape = object->shape();
-            cache->property_offset = cacheable_metadata.property_offset.value();
+        if (succeeded && cache && !name.is_number() && cacheable_metadata.type == CacheablePropertyMetadata::Type::OwnProperty) {
+            auto& shape = object->shape();
+            auto& entry = cache_entry_to_update(vm, *cache, shape, name.to_string_or_symbol(), MegamorphicPropertyCache::AccessKind::Put);
+            fill_cache_entry(entry, shape, cacheable_metadata);
+        }
+
+        if (succeeded && cache && !name.is_number() && cacheable_metadata.type == CacheablePropertyMetadata::Type::AddedOwnProperty
+            && this_value.is_object() && &this_value.as_object() == object.ptr()
+            && cacheable_metadata.property_offset == shape_before_put.property_count()) {
+            auto& shape_after_put = object->shape();
+            auto validity = prototype_chain_validity_for_added_property(*vm.current_realm(), shape_before_put);
+            if (validity || !shape_before_put.prototype()) {
+                auto& entry = cache_entry_to_update(vm, *cache, shape_before_put, name.to_string_or_symbol(), MegamorphicPropertyCache::AccessKind::Put);
+                entry = {};
+                entry.shape = shape_before_put;
+                entry.property_offset = cacheable_metadata.property_offset.value();
+                if (validity)
+                    entry.prototype_chain_validity = *validity;
+                entry.shape_after_put = shape_after_put;
+            }
         }
 
         if (!succeeded && vm.in_strict_mode()) {
@@ -1213,9 +1449,34 @@ inline ThrowCompletionOr<void> put_by_property_key(VM& vm, Value base, Value thi
         }
         break;
     }
-    case Op::PropertyKind::DirectKeyValue:
+    case Op::PropertyKind::DirectKeyValue: {
+        // OPTIMIZATION: Object literals that start out with their final shape (see NewObject) define properties that
+        //               are already part of it, which only takes a store once we know where the property lives.
+        if (cache && !name.is_number() && !cache->is_megamorphic) {
+            auto& shape = object->shape();
+            for (auto const& entry : cache->entries) {
+                if (entry.shape == &shape && !entry.in_prototype_chain && !entry.shape_after_put) {
+                    ++cache->hit_count;
+                    object->put_direct(*entry.property_offset, value);
+                    return {};
+                }
+            }
+            ++cache->miss_count;
+        }
+
+        auto& shape_before_define = object->shape();
         object->define_direct_property(name, value, Attribute::Enumerable | Attribute::Writable | Attribute::Configurable);
+
+        // NOTE: If the shape didn't change, the property was already there with these attributes.
+        if (cache && !name.is_number() && !cache->is_megamorphic && &object->shape() == &shape_before_define && !shape_before_define.is_dictionary()) {
+            if (auto* entry = cache->entry_to_update_for(shape_before_define)) {
+                *entry = {};
+                entry->shape = shape_before_define;
+                entry->property_offset = shape_before_define.lookup(name.to_string_or_symbol())->offset;
+            }
+        }
         break;
+    }
     case Op::PropertyKind::ProtoSetter:
         if (value.is_object() || value.is_null())
             MUST(object->internal_set_prototype_of(value.is_object() ? &value.as_object() : nullptr));
@@ -1298,13 +1559,14 @@ inline ThrowCompletionOr<void> put_by_value(VM& vm, Value base, Optional<Depreca
         if (storage
             && storage->is_simple_storage()
             && !object.may_interfere_with_indexed_property_access()) {
-            auto maybe_value = storage->get(index);
-            if (maybe_value.has_value()) {
-                auto existing_value = maybe_value->value;
-                if (!existing_value.is_accessor()) {
-                    storage->put(index, value);
-                    return {};
-                }
+            auto& simple_storage = static_cast<SimpleIndexedPropertyStorage&>(*storage);
+            bool can_overwrite = simple_storage.is_packed()
+                ? index < simple_storage.array_like_size()
+                : simple_storage.inline_has_index(index) && !simple_storage.elements().data()[index].is_accessor();
+            if (can_overwrite) {
+                simple_storage.inline_overwrite(index, value);
+                GC::write_barrier(object, value);
+                return {};
             }
         }
 
@@ -1636,12 +1898,12 @@ inline ThrowCompletionOr<void> append(VM& vm, Value lhs, Value rhs, bool is_spre
         // ...rhs
         size_t i = lhs_size;
         TRY(get_iterator_values(vm, rhs, [&i, &lhs_array](Value iterator_value) -> Optional<Completion> {
-            lhs_array.indexed_properties().put(i, iterator_value, default_attributes);
+            lhs_array.put_indexed_direct(i, iterator_value);
             ++i;
             return {};
         }));
     } else {
-        lhs_array.indexed_properties().put(lhs_size, rhs, default_attributes);
+        lhs_array.put_indexed_direct(lhs_size, rhs);
     }
 
     return {};
@@ -2066,6 +2328,23 @@ static ThrowCompletionOr<Value> typeof_(VM& vm, Value value)
 
 JS_ENUMERATE_COMMON_UNARY_OPS(JS_DEFINE_COMMON_UNARY_OP)
 
+// NOTE: The interpreter evaluates these conditions inline in run_bytecode(); this is used by native code.
+#define JS_DEFINE_EVALUATE_CONDITION_FOR_COMPARISON_OP(op_TitleCase, op_snake_case, numeric_operator)          \
+    ThrowCompletionOr<bool> Jump##op_TitleCase::evaluate_condition(Bytecode::Interpreter& interpreter) const \
+    {                                                                                                       \
+        auto lhs = interpreter.get(m_lhs);                                                                  \
+        auto rhs = interpreter.get(m_rhs);                                                                  \
+        if (lhs.is_number() && rhs.is_number()) {                                                           \
+            if (lhs.is_int32() && rhs.is_int32())                                                           \
+                return lhs.as_i32() numeric_operator rhs.as_i32();                                          \
+            return lhs.as_double() numeric_operator rhs.as_double();                                        \
+        }                                                                                                   \
+        return TRY(op_snake_case(interpreter.vm(), lhs, rhs)).to_boolean();                                \
+    }
+
+JS_ENUMERATE_COMPARISON_OPS(JS_DEFINE_EVALUATE_CONDITION_FOR_COMPARISON_OP)
+#undef JS_DEFINE_EVALUATE_CONDITION_FOR_COMPARISON_OP
+
 void NewArray::execute_impl(Bytecode::Interpreter& interpreter) const
 {
     auto array = MUST(Array::create(interpreter.realm(), 0));
@@ -2113,7 +2392,29 @@ void NewObject::execute_impl(Bytecode::Interpreter& interpreter) const
 {
     auto& vm = interpreter.vm();
     auto& realm = *vm.current_realm();
-    interpreter.set(dst(), Object::create(realm, realm.intrinsics().object_prototype()));
+    auto object_prototype = realm.intrinsics().object_prototype();
+
+    // OPTIMIZATION: Start out with the shape that this literal's properties led to last time. The literal then defines
+    //               the same properties in the same order, each of which finds its slot already in the shape.
+    // NOTE: The same executable can run in more than one realm, each with its own Object.prototype.
+    if (m_shape_cache_index.has_value()) {
+        auto& shape = interpreter.current_executable().object_shape_caches[*m_shape_cache_index].shape;
+        if (shape && shape->prototype() == object_prototype.ptr()) {
+            interpreter.set(dst(), Object::create_with_premade_shape(*shape));
+            return;
+        }
+    }
+
+    interpreter.set(dst(), Object::create(realm, object_prototype));
+}
+
+void CacheObjectShape::execute_impl(Bytecode::Interpreter& interpreter) const
+{
+    auto& object = interpreter.get(m_object).as_object();
+    // Dictionary shapes are unique to their object, and change in place.
+    if (object.shape().is_dictionary())
+        return;
+    interpreter.current_executable().object_shape_caches[m_cache_index].shape = object.shape();
 }
 
 void NewRegExp::execute_impl(Bytecode::Interpreter& interpreter) const
@@ -2210,6 +2511,11 @@ ThrowCompletionOr<void> GetGlobal::execute_impl(Bytecode::Interpreter& interpret
     return {};
 }
 
+ThrowCompletionOr<void> SetGlobal::execute_impl(Bytecode::Interpreter& interpreter) const
+{
+    return set_global(interpreter, m_identifier, interpreter.get(m_src), interpreter.current_executable().global_variable_caches[m_cache_index]);
+}
+
 ThrowCompletionOr<void> DeleteVariable::execute_impl(Bytecode::Interpreter& interpreter) const
 {
     auto& vm = interpreter.vm();
@@ -2987,7 +3293,7 @@ void BlockDeclarationInstantiation::execute_impl(Bytecode::Interpreter& interpre
     auto& running_execution_context = interpreter.running_execution_context();
     running_execution_context.saved_lexical_environments.append(old_environment);
     running_execution_context.lexical_environment = new_declarative_environment(*old_environment);
-    m_scope_node.block_declaration_instantiation(vm, running_execution_context.lexical_environment);
+    m_scope_node->block_declaration_instantiation(vm, running_execution_context.lexical_environment);
 }
 
 ByteString Mov::to_byte_string_impl(Bytecode::Executable const& executable) const
@@ -3036,9 +3342,16 @@ ByteString IteratorToArray::to_byte_string_impl(Bytecode::Executable const& exec
 
 ByteString NewObject::to_byte_string_impl(Bytecode::Executable const& executable) const
 {
+    if (m_shape_cache_index.has_value())
+        return ByteString::formatted("NewObject {}, shape_cache:{}", format_operand("dst"sv, dst(), executable), *m_shape_cache_index);
     return ByteString::formatted("NewObject {}", format_operand("dst"sv, dst(), executable));
 }
 
+ByteString CacheObjectShape::to_byte_string_impl(Bytecode::Executable const& executable) const
+{
+    return ByteString::formatted("CacheObjectShape {}, shape_cache:{}", format_operand("object"sv, m_object, executable), m_cache_index);
+}
+
 ByteString NewRegExp::to_byte_string_impl(Bytecode::Executable const& executable) const
 {
     return ByteString::formatted("NewRegExp {}, source:{} (\"{}\") flags:{} (\"{}\")",
@@ -3092,6 +3405,13 @@ ByteString GetGlobal::to_byte_string_impl(Bytecode::Executable const& executable
         executable.identifier_table->get(m_identifier));
 }
 
+ByteString SetGlobal::to_byte_string_impl(Bytecode::Executable const& executable) const
+{
+    return ByteString::formatted("SetGlobal {}, {}",
+        executable.identifier_table->get(m_identifier),
+        format_operand("src"sv, src(), executable));
+}
+
 ByteString DeleteVariable::to_byte_string_impl(Bytecode::Executable const& executable) const
 {
     return ByteString::formatted("DeleteVariable {}", executable.identifier_table->get(m_identifier));
@@ -3464,8 +3784,8 @@ ByteString NewFunction::to_byte_string_impl(Bytecode::Executable const& executab
     StringBuilder builder;
     builder.appendff("NewFunction {}",
         format_operand("dst"sv, m_dst, executable));
-    if (m_function_node.has_name())
-        builder.appendff(" name:{}"sv, m_function_node.name());
+    if (m_function_node->has_name())
+        builder.appendff(" name:{}"sv, m_function_node->name());
     if (m_lhs_name.has_value())
         builder.appendff(" lhs_name:{}"sv, executable.get_identifier(m_lhs_name.value()));
     if (m_home_object.has_value())
@@ -3476,7 +3796,7 @@ ByteString NewFunction::to_byte_string_impl(Bytecode::Executable const& executab
 ByteString NewClass::to_byte_string_impl(Bytecode::Executable const& executable) const
 {
     StringBuilder builder;
-    auto name = m_class_expression.name();
+    auto name = m_class_expression->name();
     builder.appendff("NewClass {}",
         format_operand("dst"sv, m_dst, executable));
     if (m_super_class.has_value())
@@ -56,8 +56,14 @@ public:
         return m_registers_and_constants_and_locals.data()[r.index()];
     }
 
-    [[nodiscard]] Value get(Operand) const;
-    void set(Operand, Value);
+    [[nodiscard]] ALWAYS_INLINE Value get(Operand op) const
+    {
+        return m_registers_and_constants_and_locals.data()[op.index()];
+    }
+    ALWAYS_INLINE void set(Operand op, Value value)
+    {
+        m_registers_and_constants_and_locals.data()[op.index()] = value;
+    }
 
     Value do_yield(Value value, Optional<Label> continuation);
     void do_return(Value value)
@@ -85,7 +91,17 @@ public:
 
     ExecutionContext& running_execution_context() { return *m_running_execution_context; }
 
+    MegamorphicPropertyCache& megamorphic_property_cache() { return m_megamorphic_property_cache; }
+    MegamorphicPropertyCache const& megamorphic_property_cache() const { return m_megamorphic_property_cache; }
+
+    // The register file and call frames live in the ExecutionContexts, which the VM gathers as precise roots.
+    // This adds the cells cached by the interpreter itself, so that none of its state depends on being found
+    // by the conservative stack scan.
+    void gather_roots(HashMap<GC::Cell*, GC::HeapRoot>&) const;
+
 private:
+    friend class JIT::Compiler;
+
     void run_bytecode(size_t entry_point);
 
     enum class HandleExceptionResponse {
@@ -93,6 +109,8 @@ private:
         ContinueInThisExecutable,
     };
     [[nodiscard]] HandleExceptionResponse handle_exception(size_t& program_counter, Value exception);
+    [[nodiscard]] HandleExceptionResponse continue_pending_unwind(size_t& program_counter, Label resume_target);
+    void schedule_jump(size_t& program_counter, Label target);
 
     VM& m_vm;
     Optional<size_t> m_scheduled_jump;
@@ -105,6 +123,7 @@ private:
     Span<Value> m_registers_and_constants_and_locals;
     Vector<Value> m_argument_values_buffer;
     ExecutionContext* m_running_execution_context { nullptr };
+    MegamorphicPropertyCache m_megamorphic_property_cache;
 };
 
 extern bool g_dump_bytecode;
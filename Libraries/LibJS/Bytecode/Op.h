@@ -8,7 +8,9 @@
 
 #pragma once
 
+#include <AK/Badge.h>
 #include <AK/FixedArray.h>
+#include <AK/NonnullRawPtr.h>
 #include <AK/StdLibExtras.h>
 #include <LibCrypto/BigInt/SignedBigInteger.h>
 #include <LibJS/Bytecode/Builtins.h>
@@ -204,9 +206,10 @@ JS_ENUMERATE_COMMON_UNARY_OPS(JS_DECLARE_COMMON_UNARY_OP)
 
 class NewObject final : public Instruction {
 public:
-    explicit NewObject(Operand dst)
+    explicit NewObject(Operand dst, Optional<u32> shape_cache_index = {})
         : Instruction(Type::NewObject)
         , m_dst(dst)
+        , m_shape_cache_index(shape_cache_index)
     {
     }
 
@@ -218,9 +221,38 @@ public:
     }
 
     Operand dst() const { return m_dst; }
+    Optional<u32> shape_cache_index() const { return m_shape_cache_index; }
 
 private:
     Operand m_dst;
+    // Set for object literals whose properties always end up the same, in which case the object starts out with the
+    // shape that the literal produced last time (see CacheObjectShape).
+    Optional<u32> m_shape_cache_index;
+};
+
+// Remembers the shape of an object that an object literal has just finished initializing, for the literal's NewObject.
+class CacheObjectShape final : public Instruction {
+public:
+    CacheObjectShape(Operand object, u32 cache_index)
+        : Instruction(Type::CacheObjectShape)
+        , m_object(object)
+        , m_cache_index(cache_index)
+    {
+    }
+
+    void execute_impl(Bytecode::Interpreter&) const;
+    ByteString to_byte_string_impl(Bytecode::Executable const&) const;
+    void visit_operands_impl(Function<void(Operand&)> visitor)
+    {
+        visitor(m_object);
+    }
+
+    Operand object() const { return m_object; }
+    u32 cache_index() const { return m_cache_index; }
+
+private:
+    Operand m_object;
+    u32 m_cache_index { 0 };
 };
 
 class NewRegExp final : public Instruction {
@@ -904,6 +936,34 @@ private:
     u32 m_cache_index { 0 };
 };
 
+class SetGlobal final : public Instruction {
+public:
+    SetGlobal(IdentifierTableIndex identifier, Operand src, u32 cache_index)
+        : Instruction(Type::SetGlobal)
+        , m_identifier(identifier)
+        , m_src(src)
+        , m_cache_index(cache_index)
+    {
+    }
+
+    ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;
+    ByteString to_byte_string_impl(Bytecode::Executable const&) const;
+
+    IdentifierTableIndex identifier() const { return m_identifier; }
+    Operand src() const { return m_src; }
+    u32 cache_index() const { return m_cache_index; }
+
+    void visit_operands_impl(Function<void(Operand&)> visitor)
+    {
+        visitor(m_src);
+    }
+
+private:
+    IdentifierTableIndex m_identifier;
+    Operand m_src;
+    u32 m_cache_index { 0 };
+};
+
 class DeleteVariable final : public Instruction {
 public:
     explicit DeleteVariable(Operand dst, IdentifierTableIndex identifier)
@@ -1648,6 +1708,7 @@ private:
         }                                                                                            \
                                                                                                      \
         ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;                          \
+        ThrowCompletionOr<bool> evaluate_condition(Bytecode::Interpreter&) const;                    \
         ByteString to_byte_string_impl(Bytecode::Executable const&) const;                           \
         void visit_labels_impl(Function<void(Label&)> visitor)                                       \
         {                                                                                            \
@@ -2050,10 +2111,12 @@ public:
     ClassExpression const& class_expression() const { return m_class_expression; }
     Optional<IdentifierTableIndex> const& lhs_name() const { return m_lhs_name; }
 
+    void link_class_expression(Badge<ExecutableCache>, ClassExpression const& class_expression) { m_class_expression = class_expression; }
+
 private:
     Operand m_dst;
     Optional<Operand> m_super_class;
-    ClassExpression const& m_class_expression;
+    NonnullRawPtr<ClassExpression const> m_class_expression;
     Optional<IdentifierTableIndex> m_lhs_name;
     size_t m_element_keys_count { 0 };
     Optional<Operand> m_element_keys[];
@@ -2084,9 +2147,11 @@ public:
     Optional<IdentifierTableIndex> const& lhs_name() const { return m_lhs_name; }
     Optional<Operand> const& home_object() const { return m_home_object; }
 
+    void link_function_node(Badge<ExecutableCache>, FunctionNode const& function_node) { m_function_node = function_node; }
+
 private:
     Operand m_dst;
-    FunctionNode const& m_function_node;
+    NonnullRawPtr<FunctionNode const> m_function_node;
     Optional<IdentifierTableIndex> m_lhs_name;
     Optional<Operand> m_home_object;
 };
@@ -2104,8 +2169,10 @@ public:
 
     ScopeNode const& scope_node() const { return m_scope_node; }
 
+    void link_scope_node(Badge<ExecutableCache>, ScopeNode const& scope_node) { m_scope_node = scope_node; }
+
 private:
-    ScopeNode const& m_scope_node;
+    NonnullRawPtr<ScopeNode const> m_scope_node;
 };
 
 class Return final : public Instruction {
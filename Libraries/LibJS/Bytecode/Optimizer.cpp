@@ -0,0 +1,681 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/BuiltinWrappers.h>
+#include <AK/Concepts.h>
+#include <AK/QuickSort.h>
+#include <LibJS/Bytecode/BasicBlock.h>
+#include <LibJS/Bytecode/Generator.h>
+#include <LibJS/Bytecode/Instruction.h>
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/Optimizer.h>
+#include <LibJS/Runtime/Value.h>
+
+namespace JS::Bytecode {
+
+OptimizationLevel g_optimization_level = OptimizationLevel::Full;
+
+// Liveness needs a register set per basic block, so give up on it for executables where those would get too big.
+static constexpr size_t max_register_bits_for_liveness = 64 * MiB;
+
+static bool is_general_purpose_register(Operand const& operand)
+{
+    return operand.is_register() && operand.index() >= Register::reserved_register_count;
+}
+
+// A set of registers, indexed by register index.
+class RegisterSet {
+public:
+    explicit RegisterSet(size_t register_count)
+    {
+        m_words.resize(ceil_div(register_count, bits_per_word));
+    }
+
+    bool contains(u32 index) const { return m_words[index / bits_per_word] & (1ull << (index % bits_per_word)); }
+    void add(u32 index) { m_words[index / bits_per_word] |= 1ull << (index % bits_per_word); }
+    void remove(u32 index) { m_words[index / bits_per_word] &= ~(1ull << (index % bits_per_word)); }
+
+    void add_all(RegisterSet const& other)
+    {
+        for (size_t i = 0; i < m_words.size(); ++i)
+            m_words[i] |= other.m_words[i];
+    }
+
+    template<typename Callback>
+    void for_each(Callback callback) const
+    {
+        for (size_t i = 0; i < m_words.size(); ++i) {
+            for (auto word = m_words[i]; word != 0; word &= word - 1)
+                callback(static_cast<u32>(i * bits_per_word + count_trailing_zeroes(word)));
+        }
+    }
+
+    bool operator==(RegisterSet const&) const = default;
+
+private:
+    static constexpr size_t bits_per_word = 64;
+
+    Vector<u64> m_words;
+};
+
+template<typename OpType>
+concept HasDestinationOperand = requires(OpType const& op) {
+    { op.dst() } -> SameAs<Operand>;
+};
+
+template<typename OpType>
+static Optional<Operand> destination_of(Instruction const& instruction)
+{
+    if constexpr (HasDestinationOperand<OpType>)
+        return static_cast<OpType const&>(instruction).dst();
+    else
+        return {};
+}
+
+// Returns the operand that an instruction writes without reading it first, if it has one.
+// Instructions may write other operands too; the passes below treat those as if they were only read.
+static Optional<Operand> overwritten_operand(Instruction const& instruction)
+{
+    switch (instruction.type()) {
+    case Instruction::Type::ArrayAppend:
+    case Instruction::Type::ConcatString:
+    case Instruction::Type::Decrement:
+    case Instruction::Type::Increment:
+        // These update their destination in place.
+        return {};
+    default:
+        break;
+    }
+
+#define __BYTECODE_OP(op)       \
+    case Instruction::Type::op: \
+        return destination_of<Op::op>(instruction);
+
+    switch (instruction.type()) {
+        ENUMERATE_BYTECODE_OPS(__BYTECODE_OP)
+    default:
+        VERIFY_NOT_REACHED();
+    }
+
+#undef __BYTECODE_OP
+}
+
+struct InstructionEffects {
+    Optional<u32> overwritten_register;
+    Vector<u32, 4> used_registers;
+};
+
+static InstructionEffects effects_of(Instruction const& instruction)
+{
+    InstructionEffects effects;
+    auto overwritten = overwritten_operand(instruction);
+    bool has_skipped_overwritten_operand = false;
+    const_cast<Instruction&>(instruction).visit_operands([&](Operand& operand) {
+        if (!is_general_purpose_register(operand))
+            return;
+        if (!has_skipped_overwritten_operand && overwritten.has_value() && *overwritten == operand) {
+            has_skipped_overwritten_operand = true;
+            effects.overwritten_register = operand.index();
+            return;
+        }
+        effects.used_registers.append(operand.index());
+    });
+    return effects;
+}
+
+static void apply_backwards(RegisterSet& live, InstructionEffects const& effects, RegisterSet const& live_on_exception)
+{
+    if (effects.overwritten_register.has_value())
+        live.remove(*effects.overwritten_register);
+    for (auto index : effects.used_registers)
+        live.add(index);
+    // Any instruction may throw, and the exception handler may read whatever is live at its start.
+    live.add_all(live_on_exception);
+}
+
+struct ControlFlowGraph {
+    Vector<Vector<size_t>> successors;
+    Vector<Vector<size_t>> exception_successors;
+};
+
+static ControlFlowGraph build_control_flow_graph(Vector<NonnullOwnPtr<BasicBlock>> const& blocks)
+{
+    // A ScheduleJump jumps to the finalizer of its block, and it's the ContinuePendingUnwind at the end of that
+    // finalizer that then jumps to the scheduled target. We don't track which finalizer ends where, so assume that
+    // any ContinuePendingUnwind may continue at any scheduled target.
+    Vector<size_t> scheduled_jump_targets;
+    for (auto& block : blocks) {
+        for (InstructionStreamIterator it(block->instruction_stream()); !it.at_end(); ++it) {
+            if ((*it).type() == Instruction::Type::ScheduleJump)
+                scheduled_jump_targets.append(static_cast<Op::ScheduleJump const&>(*it).target().basic_block_index());
+        }
+    }
+
+    ControlFlowGraph graph;
+    graph.successors.resize(blocks.size());
+    graph.exception_successors.resize(blocks.size());
+
+    for (auto& block : blocks) {
+        auto& successors = graph.successors[block->index()];
+        auto add_successor = [&](size_t index) {
+            if (!successors.contains_slow(index))
+                successors.append(index);
+        };
+
+        for (InstructionStreamIterator it(block->instruction_stream()); !it.at_end(); ++it) {
+            const_cast<Instruction&>(*it).visit_labels([&](Label& label) {
+                add_successor(label.basic_block_index());
+            });
+            if ((*it).type() == Instruction::Type::ContinuePendingUnwind) {
+                for (auto target : scheduled_jump_targets)
+                    add_successor(target);
+            }
+        }
+
+        for (auto const* handler : { block->handler(), block->finalizer() }) {
+            if (!handler)
+                continue;
+            add_successor(handler->index());
+            graph.exception_successors[block->index()].append(handler->index());
+        }
+    }
+
+    return graph;
+}
+
+struct Liveness {
+    Vector<RegisterSet> live_in;
+    Vector<RegisterSet> live_out;
+};
+
+static RegisterSet registers_live_on_exception(ControlFlowGraph const& graph, Liveness const& liveness, size_t block_index, size_t register_count)
+{
+    RegisterSet live(register_count);
+    for (auto handler_index : graph.exception_successors[block_index])
+        live.add_all(liveness.live_in[handler_index]);
+    return live;
+}
+
+static Vector<Instruction const*> instructions_of(BasicBlock const& block)
+{
+    Vector<Instruction const*> instructions;
+    for (InstructionStreamIterator it(block.instruction_stream()); !it.at_end(); ++it)
+        instructions.append(&*it);
+    return instructions;
+}
+
+static Liveness compute_liveness(Vector<NonnullOwnPtr<BasicBlock>> const& blocks, ControlFlowGraph const& graph, size_t register_count)
+{
+    Vector<Vector<InstructionEffects>> effects;
+    effects.ensure_capacity(blocks.size());
+    for (auto& block : blocks) {
+        Vector<InstructionEffects> block_effects;
+        for (auto const* instruction : instructions_of(*block))
+            block_effects.append(effects_of(*instruction));
+        effects.unchecked_append(move(block_effects));
+    }
+
+    Liveness liveness;
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        liveness.live_in.append(RegisterSet(register_count));
+        liveness.live_out.append(RegisterSet(register_count));
+    }
+
+    // The sets only ever grow, so this reaches a fixed point. Going backwards makes that take few iterations.
+    for (bool changed = true; changed;) {
+        changed = false;
+        for (size_t i = blocks.size(); i-- > 0;) {
+            RegisterSet live_out(register_count);
+            for (auto successor : graph.successors[i])
+                live_out.add_all(liveness.live_in[successor]);
+
+            auto live_on_exception = registers_live_on_exception(graph, liveness, i, register_count);
+            auto live = live_out;
+            for (size_t j = effects[i].size(); j-- > 0;)
+                apply_backwards(live, effects[i][j], live_on_exception);
+
+            if (live_out != liveness.live_out[i] || live != liveness.live_in[i]) {
+                liveness.live_out[i] = move(live_out);
+                liveness.live_in[i] = move(live);
+                changed = true;
+            }
+        }
+    }
+
+    return liveness;
+}
+
+// Builds a new instruction stream for a block, carrying its source map over to the new offsets.
+class InstructionStreamBuilder {
+public:
+    explicit InstructionStreamBuilder(BasicBlock const& block)
+        : m_block(block)
+    {
+    }
+
+    void append(Instruction const& instruction, size_t original_offset)
+    {
+        if (auto source_record = m_block.source_map().get(original_offset); source_record.has_value())
+            m_source_map.set(m_buffer.size(), *source_record);
+        m_buffer.append(reinterpret_cast<u8 const*>(&instruction), instruction.length());
+    }
+
+    Vector<u8> take_buffer() { return move(m_buffer); }
+    HashMap<size_t, SourceRecord> take_source_map() { return move(m_source_map); }
+
+private:
+    BasicBlock const& m_block;
+    Vector<u8> m_buffer;
+    HashMap<size_t, SourceRecord> m_source_map;
+};
+
+// Constants are primitives, so these only fold operations on numbers, which can neither throw nor call into user code.
+static Optional<Value> fold_binary_operation(VM& vm, Instruction::Type type, Value lhs, Value rhs)
+{
+    if (!lhs.is_number() || !rhs.is_number())
+        return {};
+
+    switch (type) {
+#define __FOLD_BINARY_OP(OpTitleCase, op_snake_case) \
+    case Instruction::Type::OpTitleCase:             \
+        return MUST(op_snake_case(vm, lhs, rhs));
+        JS_ENUMERATE_COMMON_BINARY_OPS_WITH_FAST_PATH(__FOLD_BINARY_OP)
+        __FOLD_BINARY_OP(Div, div)
+        __FOLD_BINARY_OP(Exp, exp)
+        __FOLD_BINARY_OP(Mod, mod)
+#undef __FOLD_BINARY_OP
+    case Instruction::Type::LooselyEquals:
+    case Instruction::Type::StrictlyEquals:
+        return Value(is_strictly_equal(lhs, rhs));
+    case Instruction::Type::LooselyInequals:
+    case Instruction::Type::StrictlyInequals:
+        return Value(!is_strictly_equal(lhs, rhs));
+    default:
+        return {};
+    }
+}
+
+static Optional<Value> fold_unary_operation(VM& vm, Instruction::Type type, Value value)
+{
+    if (type == Instruction::Type::Not && !value.is_empty())
+        return Value(!value.to_boolean());
+
+    if (!value.is_number())
+        return {};
+
+    switch (type) {
+    case Instruction::Type::BitwiseNot:
+        return MUST(bitwise_not(vm, value));
+    case Instruction::Type::UnaryMinus:
+        return MUST(unary_minus(vm, value));
+    case Instruction::Type::UnaryPlus:
+        return MUST(unary_plus(vm, value));
+    default:
+        return {};
+    }
+}
+
+OptimizationStatistics Optimizer::optimize(Generator& generator, OptimizationLevel level)
+{
+    Optimizer optimizer(generator);
+
+    OptimizationStatistics statistics;
+    statistics.instruction_count_before = optimizer.count_instructions();
+    statistics.register_count_before = generator.m_next_register;
+
+    if (level >= OptimizationLevel::Basic) {
+        optimizer.fold_constants(level >= OptimizationLevel::Full ? PropagateConstants::Yes : PropagateConstants::No);
+        optimizer.remove_unreachable_blocks();
+    }
+
+    if (level >= OptimizationLevel::Full && generator.m_root_basic_blocks.size() * generator.m_next_register <= max_register_bits_for_liveness) {
+        // Removing a store can make the stores feeding it dead, so repeat until nothing changes.
+        while (optimizer.remove_dead_register_stores())
+            ;
+        optimizer.compact_registers();
+    }
+
+    statistics.instruction_count_after = optimizer.count_instructions();
+    statistics.register_count_after = generator.m_next_register;
+    return statistics;
+}
+
+size_t Optimizer::count_instructions() const
+{
+    size_t count = 0;
+    for (auto& block : m_generator.m_root_basic_blocks) {
+        for (InstructionStreamIterator it(block->instruction_stream()); !it.at_end(); ++it)
+            ++count;
+    }
+    return count;
+}
+
+// Pass: Fold operations and branches whose operands are constants. With PropagateConstants::Yes, registers and
+// locals that a Mov earlier in the same block set to a constant count as that constant.
+void Optimizer::fold_constants(PropagateConstants propagate_constants)
+{
+    auto& vm = m_generator.vm();
+
+    for (auto& block : m_generator.m_root_basic_blocks) {
+        HashMap<u64, Operand> known_constants;
+
+        auto key_for = [](Operand operand) {
+            return (static_cast<u64>(operand.type()) << 32) | operand.index();
+        };
+        auto is_tracked = [&](Operand operand) {
+            return propagate_constants == PropagateConstants::Yes && (is_general_purpose_register(operand) || operand.is_local());
+        };
+        auto resolve = [&](Operand operand) {
+            if (!is_tracked(operand))
+                return operand;
+            return known_constants.get(key_for(operand)).value_or(operand);
+        };
+        auto did_write = [&](Operand destination, Operand value) {
+            if (!is_tracked(destination))
+                return;
+            if (value.is_constant())
+                known_constants.set(key_for(destination), value);
+            else
+                known_constants.remove(key_for(destination));
+        };
+        auto constant_value = [&](Operand operand) {
+            return m_generator.m_constants[operand.index()];
+        };
+
+        InstructionStreamBuilder builder(*block);
+        bool changed = false;
+
+        InstructionStreamIterator it(block->instruction_stream());
+        while (!it.at_end()) {
+            auto& instruction = const_cast<Instruction&>(*it);
+            auto offset = it.offset();
+            ++it;
+
+            auto replace_with = [&](Instruction const& replacement) {
+                builder.append(replacement, offset);
+                Instruction::destroy(instruction);
+                changed = true;
+            };
+
+            switch (instruction.type()) {
+            case Instruction::Type::Mov: {
+                auto& mov = static_cast<Op::Mov&>(instruction);
+                auto src = resolve(mov.src());
+                did_write(mov.dst(), src);
+                if (src != mov.src())
+                    replace_with(Op::Mov(mov.dst(), src));
+                else
+                    builder.append(instruction, offset);
+                continue;
+            }
+
+#define __FOLD_BINARY_OP(OpTitleCase, op_snake_case)                                                                \
+    case Instruction::Type::OpTitleCase: {                                                                          \
+        auto& op = static_cast<Op::OpTitleCase&>(instruction);                                                      \
+        auto lhs = resolve(op.lhs());                                                                               \
+        auto rhs = resolve(op.rhs());                                                                               \
+        Optional<Value> result;                                                                                     \
+        if (lhs.is_constant() && rhs.is_constant())                                                                 \
+            result = fold_binary_operation(vm, instruction.type(), constant_value(lhs), constant_value(rhs));       \
+        if (result.has_value()) {                                                                                   \
+            auto constant = m_generator.add_constant(*result).operand();                                            \
+            did_write(op.dst(), constant);                                                                          \
+            replace_with(Op::Mov(op.dst(), constant));                                                              \
+        } else {                                                                                                    \
+            did_write(op.dst(), op.dst());                                                                          \
+            if (lhs != op.lhs() || rhs != op.rhs())                                                                 \
+                replace_with(Op::OpTitleCase(op.dst(), lhs, rhs));                                                  \
+            else                                                                                                    \
+                builder.append(instruction, offset);                                                                \
+        }                                                                                                           \
+        continue;                                                                                                   \
+    }
+                JS_ENUMERATE_COMMON_BINARY_OPS_WITH_FAST_PATH(__FOLD_BINARY_OP)
+                JS_ENUMERATE_COMMON_BINARY_OPS_WITHOUT_FAST_PATH(__FOLD_BINARY_OP)
+#undef __FOLD_BINARY_OP
+
+#define __FOLD_UNARY_OP(OpTitleCase, op_snake_case)                                          \
+    case Instruction::Type::OpTitleCase: {                                                   \
+        auto& op = static_cast<Op::OpTitleCase&>(instruction);                               \
+        auto src = resolve(op.src());                                                        \
+        Optional<Value> result;                                                              \
+        if (src.is_constant())                                                               \
+            result = fold_unary_operation(vm, instruction.type(), constant_value(src));      \
+        if (result.has_value()) {                                                            \
+            auto constant = m_generator.add_constant(*result).operand();                     \
+            did_write(op.dst(), constant);                                                   \
+            replace_with(Op::Mov(op.dst(), constant));                                       \
+        } else {                                                                             \
+            did_write(op.dst(), op.dst());                                                   \
+            if (src != op.src())                                                             \
+                replace_with(Op::OpTitleCase(op.dst(), src));                                \
+            else                                                                             \
+                builder.append(instruction, offset);                                         \
+        }                                                                                    \
+        continue;                                                                            \
+    }
+                JS_ENUMERATE_COMMON_UNARY_OPS(__FOLD_UNARY_OP)
+#undef __FOLD_UNARY_OP
+
+            case Instruction::Type::JumpIf: {
+                auto& jump = static_cast<Op::JumpIf&>(instruction);
+                auto condition = resolve(jump.condition());
+                if (condition.is_constant() && !constant_value(condition).is_empty())
+                    replace_with(Op::Jump(constant_value(condition).to_boolean() ? jump.true_target() : jump.false_target()));
+                else if (condition != jump.condition())
+                    replace_with(Op::JumpIf(condition, jump.true_target(), jump.false_target()));
+                else
+                    builder.append(instruction, offset);
+                continue;
+            }
+
+#define __FOLD_COMPARISON_OP(op_TitleCase, op_snake_case, numeric_operator)                                                        \
+    case Instruction::Type::Jump##op_TitleCase: {                                                                                  \
+        auto& jump = static_cast<Op::Jump##op_TitleCase&>(instruction);                                                            \
+        auto lhs = resolve(jump.lhs());                                                                                            \
+        auto rhs = resolve(jump.rhs());                                                                                            \
+        Optional<Value> result;                                                                                                    \
+        if (lhs.is_constant() && rhs.is_constant())                                                                                \
+            result = fold_binary_operation(vm, Instruction::Type::op_TitleCase, constant_value(lhs), constant_value(rhs));         \
+        if (result.has_value())                                                                                                    \
+            replace_with(Op::Jump(result->to_boolean() ? jump.true_target() : jump.false_target()));                               \
+        else if (lhs != jump.lhs() || rhs != jump.rhs())                                                                           \
+            replace_with(Op::Jump##op_TitleCase(lhs, rhs, jump.true_target(), jump.false_target()));                               \
+        else                                                                                                                       \
+            builder.append(instruction, offset);                                                                                   \
+        continue;                                                                                                                  \
+    }
+                JS_ENUMERATE_COMPARISON_OPS(__FOLD_COMPARISON_OP)
+#undef __FOLD_COMPARISON_OP
+
+            case Instruction::Type::BlockDeclarationInstantiation:
+                // This initializes the locals of the functions declared in the block, without mentioning them.
+                known_constants.clear();
+                builder.append(instruction, offset);
+                continue;
+
+            default:
+                break;
+            }
+
+            // We don't know which operands other instructions write, so forget about all of them.
+            instruction.visit_operands([&](Operand& operand) {
+                if (is_tracked(operand))
+                    known_constants.remove(key_for(operand));
+            });
+            builder.append(instruction, offset);
+        }
+
+        if (changed)
+            block->replace_instruction_stream({}, builder.take_buffer(), builder.take_source_map());
+    }
+}
+
+// Pass: Remove the blocks that can't be reached from the entry block, and renumber the rest.
+void Optimizer::remove_unreachable_blocks()
+{
+    auto& blocks = m_generator.m_root_basic_blocks;
+    auto graph = build_control_flow_graph(blocks);
+
+    Vector<bool> is_reachable;
+    is_reachable.resize(blocks.size());
+    Vector<size_t> worklist { 0 };
+    is_reachable[0] = true;
+    while (!worklist.is_empty()) {
+        for (auto successor : graph.successors[worklist.take_last()]) {
+            if (is_reachable[successor])
+                continue;
+            is_reachable[successor] = true;
+            worklist.append(successor);
+        }
+    }
+
+    if (!is_reachable.contains_slow(false))
+        return;
+
+    Vector<u32> new_indices;
+    new_indices.resize(blocks.size());
+    Vector<NonnullOwnPtr<BasicBlock>> reachable_blocks;
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        if (!is_reachable[i])
+            continue;
+        new_indices[i] = reachable_blocks.size();
+        reachable_blocks.append(move(blocks[i]));
+    }
+
+    for (auto& block : reachable_blocks) {
+        block->set_index({}, new_indices[block->index()]);
+        for (InstructionStreamIterator it(block->instruction_stream()); !it.at_end(); ++it) {
+            const_cast<Instruction&>(*it).visit_labels([&](Label& label) {
+                label = Label { new_indices[label.basic_block_index()] };
+            });
+        }
+    }
+
+    // The blocks that were moved out of are null now, and the unreachable ones get destroyed along with the vector.
+    blocks = move(reachable_blocks);
+}
+
+// Pass: Remove Movs into general-purpose registers that are never read afterwards, and Movs of operands onto themselves.
+bool Optimizer::remove_dead_register_stores()
+{
+    auto& blocks = m_generator.m_root_basic_blocks;
+    auto register_count = m_generator.m_next_register;
+    auto graph = build_control_flow_graph(blocks);
+    auto liveness = compute_liveness(blocks, graph, register_count);
+
+    bool removed_any = false;
+    for (auto& block : blocks) {
+        auto instructions = instructions_of(*block);
+        auto live = liveness.live_out[block->index()];
+        auto live_on_exception = registers_live_on_exception(graph, liveness, block->index(), register_count);
+
+        Vector<bool> is_dead;
+        is_dead.resize(instructions.size());
+        for (size_t i = instructions.size(); i-- > 0;) {
+            auto const& instruction = *instructions[i];
+            if (instruction.type() == Instruction::Type::Mov) {
+                auto const& mov = static_cast<Op::Mov const&>(instruction);
+                if (mov.dst() == mov.src() || (is_general_purpose_register(mov.dst()) && !live.contains(mov.dst().index()))) {
+                    is_dead[i] = true;
+                    continue;
+                }
+            }
+            apply_backwards(live, effects_of(instruction), live_on_exception);
+        }
+
+        if (!is_dead.contains_slow(true))
+            continue;
+        removed_any = true;
+
+        InstructionStreamBuilder builder(*block);
+        for (size_t i = 0; i < instructions.size(); ++i) {
+            auto const& instruction = *instructions[i];
+            if (is_dead[i])
+                Instruction::destroy(const_cast<Instruction&>(instruction));
+            else
+                builder.append(instruction, reinterpret_cast<u8 const*>(&instruction) - block->data());
+        }
+        block->replace_instruction_stream({}, builder.take_buffer(), builder.take_source_map());
+    }
+
+    return removed_any;
+}
+
+// Pass: Renumber the general-purpose registers so that registers that are never live at the same time share an index.
+//
+// Each register gets the range of positions, in the order the blocks are laid out in, between the first and the last
+// point where it is live or mentioned. Registers whose ranges don't overlap are never live at the same time, so the
+// ranges are assigned to indices with a linear scan.
+void Optimizer::compact_registers()
+{
+    auto& blocks = m_generator.m_root_basic_blocks;
+    auto register_count = m_generator.m_next_register;
+    auto graph = build_control_flow_graph(blocks);
+    auto liveness = compute_liveness(blocks, graph, register_count);
+
+    struct LiveRange {
+        size_t start { NumericLimits<size_t>::max() };
+        size_t end { 0 };
+    };
+    Vector<LiveRange> ranges;
+    ranges.resize(register_count);
+    auto extend_range = [&](u32 index, size_t position) {
+        ranges[index].start = min(ranges[index].start, position);
+        ranges[index].end = max(ranges[index].end, position);
+    };
+
+    size_t position = 0;
+    for (auto& block : blocks) {
+        liveness.live_in[block->index()].for_each([&](u32 index) { extend_range(index, position); });
+        ++position;
+        for (InstructionStreamIterator it(block->instruction_stream()); !it.at_end(); ++it) {
+            const_cast<Instruction&>(*it).visit_operands([&](Operand& operand) {
+                if (is_general_purpose_register(operand))
+                    extend_range(operand.index(), position);
+            });
+            ++position;
+        }
+        liveness.live_out[block->index()].for_each([&](u32 index) { extend_range(index, position); });
+        ++position;
+    }
+
+    Vector<u32> registers_by_start;
+    for (u32 index = Register::reserved_register_count; index < register_count; ++index) {
+        if (ranges[index].start <= ranges[index].end)
+            registers_by_start.append(index);
+    }
+    quick_sort(registers_by_start, [&](u32 a, u32 b) { return ranges[a].start < ranges[b].start; });
+
+    Vector<u32> new_indices;
+    new_indices.resize(register_count);
+    Vector<u32> active_registers;
+    Vector<u32> free_indices;
+    u32 next_index = Register::reserved_register_count;
+    for (auto index : registers_by_start) {
+        active_registers.remove_all_matching([&](u32 active_index) {
+            if (ranges[active_index].end >= ranges[index].start)
+                return false;
+            free_indices.append(new_indices[active_index]);
+            return true;
+        });
+        new_indices[index] = free_indices.is_empty() ? next_index++ : free_indices.take_last();
+        active_registers.append(index);
+    }
+
+    for (auto& block : blocks) {
+        for (InstructionStreamIterator it(block->instruction_stream()); !it.at_end(); ++it) {
+            const_cast<Instruction&>(*it).visit_operands([&](Operand& operand) {
+                if (is_general_purpose_register(operand))
+                    operand = Operand(Register(new_indices[operand.index()]));
+            });
+        }
+    }
+
+    m_generator.m_next_register = next_index;
+}
+
+}
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Types.h>
+#include <LibJS/Bytecode/Executable.h>
+#include <LibJS/Forward.h>
+
+namespace JS::Bytecode {
+
+enum class OptimizationLevel : u8 {
+    // Only the jump peepholes done while linking the basic blocks into an executable.
+    None = 0,
+    // Also folds branches on constants and removes the blocks that become unreachable.
+    Basic = 1,
+    // Also propagates and folds constants, removes dead register stores and compacts the register file.
+    Full = 2,
+};
+
+extern OptimizationLevel g_optimization_level;
+
+// Runs the optimization passes over the basic blocks of a Generator, after code generation
+// and before the blocks are linked into an Executable.
+//
+// The passes run while operands still refer to registers, constants and locals by their
+// unshifted indices, and only ever treat general-purpose registers as renameable or dead;
+// locals and the reserved registers are observable outside of the bytecode.
+class Optimizer {
+public:
+    static OptimizationStatistics optimize(Generator&, OptimizationLevel);
+
+private:
+    explicit Optimizer(Generator& generator)
+        : m_generator(generator)
+    {
+    }
+
+    enum class PropagateConstants {
+        No,
+        Yes,
+    };
+    void fold_constants(PropagateConstants);
+    void remove_unreachable_blocks();
+    bool remove_dead_register_stores();
+    void compact_registers();
+
+    size_t count_instructions() const;
+
+    Generator& m_generator;
+};
+
+}
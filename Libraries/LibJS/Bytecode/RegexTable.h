@@ -32,6 +32,7 @@ public:
     ParsedRegex const& get(RegexTableIndex) const;
     void dump() const;
     bool is_empty() const { return m_regexes.is_empty(); }
+    Vector<ParsedRegex> const& regexes() const { return m_regexes; }
 
 private:
     Vector<ParsedRegex> m_regexes;
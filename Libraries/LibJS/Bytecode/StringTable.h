@@ -25,6 +25,7 @@ public:
     ByteString const& get(StringTableIndex) const;
     void dump() const;
     bool is_empty() const { return m_strings.is_empty(); }
+    Vector<ByteString> const& strings() const { return m_strings; }
 
 private:
     Vector<ByteString> m_strings;
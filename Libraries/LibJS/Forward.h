@@ -312,12 +312,20 @@ namespace Bytecode {
 class BasicBlock;
 enum class Builtin : u8;
 class Executable;
+class ExecutableCache;
+class ExecutableCacheState;
 class Generator;
 class Instruction;
 class Interpreter;
 class Operand;
+class Optimizer;
 class RegexTable;
 class Register;
 }
 
+namespace JIT {
+class Compiler;
+class NativeExecutable;
+}
+
 }
@@ -0,0 +1,681 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Platform.h>
+#include <LibJS/Bytecode/Instruction.h>
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/Register.h>
+#include <LibJS/JIT/Compiler.h>
+#include <LibJS/Runtime/Object.h>
+#include <LibJS/Runtime/Shape.h>
+#include <LibJS/Runtime/Value.h>
+#include <LibJS/Runtime/ValueInlines.h>
+#include <sys/mman.h>
+
+namespace JS::JIT {
+
+bool g_jit_enabled = false;
+u32 g_compilation_threshold = default_compilation_threshold;
+
+using Reg = Assembler::Reg;
+using Condition = Assembler::Condition;
+using Memory = Assembler::Memory;
+
+// The state of the running executable lives in callee-saved registers, so it survives calls to helpers.
+static constexpr auto INTERPRETER = Reg::RBX;
+static constexpr auto REGISTERS_AND_CONSTANTS_AND_LOCALS = Reg::R12;
+static constexpr auto ARGUMENTS = Reg::R13;
+static constexpr auto PROGRAM_COUNTER = Reg::R14;
+
+// Never holds anything across instructions; used for extracting tags.
+static constexpr auto SCRATCH = Reg::R11;
+
+Compiler::Compiler(Bytecode::Executable& executable)
+    : m_bytecode_executable(executable)
+    , m_assembler(m_output)
+{
+}
+
+OwnPtr<NativeExecutable> Compiler::compile([[maybe_unused]] Bytecode::Executable& executable)
+{
+#if ARCH(X86_64)
+    Compiler compiler { executable };
+    return compiler.compile_executable();
+#else
+    return nullptr;
+#endif
+}
+
+OwnPtr<NativeExecutable> Compiler::compile_executable()
+{
+    auto& executable = m_bytecode_executable;
+
+    // Operand offsets and program counters are encoded as 32-bit immediates.
+    auto register_count = executable.number_of_registers + executable.constants.size() + executable.local_variable_names.size();
+    if (register_count * sizeof(Value) > NumericLimits<i32>::max() || executable.bytecode.size() > NumericLimits<i32>::max())
+        return nullptr;
+
+    // NOTE: The generated code refers to these caches by address, so this must not be resized afterwards.
+    m_get_by_id_caches.resize(executable.property_lookup_caches.size());
+
+    // The entry point is called as:
+    //     entry(Interpreter*, Value* registers_and_constants_and_locals, Value* arguments, size_t* program_counter, void const* native_code_to_jump_to)
+    // Pushing rbp and the four registers we use keeps the stack 16-byte aligned for calls.
+    m_assembler.push(Reg::RBP);
+    m_assembler.mov(Reg::RBP, Reg::RSP);
+    m_assembler.push(INTERPRETER);
+    m_assembler.push(REGISTERS_AND_CONSTANTS_AND_LOCALS);
+    m_assembler.push(ARGUMENTS);
+    m_assembler.push(PROGRAM_COUNTER);
+    m_assembler.mov(INTERPRETER, Reg::RDI);
+    m_assembler.mov(REGISTERS_AND_CONSTANTS_AND_LOCALS, Reg::RSI);
+    m_assembler.mov(ARGUMENTS, Reg::RDX);
+    m_assembler.mov(PROGRAM_COUNTER, Reg::RCX);
+    m_assembler.jump(Reg::R8);
+
+    // Every way out of the native code goes through here, with a NativeResult in rax.
+    m_assembler.bind(m_exit_label);
+    m_assembler.pop(PROGRAM_COUNTER);
+    m_assembler.pop(ARGUMENTS);
+    m_assembler.pop(REGISTERS_AND_CONSTANTS_AND_LOCALS);
+    m_assembler.pop(INTERPRETER);
+    m_assembler.pop(Reg::RBP);
+    m_assembler.ret();
+
+    // Every instruction can be entered directly, which is how we resume generators and jump to exception handlers.
+    HashMap<size_t, size_t> native_offsets;
+    for (Bytecode::InstructionStreamIterator it(executable.bytecode, &executable); !it.at_end(); ++it) {
+        m_current_offset = it.offset();
+        m_assembler.bind(label_for(m_current_offset));
+        native_offsets.set(m_current_offset, m_assembler.offset());
+        compile_instruction(*it);
+    }
+
+    for (auto& it : m_labels) {
+        if (!it.value->is_bound()) {
+            dbgln("JIT: Jump to {} in executable '{}' is not an instruction boundary", it.key, executable.name);
+            return nullptr;
+        }
+    }
+
+    auto* code = mmap(nullptr, m_output.size(), PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+    if (code == MAP_FAILED) {
+        dbgln("JIT: mmap failed: {}", AK::Error::from_errno(errno));
+        return nullptr;
+    }
+    memcpy(code, m_output.data(), m_output.size());
+    if (mprotect(code, m_output.size(), PROT_READ | PROT_EXEC) < 0) {
+        dbgln("JIT: mprotect failed: {}", AK::Error::from_errno(errno));
+        munmap(code, m_output.size());
+        return nullptr;
+    }
+
+    return make<NativeExecutable>(code, m_output.size(), move(native_offsets), move(m_get_by_id_caches));
+}
+
+void Compiler::compile_instruction(Bytecode::Instruction const& instruction)
+{
+    using namespace Bytecode;
+
+    switch (instruction.type()) {
+    case Instruction::Type::GetArgument: {
+        auto& op = static_cast<Op::GetArgument const&>(instruction);
+        m_assembler.mov(Reg::RAX, Memory { ARGUMENTS, static_cast<i32>(op.index() * sizeof(Value)) });
+        store(op.dst(), Reg::RAX);
+        break;
+    }
+    case Instruction::Type::SetArgument: {
+        auto& op = static_cast<Op::SetArgument const&>(instruction);
+        load(Reg::RAX, op.src());
+        m_assembler.mov(Memory { ARGUMENTS, static_cast<i32>(op.index() * sizeof(Value)) }, Reg::RAX);
+        break;
+    }
+    case Instruction::Type::Mov: {
+        auto& op = static_cast<Op::Mov const&>(instruction);
+        load(Reg::RAX, op.src());
+        store(op.dst(), Reg::RAX);
+        break;
+    }
+    case Instruction::Type::End: {
+        auto& op = static_cast<Op::End const&>(instruction);
+        load(Reg::RAX, op.value());
+        store(Operand(Register::accumulator()), Reg::RAX);
+        m_assembler.mov32(Reg::RAX, to_underlying(NativeResult::ExitFromExecutable));
+        m_assembler.jump(m_exit_label);
+        break;
+    }
+    case Instruction::Type::Jump: {
+        auto& op = static_cast<Op::Jump const&>(instruction);
+        m_assembler.jump(label_for(op.target()));
+        break;
+    }
+    case Instruction::Type::JumpIf: {
+        auto& op = static_cast<Op::JumpIf const&>(instruction);
+        compile_jump_if_truthy(op.condition(), label_for(op.true_target()), label_for(op.false_target()));
+        break;
+    }
+    case Instruction::Type::JumpTrue: {
+        auto& op = static_cast<Op::JumpTrue const&>(instruction);
+        compile_jump_if_truthy(op.condition(), label_for(op.target()), label_for_next_instruction(op));
+        break;
+    }
+    case Instruction::Type::JumpFalse: {
+        auto& op = static_cast<Op::JumpFalse const&>(instruction);
+        compile_jump_if_truthy(op.condition(), label_for_next_instruction(op), label_for(op.target()));
+        break;
+    }
+    case Instruction::Type::JumpNullish: {
+        auto& op = static_cast<Op::JumpNullish const&>(instruction);
+        load(Reg::RAX, op.condition());
+        m_assembler.mov(SCRATCH, Reg::RAX);
+        m_assembler.shift_right(SCRATCH, GC::TAG_SHIFT);
+        m_assembler.bitwise_and32(SCRATCH, IS_NULLISH_EXTRACT_PATTERN);
+        m_assembler.cmp32(SCRATCH, IS_NULLISH_PATTERN);
+        m_assembler.jump_if(Condition::EqualTo, label_for(op.true_target()));
+        m_assembler.jump(label_for(op.false_target()));
+        break;
+    }
+    case Instruction::Type::JumpUndefined: {
+        auto& op = static_cast<Op::JumpUndefined const&>(instruction);
+        load(Reg::RAX, op.condition());
+        m_assembler.mov(SCRATCH, Reg::RAX);
+        m_assembler.shift_right(SCRATCH, GC::TAG_SHIFT);
+        m_assembler.cmp32(SCRATCH, UNDEFINED_TAG);
+        m_assembler.jump_if(Condition::EqualTo, label_for(op.true_target()));
+        m_assembler.jump(label_for(op.false_target()));
+        break;
+    }
+    case Instruction::Type::JumpLessThan:
+        compile_jump_comparison<Op::JumpLessThan, Condition::SignedLessThan>(instruction);
+        break;
+    case Instruction::Type::JumpLessThanEquals:
+        compile_jump_comparison<Op::JumpLessThanEquals, Condition::SignedLessThanOrEqualTo>(instruction);
+        break;
+    case Instruction::Type::JumpGreaterThan:
+        compile_jump_comparison<Op::JumpGreaterThan, Condition::SignedGreaterThan>(instruction);
+        break;
+    case Instruction::Type::JumpGreaterThanEquals:
+        compile_jump_comparison<Op::JumpGreaterThanEquals, Condition::SignedGreaterThanOrEqualTo>(instruction);
+        break;
+    case Instruction::Type::JumpLooselyEquals:
+        compile_jump_comparison<Op::JumpLooselyEquals, Condition::EqualTo>(instruction);
+        break;
+    case Instruction::Type::JumpLooselyInequals:
+        compile_jump_comparison<Op::JumpLooselyInequals, Condition::NotEqualTo>(instruction);
+        break;
+    case Instruction::Type::JumpStrictlyEquals:
+        compile_jump_comparison<Op::JumpStrictlyEquals, Condition::EqualTo>(instruction);
+        break;
+    case Instruction::Type::JumpStrictlyInequals:
+        compile_jump_comparison<Op::JumpStrictlyInequals, Condition::NotEqualTo>(instruction);
+        break;
+    case Instruction::Type::EnterUnwindContext: {
+        auto& op = static_cast<Op::EnterUnwindContext const&>(instruction);
+        call_helper(reinterpret_cast<FlatPtr>(&enter_unwind_context), instruction);
+        m_assembler.jump(label_for(op.entry_point()));
+        break;
+    }
+    case Instruction::Type::ContinuePendingUnwind:
+        call_helper(reinterpret_cast<FlatPtr>(&continue_pending_unwind), instruction);
+        m_assembler.jump(m_exit_label);
+        break;
+    case Instruction::Type::ScheduleJump:
+        call_helper(reinterpret_cast<FlatPtr>(&schedule_jump), instruction);
+        m_assembler.jump(m_exit_label);
+        break;
+    case Instruction::Type::Await:
+        call_helper(reinterpret_cast<FlatPtr>(&execute_instruction<Op::Await>), instruction);
+        m_assembler.mov32(Reg::RAX, to_underlying(NativeResult::ExitFromExecutable));
+        m_assembler.jump(m_exit_label);
+        break;
+    case Instruction::Type::Return:
+        call_helper(reinterpret_cast<FlatPtr>(&execute_instruction<Op::Return>), instruction);
+        m_assembler.mov32(Reg::RAX, to_underlying(NativeResult::ExitFromExecutable));
+        m_assembler.jump(m_exit_label);
+        break;
+    case Instruction::Type::Yield:
+        call_helper(reinterpret_cast<FlatPtr>(&execute_instruction<Op::Yield>), instruction);
+        m_assembler.mov32(Reg::RAX, to_underlying(NativeResult::ExitFromExecutable));
+        m_assembler.jump(m_exit_label);
+        break;
+    case Instruction::Type::Add:
+        compile_int32_arithmetic<Op::Add>(instruction);
+        break;
+    case Instruction::Type::Sub:
+        compile_int32_arithmetic<Op::Sub>(instruction);
+        break;
+    case Instruction::Type::LessThan:
+        compile_int32_comparison<Op::LessThan, Condition::SignedLessThan>(instruction);
+        break;
+    case Instruction::Type::LessThanEquals:
+        compile_int32_comparison<Op::LessThanEquals, Condition::SignedLessThanOrEqualTo>(instruction);
+        break;
+    case Instruction::Type::GreaterThan:
+        compile_int32_comparison<Op::GreaterThan, Condition::SignedGreaterThan>(instruction);
+        break;
+    case Instruction::Type::GreaterThanEquals:
+        compile_int32_comparison<Op::GreaterThanEquals, Condition::SignedGreaterThanOrEqualTo>(instruction);
+        break;
+    case Instruction::Type::GetById:
+        compile_get_by_id(static_cast<Op::GetById const&>(instruction));
+        break;
+
+#define COMPILE_WITH_HELPER(name)                     \
+    case Instruction::Type::name:                     \
+        compile_with_helper<Op::name>(instruction);   \
+        break;
+
+        COMPILE_WITH_HELPER(AddPrivateName)
+        COMPILE_WITH_HELPER(ArrayAppend)
+        COMPILE_WITH_HELPER(AsyncIteratorClose)
+        COMPILE_WITH_HELPER(BitwiseAnd)
+        COMPILE_WITH_HELPER(BitwiseNot)
+        COMPILE_WITH_HELPER(BitwiseOr)
+        COMPILE_WITH_HELPER(BitwiseXor)
+        COMPILE_WITH_HELPER(BlockDeclarationInstantiation)
+        COMPILE_WITH_HELPER(CacheObjectShape)
+        COMPILE_WITH_HELPER(Call)
+        COMPILE_WITH_HELPER(CallBuiltin)
+        COMPILE_WITH_HELPER(CallConstruct)
+        COMPILE_WITH_HELPER(CallDirectEval)
+        COMPILE_WITH_HELPER(CallWithArgumentArray)
+        COMPILE_WITH_HELPER(Catch)
+        COMPILE_WITH_HELPER(ConcatString)
+        COMPILE_WITH_HELPER(CopyObjectExcludingProperties)
+        COMPILE_WITH_HELPER(CreateLexicalEnvironment)
+        COMPILE_WITH_HELPER(CreateVariableEnvironment)
+        COMPILE_WITH_HELPER(CreatePrivateEnvironment)
+        COMPILE_WITH_HELPER(CreateVariable)
+        COMPILE_WITH_HELPER(CreateRestParams)
+        COMPILE_WITH_HELPER(CreateArguments)
+        COMPILE_WITH_HELPER(Decrement)
+        COMPILE_WITH_HELPER(DeleteById)
+        COMPILE_WITH_HELPER(DeleteByIdWithThis)
+        COMPILE_WITH_HELPER(DeleteByValue)
+        COMPILE_WITH_HELPER(DeleteByValueWithThis)
+        COMPILE_WITH_HELPER(DeleteVariable)
+        COMPILE_WITH_HELPER(Div)
+        COMPILE_WITH_HELPER(Dump)
+        COMPILE_WITH_HELPER(EnterObjectEnvironment)
+        COMPILE_WITH_HELPER(Exp)
+        COMPILE_WITH_HELPER(GetByIdWithThis)
+        COMPILE_WITH_HELPER(GetByValue)
+        COMPILE_WITH_HELPER(GetByValueWithThis)
+        COMPILE_WITH_HELPER(GetCalleeAndThisFromEnvironment)
+        COMPILE_WITH_HELPER(GetGlobal)
+        COMPILE_WITH_HELPER(GetImportMeta)
+        COMPILE_WITH_HELPER(GetIterator)
+        COMPILE_WITH_HELPER(GetLength)
+        COMPILE_WITH_HELPER(GetLengthWithThis)
+        COMPILE_WITH_HELPER(GetMethod)
+        COMPILE_WITH_HELPER(GetNewTarget)
+        COMPILE_WITH_HELPER(GetNextMethodFromIteratorRecord)
+        COMPILE_WITH_HELPER(GetObjectFromIteratorRecord)
+        COMPILE_WITH_HELPER(GetObjectPropertyIterator)
+        COMPILE_WITH_HELPER(GetPrivateById)
+        COMPILE_WITH_HELPER(GetBinding)
+        COMPILE_WITH_HELPER(HasPrivateId)
+        COMPILE_WITH_HELPER(ImportCall)
+        COMPILE_WITH_HELPER(In)
+        COMPILE_WITH_HELPER(Increment)
+        COMPILE_WITH_HELPER(InitializeLexicalBinding)
+        COMPILE_WITH_HELPER(InitializeVariableBinding)
+        COMPILE_WITH_HELPER(InstanceOf)
+        COMPILE_WITH_HELPER(IteratorClose)
+        COMPILE_WITH_HELPER(IteratorNext)
+        COMPILE_WITH_HELPER(IteratorToArray)
+        COMPILE_WITH_HELPER(LeaveFinally)
+        COMPILE_WITH_HELPER(LeaveLexicalEnvironment)
+        COMPILE_WITH_HELPER(LeavePrivateEnvironment)
+        COMPILE_WITH_HELPER(LeaveUnwindContext)
+        COMPILE_WITH_HELPER(LeftShift)
+        COMPILE_WITH_HELPER(LooselyEquals)
+        COMPILE_WITH_HELPER(LooselyInequals)
+        COMPILE_WITH_HELPER(Mod)
+        COMPILE_WITH_HELPER(Mul)
+        COMPILE_WITH_HELPER(NewArray)
+        COMPILE_WITH_HELPER(NewClass)
+        COMPILE_WITH_HELPER(NewFunction)
+        COMPILE_WITH_HELPER(NewObject)
+        COMPILE_WITH_HELPER(NewPrimitiveArray)
+        COMPILE_WITH_HELPER(NewRegExp)
+        COMPILE_WITH_HELPER(NewTypeError)
+        COMPILE_WITH_HELPER(Not)
+        COMPILE_WITH_HELPER(PrepareYield)
+        COMPILE_WITH_HELPER(PostfixDecrement)
+        COMPILE_WITH_HELPER(PostfixIncrement)
+        COMPILE_WITH_HELPER(PutById)
+        COMPILE_WITH_HELPER(PutByIdWithThis)
+        COMPILE_WITH_HELPER(PutBySpread)
+        COMPILE_WITH_HELPER(PutByValue)
+        COMPILE_WITH_HELPER(PutByValueWithThis)
+        COMPILE_WITH_HELPER(PutPrivateById)
+        COMPILE_WITH_HELPER(ResolveSuperBase)
+        COMPILE_WITH_HELPER(ResolveThisBinding)
+        COMPILE_WITH_HELPER(RestoreScheduledJump)
+        COMPILE_WITH_HELPER(RightShift)
+        COMPILE_WITH_HELPER(SetGlobal)
+        COMPILE_WITH_HELPER(SetLexicalBinding)
+        COMPILE_WITH_HELPER(SetVariableBinding)
+        COMPILE_WITH_HELPER(StrictlyEquals)
+        COMPILE_WITH_HELPER(StrictlyInequals)
+        COMPILE_WITH_HELPER(SuperCallWithArgumentArray)
+        COMPILE_WITH_HELPER(Throw)
+        COMPILE_WITH_HELPER(ThrowIfNotObject)
+        COMPILE_WITH_HELPER(ThrowIfNullish)
+        COMPILE_WITH_HELPER(ThrowIfTDZ)
+        COMPILE_WITH_HELPER(Typeof)
+        COMPILE_WITH_HELPER(TypeofBinding)
+        COMPILE_WITH_HELPER(UnaryMinus)
+        COMPILE_WITH_HELPER(UnaryPlus)
+        COMPILE_WITH_HELPER(UnsignedRightShift)
+#undef COMPILE_WITH_HELPER
+    }
+}
+
+template<typename OpType>
+void Compiler::compile_with_helper(Bytecode::Instruction const& instruction)
+{
+    call_helper(reinterpret_cast<FlatPtr>(&execute_instruction<OpType>), instruction);
+    exit_unless_helper_continued();
+}
+
+// Loads lhs into rax and rhs into rcx, going to `slow_case` unless both are Int32.
+void Compiler::load_int32_operands(Bytecode::Operand lhs, Bytecode::Operand rhs, Assembler::Label& slow_case)
+{
+    load(Reg::RAX, lhs);
+    load(Reg::RCX, rhs);
+    jump_if_tag_is_not(Reg::RAX, INT32_TAG, slow_case);
+    jump_if_tag_is_not(Reg::RCX, INT32_TAG, slow_case);
+}
+
+template<typename OpType>
+void Compiler::compile_int32_arithmetic(Bytecode::Instruction const& instruction)
+{
+    auto& op = static_cast<OpType const&>(instruction);
+    Assembler::Label slow_case;
+    Assembler::Label done;
+
+    load_int32_operands(op.lhs(), op.rhs(), slow_case);
+    m_assembler.mov32(Reg::RDX, Reg::RAX);
+    if constexpr (IsSame<OpType, Bytecode::Op::Add>)
+        m_assembler.add32(Reg::RDX, Reg::RCX);
+    else if constexpr (IsSame<OpType, Bytecode::Op::Sub>)
+        m_assembler.sub32(Reg::RDX, Reg::RCX);
+    else
+        static_assert(DependentFalse<OpType>);
+    m_assembler.jump_if(Condition::Overflow, slow_case);
+    m_assembler.mov(Reg::RAX, SHIFTED_INT32_TAG);
+    m_assembler.bitwise_or(Reg::RAX, Reg::RDX);
+    store(op.dst(), Reg::RAX);
+    m_assembler.jump(done);
+
+    m_assembler.bind(slow_case);
+    compile_with_helper<OpType>(instruction);
+    m_assembler.bind(done);
+}
+
+template<typename OpType, Assembler::Condition condition>
+void Compiler::compile_int32_comparison(Bytecode::Instruction const& instruction)
+{
+    auto& op = static_cast<OpType const&>(instruction);
+    Assembler::Label slow_case;
+    Assembler::Label done;
+
+    load_int32_operands(op.lhs(), op.rhs(), slow_case);
+    m_assembler.cmp32(Reg::RAX, Reg::RCX);
+    m_assembler.set(condition, Reg::RDX);
+    m_assembler.movzx8(Reg::RDX, Reg::RDX);
+    m_assembler.mov(Reg::RAX, SHIFTED_BOOLEAN_TAG);
+    m_assembler.bitwise_or(Reg::RAX, Reg::RDX);
+    store(op.dst(), Reg::RAX);
+    m_assembler.jump(done);
+
+    m_assembler.bind(slow_case);
+    compile_with_helper<OpType>(instruction);
+    m_assembler.bind(done);
+}
+
+template<typename OpType, Assembler::Condition condition>
+void Compiler::compile_jump_comparison(Bytecode::Instruction const& instruction)
+{
+    auto& op = static_cast<OpType const&>(instruction);
+    Assembler::Label slow_case;
+
+    load_int32_operands(op.lhs(), op.rhs(), slow_case);
+    m_assembler.cmp32(Reg::RAX, Reg::RCX);
+    m_assembler.jump_if(condition, label_for(op.true_target()));
+    m_assembler.jump(label_for(op.false_target()));
+
+    m_assembler.bind(slow_case);
+    call_helper(reinterpret_cast<FlatPtr>(&evaluate_jump_condition<OpType>), instruction);
+    m_assembler.cmp32(Reg::RAX, to_underlying(NativeResult::ExitFromExecutable));
+    m_assembler.jump_if(Condition::UnsignedGreaterThanOrEqualTo, m_exit_label);
+    m_assembler.test(Reg::RAX, Reg::RAX);
+    m_assembler.jump_if(Condition::NotEqualTo, label_for(op.true_target()));
+    m_assembler.jump(label_for(op.false_target()));
+}
+
+void Compiler::compile_get_by_id(Bytecode::Op::GetById const& op)
+{
+    Assembler::Label slow_case;
+    Assembler::Label done;
+
+    // OPTIMIZATION: If the base is an object with the shape we saw last time, we can load the property straight
+    //               from the property storage of the object that held it last time: either the base itself, or
+    //               a prototype, as long as nothing along the prototype chain has changed since.
+    load(Reg::RAX, op.base());
+    jump_if_tag_is_not(Reg::RAX, OBJECT_TAG, slow_case);
+    // Sign-extend the 48-bit pointer payload, like NanBoxedValue::extract_pointer_bits().
+    m_assembler.shift_left(Reg::RAX, 16);
+    m_assembler.arithmetic_shift_right(Reg::RAX, 16);
+
+    m_assembler.mov(Reg::RCX, reinterpret_cast<FlatPtr>(&m_get_by_id_caches[op.cache_index()]));
+    m_assembler.mov(Reg::RDX, Memory { Reg::RAX, static_cast<i32>(Object::shape_offset()) });
+    m_assembler.cmp(Reg::RDX, Memory { Reg::RCX, static_cast<i32>(offsetof(NativeExecutable::GetByIdCache, shape)) });
+    m_assembler.jump_if(Condition::NotEqualTo, slow_case);
+
+    Assembler::Label load_from_holder;
+    m_assembler.mov(Reg::RDX, Memory { Reg::RCX, static_cast<i32>(offsetof(NativeExecutable::GetByIdCache, prototype)) });
+    m_assembler.test(Reg::RDX, Reg::RDX);
+    m_assembler.jump_if(Condition::EqualTo, load_from_holder);
+    m_assembler.mov(Reg::RSI, Memory { Reg::RCX, static_cast<i32>(offsetof(NativeExecutable::GetByIdCache, prototype_chain_validity)) });
+    m_assembler.cmp8(Memory { Reg::RSI, static_cast<i32>(PrototypeChainValidity::valid_offset()) }, 0);
+    m_assembler.jump_if(Condition::EqualTo, slow_case);
+    m_assembler.mov(Reg::RAX, Reg::RDX);
+
+    m_assembler.bind(load_from_holder);
+    m_assembler.mov(Reg::RDX, Memory { Reg::RAX, static_cast<i32>(Object::storage_offset() + Vector<Value>::outline_buffer_offset()) });
+    m_assembler.add(Reg::RDX, Memory { Reg::RCX, static_cast<i32>(offsetof(NativeExecutable::GetByIdCache, property_offset_in_bytes)) });
+    m_assembler.mov(Reg::RDX, Memory { Reg::RDX });
+
+    // Getters are left to the helper.
+    m_assembler.mov(SCRATCH, Reg::RDX);
+    m_assembler.shift_right(SCRATCH, GC::TAG_SHIFT);
+    m_assembler.cmp32(SCRATCH, ACCESSOR_TAG);
+    m_assembler.jump_if(Condition::EqualTo, slow_case);
+
+    store(op.dst(), Reg::RDX);
+    m_assembler.jump(done);
+
+    m_assembler.bind(slow_case);
+    call_helper(reinterpret_cast<FlatPtr>(&get_by_id), op);
+    exit_unless_helper_continued();
+    m_assembler.bind(done);
+}
+
+void Compiler::compile_jump_if_truthy(Bytecode::Operand condition, Assembler::Label& true_label, Assembler::Label& false_label)
+{
+    Assembler::Label not_boolean;
+    Assembler::Label slow_case;
+
+    load(Reg::RAX, condition);
+    m_assembler.mov(SCRATCH, Reg::RAX);
+    m_assembler.shift_right(SCRATCH, GC::TAG_SHIFT);
+
+    m_assembler.cmp32(SCRATCH, BOOLEAN_TAG);
+    m_assembler.jump_if(Condition::NotEqualTo, not_boolean);
+    m_assembler.test32(Reg::RAX, 1);
+    m_assembler.jump_if(Condition::NotEqualTo, true_label);
+    m_assembler.jump(false_label);
+
+    m_assembler.bind(not_boolean);
+    m_assembler.cmp32(SCRATCH, INT32_TAG);
+    m_assembler.jump_if(Condition::NotEqualTo, slow_case);
+    m_assembler.test32(Reg::RAX, 0xffffffff);
+    m_assembler.jump_if(Condition::NotEqualTo, true_label);
+    m_assembler.jump(false_label);
+
+    // to_boolean() can't throw or allocate, so this doesn't need to go through call_helper().
+    m_assembler.bind(slow_case);
+    m_assembler.mov(Reg::RDI, REGISTERS_AND_CONSTANTS_AND_LOCALS);
+    m_assembler.add(Reg::RDI, memory_for(condition).offset);
+    m_assembler.mov(Reg::RAX, reinterpret_cast<FlatPtr>(&to_boolean));
+    m_assembler.call(Reg::RAX);
+    m_assembler.test(Reg::RAX, Reg::RAX);
+    m_assembler.jump_if(Condition::NotEqualTo, true_label);
+    m_assembler.jump(false_label);
+}
+
+Assembler::Label& Compiler::label_for(size_t bytecode_offset)
+{
+    return *m_labels.ensure(bytecode_offset, [] { return make<Assembler::Label>(); });
+}
+
+Assembler::Label& Compiler::label_for_next_instruction(Bytecode::Instruction const& instruction)
+{
+    return label_for(m_current_offset + instruction.length());
+}
+
+Assembler::Memory Compiler::memory_for(Bytecode::Operand operand)
+{
+    return { REGISTERS_AND_CONSTANTS_AND_LOCALS, static_cast<i32>(operand.index() * sizeof(Value)) };
+}
+
+void Compiler::load(Assembler::Reg dst, Bytecode::Operand operand)
+{
+    m_assembler.mov(dst, memory_for(operand));
+}
+
+void Compiler::store(Bytecode::Operand operand, Assembler::Reg src)
+{
+    m_assembler.mov(memory_for(operand), src);
+}
+
+void Compiler::jump_if_tag_is_not(Assembler::Reg value, u64 tag, Assembler::Label& label)
+{
+    m_assembler.mov(SCRATCH, value);
+    m_assembler.shift_right(SCRATCH, GC::TAG_SHIFT);
+    m_assembler.cmp32(SCRATCH, static_cast<u32>(tag));
+    m_assembler.jump_if(Condition::NotEqualTo, label);
+}
+
+// Calls helper(interpreter, instruction, program_counter), with the program counter pointing at the instruction,
+// so that exceptions are handled and source positions are reported like in the interpreter.
+void Compiler::call_helper(FlatPtr helper, Bytecode::Instruction const& instruction)
+{
+    m_assembler.mov(Memory { PROGRAM_COUNTER }, static_cast<i32>(m_current_offset));
+    m_assembler.mov(Reg::RDI, INTERPRETER);
+    m_assembler.mov(Reg::RSI, reinterpret_cast<FlatPtr>(&instruction));
+    m_assembler.mov(Reg::RDX, PROGRAM_COUNTER);
+    m_assembler.mov(Reg::RAX, helper);
+    m_assembler.call(Reg::RAX);
+}
+
+void Compiler::exit_unless_helper_continued()
+{
+    m_assembler.test(Reg::RAX, Reg::RAX);
+    m_assembler.jump_if(Condition::NotEqualTo, m_exit_label);
+}
+
+template<typename OpType>
+u64 Compiler::execute_instruction(Bytecode::Interpreter& interpreter, OpType const& instruction, [[maybe_unused]] size_t& program_counter)
+{
+    if constexpr (IsSame<decltype(instruction.execute_impl(interpreter)), void>) {
+        instruction.execute_impl(interpreter);
+    } else {
+        auto result = instruction.execute_impl(interpreter);
+        if (result.is_error())
+            return handle_exception(interpreter, program_counter, result.error_value());
+    }
+    return to_underlying(NativeResult::Continue);
+}
+
+template<typename OpType>
+u64 Compiler::evaluate_jump_condition(Bytecode::Interpreter& interpreter, OpType const& instruction, size_t& program_counter)
+{
+    auto result = instruction.evaluate_condition(interpreter);
+    if (result.is_error())
+        return handle_exception(interpreter, program_counter, result.error_value());
+    return to_underlying(result.value() ? NativeResult::ConditionTrue : NativeResult::Continue);
+}
+
+u64 Compiler::get_by_id(Bytecode::Interpreter& interpreter, Bytecode::Op::GetById const& instruction, size_t& program_counter)
+{
+    auto base = interpreter.get(instruction.base());
+    auto result = execute_instruction(interpreter, instruction, program_counter);
+
+    // Mirror the interpreter's cache entry for this receiver's shape, so that the inline fast path is taken next time.
+    // The inline path only checks a single shape, so a polymorphic site will keep the most recently seen one.
+    auto& executable = interpreter.current_executable();
+    auto& cache = executable.property_lookup_caches[instruction.cache_index()];
+    auto& jit_cache = executable.native_executable->get_by_id_cache(instruction.cache_index());
+    jit_cache.shape = nullptr;
+    jit_cache.prototype = nullptr;
+    jit_cache.prototype_chain_validity = nullptr;
+    if (base.is_object()) {
+        auto& shape = base.as_object().shape();
+        for (auto const& entry : cache.entries) {
+            if (entry.shape != &shape)
+                continue;
+            if (entry.in_prototype_chain) {
+                if (!entry.prototype || !entry.prototype_chain_validity || !entry.prototype_chain_validity->is_valid())
+                    break;
+                jit_cache.prototype = entry.prototype.ptr();
+                jit_cache.prototype_chain_validity = entry.prototype_chain_validity.ptr();
+            }
+            jit_cache.shape = &shape;
+            jit_cache.property_offset_in_bytes = entry.property_offset.value() * sizeof(Value);
+            break;
+        }
+    }
+
+    return result;
+}
+
+u64 Compiler::enter_unwind_context(Bytecode::Interpreter& interpreter, Bytecode::Op::EnterUnwindContext const&, size_t&)
+{
+    interpreter.enter_unwind_context();
+    return to_underlying(NativeResult::Continue);
+}
+
+u64 Compiler::continue_pending_unwind(Bytecode::Interpreter& interpreter, Bytecode::Op::ContinuePendingUnwind const& instruction, size_t& program_counter)
+{
+    if (interpreter.continue_pending_unwind(program_counter, instruction.resume_target()) == Bytecode::Interpreter::HandleExceptionResponse::ExitFromExecutable)
+        return to_underlying(NativeResult::ExitFromExecutable);
+    return to_underlying(NativeResult::ResumeAtProgramCounter);
+}
+
+u64 Compiler::schedule_jump(Bytecode::Interpreter& interpreter, Bytecode::Op::ScheduleJump const& instruction, size_t& program_counter)
+{
+    interpreter.schedule_jump(program_counter, instruction.target());
+    return to_underlying(NativeResult::ResumeAtProgramCounter);
+}
+
+u64 Compiler::to_boolean(Value const* value)
+{
+    return value->to_boolean();
+}
+
+u64 Compiler::handle_exception(Bytecode::Interpreter& interpreter, size_t& program_counter, Value exception)
+{
+    if (interpreter.handle_exception(program_counter, exception) == Bytecode::Interpreter::HandleExceptionResponse::ExitFromExecutable)
+        return to_underlying(NativeResult::ExitFromExecutable);
+    return to_underlying(NativeResult::ResumeAtProgramCounter);
+}
+
+}
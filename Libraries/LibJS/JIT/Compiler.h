@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/OwnPtr.h>
+#include <AK/Vector.h>
+#include <LibJS/Bytecode/Executable.h>
+#include <LibJS/Bytecode/Label.h>
+#include <LibJS/Bytecode/Operand.h>
+#include <LibJIT/Assembler.h>
+#include <LibJS/Forward.h>
+#include <LibJS/JIT/NativeExecutable.h>
+
+namespace JS::Bytecode::Op {
+class ContinuePendingUnwind;
+class EnterUnwindContext;
+class GetById;
+class ScheduleJump;
+}
+
+namespace JS::JIT {
+
+using ::JIT::Assembler;
+
+extern bool g_jit_enabled;
+
+// Executables are compiled to native code once they have been entered this many times.
+// A threshold of 0 compiles every executable before it runs for the first time.
+static constexpr u32 default_compilation_threshold = 16;
+extern u32 g_compilation_threshold;
+
+// A baseline compiler that translates bytecode into x86-64 code, one instruction at a time.
+//
+// Control flow, register moves and the common Int32 cases of arithmetic and comparisons are emitted inline,
+// as is a shape check for GetById. Everything else calls out to the instruction's execute_impl(), so the
+// native code always behaves exactly like the interpreter, just without the dispatch overhead.
+class Compiler {
+public:
+    // Returns null if this platform has no JIT, or if the executable uses something the compiler can't handle.
+    static OwnPtr<NativeExecutable> compile(Bytecode::Executable&);
+
+private:
+    explicit Compiler(Bytecode::Executable&);
+
+    OwnPtr<NativeExecutable> compile_executable();
+    void compile_instruction(Bytecode::Instruction const&);
+
+    template<typename OpType>
+    void compile_with_helper(Bytecode::Instruction const&);
+    template<typename OpType>
+    void compile_int32_arithmetic(Bytecode::Instruction const&);
+    template<typename OpType, Assembler::Condition>
+    void compile_int32_comparison(Bytecode::Instruction const&);
+    template<typename OpType, Assembler::Condition>
+    void compile_jump_comparison(Bytecode::Instruction const&);
+    void compile_get_by_id(Bytecode::Op::GetById const&);
+    void compile_jump_if_truthy(Bytecode::Operand condition, Assembler::Label& true_label, Assembler::Label& false_label);
+
+    Assembler::Label& label_for(size_t bytecode_offset);
+    Assembler::Label& label_for(Bytecode::Label label) { return label_for(label.address()); }
+    Assembler::Label& label_for_next_instruction(Bytecode::Instruction const&);
+
+    static Assembler::Memory memory_for(Bytecode::Operand);
+    void load(Assembler::Reg, Bytecode::Operand);
+    void store(Bytecode::Operand, Assembler::Reg);
+    void load_int32_operands(Bytecode::Operand lhs, Bytecode::Operand rhs, Assembler::Label& slow_case);
+    void jump_if_tag_is_not(Assembler::Reg value, u64 tag, Assembler::Label&);
+    void call_helper(FlatPtr helper, Bytecode::Instruction const&);
+    void exit_unless_helper_continued();
+
+    template<typename OpType>
+    static u64 execute_instruction(Bytecode::Interpreter&, OpType const&, size_t& program_counter);
+    template<typename OpType>
+    static u64 evaluate_jump_condition(Bytecode::Interpreter&, OpType const&, size_t& program_counter);
+    static u64 get_by_id(Bytecode::Interpreter&, Bytecode::Op::GetById const&, size_t& program_counter);
+    static u64 enter_unwind_context(Bytecode::Interpreter&, Bytecode::Op::EnterUnwindContext const&, size_t& program_counter);
+    static u64 continue_pending_unwind(Bytecode::Interpreter&, Bytecode::Op::ContinuePendingUnwind const&, size_t& program_counter);
+    static u64 schedule_jump(Bytecode::Interpreter&, Bytecode::Op::ScheduleJump const&, size_t& program_counter);
+    static u64 to_boolean(Value const*);
+    static u64 handle_exception(Bytecode::Interpreter&, size_t& program_counter, Value exception);
+
+    Bytecode::Executable& m_bytecode_executable;
+    Vector<u8> m_output;
+    Assembler m_assembler;
+    Assembler::Label m_exit_label;
+    HashMap<size_t, NonnullOwnPtr<Assembler::Label>> m_labels;
+    Vector<NativeExecutable::GetByIdCache> m_get_by_id_caches;
+    size_t m_current_offset { 0 };
+};
+
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/JIT/NativeExecutable.h>
+#include <LibJS/Runtime/Shape.h>
+#include <sys/mman.h>
+
+namespace JS::JIT {
+
+NativeExecutable::NativeExecutable(void* code, size_t size, HashMap<size_t, size_t> native_offsets, Vector<GetByIdCache> get_by_id_caches)
+    : m_code(code)
+    , m_size(size)
+    , m_native_offsets(move(native_offsets))
+    , m_get_by_id_caches(move(get_by_id_caches))
+{
+}
+
+NativeExecutable::~NativeExecutable()
+{
+    if (munmap(m_code, m_size) < 0) {
+        dbgln("JIT: munmap failed: {}", AK::Error::from_errno(errno));
+        VERIFY_NOT_REACHED();
+    }
+}
+
+void NativeExecutable::run(Bytecode::Interpreter& interpreter, size_t& program_counter) const
+{
+    auto& running_execution_context = interpreter.running_execution_context();
+    auto entry_function = reinterpret_cast<EntryFunction>(m_code);
+
+    for (;;) {
+        auto native_offset = m_native_offsets.get(program_counter);
+        VERIFY(native_offset.has_value());
+        auto result = static_cast<NativeResult>(entry_function(
+            &interpreter,
+            running_execution_context.registers_and_constants_and_locals.data(),
+            running_execution_context.arguments.data(),
+            &program_counter,
+            static_cast<u8 const*>(m_code) + native_offset.value()));
+        if (result == NativeResult::ExitFromExecutable)
+            return;
+        VERIFY(result == NativeResult::ResumeAtProgramCounter);
+    }
+}
+
+void NativeExecutable::visit_edges(GC::Cell::Visitor& visitor)
+{
+    for (auto& cache : m_get_by_id_caches) {
+        visitor.visit(cache.shape);
+        visitor.visit(cache.prototype);
+        visitor.visit(cache.prototype_chain_validity);
+    }
+}
+
+}
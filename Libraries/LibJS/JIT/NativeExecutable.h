@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/Noncopyable.h>
+#include <AK/Vector.h>
+#include <LibGC/Cell.h>
+#include <LibGC/Ptr.h>
+#include <LibJS/Forward.h>
+
+namespace JS::JIT {
+
+// What native code (and the helpers it calls) reports back to its caller.
+enum class NativeResult : u64 {
+    // Carry on with the next instruction.
+    Continue = 0,
+    // Only returned by the helpers of conditional jumps; Continue then means that the condition was false.
+    ConditionTrue = 1,
+    // The executable has finished running (returned, threw, yielded or awaited).
+    ExitFromExecutable = 2,
+    // Execution continues at the program counter, which the helper has changed, e.g. to jump to an exception handler.
+    ResumeAtProgramCounter = 3,
+};
+
+// The native code generated for a Bytecode::Executable by the JIT compiler.
+class NativeExecutable {
+    AK_MAKE_NONCOPYABLE(NativeExecutable);
+    AK_MAKE_NONMOVABLE(NativeExecutable);
+
+public:
+    // A cache for the inline fast path of GetById, mirroring the PropertyLookupCache entry of the same index for
+    // the most recently seen shape. Unlike the PropertyLookupCache, this keeps its cells alive, as the native code
+    // compares shapes by address.
+    struct GetByIdCache {
+        GC::Ptr<Shape> shape;
+        u64 property_offset_in_bytes { 0 };
+        // Null if the property is an own property of the receiver.
+        GC::Ptr<Object> prototype;
+        GC::Ptr<PrototypeChainValidity> prototype_chain_validity;
+    };
+
+    using EntryFunction = u64 (*)(Bytecode::Interpreter*, Value* registers_and_constants_and_locals, Value* arguments, size_t* program_counter, void const* entry_point);
+
+    NativeExecutable(void* code, size_t size, HashMap<size_t, size_t> native_offsets, Vector<GetByIdCache> get_by_id_caches);
+    ~NativeExecutable();
+
+    // Runs the native code from the given program counter until the executable is exited.
+    void run(Bytecode::Interpreter&, size_t& program_counter) const;
+
+    GetByIdCache& get_by_id_cache(u32 index) { return m_get_by_id_caches[index]; }
+
+    void visit_edges(GC::Cell::Visitor&);
+
+private:
+    void* m_code { nullptr };
+    size_t m_size { 0 };
+    HashMap<size_t, size_t> m_native_offsets;
+    Vector<GetByIdCache> m_get_by_id_caches;
+};
+
+}
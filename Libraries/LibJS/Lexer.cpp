@@ -223,7 +223,13 @@ static consteval Array<TokenType, 256> make_single_char_tokens_array()
 static constexpr auto s_single_char_tokens = make_single_char_tokens_array();
 
 Lexer::Lexer(StringView source, StringView filename, size_t line_number, size_t line_column)
-    : m_source(source)
+    : Lexer(ByteString { source }, 0, filename, line_number, line_column)
+{
+}
+
+Lexer::Lexer(ByteString source, size_t source_offset, StringView filename, size_t line_number, size_t line_column)
+    : m_source(move(source))
+    , m_source_offset(source_offset)
     , m_current_token(TokenType::Eof, {}, {}, {}, 0, 0, 0)
     , m_filename(String::from_utf8(filename).release_value_but_fixme_should_propagate_errors())
     , m_line_number(line_number)
@@ -963,7 +969,7 @@ Token Lexer::next()
             m_source.substring_view(value_start + 1, min(4u, m_source.length() - value_start - 2)),
             m_line_number,
             m_line_column - 1,
-            value_start + 1);
+            m_source_offset + value_start + 1);
         m_hit_invalid_unicode.clear();
         // Do not produce any further tokens.
         VERIFY(is_eof());
@@ -975,7 +981,7 @@ Token Lexer::next()
             m_source.substring_view(value_start - 1, m_position - value_start),
             value_start_line_number,
             value_start_column_number,
-            value_start - 1);
+            m_source_offset + value_start - 1);
     }
 
     if (identifier.has_value())
@@ -1018,7 +1024,7 @@ Token Lexer::force_slash_as_regex()
         m_source.substring_view(value_start - 1, m_position - value_start),
         m_current_token.line_number(),
         m_current_token.line_column(),
-        value_start - 1);
+        m_source_offset + value_start - 1);
 
     if constexpr (LEXER_DEBUG) {
         dbgln("------------------------------");
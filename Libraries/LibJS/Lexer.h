@@ -18,10 +18,14 @@ namespace JS {
 class Lexer {
 public:
     explicit Lexer(StringView source, StringView filename = "(unknown)"sv, size_t line_number = 1, size_t line_column = 0);
+    // Lexes a part of a larger source, which starts at the given offset into it. The offsets of tokens are relative to the larger source.
+    Lexer(ByteString source, size_t source_offset, StringView filename, size_t line_number, size_t line_column);
 
     Token next();
 
     ByteString const& source() const { return m_source; }
+    size_t source_offset() const { return m_source_offset; }
+    StringView source_view(size_t offset, size_t length) const { return m_source.substring_view(offset - m_source_offset, length); }
     String const& filename() const { return m_filename; }
 
     void disallow_html_comments() { m_allow_html_comments = false; }
@@ -59,6 +63,7 @@ private:
     TokenType consume_regex_literal();
 
     ByteString m_source;
+    size_t m_source_offset { 0 };
     size_t m_position { 0 };
     Token m_current_token;
     char m_current_char { 0 };
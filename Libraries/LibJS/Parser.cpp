@@ -384,6 +384,9 @@ public:
                 if (m_contains_direct_call_to_eval)
                     identifier_group.used_inside_scope_with_eval = true;
 
+                if (m_free_identifiers_sink)
+                    m_free_identifiers_sink->extend(identifier_group.identifiers);
+
                 if (m_parent_scope) {
                     if (auto maybe_parent_scope_identifier_group = m_parent_scope->m_identifier_groups.get(identifier_group_name); maybe_parent_scope_identifier_group.has_value()) {
                         maybe_parent_scope_identifier_group.value().identifiers.extend(identifier_group.identifiers);
@@ -477,6 +480,12 @@ public:
         m_is_arrow_function = true;
     }
 
+    // Collects the identifiers that aren't declared in this scope, when it goes away.
+    void set_free_identifiers_sink(Vector<NonnullRefPtr<Identifier>>& sink)
+    {
+        m_free_identifiers_sink = &sink;
+    }
+
 private:
     void throw_identifier_declared(DeprecatedFlyString const& name, NonnullRefPtr<Declaration const> const& declaration)
     {
@@ -513,6 +522,7 @@ private:
     HashMap<DeprecatedFlyString, IdentifierGroup> m_identifier_groups;
 
     Optional<Vector<FunctionParameter>> m_function_parameters;
+    Vector<NonnullRefPtr<Identifier>>* m_free_identifiers_sink { nullptr };
 
     bool m_contains_access_to_arguments_object { false };
     bool m_contains_direct_call_to_eval { false };
@@ -661,6 +671,16 @@ Parser::ParserState::ParserState(Lexer l, Program::Type program_type)
     current_token = lexer.next();
 }
 
+bool Parser::s_lazy_parsing_enabled = false;
+Parser::LazyParsingStatistics Parser::s_lazy_parsing_statistics;
+
+Parser::Parser(Lexer lexer, NonnullRefPtr<SourceCode const> source_code, Program::Type program_type)
+    : m_source_code(move(source_code))
+    , m_state(move(lexer), program_type)
+    , m_program_type(program_type)
+{
+}
+
 Parser::Parser(Lexer lexer, Program::Type program_type, Optional<EvalInitialState> initial_state_for_eval)
     : m_source_code(SourceCode::create(lexer.filename(), String::from_byte_string(lexer.source()).release_value_but_fixme_should_propagate_errors()))
     , m_state(move(lexer), program_type)
@@ -1133,7 +1153,7 @@ RefPtr<FunctionExpression const> Parser::try_parse_arrow_function_expression(boo
 
     auto function_start_offset = rule_start.position().offset;
     auto function_end_offset = position().offset - m_state.current_token.trivia().length();
-    auto source_text = ByteString { m_state.lexer.source().substring_view(function_start_offset, function_end_offset - function_start_offset) };
+    auto source_text = ByteString { m_state.lexer.source_view(function_start_offset, function_end_offset - function_start_offset) };
     return create_ast_node<FunctionExpression>(
         { m_source_code, rule_start.position(), position() }, nullptr, move(source_text),
         move(body), move(parameters), function_length, function_kind, body->in_strict_mode(),
@@ -1656,7 +1676,7 @@ NonnullRefPtr<ClassExpression const> Parser::parse_class_expression(bool expect_
 
     auto function_start_offset = rule_start.position().offset;
     auto function_end_offset = position().offset - m_state.current_token.trivia().length();
-    auto source_text = ByteString { m_state.lexer.source().substring_view(function_start_offset, function_end_offset - function_start_offset) };
+    auto source_text = ByteString { m_state.lexer.source_view(function_start_offset, function_end_offset - function_start_offset) };
 
     return create_ast_node<ClassExpression>({ m_source_code, rule_start.position(), position() }, move(class_name), move(source_text), move(constructor), move(super_class), move(elements));
 }
@@ -2551,7 +2571,7 @@ RefPtr<BindingPattern const> Parser::synthesize_binding_pattern(Expression const
     // This means that `source` will contain the subsequent token's trivia, if any (which is fine).
     auto source_start_offset = expression.source_range().start.offset;
     auto source_end_offset = expression.source_range().end.offset;
-    auto source = m_state.lexer.source().substring_view(source_start_offset, source_end_offset - source_start_offset);
+    auto source = m_state.lexer.source_view(source_start_offset, source_end_offset - source_start_offset);
     Lexer lexer { source, m_state.lexer.filename(), expression.source_range().start.line, expression.source_range().start.column };
     Parser parser { lexer };
 
@@ -2612,184 +2632,1708 @@ NonnullRefPtr<AssignmentExpression const> Parser::parse_assignment_expression(As
         }
     }
 
-    // Note: The web reality is that all but &&=, ||= and ??= do allow left hand side CallExpresions.
-    //       These are the exception as they are newer.
-    auto has_web_reality_assignment_target_exceptions = assignment_op != AssignmentOp::AndAssignment
-        && assignment_op != AssignmentOp::OrAssignment
-        && assignment_op != AssignmentOp::NullishAssignment;
+    // Note: The web reality is that all but &&=, ||= and ??= do allow left hand side CallExpresions.
+    //       These are the exception as they are newer.
+    auto has_web_reality_assignment_target_exceptions = assignment_op != AssignmentOp::AndAssignment
+        && assignment_op != AssignmentOp::OrAssignment
+        && assignment_op != AssignmentOp::NullishAssignment;
+
+    if (!is_simple_assignment_target(*lhs, has_web_reality_assignment_target_exceptions)) {
+        syntax_error("Invalid left-hand side in assignment");
+    } else if (m_state.strict_mode && is<Identifier>(*lhs)) {
+        auto const& name = static_cast<Identifier const&>(*lhs).string();
+        check_identifier_name_for_assignment_validity(name);
+    }
+    auto rhs = parse_expression(min_precedence, associativity, forbidden);
+    return create_ast_node<AssignmentExpression>({ m_source_code, rule_start.position(), position() }, assignment_op, move(lhs), move(rhs));
+}
+
+NonnullRefPtr<Identifier const> Parser::parse_identifier()
+{
+    auto identifier_start = position();
+    auto token = consume_identifier();
+    if (m_state.in_class_field_initializer && token.value() == "arguments"sv)
+        syntax_error("'arguments' is not allowed in class field initializer");
+    return create_identifier_and_register_in_current_scope({ m_source_code, identifier_start, position() }, token.DeprecatedFlyString_value());
+}
+
+Vector<CallExpression::Argument> Parser::parse_arguments()
+{
+    Vector<CallExpression::Argument> arguments;
+
+    consume(TokenType::ParenOpen);
+    while (match_expression() || match(TokenType::TripleDot)) {
+        if (match(TokenType::TripleDot)) {
+            consume();
+            arguments.append({ parse_expression(2), true });
+        } else {
+            arguments.append({ parse_expression(2), false });
+        }
+        if (!match(TokenType::Comma))
+            break;
+        consume();
+    }
+
+    consume(TokenType::ParenClose);
+    return arguments;
+}
+
+NonnullRefPtr<Expression const> Parser::parse_call_expression(NonnullRefPtr<Expression const> lhs)
+{
+    auto rule_start = push_start();
+    if (!m_state.allow_super_constructor_call && is<SuperExpression>(*lhs))
+        syntax_error("'super' keyword unexpected here");
+
+    auto arguments = parse_arguments();
+
+    if (is<SuperExpression>(*lhs))
+        return create_ast_node<SuperCall>({ m_source_code, rule_start.position(), position() }, move(arguments));
+
+    return CallExpression::create({ m_source_code, rule_start.position(), position() }, move(lhs), arguments.span(), InvocationStyleEnum::Parenthesized, InsideParenthesesEnum::NotInsideParentheses);
+}
+
+NonnullRefPtr<NewExpression const> Parser::parse_new_expression()
+{
+    auto rule_start = push_start();
+    consume(TokenType::New);
+
+    auto callee = parse_expression(g_operator_precedence.get(TokenType::New), Associativity::Right, { TokenType::ParenOpen, TokenType::QuestionMarkPeriod });
+    if (is<ImportCall>(*callee))
+        syntax_error("Cannot call new on dynamic import", callee->source_range().start);
+
+    Vector<CallExpression::Argument> arguments;
+
+    auto is_parenthesized = match(TokenType::ParenOpen);
+
+    if (is_parenthesized) {
+        consume();
+        while (match_expression() || match(TokenType::TripleDot)) {
+            if (match(TokenType::TripleDot)) {
+                consume();
+                arguments.append({ parse_expression(2), true });
+            } else {
+                arguments.append({ parse_expression(2), false });
+            }
+            if (!match(TokenType::Comma))
+                break;
+            consume();
+        }
+        consume(TokenType::ParenClose);
+    }
+
+    InvocationStyleEnum invocation_style = is_parenthesized ? InvocationStyleEnum::Parenthesized : InvocationStyleEnum::NotParenthesized;
+
+    return NewExpression::create({ m_source_code, rule_start.position(), position() }, move(callee), move(arguments), invocation_style, InsideParenthesesEnum::NotInsideParentheses);
+}
+
+NonnullRefPtr<YieldExpression const> Parser::parse_yield_expression()
+{
+    auto rule_start = push_start();
+
+    if (m_state.in_formal_parameter_context)
+        syntax_error("'Yield' expression is not allowed in formal parameters of generator function");
+
+    consume(TokenType::Yield);
+    RefPtr<Expression const> argument;
+    bool yield_from = false;
+
+    if (!m_state.current_token.trivia_contains_line_terminator()) {
+        if (match(TokenType::Asterisk)) {
+            consume();
+            yield_from = true;
+        }
+
+        if (yield_from || match_expression() || match(TokenType::Class))
+            argument = parse_expression(2);
+    }
+
+    return create_ast_node<YieldExpression>({ m_source_code, rule_start.position(), position() }, move(argument), yield_from);
+}
+
+NonnullRefPtr<AwaitExpression const> Parser::parse_await_expression()
+{
+    auto rule_start = push_start();
+
+    if (m_state.in_formal_parameter_context)
+        syntax_error("'Await' expression is not allowed in formal parameters of an async function");
+
+    consume(TokenType::Await);
+
+    auto precedence = g_operator_precedence.get(TokenType::Await);
+    auto associativity = operator_associativity(TokenType::Await);
+    auto argument = parse_expression(precedence, associativity);
+
+    m_state.current_scope_pusher->set_contains_await_expression();
+
+    return create_ast_node<AwaitExpression>({ m_source_code, rule_start.position(), position() }, move(argument));
+}
+
+NonnullRefPtr<ReturnStatement const> Parser::parse_return_statement()
+{
+    auto rule_start = push_start();
+    if (!m_state.in_function_context && !m_state.in_arrow_function_context)
+        syntax_error("'return' not allowed outside of a function");
+
+    consume(TokenType::Return);
+
+    // Automatic semicolon insertion: terminate statement when return is followed by newline
+    if (m_state.current_token.trivia_contains_line_terminator())
+        return create_ast_node<ReturnStatement>({ m_source_code, rule_start.position(), position() }, nullptr);
+
+    if (match_expression()) {
+        auto expression = parse_expression(0);
+        consume_or_insert_semicolon();
+        return create_ast_node<ReturnStatement>({ m_source_code, rule_start.position(), position() }, move(expression));
+    }
+
+    consume_or_insert_semicolon();
+    return create_ast_node<ReturnStatement>({ m_source_code, rule_start.position(), position() }, nullptr);
+}
+
+void Parser::parse_statement_list(ScopeNode& output_node, AllowLabelledFunction allow_labelled_functions)
+{
+    while (!done()) {
+        if (match_declaration(AllowUsingDeclaration::Yes)) {
+            auto declaration = parse_declaration();
+            VERIFY(m_state.current_scope_pusher);
+            m_state.current_scope_pusher->add_declaration(declaration);
+            output_node.append(move(declaration));
+        } else if (match_statement()) {
+            output_node.append(parse_statement(allow_labelled_functions));
+        } else {
+            break;
+        }
+    }
+
+    output_node.shrink_to_fit();
+}
+
+// Skips over the statements of a function body without building an AST for them. It checks them for syntax errors,
+// and finds the names that the body uses without declaring them, which is all the scope analysis of the code around
+// the function needs to know about it.
+// This only understands the more common parts of the grammar, and gives up on anything else: classes, generators,
+// async functions, destructuring assignments, eval, with, and so on. It also gives up on anything that the parser
+// would report as a syntax error, so the parser can parse the body as usual afterwards and report it.
+class PreParser {
+public:
+    explicit PreParser(Parser& parser)
+        : m_parser(parser)
+        , m_state(parser.m_state)
+    {
+    }
+
+    // Expects the directives of the body to have been parsed already, and stops at its closing curly bracket.
+    ErrorOr<HashTable<DeprecatedFlyString>> skip_function_body(Vector<FunctionParameter> const& parameters);
+
+    // The offsets of the nested function bodies that it was inside of, if it gave up.
+    Vector<size_t> const& open_function_body_offsets() const { return m_open_function_body_offsets; }
+
+private:
+    // What the PreParser needs to know about an expression to check where it's used.
+    struct SkippedExpression {
+        enum class Kind {
+            Identifier,
+            Member,
+            Call,
+            New,
+            ObjectLiteral,
+            ArrayLiteral,
+            Update,
+            Other,
+        };
+
+        Kind kind { Kind::Other };
+        DeprecatedFlyString identifier_name {};
+    };
+
+    struct SkippedPrimaryExpression {
+        SkippedExpression expression;
+        bool should_continue_parsing_as_expression { true };
+    };
+
+    struct SkippedSecondaryExpression {
+        SkippedExpression expression;
+        Parser::ForbiddenTokens forbidden {};
+    };
+
+    enum class ScopeType {
+        Function,
+        ArrowFunction,
+        Block,
+        Catch,
+    };
+
+    // Keeps track of the same names as a ScopePusher does, to find the same redeclarations.
+    struct Scope {
+        ScopeType type;
+        HashTable<DeprecatedFlyString> var_names {};
+        HashTable<DeprecatedFlyString> lexical_names {};
+        HashTable<DeprecatedFlyString> function_names {};
+        HashTable<DeprecatedFlyString> forbidden_lexical_names {};
+        HashTable<DeprecatedFlyString> forbidden_var_names {};
+        HashTable<DeprecatedFlyString> bound_names {};
+        HashTable<DeprecatedFlyString> referenced_names {};
+
+        bool is_top_level() const { return type == ScopeType::Function || type == ScopeType::ArrowFunction; }
+        bool declares(DeprecatedFlyString const&) const;
+    };
+
+    enum class FunctionType {
+        Declaration,
+        Expression,
+        Method,
+        Getter,
+        Setter,
+    };
+
+    struct SkippedVariableDeclaration {
+        TokenType kind;
+        size_t declarator_count { 0 };
+        bool first_declarator_has_initializer { false };
+        bool first_declarator_is_identifier { false };
+        bool all_declarators_have_initializers { true };
+    };
+
+    static AK::Error give_up() { return AK::Error::from_string_literal("Code not supported by the PreParser"); }
+    static bool is_simple_assignment_target(SkippedExpression const&, bool allow_web_reality_call_expression = true);
+
+    ErrorOr<void> check_for_errors() const;
+    bool match(TokenType type) const { return m_parser.match(type); }
+    ErrorOr<Token> consume(TokenType);
+    ErrorOr<DeprecatedFlyString> consume_binding_identifier();
+    ErrorOr<void> consume_or_insert_semicolon();
+
+    void push_scope(ScopeType type) { m_scopes.append({ .type = type }); }
+    void pop_scope();
+    void reference(DeprecatedFlyString const& name) { m_scopes.last().referenced_names.set(name); }
+    ErrorOr<void> declare_lexical(DeprecatedFlyString const&);
+    ErrorOr<void> declare_var(DeprecatedFlyString const&);
+    ErrorOr<void> declare_function(DeprecatedFlyString const&);
+
+    ErrorOr<void> skip_statement_list();
+    ErrorOr<void> skip_declaration();
+    ErrorOr<bool> skip_statement();
+    ErrorOr<bool> skip_labelled_statement();
+    ErrorOr<void> skip_block_statement();
+    ErrorOr<void> skip_return_statement();
+    ErrorOr<SkippedVariableDeclaration> skip_variable_declaration(Parser::IsForLoopVariableDeclaration = Parser::IsForLoopVariableDeclaration::No);
+    ErrorOr<void> skip_binding_pattern(Parser::AllowDuplicates, Vector<DeprecatedFlyString>& bound_names);
+    ErrorOr<void> skip_binding_pattern_entries(Vector<DeprecatedFlyString>& bound_names);
+    ErrorOr<void> skip_if_statement();
+    ErrorOr<void> skip_for_statement();
+    ErrorOr<void> skip_for_in_of_statement(Optional<SkippedVariableDeclaration> const&, SkippedExpression const&);
+    ErrorOr<void> skip_while_statement();
+    ErrorOr<void> skip_do_while_statement();
+    ErrorOr<void> skip_switch_statement();
+    ErrorOr<void> skip_try_statement();
+    ErrorOr<void> skip_catch_clause();
+    ErrorOr<void> skip_throw_statement();
+    ErrorOr<void> skip_break_statement();
+    ErrorOr<void> skip_continue_statement();
+
+    ErrorOr<void> skip_function(FunctionType);
+    ErrorOr<void> skip_formal_parameters(FunctionType, Vector<DeprecatedFlyString>& parameter_names);
+    ErrorOr<void> skip_arrow_function(bool has_parentheses);
+    bool is_arrow_function_ahead() const;
+
+    ErrorOr<SkippedExpression> skip_expression(int min_precedence, Associativity = Associativity::Right, Parser::ForbiddenTokens = {});
+    ErrorOr<SkippedPrimaryExpression> skip_primary_expression();
+    ErrorOr<SkippedExpression> skip_unary_prefixed_expression();
+    ErrorOr<SkippedSecondaryExpression> skip_secondary_expression(SkippedExpression const& lhs, int min_precedence, Associativity, Parser::ForbiddenTokens);
+    ErrorOr<SkippedExpression> skip_assignment_expression(TokenType, SkippedExpression const& lhs, int min_precedence, Associativity, Parser::ForbiddenTokens);
+    ErrorOr<void> skip_arguments();
+    ErrorOr<void> skip_new_expression();
+    ErrorOr<void> skip_optional_chain();
+    ErrorOr<void> skip_object_expression();
+    ErrorOr<Optional<DeprecatedFlyString>> skip_property_key();
+    ErrorOr<void> skip_array_expression();
+    ErrorOr<void> skip_template_literal(bool is_tagged);
+    ErrorOr<void> skip_regexp_literal();
+    ErrorOr<void> check_string_literal(Token const&, Parser::StringLiteralType = Parser::StringLiteralType::Normal);
+
+    Parser& m_parser;
+    Parser::ParserState& m_state;
+    Vector<Scope> m_scopes;
+    Vector<size_t> m_open_function_body_offsets;
+};
+
+bool PreParser::Scope::declares(DeprecatedFlyString const& name) const
+{
+    switch (type) {
+    case ScopeType::Function:
+        if (bound_names.contains(name) || name == "arguments"sv)
+            return true;
+        [[fallthrough]];
+    case ScopeType::ArrowFunction:
+        return var_names.contains(name) || lexical_names.contains(name) || function_names.contains(name) || forbidden_lexical_names.contains(name);
+    case ScopeType::Block:
+        return lexical_names.contains(name) || function_names.contains(name);
+    case ScopeType::Catch:
+        return bound_names.contains(name);
+    }
+    VERIFY_NOT_REACHED();
+}
+
+bool PreParser::is_simple_assignment_target(SkippedExpression const& expression, bool allow_web_reality_call_expression)
+{
+    switch (expression.kind) {
+    case SkippedExpression::Kind::Identifier:
+    case SkippedExpression::Kind::Member:
+        return true;
+    case SkippedExpression::Kind::Call:
+    case SkippedExpression::Kind::New:
+        return allow_web_reality_call_expression;
+    default:
+        return false;
+    }
+}
+
+ErrorOr<void> PreParser::check_for_errors() const
+{
+    if (!m_state.errors.is_empty())
+        return give_up();
+    return {};
+}
+
+ErrorOr<Token> PreParser::consume(TokenType type)
+{
+    if (!match(type))
+        return give_up();
+    auto token = m_parser.consume(type);
+    TRY(check_for_errors());
+    return token;
+}
+
+// Only plain identifiers, as the PreParser doesn't know about the contexts in which await, yield or let are names.
+ErrorOr<DeprecatedFlyString> PreParser::consume_binding_identifier()
+{
+    auto name = TRY(consume(TokenType::Identifier)).DeprecatedFlyString_value();
+    if (name == "eval"sv)
+        return give_up();
+    m_parser.check_identifier_name_for_assignment_validity(name);
+    TRY(check_for_errors());
+    return name;
+}
+
+ErrorOr<void> PreParser::consume_or_insert_semicolon()
+{
+    m_parser.consume_or_insert_semicolon();
+    return check_for_errors();
+}
+
+void PreParser::pop_scope()
+{
+    auto scope = m_scopes.take_last();
+    for (auto const& name : scope.referenced_names) {
+        if (!scope.declares(name))
+            m_scopes.last().referenced_names.set(name);
+    }
+}
+
+ErrorOr<void> PreParser::declare_lexical(DeprecatedFlyString const& name)
+{
+    auto& scope = m_scopes.last();
+    if (scope.var_names.contains(name) || scope.forbidden_lexical_names.contains(name) || scope.function_names.contains(name))
+        return give_up();
+    if (scope.lexical_names.set(name) != AK::HashSetResult::InsertedNewEntry)
+        return give_up();
+    return {};
+}
+
+ErrorOr<void> PreParser::declare_var(DeprecatedFlyString const& name)
+{
+    for (size_t i = m_scopes.size(); i > 0; --i) {
+        auto& scope = m_scopes[i - 1];
+        if (scope.lexical_names.contains(name) || scope.function_names.contains(name) || scope.forbidden_var_names.contains(name))
+            return give_up();
+        scope.var_names.set(name);
+        if (scope.is_top_level())
+            break;
+    }
+    return {};
+}
+
+ErrorOr<void> PreParser::declare_function(DeprecatedFlyString const& name)
+{
+    auto& scope = m_scopes.last();
+    if (scope.is_top_level()) {
+        scope.var_names.set(name);
+        return {};
+    }
+    if (scope.var_names.contains(name) || scope.lexical_names.contains(name))
+        return give_up();
+    if (m_state.strict_mode) {
+        if (scope.function_names.contains(name))
+            return give_up();
+        scope.lexical_names.set(name);
+        return {};
+    }
+    scope.function_names.set(name);
+    return {};
+}
+
+template<typename Callback>
+static void for_each_parameter_name(Vector<FunctionParameter> const& parameters, Callback callback)
+{
+    for (auto const& parameter : parameters) {
+        parameter.binding.visit(
+            [&](Identifier const& identifier) { callback(identifier.string()); },
+            [&](NonnullRefPtr<BindingPattern const> const& binding) {
+                // NOTE: Nothing in the callback throws an exception.
+                MUST(binding->for_each_bound_identifier([&](auto const& identifier) { callback(identifier.string()); }));
+            });
+    }
+}
+
+ErrorOr<HashTable<DeprecatedFlyString>> PreParser::skip_function_body(Vector<FunctionParameter> const& parameters)
+{
+    TRY(check_for_errors());
+
+    push_scope(ScopeType::Function);
+    for_each_parameter_name(parameters, [&](auto const& name) { m_scopes.last().forbidden_lexical_names.set(name); });
+
+    TRY(skip_statement_list());
+    if (!match(TokenType::CurlyClose))
+        return give_up();
+
+    // The parameters, the function's name and `arguments` are left to the function's ScopePusher.
+    auto const& scope = m_scopes.last();
+    HashTable<DeprecatedFlyString> free_names;
+    for (auto const& name : scope.referenced_names) {
+        if (!scope.var_names.contains(name) && !scope.lexical_names.contains(name) && !scope.function_names.contains(name))
+            free_names.set(name);
+    }
+    return free_names;
+}
+
+ErrorOr<void> PreParser::skip_statement_list()
+{
+    while (!m_parser.done()) {
+        if (m_parser.match_declaration(Parser::AllowUsingDeclaration::Yes))
+            TRY(skip_declaration());
+        else if (m_parser.match_statement())
+            TRY(skip_statement());
+        else
+            break;
+    }
+    return {};
+}
+
+ErrorOr<void> PreParser::skip_declaration()
+{
+    switch (m_state.current_token.type()) {
+    case TokenType::Function:
+        return skip_function(FunctionType::Declaration);
+    case TokenType::Let:
+    case TokenType::Const:
+        TRY(skip_variable_declaration());
+        return {};
+    default:
+        // Classes, async functions and using declarations.
+        return give_up();
+    }
+}
+
+// Returns whether the statement is an iteration statement, which is what labels need to know.
+ErrorOr<bool> PreParser::skip_statement()
+{
+    switch (m_state.current_token.type()) {
+    case TokenType::CurlyOpen:
+        TRY(skip_block_statement());
+        return false;
+    case TokenType::Return:
+        TRY(skip_return_statement());
+        return false;
+    case TokenType::Var:
+        TRY(skip_variable_declaration());
+        return false;
+    case TokenType::For:
+        TRY(skip_for_statement());
+        return true;
+    case TokenType::If:
+        TRY(skip_if_statement());
+        return false;
+    case TokenType::Throw:
+        TRY(skip_throw_statement());
+        return false;
+    case TokenType::Try:
+        TRY(skip_try_statement());
+        return false;
+    case TokenType::Break:
+        TRY(skip_break_statement());
+        return false;
+    case TokenType::Continue:
+        TRY(skip_continue_statement());
+        return false;
+    case TokenType::Switch:
+        TRY(skip_switch_statement());
+        return false;
+    case TokenType::Do:
+        TRY(skip_do_while_statement());
+        return true;
+    case TokenType::While:
+        TRY(skip_while_statement());
+        return true;
+    case TokenType::Debugger:
+        m_parser.consume();
+        TRY(consume_or_insert_semicolon());
+        return false;
+    case TokenType::Semicolon:
+        m_parser.consume();
+        return false;
+    case TokenType::Slash:
+    case TokenType::SlashEquals:
+        m_state.current_token = m_state.lexer.force_slash_as_regex();
+        [[fallthrough]];
+    default:
+        if (match(TokenType::Identifier) && m_parser.next_token().type() == TokenType::Colon)
+            return skip_labelled_statement();
+        if (!m_parser.match_expression())
+            return give_up();
+        // Declarations in single-statement contexts are errors, and `let` or `async` might be names or might not.
+        if (match(TokenType::Function) || match(TokenType::Class) || match(TokenType::Let) || match(TokenType::Async))
+            return give_up();
+        TRY(skip_expression(0));
+        TRY(consume_or_insert_semicolon());
+        return false;
+    }
+}
+
+ErrorOr<bool> PreParser::skip_labelled_statement()
+{
+    auto label = TRY(consume(TokenType::Identifier)).value();
+    m_parser.consume(TokenType::Colon);
+
+    if (!m_parser.match_statement() || match(TokenType::Function) || m_state.labels_in_scope.contains(label))
+        return give_up();
+
+    m_state.labels_in_scope.set(label, {});
+    auto is_iteration_statement = TRY(skip_statement());
+    if (!is_iteration_statement && m_state.labels_in_scope.get(label)->has_value())
+        return give_up();
+    m_state.labels_in_scope.remove(label);
+    return is_iteration_statement;
+}
+
+ErrorOr<void> PreParser::skip_block_statement()
+{
+    push_scope(ScopeType::Block);
+    TRY(consume(TokenType::CurlyOpen));
+    TRY(skip_statement_list());
+    TRY(consume(TokenType::CurlyClose));
+    pop_scope();
+    return {};
+}
+
+ErrorOr<void> PreParser::skip_return_statement()
+{
+    m_parser.consume(TokenType::Return);
+    if (m_state.current_token.trivia_contains_line_terminator())
+        return {};
+    if (m_parser.match_expression())
+        TRY(skip_expression(0));
+    return consume_or_insert_semicolon();
+}
+
+ErrorOr<PreParser::SkippedVariableDeclaration> PreParser::skip_variable_declaration(Parser::IsForLoopVariableDeclaration is_for_loop_variable_declaration)
+{
+    auto is_for_loop = is_for_loop_variable_declaration == Parser::IsForLoopVariableDeclaration::Yes;
+    SkippedVariableDeclaration declaration { .kind = m_parser.consume().type() };
+    auto is_var = declaration.kind == TokenType::Var;
+
+    Vector<DeprecatedFlyString> bound_names;
+    for (;;) {
+        bool is_pattern = match(TokenType::CurlyOpen) || match(TokenType::BracketOpen);
+        if (is_pattern) {
+            auto first_bound_name = bound_names.size();
+            TRY(skip_binding_pattern(is_var ? Parser::AllowDuplicates::Yes : Parser::AllowDuplicates::No, bound_names));
+            if (!is_var && bound_names.span().slice(first_bound_name).contains_slow("let"sv))
+                return give_up();
+        } else {
+            bound_names.append(TRY(consume_binding_identifier()));
+        }
+
+        bool has_initializer = match(TokenType::Equals);
+        if (has_initializer) {
+            m_parser.consume();
+            if (is_for_loop)
+                TRY(skip_expression(2, Associativity::Right, { TokenType::In }));
+            else
+                TRY(skip_expression(2));
+        } else if (!is_for_loop && (declaration.kind == TokenType::Const || is_pattern)) {
+            return give_up();
+        }
+
+        if (declaration.declarator_count++ == 0) {
+            declaration.first_declarator_has_initializer = has_initializer;
+            declaration.first_declarator_is_identifier = !is_pattern;
+        }
+        declaration.all_declarators_have_initializers &= has_initializer;
+
+        if (!match(TokenType::Comma))
+            break;
+        m_parser.consume();
+    }
+
+    if (!is_for_loop)
+        TRY(consume_or_insert_semicolon());
+
+    for (auto const& name : bound_names) {
+        if (is_var)
+            TRY(declare_var(name));
+        else
+            TRY(declare_lexical(name));
+    }
+    return declaration;
+}
+
+ErrorOr<void> PreParser::skip_binding_pattern(Parser::AllowDuplicates allow_duplicates, Vector<DeprecatedFlyString>& bound_names)
+{
+    auto first_bound_name = bound_names.size();
+    TRY(skip_binding_pattern_entries(bound_names));
+
+    HashTable<DeprecatedFlyString> seen_names;
+    for (auto const& name : bound_names.span().slice(first_bound_name)) {
+        if (name == "eval"sv)
+            return give_up();
+        if (allow_duplicates == Parser::AllowDuplicates::No && seen_names.set(name) != AK::HashSetResult::InsertedNewEntry)
+            return give_up();
+        m_parser.check_identifier_name_for_assignment_validity(name);
+    }
+    return check_for_errors();
+}
+
+ErrorOr<void> PreParser::skip_binding_pattern_entries(Vector<DeprecatedFlyString>& bound_names)
+{
+    bool is_object = match(TokenType::CurlyOpen);
+    auto closing_token = is_object ? TokenType::CurlyClose : TokenType::BracketClose;
+    m_parser.consume();
+
+    while (!match(closing_token)) {
+        if (!is_object && match(TokenType::Comma)) {
+            m_parser.consume();
+            continue;
+        }
+
+        bool is_rest = match(TokenType::TripleDot);
+        if (is_rest)
+            m_parser.consume();
+
+        // The name of a property without an alias is bound as is, so it has to be a plain identifier.
+        Optional<DeprecatedFlyString> shorthand_name;
+        if (is_object) {
+            if (match(TokenType::Identifier)) {
+                shorthand_name = m_parser.consume().DeprecatedFlyString_value();
+            } else if (match(TokenType::StringLiteral)) {
+                TRY(check_string_literal(m_parser.consume()));
+            } else if (match(TokenType::BracketOpen)) {
+                m_parser.consume();
+                TRY(skip_expression(0));
+                TRY(consume(TokenType::BracketClose));
+            } else if (m_parser.match_identifier_name() || match(TokenType::NumericLiteral) || match(TokenType::BigIntLiteral)) {
+                m_parser.consume();
+            } else {
+                return give_up();
+            }
+
+            if (!is_rest && match(TokenType::Colon)) {
+                m_parser.consume();
+                if (match(TokenType::CurlyOpen) || match(TokenType::BracketOpen))
+                    TRY(skip_binding_pattern_entries(bound_names));
+                else
+                    bound_names.append(TRY(consume(TokenType::Identifier)).DeprecatedFlyString_value());
+            } else if (shorthand_name.has_value()) {
+                bound_names.append(shorthand_name.release_value());
+            } else {
+                return give_up();
+            }
+        } else if (match(TokenType::CurlyOpen) || match(TokenType::BracketOpen)) {
+            TRY(skip_binding_pattern_entries(bound_names));
+        } else {
+            bound_names.append(TRY(consume(TokenType::Identifier)).DeprecatedFlyString_value());
+        }
+
+        if (match(TokenType::Equals)) {
+            if (is_rest)
+                return give_up();
+            m_parser.consume();
+            TRY(skip_expression(2));
+        }
+
+        if (match(TokenType::Comma)) {
+            if (is_rest)
+                return give_up();
+            m_parser.consume();
+        } else if (!match(closing_token)) {
+            return give_up();
+        }
+    }
+
+    m_parser.consume();
+    return {};
+}
+
+ErrorOr<void> PreParser::skip_if_statement()
+{
+    m_parser.consume(TokenType::If);
+    TRY(consume(TokenType::ParenOpen));
+    TRY(skip_expression(0));
+    TRY(consume(TokenType::ParenClose));
+
+    // Function declarations in sloppy mode if statements get a block of their own.
+    if (match(TokenType::Function))
+        return give_up();
+    TRY(skip_statement());
+
+    if (match(TokenType::Else)) {
+        m_parser.consume();
+        if (match(TokenType::Function))
+            return give_up();
+        TRY(skip_statement());
+    }
+    return {};
+}
+
+ErrorOr<void> PreParser::skip_for_statement()
+{
+    m_parser.consume(TokenType::For);
+    if (match(TokenType::Await))
+        return give_up();
+    TRY(consume(TokenType::ParenOpen));
+
+    auto match_for_in_of = [&] {
+        return match(TokenType::In) || (match(TokenType::Identifier) && m_state.current_token.original_value() == "of"sv);
+    };
+
+    push_scope(ScopeType::Block);
+    if (!match(TokenType::Semicolon)) {
+        if (match(TokenType::Identifier) && m_state.current_token.original_value() == "using"sv)
+            return give_up();
+        if (m_parser.match_variable_declaration()) {
+            auto declaration = TRY(skip_variable_declaration(Parser::IsForLoopVariableDeclaration::Yes));
+            if (match_for_in_of()) {
+                if (declaration.declarator_count != 1)
+                    return give_up();
+                TRY(skip_for_in_of_statement(declaration, {}));
+                pop_scope();
+                return {};
+            }
+            if (declaration.kind == TokenType::Const && !declaration.all_declarators_have_initializers)
+                return give_up();
+        } else if (m_parser.match_expression()) {
+            if (match(TokenType::Async))
+                return give_up();
+            auto init = TRY(skip_expression(0, Associativity::Right, { TokenType::In }));
+            if (match_for_in_of()) {
+                TRY(skip_for_in_of_statement({}, init));
+                pop_scope();
+                return {};
+            }
+        } else {
+            return give_up();
+        }
+    }
+    TRY(consume(TokenType::Semicolon));
+    if (!match(TokenType::Semicolon))
+        TRY(skip_expression(0));
+    TRY(consume(TokenType::Semicolon));
+    if (!match(TokenType::ParenClose))
+        TRY(skip_expression(0));
+    TRY(consume(TokenType::ParenClose));
+
+    {
+        TemporaryChange break_change(m_state.in_break_context, true);
+        TemporaryChange continue_change(m_state.in_continue_context, true);
+        TRY(skip_statement());
+    }
+    pop_scope();
+    return {};
+}
+
+ErrorOr<void> PreParser::skip_for_in_of_statement(Optional<SkippedVariableDeclaration> const& declaration, SkippedExpression const& lhs)
+{
+    bool has_annex_b_for_in_initializer = false;
+    if (declaration.has_value()) {
+        if (declaration->first_declarator_has_initializer) {
+            if (m_state.strict_mode || declaration->kind != TokenType::Var || !declaration->first_declarator_is_identifier)
+                return give_up();
+            has_annex_b_for_in_initializer = true;
+        }
+    } else if (!is_simple_assignment_target(lhs)) {
+        // Destructuring assignments.
+        return give_up();
+    }
+
+    auto is_in = m_parser.consume().type() == TokenType::In;
+    if (!is_in && has_annex_b_for_in_initializer)
+        return give_up();
+
+    TRY(skip_expression(is_in ? 0 : 2));
+    TRY(consume(TokenType::ParenClose));
+
+    TemporaryChange break_change(m_state.in_break_context, true);
+    TemporaryChange continue_change(m_state.in_continue_context, true);
+    TRY(skip_statement());
+    return {};
+}
+
+ErrorOr<void> PreParser::skip_while_statement()
+{
+    m_parser.consume(TokenType::While);
+    TRY(consume(TokenType::ParenOpen));
+    TRY(skip_expression(0));
+    TRY(consume(TokenType::ParenClose));
+
+    TemporaryChange break_change(m_state.in_break_context, true);
+    TemporaryChange continue_change(m_state.in_continue_context, true);
+    TRY(skip_statement());
+    return {};
+}
+
+ErrorOr<void> PreParser::skip_do_while_statement()
+{
+    m_parser.consume(TokenType::Do);
+    {
+        TemporaryChange break_change(m_state.in_break_context, true);
+        TemporaryChange continue_change(m_state.in_continue_context, true);
+        TRY(skip_statement());
+    }
+    TRY(consume(TokenType::While));
+    TRY(consume(TokenType::ParenOpen));
+    TRY(skip_expression(0));
+    TRY(consume(TokenType::ParenClose));
+    if (match(TokenType::Semicolon))
+        m_parser.consume();
+    return {};
+}
+
+ErrorOr<void> PreParser::skip_switch_statement()
+{
+    m_parser.consume(TokenType::Switch);
+    TRY(consume(TokenType::ParenOpen));
+    TRY(skip_expression(0));
+    TRY(consume(TokenType::ParenClose));
+    TRY(consume(TokenType::CurlyOpen));
+
+    push_scope(ScopeType::Block);
+    bool has_default = false;
+    while (match(TokenType::Case) || match(TokenType::Default)) {
+        if (m_parser.consume().type() == TokenType::Case) {
+            TRY(skip_expression(0));
+        } else {
+            if (has_default)
+                return give_up();
+            has_default = true;
+        }
+        TRY(consume(TokenType::Colon));
+
+        TemporaryChange break_change(m_state.in_break_context, true);
+        TRY(skip_statement_list());
+    }
+    pop_scope();
+
+    TRY(consume(TokenType::CurlyClose));
+    return {};
+}
+
+ErrorOr<void> PreParser::skip_try_statement()
+{
+    m_parser.consume(TokenType::Try);
+    TRY(skip_block_statement());
+
+    bool has_handler = match(TokenType::Catch);
+    if (has_handler)
+        TRY(skip_catch_clause());
+
+    if (match(TokenType::Finally)) {
+        m_parser.consume();
+        TRY(skip_block_statement());
+    } else if (!has_handler) {
+        return give_up();
+    }
+    return {};
+}
+
+ErrorOr<void> PreParser::skip_catch_clause()
+{
+    m_parser.consume(TokenType::Catch);
+
+    Vector<DeprecatedFlyString> bound_names;
+    bool has_pattern = false;
+    if (match(TokenType::ParenOpen)) {
+        m_parser.consume();
+        if (match(TokenType::CurlyOpen) || match(TokenType::BracketOpen)) {
+            has_pattern = true;
+            TRY(skip_binding_pattern(Parser::AllowDuplicates::No, bound_names));
+        } else {
+            bound_names.append(TRY(consume_binding_identifier()));
+        }
+        TRY(consume(TokenType::ParenClose));
+    }
+
+    push_scope(ScopeType::Catch);
+    for (auto const& name : bound_names) {
+        if (has_pattern)
+            m_scopes.last().forbidden_var_names.set(name);
+        else
+            m_scopes.last().var_names.set(name);
+        m_scopes.last().bound_names.set(name);
+    }
+
+    push_scope(ScopeType::Block);
+    TRY(consume(TokenType::CurlyOpen));
+    TRY(skip_statement_list());
+    TRY(consume(TokenType::CurlyClose));
+    for (auto const& name : bound_names) {
+        if (m_scopes.last().lexical_names.contains(name) || m_scopes.last().function_names.contains(name))
+            return give_up();
+    }
+    pop_scope();
+
+    pop_scope();
+    return {};
+}
+
+ErrorOr<void> PreParser::skip_throw_statement()
+{
+    m_parser.consume(TokenType::Throw);
+    if (m_state.current_token.trivia_contains_line_terminator())
+        return give_up();
+    TRY(skip_expression(0));
+    return consume_or_insert_semicolon();
+}
+
+ErrorOr<void> PreParser::skip_break_statement()
+{
+    m_parser.consume(TokenType::Break);
+    bool has_label = false;
+    if (match(TokenType::Semicolon)) {
+        m_parser.consume();
+    } else {
+        if (!m_state.current_token.trivia_contains_line_terminator() && m_parser.match_identifier()) {
+            auto label = TRY(consume(TokenType::Identifier)).value();
+            if (!m_state.labels_in_scope.contains(label))
+                return give_up();
+            has_label = true;
+        }
+        TRY(consume_or_insert_semicolon());
+    }
+
+    if (!has_label && !m_state.in_break_context)
+        return give_up();
+    return {};
+}
+
+ErrorOr<void> PreParser::skip_continue_statement()
+{
+    if (!m_state.in_continue_context)
+        return give_up();
+
+    m_parser.consume(TokenType::Continue);
+    if (match(TokenType::Semicolon)) {
+        m_parser.consume();
+        return {};
+    }
+    if (!m_state.current_token.trivia_contains_line_terminator() && m_parser.match_identifier()) {
+        auto label_position = m_parser.position();
+        auto label = TRY(consume(TokenType::Identifier)).value();
+        auto entry = m_state.labels_in_scope.find(label);
+        if (entry == m_state.labels_in_scope.end())
+            return give_up();
+        entry->value = label_position;
+    }
+    return consume_or_insert_semicolon();
+}
+
+ErrorOr<void> PreParser::skip_function(FunctionType type)
+{
+    TemporaryChange break_context_rollback(m_state.in_break_context, false);
+    TemporaryChange continue_context_rollback(m_state.in_continue_context, false);
+    TemporaryChange might_need_arguments_object_rollback(m_state.function_might_need_arguments_object, false);
+
+    Optional<DeprecatedFlyString> name;
+    if (type == FunctionType::Declaration || type == FunctionType::Expression) {
+        m_parser.consume(TokenType::Function);
+        if (type == FunctionType::Declaration || !match(TokenType::ParenOpen))
+            name = TRY(consume_binding_identifier());
+    }
+
+    push_scope(ScopeType::Function);
+    if (name.has_value() && type == FunctionType::Expression)
+        m_scopes.last().bound_names.set(*name);
+
+    TRY(consume(TokenType::ParenOpen));
+    Vector<DeprecatedFlyString> parameter_names;
+    TRY(skip_formal_parameters(type, parameter_names));
+    TRY(consume(TokenType::ParenClose));
+    for (auto const& parameter_name : parameter_names)
+        m_scopes.last().forbidden_lexical_names.set(parameter_name);
+
+    auto old_labels_in_scope = move(m_state.labels_in_scope);
+    ScopeGuard guard([&] {
+        m_state.labels_in_scope = move(old_labels_in_scope);
+    });
+
+    TRY(consume(TokenType::CurlyOpen));
+    // A directive prologue could make the function strict, which changes the meaning of what comes before it.
+    if (match(TokenType::StringLiteral))
+        return give_up();
+    m_open_function_body_offsets.append(m_parser.position().offset);
+    TRY(skip_statement_list());
+    TRY(consume(TokenType::CurlyClose));
+    m_open_function_body_offsets.take_last();
+    pop_scope();
+
+    if (type == FunctionType::Declaration)
+        TRY(declare_function(*name));
+    return {};
+}
+
+ErrorOr<void> PreParser::skip_formal_parameters(FunctionType type, Vector<DeprecatedFlyString>& parameter_names)
+{
+    size_t parameter_count = 0;
+    while (match(TokenType::CurlyOpen) || match(TokenType::BracketOpen) || match(TokenType::Identifier) || match(TokenType::TripleDot)) {
+        bool is_rest = match(TokenType::TripleDot);
+        if (is_rest) {
+            if (type == FunctionType::Setter)
+                return give_up();
+            m_parser.consume();
+        }
+
+        if (match(TokenType::CurlyOpen) || match(TokenType::BracketOpen))
+            TRY(skip_binding_pattern(Parser::AllowDuplicates::No, parameter_names));
+        else
+            parameter_names.append(TRY(consume_binding_identifier()));
+        ++parameter_count;
+
+        if (match(TokenType::Equals)) {
+            if (is_rest)
+                return give_up();
+            m_parser.consume();
+            TRY(skip_expression(2));
+        }
+
+        if (!match(TokenType::Comma) || is_rest)
+            break;
+        m_parser.consume();
+    }
+
+    if (type == FunctionType::Getter && parameter_count != 0)
+        return give_up();
+    if (type == FunctionType::Setter && parameter_count != 1)
+        return give_up();
+
+    // Only sloppy functions with simple parameters may have duplicate parameters, which is rare enough to not bother.
+    HashTable<DeprecatedFlyString> seen_names;
+    for (auto const& name : parameter_names) {
+        if (seen_names.set(name) != AK::HashSetResult::InsertedNewEntry)
+            return give_up();
+    }
+
+    if (!match(TokenType::ParenClose))
+        return give_up();
+    return {};
+}
+
+// Looks for a `=>` right after the parenthesis that the current token opens.
+bool PreParser::is_arrow_function_ahead() const
+{
+    auto lexer = m_state.lexer;
+    size_t depth = 1;
+    for (;;) {
+        auto token = lexer.next();
+        switch (token.type()) {
+        case TokenType::Eof:
+            return false;
+        case TokenType::ParenOpen:
+            ++depth;
+            break;
+        case TokenType::ParenClose:
+            if (--depth == 0) {
+                auto next_token = lexer.next();
+                return next_token.type() == TokenType::Arrow && !next_token.trivia_contains_line_terminator();
+            }
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+ErrorOr<void> PreParser::skip_arrow_function(bool has_parentheses)
+{
+    push_scope(ScopeType::ArrowFunction);
+
+    Vector<DeprecatedFlyString> parameter_names;
+    if (has_parentheses) {
+        m_parser.consume(TokenType::ParenOpen);
+        TRY(skip_formal_parameters(FunctionType::Expression, parameter_names));
+        m_parser.consume(TokenType::ParenClose);
+    } else {
+        parameter_names.append(TRY(consume_binding_identifier()));
+    }
+    for (auto const& parameter_name : parameter_names)
+        m_scopes.last().forbidden_lexical_names.set(parameter_name);
+
+    if (m_state.current_token.trivia_contains_line_terminator())
+        return give_up();
+    TRY(consume(TokenType::Arrow));
+
+    auto old_labels_in_scope = move(m_state.labels_in_scope);
+    ScopeGuard guard([&] {
+        m_state.labels_in_scope = move(old_labels_in_scope);
+    });
+    TemporaryChange arrow_function_context_change(m_state.in_arrow_function_context, true);
+
+    if (match(TokenType::CurlyOpen)) {
+        m_parser.consume();
+        if (match(TokenType::StringLiteral))
+            return give_up();
+        TRY(skip_statement_list());
+        TRY(consume(TokenType::CurlyClose));
+    } else if (m_parser.match_expression()) {
+        TRY(skip_expression(2));
+    } else {
+        return give_up();
+    }
+
+    pop_scope();
+    return {};
+}
+
+ErrorOr<PreParser::SkippedExpression> PreParser::skip_expression(int min_precedence, Associativity associativity, Parser::ForbiddenTokens forbidden)
+{
+    auto [expression, should_continue_parsing] = TRY(skip_primary_expression());
+    while (match(TokenType::TemplateLiteralStart)) {
+        TRY(skip_template_literal(true));
+        expression = {};
+    }
+
+    if (should_continue_parsing) {
+        auto original_forbidden = forbidden;
+        while (m_parser.match_secondary_expression(forbidden)) {
+            int new_precedence = g_operator_precedence.get(m_state.current_token.type());
+            if (new_precedence < min_precedence)
+                break;
+            if (new_precedence == min_precedence && associativity == Associativity::Left)
+                break;
+
+            auto new_associativity = m_parser.operator_associativity(m_state.current_token.type());
+            auto result = TRY(skip_secondary_expression(expression, new_precedence, new_associativity, original_forbidden));
+            expression = move(result.expression);
+            forbidden = forbidden.merge(result.forbidden);
+            while (match(TokenType::TemplateLiteralStart) && expression.kind != SkippedExpression::Kind::Update) {
+                TRY(skip_template_literal(true));
+                expression = {};
+            }
+        }
+    }
+
+    if (match(TokenType::Comma) && min_precedence <= 1) {
+        while (match(TokenType::Comma)) {
+            m_parser.consume();
+            TRY(skip_expression(2));
+        }
+        expression = {};
+    }
+    return expression;
+}
+
+ErrorOr<PreParser::SkippedPrimaryExpression> PreParser::skip_primary_expression()
+{
+    if (m_parser.match_unary_prefixed_expression())
+        return SkippedPrimaryExpression { TRY(skip_unary_prefixed_expression()) };
+
+    switch (m_state.current_token.type()) {
+    case TokenType::ParenOpen: {
+        auto next_type = m_parser.next_token().type();
+        if ((next_type == TokenType::ParenClose || next_type == TokenType::Identifier || next_type == TokenType::TripleDot || next_type == TokenType::CurlyOpen || next_type == TokenType::BracketOpen)
+            && is_arrow_function_ahead()) {
+            TRY(skip_arrow_function(true));
+            return SkippedPrimaryExpression { {}, false };
+        }
+        m_parser.consume();
+        auto expression = TRY(skip_expression(0));
+        TRY(consume(TokenType::ParenClose));
+        // Unlike `new a?.b`, `(new a)?.b` is fine.
+        if (expression.kind == SkippedExpression::Kind::New)
+            expression.kind = SkippedExpression::Kind::Call;
+        return SkippedPrimaryExpression { move(expression) };
+    }
+    case TokenType::This:
+        m_parser.consume_and_allow_division();
+        return SkippedPrimaryExpression {};
+    case TokenType::Identifier: {
+        auto next_token = m_parser.next_token();
+        if (next_token.type() == TokenType::Arrow && !next_token.trivia_contains_line_terminator()) {
+            TRY(skip_arrow_function(false));
+            return SkippedPrimaryExpression { {}, false };
+        }
+
+        auto name = m_state.current_token.DeprecatedFlyString_value();
+        // A direct call to eval would need the scope analysis to know everything about the body.
+        if (name == "eval"sv)
+            return give_up();
+        if (m_state.strict_mode && is_strict_reserved_word(name))
+            return give_up();
+        TRY(consume(TokenType::Identifier));
+        reference(name);
+        return SkippedPrimaryExpression { { SkippedExpression::Kind::Identifier, move(name) } };
+    }
+    case TokenType::NumericLiteral:
+        m_parser.consume_and_validate_numeric_literal();
+        TRY(check_for_errors());
+        return SkippedPrimaryExpression {};
+    case TokenType::BigIntLiteral:
+        m_parser.consume();
+        return SkippedPrimaryExpression {};
+    case TokenType::BoolLiteral:
+    case TokenType::NullLiteral:
+        m_parser.consume_and_allow_division();
+        return SkippedPrimaryExpression {};
+    case TokenType::StringLiteral:
+        TRY(check_string_literal(m_parser.consume()));
+        return SkippedPrimaryExpression {};
+    case TokenType::CurlyOpen:
+        TRY(skip_object_expression());
+        return SkippedPrimaryExpression { { SkippedExpression::Kind::ObjectLiteral } };
+    case TokenType::Function:
+        if (m_parser.next_token().type() == TokenType::Asterisk)
+            return give_up();
+        TRY(skip_function(FunctionType::Expression));
+        return SkippedPrimaryExpression {};
+    case TokenType::BracketOpen:
+        TRY(skip_array_expression());
+        return SkippedPrimaryExpression { { SkippedExpression::Kind::ArrayLiteral } };
+    case TokenType::RegexLiteral:
+        TRY(skip_regexp_literal());
+        return SkippedPrimaryExpression {};
+    case TokenType::TemplateLiteralStart:
+        TRY(skip_template_literal(false));
+        return SkippedPrimaryExpression {};
+    case TokenType::New:
+        if (m_parser.next_token().type() == TokenType::Period) {
+            m_parser.consume();
+            m_parser.consume();
+            if (!match(TokenType::Identifier) || m_state.current_token.original_value() != "target"sv)
+                return give_up();
+            m_parser.consume();
+            return SkippedPrimaryExpression {};
+        }
+        TRY(skip_new_expression());
+        return SkippedPrimaryExpression { { SkippedExpression::Kind::New } };
+    default:
+        // Classes, super, import, await, yield, private names, and keywords or escaped names used as identifiers.
+        return give_up();
+    }
+}
+
+ErrorOr<PreParser::SkippedExpression> PreParser::skip_unary_prefixed_expression()
+{
+    auto type = m_state.current_token.type();
+    auto precedence = g_operator_precedence.get_unary(type);
+    auto associativity = m_parser.operator_associativity(type);
+    m_parser.consume();
+
+    if (type == TokenType::PlusPlus || type == TokenType::MinusMinus) {
+        auto operand = TRY(skip_expression(precedence, associativity));
+        if (!is_simple_assignment_target(operand))
+            return give_up();
+        if (m_state.strict_mode && operand.kind == SkippedExpression::Kind::Identifier) {
+            m_parser.check_identifier_name_for_assignment_validity(operand.identifier_name);
+            TRY(check_for_errors());
+        }
+        return SkippedExpression {};
+    }
+
+    if (m_parser.next_token().type() == TokenType::DoubleAsterisk)
+        return give_up();
+    auto operand = TRY(skip_expression(precedence, associativity));
+    if (type == TokenType::Delete && m_state.strict_mode && operand.kind == SkippedExpression::Kind::Identifier)
+        return give_up();
+    return SkippedExpression {};
+}
+
+ErrorOr<PreParser::SkippedSecondaryExpression> PreParser::skip_secondary_expression(SkippedExpression const& lhs, int min_precedence, Associativity associativity, Parser::ForbiddenTokens forbidden)
+{
+    auto type = m_state.current_token.type();
+    switch (type) {
+    case TokenType::Plus:
+    case TokenType::Minus:
+    case TokenType::Asterisk:
+    case TokenType::Slash:
+    case TokenType::Percent:
+    case TokenType::DoubleAsterisk:
+    case TokenType::GreaterThan:
+    case TokenType::GreaterThanEquals:
+    case TokenType::LessThan:
+    case TokenType::LessThanEquals:
+    case TokenType::EqualsEqualsEquals:
+    case TokenType::ExclamationMarkEqualsEquals:
+    case TokenType::EqualsEquals:
+    case TokenType::ExclamationMarkEquals:
+    case TokenType::Instanceof:
+    case TokenType::Ampersand:
+    case TokenType::Pipe:
+    case TokenType::Caret:
+    case TokenType::ShiftLeft:
+    case TokenType::ShiftRight:
+    case TokenType::UnsignedShiftRight:
+        m_parser.consume();
+        TRY(skip_expression(min_precedence, associativity, forbidden));
+        return SkippedSecondaryExpression {};
+    case TokenType::In:
+        m_parser.consume();
+        TRY(skip_expression(min_precedence, associativity));
+        return SkippedSecondaryExpression {};
+    case TokenType::Equals:
+    case TokenType::PlusEquals:
+    case TokenType::MinusEquals:
+    case TokenType::AsteriskEquals:
+    case TokenType::SlashEquals:
+    case TokenType::PercentEquals:
+    case TokenType::DoubleAsteriskEquals:
+    case TokenType::AmpersandEquals:
+    case TokenType::PipeEquals:
+    case TokenType::CaretEquals:
+    case TokenType::ShiftLeftEquals:
+    case TokenType::ShiftRightEquals:
+    case TokenType::UnsignedShiftRightEquals:
+    case TokenType::DoubleAmpersandEquals:
+    case TokenType::DoublePipeEquals:
+    case TokenType::DoubleQuestionMarkEquals:
+        return SkippedSecondaryExpression { TRY(skip_assignment_expression(type, lhs, min_precedence, associativity, forbidden)) };
+    case TokenType::ParenOpen:
+        TRY(skip_arguments());
+        return SkippedSecondaryExpression { { SkippedExpression::Kind::Call } };
+    case TokenType::Period:
+        m_parser.consume();
+        if (!m_parser.match_identifier_name())
+            return give_up();
+        m_parser.consume_and_allow_division();
+        return SkippedSecondaryExpression { { SkippedExpression::Kind::Member } };
+    case TokenType::BracketOpen:
+        m_parser.consume();
+        TRY(skip_expression(0));
+        TRY(consume(TokenType::BracketClose));
+        return SkippedSecondaryExpression { { SkippedExpression::Kind::Member } };
+    case TokenType::PlusPlus:
+    case TokenType::MinusMinus:
+        if (!is_simple_assignment_target(lhs))
+            return give_up();
+        if (m_state.strict_mode && lhs.kind == SkippedExpression::Kind::Identifier) {
+            m_parser.check_identifier_name_for_assignment_validity(lhs.identifier_name);
+            TRY(check_for_errors());
+        }
+        m_parser.consume();
+        return SkippedSecondaryExpression { { SkippedExpression::Kind::Update } };
+    case TokenType::DoubleAmpersand:
+    case TokenType::DoublePipe:
+        m_parser.consume();
+        TRY(skip_expression(min_precedence, associativity, forbidden.forbid({ TokenType::DoubleQuestionMark })));
+        return SkippedSecondaryExpression { {}, { TokenType::DoubleQuestionMark } };
+    case TokenType::DoubleQuestionMark:
+        m_parser.consume();
+        TRY(skip_expression(min_precedence, associativity, forbidden.forbid({ TokenType::DoubleAmpersand, TokenType::DoublePipe })));
+        return SkippedSecondaryExpression { {}, { TokenType::DoubleAmpersand, TokenType::DoublePipe } };
+    case TokenType::QuestionMark:
+        m_parser.consume();
+        TRY(skip_expression(2));
+        TRY(consume(TokenType::Colon));
+        TRY(skip_expression(2, Associativity::Right, forbidden));
+        return SkippedSecondaryExpression {};
+    case TokenType::QuestionMarkPeriod:
+        if (lhs.kind == SkippedExpression::Kind::New)
+            return give_up();
+        TRY(skip_optional_chain());
+        return SkippedSecondaryExpression {};
+    default:
+        return give_up();
+    }
+}
+
+ErrorOr<PreParser::SkippedExpression> PreParser::skip_assignment_expression(TokenType type, SkippedExpression const& lhs, int min_precedence, Associativity associativity, Parser::ForbiddenTokens forbidden)
+{
+    m_parser.consume();
 
-    if (!is_simple_assignment_target(*lhs, has_web_reality_assignment_target_exceptions)) {
-        syntax_error("Invalid left-hand side in assignment");
-    } else if (m_state.strict_mode && is<Identifier>(*lhs)) {
-        auto const& name = static_cast<Identifier const&>(*lhs).string();
-        check_identifier_name_for_assignment_validity(name);
+    // Destructuring assignments.
+    if (lhs.kind == SkippedExpression::Kind::ObjectLiteral || lhs.kind == SkippedExpression::Kind::ArrayLiteral)
+        return give_up();
+
+    bool is_logical_assignment = type == TokenType::DoubleAmpersandEquals || type == TokenType::DoublePipeEquals || type == TokenType::DoubleQuestionMarkEquals;
+    if (!is_simple_assignment_target(lhs, !is_logical_assignment))
+        return give_up();
+    if (m_state.strict_mode && lhs.kind == SkippedExpression::Kind::Identifier) {
+        m_parser.check_identifier_name_for_assignment_validity(lhs.identifier_name);
+        TRY(check_for_errors());
     }
-    auto rhs = parse_expression(min_precedence, associativity, forbidden);
-    return create_ast_node<AssignmentExpression>({ m_source_code, rule_start.position(), position() }, assignment_op, move(lhs), move(rhs));
-}
 
-NonnullRefPtr<Identifier const> Parser::parse_identifier()
-{
-    auto identifier_start = position();
-    auto token = consume_identifier();
-    if (m_state.in_class_field_initializer && token.value() == "arguments"sv)
-        syntax_error("'arguments' is not allowed in class field initializer");
-    return create_identifier_and_register_in_current_scope({ m_source_code, identifier_start, position() }, token.DeprecatedFlyString_value());
+    TRY(skip_expression(min_precedence, associativity, forbidden));
+    return SkippedExpression {};
 }
 
-Vector<CallExpression::Argument> Parser::parse_arguments()
+ErrorOr<void> PreParser::skip_arguments()
 {
-    Vector<CallExpression::Argument> arguments;
-
-    consume(TokenType::ParenOpen);
-    while (match_expression() || match(TokenType::TripleDot)) {
-        if (match(TokenType::TripleDot)) {
-            consume();
-            arguments.append({ parse_expression(2), true });
-        } else {
-            arguments.append({ parse_expression(2), false });
-        }
+    TRY(consume(TokenType::ParenOpen));
+    while (m_parser.match_expression() || match(TokenType::TripleDot)) {
+        if (match(TokenType::TripleDot))
+            m_parser.consume();
+        TRY(skip_expression(2));
         if (!match(TokenType::Comma))
             break;
-        consume();
+        m_parser.consume();
     }
-
-    consume(TokenType::ParenClose);
-    return arguments;
+    TRY(consume(TokenType::ParenClose));
+    return {};
 }
 
-NonnullRefPtr<Expression const> Parser::parse_call_expression(NonnullRefPtr<Expression const> lhs)
+ErrorOr<void> PreParser::skip_new_expression()
 {
-    auto rule_start = push_start();
-    if (!m_state.allow_super_constructor_call && is<SuperExpression>(*lhs))
-        syntax_error("'super' keyword unexpected here");
-
-    auto arguments = parse_arguments();
-
-    if (is<SuperExpression>(*lhs))
-        return create_ast_node<SuperCall>({ m_source_code, rule_start.position(), position() }, move(arguments));
-
-    return CallExpression::create({ m_source_code, rule_start.position(), position() }, move(lhs), arguments.span(), InvocationStyleEnum::Parenthesized, InsideParenthesesEnum::NotInsideParentheses);
+    m_parser.consume(TokenType::New);
+    TRY(skip_expression(g_operator_precedence.get(TokenType::New), Associativity::Right, { TokenType::ParenOpen, TokenType::QuestionMarkPeriod }));
+    if (match(TokenType::ParenOpen))
+        TRY(skip_arguments());
+    return {};
 }
 
-NonnullRefPtr<NewExpression const> Parser::parse_new_expression()
+ErrorOr<void> PreParser::skip_optional_chain()
 {
-    auto rule_start = push_start();
-    consume(TokenType::New);
-
-    auto callee = parse_expression(g_operator_precedence.get(TokenType::New), Associativity::Right, { TokenType::ParenOpen, TokenType::QuestionMarkPeriod });
-    if (is<ImportCall>(*callee))
-        syntax_error("Cannot call new on dynamic import", callee->source_range().start);
-
-    Vector<CallExpression::Argument> arguments;
-
-    auto is_parenthesized = match(TokenType::ParenOpen);
-
-    if (is_parenthesized) {
-        consume();
-        while (match_expression() || match(TokenType::TripleDot)) {
-            if (match(TokenType::TripleDot)) {
-                consume();
-                arguments.append({ parse_expression(2), true });
+    do {
+        if (match(TokenType::QuestionMarkPeriod)) {
+            m_parser.consume();
+            if (match(TokenType::ParenOpen)) {
+                TRY(skip_arguments());
+            } else if (match(TokenType::BracketOpen)) {
+                m_parser.consume();
+                TRY(skip_expression(0));
+                TRY(consume(TokenType::BracketClose));
+            } else if (m_parser.match_identifier_name()) {
+                m_parser.consume_and_allow_division();
             } else {
-                arguments.append({ parse_expression(2), false });
+                return give_up();
             }
-            if (!match(TokenType::Comma))
-                break;
-            consume();
+        } else if (match(TokenType::ParenOpen)) {
+            TRY(skip_arguments());
+        } else if (match(TokenType::Period)) {
+            m_parser.consume();
+            if (!m_parser.match_identifier_name())
+                return give_up();
+            m_parser.consume_and_allow_division();
+        } else if (match(TokenType::TemplateLiteralStart)) {
+            return give_up();
+        } else if (match(TokenType::BracketOpen)) {
+            m_parser.consume();
+            TRY(skip_expression(2));
+            TRY(consume(TokenType::BracketClose));
+        } else {
+            break;
         }
-        consume(TokenType::ParenClose);
-    }
-
-    InvocationStyleEnum invocation_style = is_parenthesized ? InvocationStyleEnum::Parenthesized : InvocationStyleEnum::NotParenthesized;
-
-    return NewExpression::create({ m_source_code, rule_start.position(), position() }, move(callee), move(arguments), invocation_style, InsideParenthesesEnum::NotInsideParentheses);
+    } while (!m_parser.done());
+    return {};
 }
 
-NonnullRefPtr<YieldExpression const> Parser::parse_yield_expression()
+ErrorOr<void> PreParser::skip_object_expression()
 {
-    auto rule_start = push_start();
+    m_parser.consume(TokenType::CurlyOpen);
 
-    if (m_state.in_formal_parameter_context)
-        syntax_error("'Yield' expression is not allowed in formal parameters of generator function");
+    bool has_direct_proto_property = false;
+    while (!m_parser.done() && !match(TokenType::CurlyClose)) {
+        if (match(TokenType::TripleDot)) {
+            m_parser.consume();
+            TRY(skip_expression(2));
+            if (!match(TokenType::Comma))
+                break;
+            m_parser.consume();
+            continue;
+        }
 
-    consume(TokenType::Yield);
-    RefPtr<Expression const> argument;
-    bool yield_from = false;
+        // Async and generator methods.
+        if (match(TokenType::Async) || match(TokenType::Asterisk))
+            return give_up();
 
-    if (!m_state.current_token.trivia_contains_line_terminator()) {
-        if (match(TokenType::Asterisk)) {
-            consume();
-            yield_from = true;
+        auto type = m_state.current_token.type();
+        auto function_type = FunctionType::Method;
+        Optional<DeprecatedFlyString> key;
+        Optional<DeprecatedFlyString> shorthand_name;
+        if (m_parser.match_identifier()) {
+            if (type != TokenType::Identifier)
+                return give_up();
+            auto identifier = m_parser.consume();
+            if (identifier.original_value() == "get"sv && m_parser.match_property_key()) {
+                function_type = FunctionType::Getter;
+                TRY(skip_property_key());
+            } else if (identifier.original_value() == "set"sv && m_parser.match_property_key()) {
+                function_type = FunctionType::Setter;
+                TRY(skip_property_key());
+            } else {
+                key = identifier.DeprecatedFlyString_value();
+                shorthand_name = key;
+            }
+        } else {
+            key = TRY(skip_property_key());
         }
 
-        if (yield_from || match_expression() || match(TokenType::Class))
-            argument = parse_expression(2);
+        if (match(TokenType::ParenOpen)) {
+            TRY(skip_function(function_type));
+        } else if (function_type != FunctionType::Method) {
+            return give_up();
+        } else if (match(TokenType::Colon)) {
+            m_parser.consume();
+            bool is_proto = (type == TokenType::StringLiteral || type == TokenType::Identifier) && key == "__proto__"sv;
+            if (is_proto) {
+                if (has_direct_proto_property)
+                    return give_up();
+                has_direct_proto_property = true;
+            }
+            TRY(skip_expression(2));
+        } else if (shorthand_name.has_value() && !match(TokenType::Equals)) {
+            if (*shorthand_name == "eval"sv || (m_state.strict_mode && is_strict_reserved_word(*shorthand_name)))
+                return give_up();
+            reference(*shorthand_name);
+        } else {
+            // Including the `a = 1` of the patterns that destructuring assignments start out as.
+            return give_up();
+        }
+
+        if (!match(TokenType::Comma))
+            break;
+        m_parser.consume();
     }
 
-    return create_ast_node<YieldExpression>({ m_source_code, rule_start.position(), position() }, move(argument), yield_from);
+    TRY(consume(TokenType::CurlyClose));
+    return {};
 }
 
-NonnullRefPtr<AwaitExpression const> Parser::parse_await_expression()
+// Returns the name of a property key that isn't computed.
+ErrorOr<Optional<DeprecatedFlyString>> PreParser::skip_property_key()
 {
-    auto rule_start = push_start();
+    if (match(TokenType::StringLiteral)) {
+        auto token = m_parser.consume();
+        TRY(check_string_literal(token));
+        auto status = Token::StringValueStatus::Ok;
+        return DeprecatedFlyString { token.string_value(status) };
+    }
+    if (match(TokenType::NumericLiteral) || match(TokenType::BigIntLiteral)) {
+        m_parser.consume();
+        return OptionalNone {};
+    }
+    if (match(TokenType::BracketOpen)) {
+        m_parser.consume();
+        TRY(skip_expression(2));
+        TRY(consume(TokenType::BracketClose));
+        return OptionalNone {};
+    }
+    if (!m_parser.match_identifier_name())
+        return give_up();
+    return m_parser.consume().DeprecatedFlyString_value();
+}
 
-    if (m_state.in_formal_parameter_context)
-        syntax_error("'Await' expression is not allowed in formal parameters of an async function");
+ErrorOr<void> PreParser::skip_array_expression()
+{
+    m_parser.consume(TokenType::BracketOpen);
+    while (m_parser.match_expression() || match(TokenType::TripleDot) || match(TokenType::Comma)) {
+        if (match(TokenType::TripleDot)) {
+            m_parser.consume();
+            TRY(skip_expression(2));
+        } else if (m_parser.match_expression()) {
+            TRY(skip_expression(2));
+        }
+        if (!match(TokenType::Comma))
+            break;
+        m_parser.consume();
+    }
+    TRY(consume(TokenType::BracketClose));
+    return {};
+}
 
-    consume(TokenType::Await);
+ErrorOr<void> PreParser::skip_template_literal(bool is_tagged)
+{
+    m_parser.consume(TokenType::TemplateLiteralStart);
+    while (!m_parser.done() && !match(TokenType::TemplateLiteralEnd) && !match(TokenType::UnterminatedTemplateLiteral)) {
+        if (match(TokenType::TemplateLiteralString)) {
+            TRY(check_string_literal(m_parser.consume(), is_tagged ? Parser::StringLiteralType::TaggedTemplate : Parser::StringLiteralType::NonTaggedTemplate));
+        } else if (match(TokenType::TemplateLiteralExprStart)) {
+            m_parser.consume();
+            if (match(TokenType::TemplateLiteralExprEnd))
+                return give_up();
+            TRY(skip_expression(0));
+            TRY(consume(TokenType::TemplateLiteralExprEnd));
+        } else {
+            return give_up();
+        }
+    }
+    TRY(consume(TokenType::TemplateLiteralEnd));
+    return {};
+}
 
-    auto precedence = g_operator_precedence.get(TokenType::Await);
-    auto associativity = operator_associativity(TokenType::Await);
-    auto argument = parse_expression(precedence, associativity);
+ErrorOr<void> PreParser::skip_regexp_literal()
+{
+    auto pattern = m_parser.consume().value();
+    pattern = pattern.substring_view(1, pattern.length() - 2);
 
-    m_state.current_scope_pusher->set_contains_await_expression();
+    auto parsed_flags = RegExpObject::default_flags;
+    if (match(TokenType::RegexFlags)) {
+        auto parsed_flags_or_error = regex_flags_from_string(m_parser.consume().value());
+        if (parsed_flags_or_error.is_error())
+            return give_up();
+        parsed_flags = parsed_flags_or_error.release_value();
+    }
 
-    return create_ast_node<AwaitExpression>({ m_source_code, rule_start.position(), position() }, move(argument));
+    auto parsed_pattern = parse_regex_pattern(pattern, parsed_flags.has_flag_set(ECMAScriptFlags::Unicode), parsed_flags.has_flag_set(ECMAScriptFlags::UnicodeSets));
+    if (parsed_pattern.is_error())
+        return give_up();
+    if (Regex<ECMA262>::parse_pattern(parsed_pattern.value(), parsed_flags).error != regex::Error::NoError)
+        return give_up();
+    return {};
 }
 
-NonnullRefPtr<ReturnStatement const> Parser::parse_return_statement()
+ErrorOr<void> PreParser::check_string_literal(Token const& token, Parser::StringLiteralType string_literal_type)
 {
-    auto rule_start = push_start();
-    if (!m_state.in_function_context && !m_state.in_arrow_function_context)
-        syntax_error("'return' not allowed outside of a function");
-
-    consume(TokenType::Return);
+    // Only escape sequences can be invalid.
+    if (!token.value().contains('\\'))
+        return {};
 
-    // Automatic semicolon insertion: terminate statement when return is followed by newline
-    if (m_state.current_token.trivia_contains_line_terminator())
-        return create_ast_node<ReturnStatement>({ m_source_code, rule_start.position(), position() }, nullptr);
+    auto status = Token::StringValueStatus::Ok;
+    (void)token.string_value(status);
+    if (status == Token::StringValueStatus::Ok)
+        return {};
 
-    if (match_expression()) {
-        auto expression = parse_expression(0);
-        consume_or_insert_semicolon();
-        return create_ast_node<ReturnStatement>({ m_source_code, rule_start.position(), position() }, move(expression));
+    // NOTE: Tagged templates can contain invalid escapes, as their raw contents can still be accessed.
+    if (status == Token::StringValueStatus::LegacyOctalEscapeSequence) {
+        m_state.string_legacy_octal_escape_sequence_in_scope = true;
+        if (string_literal_type == Parser::StringLiteralType::NonTaggedTemplate || (string_literal_type == Parser::StringLiteralType::Normal && m_state.strict_mode))
+            return give_up();
+        return {};
     }
-
-    consume_or_insert_semicolon();
-    return create_ast_node<ReturnStatement>({ m_source_code, rule_start.position(), position() }, nullptr);
+    if (string_literal_type != Parser::StringLiteralType::TaggedTemplate)
+        return give_up();
+    return {};
 }
 
-void Parser::parse_statement_list(ScopeNode& output_node, AllowLabelledFunction allow_labelled_functions)
+// Lets the PreParser skip the statements of a function body, once the directives have been parsed. Returns false if
+// it gave up, in which case the parser is back where it started.
+bool Parser::skip_function_body_statements(Vector<FunctionParameter> const& parameters)
 {
-    while (!done()) {
-        if (match_declaration(AllowUsingDeclaration::Yes)) {
-            auto declaration = parse_declaration();
-            VERIFY(m_state.current_scope_pusher);
-            m_state.current_scope_pusher->add_declaration(declaration);
-            output_node.append(move(declaration));
-        } else if (match_statement()) {
-            output_node.append(parse_statement(allow_labelled_functions));
-        } else {
-            break;
-        }
+    save_state();
+    PreParser pre_parser { *this };
+    auto free_names = pre_parser.skip_function_body(parameters);
+    if (free_names.is_error()) {
+        load_state();
+        // The PreParser would give up on the same code again while skipping the functions it was inside of.
+        for (auto offset : pre_parser.open_function_body_offsets())
+            m_function_bodies_that_cannot_be_skipped.set(offset);
+        return false;
     }
+    discard_saved_state();
 
-    output_node.shrink_to_fit();
+    // Stand-ins for the uses of these names, so the function's scope passes them on to the scopes around it.
+    for (auto const& name : free_names.value())
+        (void)create_identifier_and_register_in_current_scope({ m_source_code, position(), position() }, name);
+    return true;
 }
 
 // FunctionBody, https://tc39.es/ecma262/#prod-FunctionBody
-NonnullRefPtr<FunctionBody const> Parser::parse_function_body(Vector<FunctionParameter> const& parameters, FunctionKind function_kind, FunctionParsingInsights& parsing_insights)
+NonnullRefPtr<FunctionBody const> Parser::parse_function_body(Vector<FunctionParameter> const& parameters, FunctionKind function_kind, FunctionParsingInsights& parsing_insights, bool* body_was_skipped)
 {
     auto rule_start = push_start();
     auto function_body = create_ast_node<FunctionBody>({ m_source_code, rule_start.position(), position() });
@@ -2809,7 +4353,16 @@ NonnullRefPtr<FunctionBody const> Parser::parse_function_body(Vector<FunctionPar
         function_body->set_strict_mode();
     }
 
-    parse_statement_list(function_body);
+    bool skipped = false;
+    if (body_was_skipped
+        && m_state.errors.is_empty()
+        && !m_function_bodies_that_cannot_be_skipped.contains(rule_start.position().offset)
+        && !m_state.current_scope_pusher->contains_direct_call_to_eval()) {
+        skipped = skip_function_body_statements(parameters);
+        *body_was_skipped = skipped;
+    }
+    if (!skipped)
+        parse_statement_list(function_body);
 
     // If we're parsing the function body standalone, e.g. via CreateDynamicFunction, we must have reached EOF here.
     // Otherwise, we need a closing curly bracket (which is consumed elsewhere). If we get neither, it's an error.
@@ -2882,6 +4435,20 @@ NonnullRefPtr<BlockStatement const> Parser::parse_block_statement()
     return block;
 }
 
+// Like other engines, assume that a function expression right after an opening parenthesis or a `!` is called
+// right away, as in `(function() { ... })()` or `!function() { ... }()`, so deferring its body would only cost time.
+static bool is_probably_immediately_invoked(Lexer const& lexer, size_t function_start_offset)
+{
+    auto const& source = lexer.source();
+    for (auto i = function_start_offset - lexer.source_offset(); i > 0; --i) {
+        auto ch = source[i - 1];
+        if (is_ascii_space(ch))
+            continue;
+        return ch == '(' || ch == '!';
+    }
+    return false;
+}
+
 template<typename FunctionNodeType>
 NonnullRefPtr<FunctionNodeType> Parser::parse_function_node(u16 parse_options, Optional<Position> const& function_start)
 {
@@ -2890,6 +4457,23 @@ NonnullRefPtr<FunctionNodeType> Parser::parse_function_node(u16 parse_options, O
         : push_start();
     VERIFY(!(parse_options & FunctionNodeParseOptions::IsGetterFunction && parse_options & FunctionNodeParseOptions::IsSetterFunction));
 
+    constexpr auto is_function_expression = IsSame<FunctionNodeType, FunctionExpression>;
+
+    // Methods, accessors and anything in a class body are always parsed eagerly, as super and private names
+    // depend on the code around them. So are functions in catch or formal parameters, for which the scope
+    // analysis is different, and function expressions that look like they're called right away.
+    constexpr u16 parse_options_allowing_lazy_parsing = FunctionNodeParseOptions::CheckForFunctionAndName
+        | FunctionNodeParseOptions::IsGeneratorFunction
+        | FunctionNodeParseOptions::IsAsyncFunction
+        | FunctionNodeParseOptions::HasDefaultExportName;
+    bool might_parse_body_lazily = s_lazy_parsing_enabled
+        && (parse_options & ~parse_options_allowing_lazy_parsing) == 0
+        && !m_state.referenced_private_names
+        && !m_state.in_catch_parameter_context
+        && !m_state.in_formal_parameter_context
+        && !(is_function_expression && is_probably_immediately_invoked(m_state.lexer, rule_start.position().offset));
+    auto starts_in_strict_mode = m_state.strict_mode;
+
     TemporaryChange super_property_access_rollback(m_state.allow_super_property_lookup, !!(parse_options & FunctionNodeParseOptions::AllowSuperPropertyLookup));
     TemporaryChange super_constructor_call_rollback(m_state.allow_super_constructor_call, !!(parse_options & FunctionNodeParseOptions::AllowSuperConstructorCall));
     TemporaryChange break_context_rollback(m_state.in_break_context, false);
@@ -2898,7 +4482,6 @@ NonnullRefPtr<FunctionNodeType> Parser::parse_function_node(u16 parse_options, O
     TemporaryChange might_need_arguments_object_rollback(m_state.function_might_need_arguments_object, false);
     TemporaryChange in_formal_parameter_context_rollback(m_state.in_formal_parameter_context, false);
 
-    constexpr auto is_function_expression = IsSame<FunctionNodeType, FunctionExpression>;
     FunctionKind function_kind;
     if ((parse_options & FunctionNodeParseOptions::IsGeneratorFunction) != 0 && (parse_options & FunctionNodeParseOptions::IsAsyncFunction) != 0)
         function_kind = FunctionKind::AsyncGenerator;
@@ -2953,9 +4536,16 @@ NonnullRefPtr<FunctionNodeType> Parser::parse_function_node(u16 parse_options, O
     i32 function_length = -1;
     Vector<FunctionParameter> parameters;
     FunctionParsingInsights parsing_insights;
+    Position parameters_start;
+    Position body_start;
+    Vector<NonnullRefPtr<Identifier>> free_identifiers;
+    bool body_was_skipped = false;
     auto body = [&] {
         ScopePusher function_scope = ScopePusher::function_scope(*this, name);
+        if (might_parse_body_lazily)
+            function_scope.set_free_identifiers_sink(free_identifiers);
 
+        parameters_start = position();
         consume(TokenType::ParenOpen);
         parameters = parse_formal_parameters(function_length, parse_options);
         consume(TokenType::ParenClose);
@@ -2972,7 +4562,8 @@ NonnullRefPtr<FunctionNodeType> Parser::parse_function_node(u16 parse_options, O
 
         consume(TokenType::CurlyOpen);
 
-        auto body = parse_function_body(parameters, function_kind, parsing_insights);
+        body_start = position();
+        auto body = parse_function_body(parameters, function_kind, parsing_insights, might_parse_body_lazily && function_kind == FunctionKind::Normal ? &body_was_skipped : nullptr);
         return body;
     }();
 
@@ -2986,11 +4577,32 @@ NonnullRefPtr<FunctionNodeType> Parser::parse_function_node(u16 parse_options, O
 
     auto function_start_offset = rule_start.position().offset;
     auto function_end_offset = position().offset - m_state.current_token.trivia().length();
-    auto source_text = ByteString { m_state.lexer.source().substring_view(function_start_offset, function_end_offset - function_start_offset) };
+    auto source_text = ByteString { m_state.lexer.source_view(function_start_offset, function_end_offset - function_start_offset) };
     parsing_insights.might_need_arguments_object = m_state.function_might_need_arguments_object;
+
+    NonnullRefPtr<Statement const> function_body = move(body);
+    auto body_size = function_end_offset - body_start.offset;
+    if (body_was_skipped) {
+        // Only keep one identifier per name, which is all that's needed to find out if the name is global.
+        HashTable<DeprecatedFlyString> free_identifier_names;
+        Vector<NonnullRefPtr<Identifier const>> representative_free_identifiers;
+        for (auto& identifier : free_identifiers) {
+            if (free_identifier_names.set(identifier->string()) == AK::HashSetResult::InsertedNewEntry)
+                representative_free_identifiers.append(identifier);
+        }
+
+        function_body = create_ast_node<LazyFunctionBody>(
+            { m_source_code, body_start, body_start },
+            source_text, function_start_offset, parameters_start, parse_options, function_kind,
+            starts_in_strict_mode, m_program_type, move(representative_free_identifiers));
+
+        ++s_lazy_parsing_statistics.skipped_function_count;
+        s_lazy_parsing_statistics.skipped_bytes += body_size;
+    }
+
     return create_ast_node<FunctionNodeType>(
         { m_source_code, rule_start.position(), position() },
-        name, move(source_text), move(body), move(parameters), function_length,
+        name, move(source_text), move(function_body), move(parameters), function_length,
         function_kind, has_strict_directive, parsing_insights,
         move(local_variables_names));
 }
@@ -5187,4 +6799,62 @@ Parser Parser::parse_function_body_from_string(ByteString const& body_string, u1
     return body_parser;
 }
 
+Optional<LazyFunctionBody::Parsed> Parser::parse_lazy_function_body(LazyFunctionBody const& lazy_body)
+{
+    // Parse from the start of the formal parameters, which is where the function's scope starts, with the same
+    // offsets, lines and columns as the first time around.
+    auto const& parameters_start = lazy_body.parameters_start();
+    auto source = lazy_body.function_source_text().substring_view(parameters_start.offset - lazy_body.function_start_offset());
+    Lexer lexer { ByteString { source }, parameters_start.offset, lazy_body.source_code().filename(), parameters_start.line, parameters_start.column - 1 };
+    Parser parser { move(lexer), lazy_body.source_code(), lazy_body.program_type() };
+
+    auto kind = lazy_body.kind();
+    parser.m_state.strict_mode = lazy_body.starts_in_strict_mode();
+    parser.m_state.in_generator_function_context = kind == FunctionKind::Generator || kind == FunctionKind::AsyncGenerator;
+    parser.m_state.await_expression_is_valid = kind == FunctionKind::Async || kind == FunctionKind::AsyncGenerator;
+
+    // Which names are global variables depends on the whole script, so that comes from the first parse.
+    HashTable<DeprecatedFlyString> global_names;
+    for (auto const& identifier : lazy_body.free_identifiers()) {
+        if (identifier->is_global())
+            global_names.set(identifier->string());
+    }
+
+    FunctionParsingInsights parsing_insights;
+    Vector<FunctionParameter> parameters;
+    Vector<NonnullRefPtr<Identifier>> free_identifiers;
+    auto body = [&] {
+        ScopePusher function_scope = ScopePusher::function_scope(parser);
+        function_scope.set_free_identifiers_sink(free_identifiers);
+
+        parser.consume(TokenType::ParenOpen);
+        i32 function_length = -1;
+        parameters = parser.parse_formal_parameters(function_length, lazy_body.parse_options());
+        parser.consume(TokenType::ParenClose);
+
+        TemporaryChange function_context_rollback(parser.m_state.in_function_context, true);
+        parser.consume(TokenType::CurlyOpen);
+        return parser.parse_function_body(parameters, kind, parsing_insights);
+    }();
+    parser.consume(TokenType::CurlyClose);
+    parsing_insights.might_need_arguments_object = parser.m_state.function_might_need_arguments_object;
+
+    // The PreParser has already checked the body for syntax errors, so this would be a bug in one of the two. Let the
+    // caller report it to the script rather than crash.
+    if (parser.has_errors()) {
+        for (auto const& error : parser.errors())
+            dbgln("Failed to parse lazy function body: {}", error.to_string());
+        return {};
+    }
+
+    for (auto& identifier : free_identifiers) {
+        if (global_names.contains(identifier->string()))
+            identifier->set_is_global();
+    }
+
+    ++s_lazy_parsing_statistics.reparsed_function_count;
+    s_lazy_parsing_statistics.reparsed_bytes += lazy_body.function_start_offset() + lazy_body.function_source_text().length() - body->start_offset();
+    return LazyFunctionBody::Parsed { move(body), move(parameters), parsing_insights };
+}
+
 }
@@ -43,6 +43,7 @@ struct FunctionNodeParseOptions {
 };
 
 class ScopePusher;
+class PreParser;
 
 class Parser {
 public:
@@ -87,7 +88,9 @@ public:
 
     NonnullRefPtr<Statement const> parse_statement(AllowLabelledFunction allow_labelled_function = AllowLabelledFunction::No);
     NonnullRefPtr<BlockStatement const> parse_block_statement();
-    NonnullRefPtr<FunctionBody const> parse_function_body(Vector<FunctionParameter> const& parameters, FunctionKind function_kind, FunctionParsingInsights&);
+    // If `body_was_skipped` is given, the statements of the body are only checked by the PreParser if it understands
+    // them, which leaves the returned body empty. It's set to whether that happened.
+    NonnullRefPtr<FunctionBody const> parse_function_body(Vector<FunctionParameter> const& parameters, FunctionKind function_kind, FunctionParsingInsights&, bool* body_was_skipped = nullptr);
     NonnullRefPtr<ReturnStatement const> parse_return_statement();
 
     enum class IsForLoopVariableDeclaration {
@@ -213,8 +216,27 @@ public:
 
     static Parser parse_function_body_from_string(ByteString const& body_string, u16 parse_options, Vector<FunctionParameter> const& parameters, FunctionKind kind, FunctionParsingInsights&);
 
+    // With lazy parsing enabled, the bodies of functions that are unlikely to be called right away are only checked
+    // for syntax errors and scanned for the names they use, leaving a LazyFunctionBody. This parses them properly
+    // when the function is first called. Returns an empty Optional if that fails.
+    static Optional<LazyFunctionBody::Parsed> parse_lazy_function_body(LazyFunctionBody const&);
+
+    static bool is_lazy_parsing_enabled() { return s_lazy_parsing_enabled; }
+    static void set_lazy_parsing_enabled(bool enabled) { s_lazy_parsing_enabled = enabled; }
+
+    struct LazyParsingStatistics {
+        size_t skipped_function_count { 0 };
+        size_t skipped_bytes { 0 };
+        size_t reparsed_function_count { 0 };
+        size_t reparsed_bytes { 0 };
+    };
+    static LazyParsingStatistics const& lazy_parsing_statistics() { return s_lazy_parsing_statistics; }
+
 private:
     friend class ScopePusher;
+    friend class PreParser;
+
+    Parser(Lexer, NonnullRefPtr<SourceCode const>, Program::Type);
 
     void parse_script(Program& program, bool starts_in_strict_mode);
     void parse_module(Program& program);
@@ -269,6 +291,7 @@ private:
 
     bool parse_directive(ScopeNode& body);
     void parse_statement_list(ScopeNode& output_node, AllowLabelledFunction allow_labelled_functions = AllowLabelledFunction::No);
+    bool skip_function_body_statements(Vector<FunctionParameter> const& parameters);
 
     DeprecatedFlyString consume_string_value();
     ModuleRequest parse_module_request();
@@ -341,6 +364,11 @@ private:
     DeprecatedFlyString m_filename;
     Vector<ParserState> m_saved_state;
     HashMap<size_t, TokenMemoization> m_token_memoizations;
+    // The offsets of the function bodies that the PreParser was inside of when it gave up, so they aren't tried again.
+    HashTable<size_t> m_function_bodies_that_cannot_be_skipped;
     Program::Type m_program_type;
+
+    static bool s_lazy_parsing_enabled;
+    static LazyParsingStatistics s_lazy_parsing_statistics;
 };
 }
@@ -27,9 +27,9 @@ GC::Ref<ArrayBuffer> ArrayBuffer::create(Realm& realm, ByteBuffer buffer)
     return realm.create<ArrayBuffer>(move(buffer), realm.intrinsics().array_buffer_prototype());
 }
 
-GC::Ref<ArrayBuffer> ArrayBuffer::create(Realm& realm, ByteBuffer* buffer)
+GC::Ref<ArrayBuffer> ArrayBuffer::create_with_external_storage(Realm& realm, Bytes external_storage)
 {
-    return realm.create<ArrayBuffer>(buffer, realm.intrinsics().array_buffer_prototype());
+    return realm.create<ArrayBuffer>(external_storage, realm.intrinsics().array_buffer_prototype());
 }
 
 ArrayBuffer::ArrayBuffer(ByteBuffer buffer, Object& prototype)
@@ -39,9 +39,9 @@ ArrayBuffer::ArrayBuffer(ByteBuffer buffer, Object& prototype)
 {
 }
 
-ArrayBuffer::ArrayBuffer(ByteBuffer* buffer, Object& prototype)
+ArrayBuffer::ArrayBuffer(Bytes external_storage, Object& prototype)
     : Object(ConstructWithPrototypeTag::Tag, prototype)
-    , m_data_block(DataBlock { buffer, DataBlock::Shared::No })
+    , m_data_block(DataBlock { external_storage, DataBlock::Shared::No })
     , m_detach_key(js_undefined())
 {
 }
@@ -88,10 +88,10 @@ static ThrowCompletionOr<DataBlock> create_shared_byte_data_block(VM& vm, size_t
 }
 
 // 6.2.9.3 CopyDataBlockBytes ( toBlock, toIndex, fromBlock, fromIndex, count ), https://tc39.es/ecma262/#sec-copydatablockbytes
-void copy_data_block_bytes(ByteBuffer& to_block, u64 to_index, ByteBuffer const& from_block, u64 from_index, u64 count)
+void copy_data_block_bytes(Bytes to_block, u64 to_index, ReadonlyBytes from_block, u64 from_index, u64 count)
 {
     // 1. Assert: fromBlock and toBlock are distinct values.
-    VERIFY(&to_block != &from_block);
+    VERIFY(to_block.data() != from_block.data() || to_block.is_empty());
 
     // 2. Let fromSize be the number of bytes in fromBlock.
     auto from_size = from_block.size();
@@ -156,7 +156,7 @@ ThrowCompletionOr<ArrayBuffer*> allocate_array_buffer(VM& vm, FunctionObject& co
     }
 
     // 4. Let obj be ? OrdinaryCreateFromConstructor(constructor, "%ArrayBuffer.prototype%", slots).
-    auto obj = TRY(ordinary_create_from_constructor<ArrayBuffer>(vm, constructor, &Intrinsics::array_buffer_prototype, nullptr));
+    auto obj = TRY(ordinary_create_from_constructor<ArrayBuffer>(vm, constructor, &Intrinsics::array_buffer_prototype, ByteBuffer {}));
 
     // 5. Let block be ? CreateByteDataBlock(byteLength).
     auto block = TRY(create_byte_data_block(vm, byte_length));
@@ -170,7 +170,7 @@ ThrowCompletionOr<ArrayBuffer*> allocate_array_buffer(VM& vm, FunctionObject& co
     if (allocating_resizable_buffer) {
         // a. If it is not possible to create a Data Block block consisting of maxByteLength bytes, throw a RangeError exception.
         // b. NOTE: Resizable ArrayBuffers are designed to be implementable with in-place growth. Implementations may throw if, for example, virtual memory cannot be reserved up front.
-        if (auto result = obj->buffer().try_ensure_capacity(*max_byte_length); result.is_error())
+        if (auto result = obj->owned_buffer().try_ensure_capacity(*max_byte_length); result.is_error())
             return vm.throw_completion<RangeError>(ErrorType::NotEnoughMemoryToAllocate, *max_byte_length);
 
         // c. Set obj.[[ArrayBufferMaxByteLength]] to maxByteLength.
@@ -271,10 +271,10 @@ ThrowCompletionOr<ArrayBuffer*> clone_array_buffer(VM& vm, ArrayBuffer& source_b
     auto* target_buffer = TRY(allocate_array_buffer(vm, realm.intrinsics().array_buffer_constructor(), source_length));
 
     // 3. Let srcBlock be srcBuffer.[[ArrayBufferData]].
-    auto& source_block = source_buffer.buffer();
+    auto source_block = source_buffer.buffer();
 
     // 4. Let targetBlock be targetBuffer.[[ArrayBufferData]].
-    auto& target_block = target_buffer->buffer();
+    auto target_block = target_buffer->buffer();
 
     // 5. Perform CopyDataBlockBytes(targetBlock, 0, srcBlock, srcByteOffset, srcLength).
     copy_data_block_bytes(target_block, 0, source_block, source_byte_offset, source_length);
@@ -305,7 +305,7 @@ ThrowCompletionOr<Optional<size_t>> get_array_buffer_max_byte_length_option(VM&
 ThrowCompletionOr<GC::Ref<ArrayBuffer>> allocate_shared_array_buffer(VM& vm, FunctionObject& constructor, size_t byte_length)
 {
     // 1. Let obj be ? OrdinaryCreateFromConstructor(constructor, "%SharedArrayBuffer.prototype%", « [[ArrayBufferData]], [[ArrayBufferByteLength]] »).
-    auto obj = TRY(ordinary_create_from_constructor<ArrayBuffer>(vm, constructor, &Intrinsics::shared_array_buffer_prototype, nullptr));
+    auto obj = TRY(ordinary_create_from_constructor<ArrayBuffer>(vm, constructor, &Intrinsics::shared_array_buffer_prototype, ByteBuffer {}));
 
     // 2. Let block be ? CreateSharedByteDataBlock(byteLength).
     auto block = TRY(create_shared_byte_data_block(vm, byte_length));
@@ -34,23 +34,26 @@ struct DataBlock {
         Yes,
     };
 
-    ByteBuffer& buffer()
+    Bytes buffer()
     {
-        ByteBuffer* ptr { nullptr };
-        byte_buffer.visit([&](Empty) { VERIFY_NOT_REACHED(); }, [&](auto* pointer) { ptr = pointer; }, [&](auto& value) { ptr = &value; });
-        return *ptr;
+        if (auto* buffer = byte_buffer.get_pointer<ByteBuffer>())
+            return buffer->bytes();
+        return byte_buffer.get<Bytes>();
     }
-    ByteBuffer const& buffer() const { return const_cast<DataBlock*>(this)->buffer(); }
+    ReadonlyBytes buffer() const { return const_cast<DataBlock*>(this)->buffer(); }
+
+    // Only a data block that owns its bytes can change its size.
+    ByteBuffer& owned_buffer() { return byte_buffer.get<ByteBuffer>(); }
 
     size_t size() const
     {
         return byte_buffer.visit(
             [](Empty) -> size_t { return 0u; },
-            [](ByteBuffer const& buffer) { return buffer.size(); },
-            [](ByteBuffer const* buffer) { return buffer->size(); });
+            [](auto const& buffer) { return buffer.size(); });
     }
 
-    Variant<Empty, ByteBuffer, ByteBuffer*> byte_buffer;
+    // External storage, such as the memory of a WebAssembly instance, is owned by whoever created the data block.
+    Variant<Empty, ByteBuffer, Bytes> byte_buffer;
     Shared is_shared = { Shared::No };
 };
 
@@ -61,15 +64,16 @@ class ArrayBuffer : public Object {
 public:
     static ThrowCompletionOr<GC::Ref<ArrayBuffer>> create(Realm&, size_t);
     static GC::Ref<ArrayBuffer> create(Realm&, ByteBuffer);
-    static GC::Ref<ArrayBuffer> create(Realm&, ByteBuffer*);
+    static GC::Ref<ArrayBuffer> create_with_external_storage(Realm&, Bytes);
 
     virtual ~ArrayBuffer() override = default;
 
     size_t byte_length() const { return m_data_block.size(); }
 
     // [[ArrayBufferData]]
-    ByteBuffer& buffer() { return m_data_block.buffer(); }
-    ByteBuffer const& buffer() const { return m_data_block.buffer(); }
+    Bytes buffer() { return m_data_block.buffer(); }
+    ReadonlyBytes buffer() const { return m_data_block.buffer(); }
+    ByteBuffer& owned_buffer() { return m_data_block.owned_buffer(); }
 
     // [[ArrayBufferMaxByteLength]]
     size_t max_byte_length() const { return m_max_byte_length.value(); }
@@ -133,7 +137,7 @@ public:
 
 private:
     ArrayBuffer(ByteBuffer buffer, Object& prototype);
-    ArrayBuffer(ByteBuffer* buffer, Object& prototype);
+    ArrayBuffer(Bytes external_storage, Object& prototype);
 
     virtual void visit_edges(Visitor&) override;
 
@@ -146,7 +150,7 @@ private:
 };
 
 ThrowCompletionOr<DataBlock> create_byte_data_block(VM& vm, size_t size);
-void copy_data_block_bytes(ByteBuffer& to_block, u64 to_index, ByteBuffer const& from_block, u64 from_index, u64 count);
+void copy_data_block_bytes(Bytes to_block, u64 to_index, ReadonlyBytes from_block, u64 from_index, u64 count);
 ThrowCompletionOr<ArrayBuffer*> allocate_array_buffer(VM&, FunctionObject& constructor, size_t byte_length, Optional<size_t> const& max_byte_length = {});
 ThrowCompletionOr<ArrayBuffer*> array_buffer_copy_and_detach(VM&, ArrayBuffer& array_buffer, Value new_length, PreserveResizability preserve_resizability);
 ThrowCompletionOr<void> detach_array_buffer(VM&, ArrayBuffer& array_buffer, Optional<Value> key = {});
@@ -267,10 +271,10 @@ Value ArrayBuffer::get_value(size_t byte_index, [[maybe_unused]] bool is_typed_a
     VERIFY(!is_detached());
 
     // 2. Assert: There are sufficient bytes in arrayBuffer starting at byteIndex to represent a value of type.
-    VERIFY(m_data_block.buffer().bytes().slice(byte_index).size() >= sizeof(T));
+    VERIFY(m_data_block.buffer().slice(byte_index).size() >= sizeof(T));
 
     // 3. Let block be arrayBuffer.[[ArrayBufferData]].
-    auto& block = m_data_block.buffer();
+    auto block = m_data_block.buffer();
 
     // 4. Let elementSize be the Element Size value specified in Table 70 for Element Type type.
     auto element_size = sizeof(T);
@@ -291,7 +295,7 @@ Value ArrayBuffer::get_value(size_t byte_index, [[maybe_unused]] bool is_typed_a
     // 6. Else,
     else {
         // a. Let rawValue be a List whose elements are bytes from block at indices in the interval from byteIndex (inclusive) to byteIndex + elementSize (exclusive).
-        block.bytes().slice(byte_index, element_size).copy_to(raw_value);
+        block.slice(byte_index, element_size).copy_to(raw_value);
     }
 
     // 7. Assert: The number of elements in rawValue is elementSize.
@@ -386,7 +390,7 @@ void ArrayBuffer::set_value(size_t byte_index, Value value, [[maybe_unused]] boo
     VERIFY(!is_detached());
 
     // 2. Assert: There are sufficient bytes in arrayBuffer starting at byteIndex to represent a value of type.
-    VERIFY(m_data_block.buffer().bytes().slice(byte_index).size() >= sizeof(T));
+    VERIFY(m_data_block.buffer().slice(byte_index).size() >= sizeof(T));
 
     // 3. Assert: value is a BigInt if IsBigIntElementType(type) is true; otherwise, value is a Number.
     if constexpr (IsIntegral<T> && sizeof(T) == 8)
@@ -395,7 +399,7 @@ void ArrayBuffer::set_value(size_t byte_index, Value value, [[maybe_unused]] boo
         VERIFY(value.is_number());
 
     // 4. Let block be arrayBuffer.[[ArrayBufferData]].
-    auto& block = m_data_block.buffer();
+    auto block = m_data_block.buffer();
 
     // FIXME: 5. Let elementSize be the Element Size value specified in Table 70 for Element Type type.
 
@@ -416,7 +420,7 @@ void ArrayBuffer::set_value(size_t byte_index, Value value, [[maybe_unused]] boo
     // 9. Else,
     else {
         // a. Store the individual bytes of rawBytes into block, starting at block[byteIndex].
-        raw_bytes.span().copy_to(block.span().slice(byte_index));
+        raw_bytes.span().copy_to(block.slice(byte_index));
     }
 
     // 10. Return unused.
@@ -434,9 +438,9 @@ Value ArrayBuffer::get_modify_set_value(size_t byte_index, Value value, ReadWrit
     // FIXME: Check for shared buffer
 
     auto raw_bytes_read = MUST(ByteBuffer::create_uninitialized(sizeof(T)));
-    m_data_block.buffer().bytes().slice(byte_index, sizeof(T)).copy_to(raw_bytes_read);
+    m_data_block.buffer().slice(byte_index, sizeof(T)).copy_to(raw_bytes_read);
     auto raw_bytes_modified = operation(raw_bytes_read, raw_bytes);
-    raw_bytes_modified.span().copy_to(m_data_block.buffer().span().slice(byte_index));
+    raw_bytes_modified.span().copy_to(m_data_block.buffer().slice(byte_index));
 
     return raw_bytes_to_numeric<T>(vm, raw_bytes_read, is_little_endian);
 }
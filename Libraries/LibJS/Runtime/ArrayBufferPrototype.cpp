@@ -154,7 +154,7 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayBufferPrototype::resize)
         return js_undefined();
 
     // 9. Let oldBlock be O.[[ArrayBufferData]].
-    auto const& old_block = array_buffer_object->buffer();
+    auto old_block = array_buffer_object->buffer();
 
     // 10. Let newBlock be ? CreateByteDataBlock(newByteLength).
     auto new_block = TRY(create_byte_data_block(vm, new_byte_length));
@@ -264,10 +264,10 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayBufferPrototype::slice)
         return vm.throw_completion<TypeError>(ErrorType::DetachedArrayBuffer);
 
     // 24. Let fromBuf be O.[[ArrayBufferData]].
-    auto& from_buf = array_buffer_object->buffer();
+    auto from_buf = array_buffer_object->buffer();
 
     // 25. Let toBuf be new.[[ArrayBufferData]].
-    auto& to_buf = new_array_buffer_object->buffer();
+    auto to_buf = new_array_buffer_object->buffer();
 
     // 26. Let currentLen be O.[[ArrayBufferByteLength]].
     auto current_length = array_buffer_object->byte_length();
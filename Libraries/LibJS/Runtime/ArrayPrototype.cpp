@@ -9,6 +9,7 @@
 
 #include <AK/Function.h>
 #include <AK/HashTable.h>
+#include <AK/QuickSort.h>
 #include <AK/ScopeGuard.h>
 #include <AK/StringBuilder.h>
 #include <LibJS/Runtime/AbstractOperations.h>
@@ -344,6 +345,163 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::every)
     return Value(true);
 }
 
+// Returns the storage of an Array whose elements below length are all present data properties, which makes
+// HasProperty and Get on them unobservable, so they can be read and overwritten directly.
+static SimpleIndexedPropertyStorage* packed_array_storage(Object& object, size_t length)
+{
+    if (!is<Array>(object) || object.may_interfere_with_indexed_property_access())
+        return nullptr;
+    auto* storage = object.indexed_properties().storage();
+    if (!storage || !storage->is_simple_storage())
+        return nullptr;
+    auto& simple_storage = static_cast<SimpleIndexedPropertyStorage&>(*storage);
+    if (!simple_storage.is_packed() || simple_storage.array_like_size() < length)
+        return nullptr;
+    return &simple_storage;
+}
+
+// Returns whether the prototype chain of an Array is the Array.prototype and Object.prototype of its realm, and neither of
+// them has any indexed properties that could show through the holes of the array.
+static bool has_unmodified_prototype_chain(Object const& array)
+{
+    auto& intrinsics = array.shape().realm().intrinsics();
+    auto const* array_prototype = array.prototype();
+    if (array_prototype != intrinsics.array_prototype().ptr())
+        return false;
+    auto const* object_prototype = array_prototype->prototype();
+    if (object_prototype != intrinsics.object_prototype().ptr())
+        return false;
+    return array_prototype->indexed_properties().is_empty() && object_prototype->indexed_properties().is_empty();
+}
+
+// Like packed_array_storage(), but also allows holes as long as the prototype chain can't fill them in, which makes
+// them absent for HasProperty and undefined for Get.
+static SimpleIndexedPropertyStorage const* directly_readable_array_storage(Object& object, size_t length)
+{
+    if (!is<Array>(object) || object.may_interfere_with_indexed_property_access())
+        return nullptr;
+    auto const* storage = object.indexed_properties().storage();
+    if (!storage || !storage->is_simple_storage())
+        return nullptr;
+    auto const& simple_storage = static_cast<SimpleIndexedPropertyStorage const&>(*storage);
+    if (simple_storage.array_like_size() < length)
+        return nullptr;
+    if (!simple_storage.is_packed() && !has_unmodified_prototype_chain(object))
+        return nullptr;
+    return &simple_storage;
+}
+
+struct DirectElement {
+    bool is_present { false };
+    Value value;
+};
+
+// Reads element k like HasProperty followed by Get would, if neither can be observed. Callbacks may change the array and
+// its prototypes at any time, so this is validated again on every read.
+static Optional<DirectElement> read_element_directly(Object& object, size_t k)
+{
+    auto const* storage = directly_readable_array_storage(object, k + 1);
+    if (!storage)
+        return {};
+    auto value = storage->elements().data()[k];
+    if (value.is_accessor())
+        return {};
+    return DirectElement { .is_present = !value.is_empty(), .value = value };
+}
+
+enum class SearchDirection {
+    Forward,
+    Backward,
+};
+
+enum class SearchComparison {
+    // IsStrictlyEqual, skipping holes.
+    StrictlyEqual,
+    // SameValueZero, reading holes as undefined.
+    SameValueZero,
+};
+
+// Finds an element in [from, to) that matches search_element, specialized for the kind of the storage.
+static Optional<size_t> find_element(SimpleIndexedPropertyStorage const& storage, Value search_element, size_t from, size_t to, SearchDirection direction, SearchComparison comparison)
+{
+    auto const* elements = storage.elements().data();
+    auto find = [&](auto matches) -> Optional<size_t> {
+        if (direction == SearchDirection::Forward) {
+            for (size_t i = from; i < to; ++i) {
+                if (matches(elements[i]))
+                    return i;
+            }
+        } else {
+            for (size_t i = to; i > from; --i) {
+                if (matches(elements[i - 1]))
+                    return i - 1;
+            }
+        }
+        return {};
+    };
+
+    if (!storage.holds_only_numbers()) {
+        if (comparison == SearchComparison::StrictlyEqual)
+            return find([&](Value element) { return !element.is_empty() && is_strictly_equal(search_element, element); });
+        return find([&](Value element) { return same_value_zero(element.is_empty() ? js_undefined() : element, search_element); });
+    }
+
+    if (!search_element.is_number())
+        return {};
+    auto number = search_element.as_double();
+
+    if (storage.kind() == ElementsKind::PackedInt32) {
+        // NOTE: This also rejects NaN, which no Int32 is the same as either, and lets -0 find +0.
+        if (trunc(number) != number || number < NumericLimits<i32>::min() || number > NumericLimits<i32>::max())
+            return {};
+        auto int32 = static_cast<i32>(number);
+        return find([&](Value element) { return element.as_i32() == int32; });
+    }
+
+    if (isnan(number)) {
+        if (comparison == SearchComparison::StrictlyEqual)
+            return {};
+        return find([&](Value element) { return element.is_nan(); });
+    }
+    return find([&](Value element) { return element.as_double() == number; });
+}
+
+// Compares the decimal string representations of two Int32s like IsLessThan would, without creating the strings.
+static int compare_int32_as_strings(i32 a, i32 b)
+{
+    // '-' sorts before every digit.
+    if ((a < 0) != (b < 0))
+        return a < 0 ? -1 : 1;
+
+    auto magnitude = [](i32 value) { return value < 0 ? static_cast<u64>(-static_cast<i64>(value)) : static_cast<u64>(value); };
+    auto digit_count = [](u64 value) {
+        size_t count = 1;
+        while (value >= 10) {
+            value /= 10;
+            ++count;
+        }
+        return count;
+    };
+
+    auto x = magnitude(a);
+    auto y = magnitude(b);
+    auto x_digits = digit_count(x);
+    auto y_digits = digit_count(y);
+
+    // Pad the shorter number with zeros to compare digit by digit. If that makes them equal, the shorter one is a prefix of the other.
+    auto padded_x = x;
+    auto padded_y = y;
+    for (auto i = x_digits; i < y_digits; ++i)
+        padded_x *= 10;
+    for (auto i = y_digits; i < x_digits; ++i)
+        padded_y *= 10;
+    if (padded_x != padded_y)
+        return padded_x < padded_y ? -1 : 1;
+    if (x_digits != y_digits)
+        return x_digits < y_digits ? -1 : 1;
+    return 0;
+}
+
 // 23.1.3.7 Array.prototype.fill ( value [ , start [ , end ] ] ), https://tc39.es/ecma262/#sec-array.prototype.fill
 JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::fill)
 {
@@ -379,6 +537,15 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::fill)
     else
         to = min(relative_end, length);
 
+    // OPTIMIZATION: Elements of a packed array can be overwritten in place, as nothing can observe the Set.
+    if (auto* storage = packed_array_storage(this_object, length)) {
+        auto value = vm.argument(0);
+        for (u64 i = from; i < to; i++)
+            storage->inline_overwrite(i, value);
+        GC::write_barrier(*this_object, value);
+        return this_object;
+    }
+
     for (u64 i = from; i < to; i++)
         TRY(this_object->set(i, vm.argument(0), Object::ShouldThrowExceptions::Yes));
 
@@ -415,13 +582,16 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::filter)
         // a. Let Pk be ! ToString(𝔽(k)).
         auto property_key = PropertyKey { k };
 
+        // OPTIMIZATION: Read the element directly when HasProperty and Get can't be observed.
+        auto direct_element = read_element_directly(object, k);
+
         // b. Let kPresent be ? HasProperty(O, Pk).
-        auto k_present = TRY(object->has_property(property_key));
+        auto k_present = direct_element.has_value() ? direct_element->is_present : TRY(object->has_property(property_key));
 
         // c. If kPresent is true, then
         if (k_present) {
             // i. Let kValue be ? Get(O, Pk).
-            auto k_value = TRY(object->get(k));
+            auto k_value = direct_element.has_value() ? direct_element->value : TRY(object->get(property_key));
 
             // ii. Let selected be ToBoolean(? Call(callbackfn, thisArg, « kValue, 𝔽(k), O »)).
             auto selected = TRY(call(vm, callback_function.as_function(), this_arg, k_value, Value(k), object)).to_boolean();
@@ -700,13 +870,16 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::for_each)
         // a. Let Pk be ! ToString(𝔽(k)).
         auto property_key = PropertyKey { k };
 
+        // OPTIMIZATION: Read the element directly when HasProperty and Get can't be observed.
+        auto direct_element = read_element_directly(object, k);
+
         // b. Let kPresent be ? HasProperty(O, Pk).
-        auto k_present = TRY(object->has_property(property_key));
+        auto k_present = direct_element.has_value() ? direct_element->is_present : TRY(object->has_property(property_key));
 
         // c. If kPresent is true, then
         if (k_present) {
             // i. Let kValue be ? Get(O, Pk).
-            auto k_value = TRY(object->get(property_key));
+            auto k_value = direct_element.has_value() ? direct_element->value : TRY(object->get(property_key));
 
             // ii. Perform ? Call(callbackfn, thisArg, « kValue, 𝔽(k), O »).
             TRY(call(vm, callback_function.as_function(), this_arg, k_value, Value(k), object));
@@ -742,6 +915,13 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::includes)
             from_index = from_argument;
     }
     auto value_to_find = vm.argument(0);
+
+    // OPTIMIZATION: Search the elements of an array directly when Get can't be observed.
+    if (auto const* storage = directly_readable_array_storage(this_object, length)) {
+        auto index = find_element(*storage, value_to_find, from_index, length, SearchDirection::Forward, SearchComparison::SameValueZero);
+        return Value(index.has_value());
+    }
+
     for (u64 i = from_index; i < length; ++i) {
         auto element = TRY(this_object->get(i));
         if (same_value_zero(element, value_to_find))
@@ -795,6 +975,14 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::index_of)
         k = max(length + n, 0);
     }
 
+    // OPTIMIZATION: Search the elements of an array directly when HasProperty and Get can't be observed.
+    if (auto const* storage = directly_readable_array_storage(object, length)) {
+        if (k >= length)
+            return Value(-1);
+        auto index = find_element(*storage, search_element, k, length, SearchDirection::Forward, SearchComparison::StrictlyEqual);
+        return index.has_value() ? Value(*index) : Value(-1);
+    }
+
     // 10. Repeat, while k < len,
     for (; k < length; ++k) {
         auto property_key = PropertyKey { k };
@@ -906,6 +1094,14 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::last_index_of)
         k = (double)length + n;
     }
 
+    // OPTIMIZATION: Search the elements of an array directly when HasProperty and Get can't be observed.
+    if (auto const* storage = directly_readable_array_storage(object, length)) {
+        if (k < 0)
+            return Value(-1);
+        auto index = find_element(*storage, search_element, 0, k + 1, SearchDirection::Backward, SearchComparison::StrictlyEqual);
+        return index.has_value() ? Value(*index) : Value(-1);
+    }
+
     // 8. Repeat, while k ≥ 0,
     for (; k >= 0; --k) {
         auto property_key = PropertyKey { k };
@@ -958,13 +1154,16 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::map)
         // a. Let Pk be ! ToString(𝔽(k)).
         auto property_key = PropertyKey { k };
 
+        // OPTIMIZATION: Read the element directly when HasProperty and Get can't be observed.
+        auto direct_element = read_element_directly(object, k);
+
         // b. Let kPresent be ? HasProperty(O, Pk).
-        auto k_present = TRY(object->has_property(property_key));
+        auto k_present = direct_element.has_value() ? direct_element->is_present : TRY(object->has_property(property_key));
 
         // c. If kPresent is true, then
         if (k_present) {
             // i. Let kValue be ? Get(O, Pk).
-            auto k_value = TRY(object->get(property_key));
+            auto k_value = direct_element.has_value() ? direct_element->value : TRY(object->get(property_key));
 
             // ii. Let mappedValue be ? Call(callbackfn, thisArg, « kValue, 𝔽(k), O »).
             auto mapped_value = TRY(call(vm, callback_function.as_function(), this_arg, k_value, Value(k), object));
@@ -1075,13 +1274,16 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::reduce)
         // a. Let Pk be ! ToString(𝔽(k)).
         auto property_key = PropertyKey { k };
 
+        // OPTIMIZATION: Read the element directly when HasProperty and Get can't be observed.
+        auto direct_element = read_element_directly(object, k);
+
         // b. Let kPresent be ? HasProperty(O, Pk).
-        auto k_present = TRY(object->has_property(property_key));
+        auto k_present = direct_element.has_value() ? direct_element->is_present : TRY(object->has_property(property_key));
 
         // c. If kPresent is true, then
         if (k_present) {
             // i. Let kValue be ? Get(O, Pk).
-            auto k_value = TRY(object->get(property_key));
+            auto k_value = direct_element.has_value() ? direct_element->value : TRY(object->get(property_key));
 
             // ii. Set accumulator to ? Call(callbackfn, undefined, « accumulator, kValue, 𝔽(k), O »).
             accumulator = TRY(call(vm, callback_function.as_function(), js_undefined(), accumulator, k_value, Value(k), object));
@@ -1409,6 +1611,21 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::sort)
     // 3. Let len be ? LengthOfArrayLike(obj).
     auto length = TRY(length_of_array_like(vm, object));
 
+    // OPTIMIZATION: Without a comparefn, a packed array of Int32s is sorted by the decimal strings of its elements, which
+    //               can be compared without creating them. Elements that compare equal are equal, so stability doesn't matter.
+    if (comparefn.is_undefined()) {
+        if (auto* storage = packed_array_storage(object, length); storage && storage->kind() == ElementsKind::PackedInt32) {
+            Vector<i32> sorted_elements;
+            sorted_elements.ensure_capacity(length);
+            for (size_t i = 0; i < length; ++i)
+                sorted_elements.unchecked_append(storage->elements().data()[i].as_i32());
+            quick_sort(sorted_elements, [](i32 a, i32 b) { return compare_int32_as_strings(a, b) < 0; });
+            for (size_t i = 0; i < length; ++i)
+                storage->inline_overwrite(i, Value(sorted_elements[i]));
+            return object;
+        }
+    }
+
     // 4. Let SortCompare be a new Abstract Closure with parameters (x, y) that captures comparefn and performs the following steps when called:
     Function<ThrowCompletionOr<double>(Value, Value)> sort_compare = [&](auto x, auto y) -> ThrowCompletionOr<double> {
         // a. Return ? CompareArrayElements(x, y, comparefn).
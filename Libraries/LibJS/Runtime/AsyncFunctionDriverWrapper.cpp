@@ -43,8 +43,10 @@ ThrowCompletionOr<void> AsyncFunctionDriverWrapper::await(JS::Value value)
     auto& realm = *vm.current_realm();
 
     // 1. Let asyncContext be the running execution context.
-    if (!m_suspended_execution_context)
+    if (!m_suspended_execution_context) {
         m_suspended_execution_context = vm.running_execution_context().copy();
+        GC::write_barrier(*this);
+    }
 
     // 2. Let promise be ? PromiseResolve(%Promise%, value).
     auto* promise_object = TRY(promise_resolve(vm, realm.intrinsics().promise_constructor(), value));
@@ -65,6 +67,8 @@ ThrowCompletionOr<void> AsyncFunctionDriverWrapper::await(JS::Value value)
         //    suspended it.
         continue_async_execution(vm, value, true);
         vm.pop_execution_context();
+        // NOTE: The registers of asyncContext were written to without going through the write barrier while it was running.
+        GC::write_barrier(*this);
 
         // e. Assert: When we reach this step, asyncContext has already been removed from the execution context stack and
         //    prevContext is the currently running execution context.
@@ -93,6 +97,8 @@ ThrowCompletionOr<void> AsyncFunctionDriverWrapper::await(JS::Value value)
         //    suspended it.
         continue_async_execution(vm, reason, false);
         vm.pop_execution_context();
+        // NOTE: The registers of asyncContext were written to without going through the write barrier while it was running.
+        GC::write_barrier(*this);
 
         // e. Assert: When we reach this step, asyncContext has already been removed from the execution context stack and
         //    prevContext is the currently running execution context.
@@ -107,6 +113,7 @@ ThrowCompletionOr<void> AsyncFunctionDriverWrapper::await(JS::Value value)
 
     // 7. Perform PerformPromiseThen(promise, onFulfilled, onRejected).
     m_current_promise = as<Promise>(promise_object);
+    GC::write_barrier(*this, m_current_promise.ptr());
     m_current_promise->perform_then(on_fulfilled, on_rejected, {});
 
     // NOTE: None of these are necessary. 8-12 are handled by step d of the above lambdas.
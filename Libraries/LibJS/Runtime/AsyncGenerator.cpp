@@ -58,6 +58,9 @@ void AsyncGenerator::async_generator_enqueue(Completion completion, GC::Ref<Prom
 
     // 2. Append request to generator.[[AsyncGeneratorQueue]].
     m_async_generator_queue.append(move(request));
+    GC::write_barrier(*this, promise_capability.ptr());
+    if (auto const& value = m_async_generator_queue.last().completion.value(); value.has_value())
+        GC::write_barrier(*this, *value);
 
     // 3. Return unused.
 }
@@ -135,11 +138,14 @@ ThrowCompletionOr<void> AsyncGenerator::await(Value value)
 
     // 7. Perform PerformPromiseThen(promise, onFulfilled, onRejected).
     m_current_promise = as<Promise>(promise_object);
+    GC::write_barrier(*this, m_current_promise.ptr());
     m_current_promise->perform_then(on_fulfilled, on_rejected, {});
 
     // 8. Remove asyncContext from the execution context stack and restore the execution context that is at the top of the
     //    execution context stack as the running execution context.
     vm.pop_execution_context();
+    // NOTE: The registers of asyncContext were written to without going through the write barrier while it was running.
+    GC::write_barrier(*this);
 
     // NOTE: None of these are necessary. 10-12 are handled by step d of the above lambdas.
     // 9. Let callerContext be the running execution context.
@@ -194,6 +200,7 @@ void AsyncGenerator::execute(VM& vm, Completion completion)
         auto result_value = move(next_result.value);
         if (!result_value.is_throw_completion()) {
             m_previous_value = result_value.release_value();
+            GC::write_barrier(*this, m_previous_value);
             auto value = generated_value(m_previous_value);
             bool is_await = generated_is_await(m_previous_value);
 
@@ -257,6 +264,7 @@ void AsyncGenerator::execute(VM& vm, Completion completion)
                 // b. Remove genContext from the execution context stack and restore the execution context that is at the top of the
                 //    execution context stack as the running execution context.
                 vm.pop_execution_context();
+                GC::write_barrier(*this);
 
                 // c. Let callerContext be the running execution context.
                 // d. Resume callerContext passing undefined. If genContext is ever resumed again, let resumptionValue be the Completion Record with which it is resumed.
@@ -271,6 +279,7 @@ void AsyncGenerator::execute(VM& vm, Completion completion)
         // 4.e. Assert: If we return here, the async generator either threw an exception or performed either an implicit or explicit return.
         // 4.f. Remove acGenContext from the execution context stack and restore the execution context that is at the top of the execution context stack as the running execution context.
         vm.pop_execution_context();
+        GC::write_barrier(*this);
 
         // 4.g. Set acGenerator.[[AsyncGeneratorState]] to completed.
         m_async_generator_state = State::Completed;
@@ -421,6 +430,7 @@ void AsyncGenerator::await_return()
     // NOTE: await_return should only be called when the generator is in SuspendedStart or Completed state,
     //       so an await shouldn't be running currently, so it should be safe to overwrite m_current_promise.
     m_current_promise = as<Promise>(promise);
+    GC::write_barrier(*this, m_current_promise.ptr());
     m_current_promise->perform_then(on_fulfilled, on_rejected, {});
 
     // 15. Return unused.
@@ -29,6 +29,8 @@ class DeclarativeEnvironment : public Environment {
     };
 
 public:
+    GC_ALLOW_LAZY_SWEEP(DeclarativeEnvironment);
+
     static DeclarativeEnvironment* create_for_per_iteration_bindings(Badge<ForStatement>, DeclarativeEnvironment& other, size_t bindings_size);
 
     virtual ~DeclarativeEnvironment() override = default;
@@ -74,7 +74,9 @@ ECMAScriptFunctionObject::ECMAScriptFunctionObject(DeprecatedFlyString name, Byt
     , m_might_need_arguments_object(parsing_insights.might_need_arguments_object)
     , m_contains_direct_call_to_eval(parsing_insights.contains_direct_call_to_eval)
     , m_is_arrow_function(is_arrow_function)
+    , m_uses_this_from_environment(parsing_insights.uses_this_from_environment)
     , m_kind(kind)
+    , m_uses_this(parsing_insights.uses_this)
 {
     // NOTE: This logic is from OrdinaryFunctionCreate, https://tc39.es/ecma262/#sec-ordinaryfunctioncreate
 
@@ -102,6 +104,34 @@ ECMAScriptFunctionObject::ECMAScriptFunctionObject(DeprecatedFlyString name, Byt
         return true;
     });
 
+    // The rest needs the body, which for lazily parsed functions is only parsed when they are first called.
+    if (!is<LazyFunctionBody>(*m_ecmascript_code))
+        prepare_function_declaration_instantiation();
+}
+
+ThrowCompletionOr<void> ECMAScriptFunctionObject::parse_lazy_body()
+{
+    auto const* parsed = static_cast<LazyFunctionBody const&>(*m_ecmascript_code).parsed();
+    if (!parsed)
+        return vm().throw_completion<InternalError>(ErrorType::LazyFunctionBodyReparseFailed, m_name);
+
+    // NOTE: The first parse skipped the body, so it couldn't tell which parameters and variables are locals, or what
+    //       the body needs from its environment. Everything that depends on that comes from the second parse.
+    m_formal_parameters = parsed->parameters;
+    m_local_variables_names = parsed->body->local_variables_names();
+    m_might_need_arguments_object = parsed->parsing_insights.might_need_arguments_object;
+    m_contains_direct_call_to_eval = parsed->parsing_insights.contains_direct_call_to_eval;
+    m_uses_this_from_environment = parsed->parsing_insights.uses_this_from_environment;
+    m_uses_this = parsed->parsing_insights.uses_this;
+
+    // This may drop the last reference to the LazyFunctionBody, and with it `parsed`.
+    m_ecmascript_code = parsed->body;
+    prepare_function_declaration_instantiation();
+    return {};
+}
+
+void ECMAScriptFunctionObject::prepare_function_declaration_instantiation()
+{
     // NOTE: The following steps are from FunctionDeclarationInstantiation that could be executed once
     //       and then reused in all subsequent function instantiations.
 
@@ -331,8 +361,7 @@ ECMAScriptFunctionObject::ECMAScriptFunctionObject(DeprecatedFlyString name, Byt
         }));
     }
 
-    m_function_environment_needed = arguments_object_needs_binding || m_function_environment_bindings_count > 0 || m_var_environment_bindings_count > 0 || m_lex_environment_bindings_count > 0 || parsing_insights.uses_this_from_environment || m_contains_direct_call_to_eval;
-    m_uses_this = parsing_insights.uses_this;
+    m_function_environment_needed = arguments_object_needs_binding || m_function_environment_bindings_count > 0 || m_var_environment_bindings_count > 0 || m_lex_environment_bindings_count > 0 || m_uses_this_from_environment || m_contains_direct_call_to_eval;
 }
 
 void ECMAScriptFunctionObject::initialize(Realm& realm)
@@ -379,6 +408,9 @@ ThrowCompletionOr<Value> ECMAScriptFunctionObject::internal_call(Value this_argu
 {
     auto& vm = this->vm();
 
+    if (is<LazyFunctionBody>(*m_ecmascript_code)) [[unlikely]]
+        TRY(parse_lazy_body());
+
     // 1. Let callerContext be the running execution context.
     // NOTE: No-op, kept by the VM in its execution context stack.
 
@@ -439,6 +471,9 @@ ThrowCompletionOr<GC::Ref<Object>> ECMAScriptFunctionObject::internal_construct(
 {
     auto& vm = this->vm();
 
+    if (is<LazyFunctionBody>(*m_ecmascript_code)) [[unlikely]]
+        TRY(parse_lazy_body());
+
     // 1. Let callerContext be the running execution context.
     // NOTE: No-op, kept by the VM in its execution context stack.
 
@@ -450,7 +485,8 @@ ThrowCompletionOr<GC::Ref<Object>> ECMAScriptFunctionObject::internal_construct(
     // 3. If kind is base, then
     if (kind == ConstructorKind::Base) {
         // a. Let thisArgument be ? OrdinaryCreateFromConstructor(newTarget, "%Object.prototype%").
-        this_argument = TRY(ordinary_create_from_constructor<Object>(vm, new_target, &Intrinsics::object_prototype, ConstructWithPrototypeTag::Tag));
+        auto* prototype = TRY(get_prototype_from_constructor(vm, new_target, &Intrinsics::object_prototype));
+        this_argument = create_this_argument_for_construct(*prototype);
     }
 
     auto callee_context = ExecutionContext::create();
@@ -513,8 +549,12 @@ ThrowCompletionOr<GC::Ref<Object>> ECMAScriptFunctionObject::internal_construct(
         return result.value()->as_object();
 
     // 13. If kind is base, return thisArgument.
-    if (kind == ConstructorKind::Base)
+    if (kind == ConstructorKind::Base) {
+        // Past the transition limit, objects switch to a dictionary shape, and stop growing their storage one by one.
+        static constexpr u32 max_expected_property_count = 64;
+        m_expected_property_count_for_construct = min(this_argument->shape().property_count(), max_expected_property_count);
         return *this_argument;
+    }
 
     // 14. If result.[[Value]] is not undefined, throw a TypeError exception.
     if (!result.value()->is_undefined())
@@ -530,6 +570,27 @@ ThrowCompletionOr<GC::Ref<Object>> ECMAScriptFunctionObject::internal_construct(
     return this_binding.as_object();
 }
 
+// Non-standard: The object part of OrdinaryCreateFromConstructor, for objects created by [[Construct]].
+GC::Ref<Object> ECMAScriptFunctionObject::create_this_argument_for_construct(Object& prototype)
+{
+    GC::Ptr<Object> object;
+
+    // OPTIMIZATION: Objects constructed by the same function usually share a prototype, so we can skip the prototype
+    //               transition from the empty shape (and its lookup in the transition table) by remembering where it led.
+    if (m_initial_shape_for_construct && m_initial_shape_for_construct->prototype() == &prototype) {
+        object = Object::create_with_premade_shape(*m_initial_shape_for_construct);
+    } else {
+        object = Object::create(*vm().current_realm(), &prototype);
+        if (!object->shape().is_dictionary())
+            m_initial_shape_for_construct = object->shape();
+    }
+
+    // OPTIMIZATION: Constructors usually add the same properties to every object, so make room for as many as the last
+    //               object got, rather than growing the storage for each one.
+    object->ensure_storage_capacity(m_expected_property_count_for_construct);
+    return *object;
+}
+
 void ECMAScriptFunctionObject::visit_edges(Visitor& visitor)
 {
     Base::visit_edges(visitor);
@@ -26,6 +26,7 @@ void async_function_start(VM&, PromiseCapability const&, T const& async_function
 class ECMAScriptFunctionObject final : public FunctionObject {
     JS_OBJECT(ECMAScriptFunctionObject, FunctionObject);
     GC_DECLARE_ALLOCATOR(ECMAScriptFunctionObject);
+    GC_ALLOW_LAZY_SWEEP(ECMAScriptFunctionObject);
 
 public:
     enum class ConstructorKind : u8 {
@@ -72,16 +73,28 @@ public:
     ThisMode this_mode() const { return m_this_mode; }
 
     Object* home_object() const { return m_home_object; }
-    void set_home_object(Object* home_object) { m_home_object = home_object; }
+    void set_home_object(Object* home_object)
+    {
+        m_home_object = home_object;
+        GC::write_barrier(*this, home_object);
+    }
 
     ByteString const& source_text() const { return m_source_text; }
     void set_source_text(ByteString source_text) { m_source_text = move(source_text); }
 
     Vector<ClassFieldDefinition> const& fields() const { return m_fields; }
-    void add_field(ClassFieldDefinition field) { m_fields.append(move(field)); }
+    void add_field(ClassFieldDefinition field)
+    {
+        m_fields.append(move(field));
+        GC::write_barrier(*this);
+    }
 
     Vector<PrivateElement> const& private_methods() const { return m_private_methods; }
-    void add_private_method(PrivateElement method) { m_private_methods.append(move(method)); }
+    void add_private_method(PrivateElement method)
+    {
+        m_private_methods.append(move(method));
+        GC::write_barrier(*this);
+    }
 
     // This is for IsSimpleParameterList (static semantics)
     bool has_simple_parameter_list() const { return m_has_simple_parameter_list; }
@@ -114,7 +127,11 @@ private:
     virtual bool is_ecmascript_function_object() const override { return true; }
     virtual void visit_edges(Visitor&) override;
 
+    void prepare_function_declaration_instantiation();
+    ThrowCompletionOr<void> parse_lazy_body();
+
     ThrowCompletionOr<void> prepare_for_ordinary_call(ExecutionContext& callee_context, Object* new_target);
+    GC::Ref<Object> create_this_argument_for_construct(Object& prototype);
     void ordinary_call_bind_this(ExecutionContext&, Value this_argument);
 
     DeprecatedFlyString m_name;
@@ -127,7 +144,7 @@ private:
     // Internal Slots of ECMAScript Function Objects, https://tc39.es/ecma262/#table-internal-slots-of-ecmascript-function-objects
     GC::Ptr<Environment> m_environment;                                      // [[Environment]]
     GC::Ptr<PrivateEnvironment> m_private_environment;                       // [[PrivateEnvironment]]
-    Vector<FunctionParameter> const m_formal_parameters;                     // [[FormalParameters]]
+    Vector<FunctionParameter> m_formal_parameters;                           // [[FormalParameters]]
     NonnullRefPtr<Statement const> m_ecmascript_code;                        // [[ECMAScriptCode]]
     GC::Ptr<Realm> m_realm;                                                  // [[Realm]]
     ScriptOrModule m_script_or_module;                                       // [[ScriptOrModule]]
@@ -144,6 +161,7 @@ private:
     bool m_might_need_arguments_object : 1 { true };
     bool m_contains_direct_call_to_eval : 1 { true };
     bool m_is_arrow_function : 1 { false };
+    bool m_uses_this_from_environment : 1 { false };
     bool m_has_simple_parameter_list : 1 { false };
     FunctionKind m_kind : 3 { FunctionKind::Normal };
 
@@ -168,6 +186,11 @@ private:
     Vector<VariableNameToInitialize> m_var_names_to_initialize_binding;
     Vector<DeprecatedFlyString> m_function_names_to_initialize_binding;
 
+    // The shape that objects created by [[Construct]] start out with, which is an empty shape with the prototype from
+    // the last construction, and the number of named properties the last constructed object ended up with.
+    WeakPtr<Shape> m_initial_shape_for_construct;
+    u32 m_expected_property_count_for_construct { 0 };
+
     size_t m_function_environment_bindings_count { 0 };
     size_t m_var_environment_bindings_count { 0 };
     size_t m_lex_environment_bindings_count { 0 };
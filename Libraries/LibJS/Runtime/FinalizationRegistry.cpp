@@ -23,6 +23,7 @@ void FinalizationRegistry::add_finalization_record(Cell& target, Value held_valu
 {
     VERIFY(!held_value.is_empty());
     m_records.append({ &target, held_value, unregister_token });
+    GC::write_barrier(*this, held_value);
 }
 
 // Extracted from FinalizationRegistry.prototype.unregister ( unregisterToken )
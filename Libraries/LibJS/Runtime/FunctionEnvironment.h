@@ -14,6 +14,7 @@ namespace JS {
 class FunctionEnvironment final : public DeclarativeEnvironment {
     JS_ENVIRONMENT(FunctionEnvironment, DeclarativeEnvironment);
     GC_DECLARE_ALLOCATOR(FunctionEnvironment);
+    GC_ALLOW_LAZY_SWEEP(FunctionEnvironment);
 
 public:
     enum class ThisBindingStatus : u8 {
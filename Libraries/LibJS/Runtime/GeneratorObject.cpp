@@ -113,6 +113,8 @@ ThrowCompletionOr<Value> GeneratorObject::execute(VM& vm, Completion const& comp
     auto next_result = bytecode_interpreter.run_executable(*m_generating_function->bytecode_executable(), next_block, completion_object);
 
     vm.pop_execution_context();
+    // NOTE: The generator's registers were written to without going through the write barrier while it was running.
+    GC::write_barrier(*this);
 
     auto result_value = move(next_result.value);
     if (result_value.is_throw_completion()) {
@@ -121,6 +123,7 @@ ThrowCompletionOr<Value> GeneratorObject::execute(VM& vm, Completion const& comp
         return result_value;
     }
     m_previous_value = result_value.release_value();
+    GC::write_barrier(*this, m_previous_value);
     bool done = !generated_continuation(m_previous_value).has_value();
 
     m_generator_state = done ? GeneratorState::Completed : GeneratorState::SuspendedYield;
@@ -19,6 +19,20 @@ struct ValueAndAttributes {
     Optional<u32> property_offset {};
 };
 
+// The kind of values held by a SimpleIndexedPropertyStorage, from most to least specific.
+// A storage only moves towards less specific kinds until it is emptied, so the kind holds for
+// every element below the array-like size.
+enum class ElementsKind : u8 {
+    // No holes, and every element is an Int32.
+    PackedInt32,
+    // No holes, and every element is a number.
+    PackedDouble,
+    // No holes, and no element is an accessor.
+    PackedValue,
+    // Anything goes.
+    Holey,
+};
+
 class IndexedProperties;
 class IndexedPropertyIterator;
 class GenericIndexedPropertyStorage;
@@ -78,6 +92,21 @@ public:
 
     Vector<Value> const& elements() const { return m_packed_elements; }
 
+    ElementsKind kind() const { return m_kind; }
+    bool is_packed() const { return m_kind != ElementsKind::Holey; }
+    bool holds_only_numbers() const { return m_kind <= ElementsKind::PackedDouble; }
+
+    static ElementsKind kind_of(Value value)
+    {
+        if (value.is_int32())
+            return ElementsKind::PackedInt32;
+        if (value.is_number())
+            return ElementsKind::PackedDouble;
+        if (value.is_empty() || value.is_accessor())
+            return ElementsKind::Holey;
+        return ElementsKind::PackedValue;
+    }
+
     [[nodiscard]] bool inline_has_index(u32 index) const
     {
         return index < m_array_size && !m_packed_elements.data()[index].is_empty();
@@ -90,6 +119,14 @@ public:
         return ValueAndAttributes { m_packed_elements.data()[index], default_attributes };
     }
 
+    // Overwrites an element that is known to be present. The caller is responsible for the write barrier.
+    void inline_overwrite(u32 index, Value value)
+    {
+        VERIFY(index < m_array_size);
+        m_packed_elements.data()[index] = value;
+        m_kind = max(m_kind, kind_of(value));
+    }
+
 private:
     friend GenericIndexedPropertyStorage;
 
@@ -97,6 +134,7 @@ private:
 
     size_t m_array_size { 0 };
     Vector<Value> m_packed_elements;
+    ElementsKind m_kind { ElementsKind::PackedInt32 };
 };
 
 class GenericIndexedPropertyStorage final : public IndexedPropertyStorage {
@@ -183,7 +221,11 @@ public:
         if (!m_storage)
             return;
         if (m_storage->is_simple_storage()) {
-            for (auto& value : static_cast<SimpleIndexedPropertyStorage&>(*m_storage).elements())
+            auto& storage = static_cast<SimpleIndexedPropertyStorage&>(*m_storage);
+            // Numbers are never cells, so there is nothing to visit in a numeric storage.
+            if (storage.holds_only_numbers())
+                return;
+            for (auto& value : storage.elements())
                 callback(value);
         } else {
             for (auto& element : static_cast<GenericIndexedPropertyStorage const&>(*m_storage).sparse_elements())
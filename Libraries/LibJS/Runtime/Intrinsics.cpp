@@ -296,6 +296,8 @@ JS_ENUMERATE_TYPED_ARRAYS
             m_##snake_namespace##snake_name##_prototype = m_realm->create<Namespace::PrototypeName>(m_realm);                                            \
             m_##snake_namespace##snake_name##_constructor = m_realm->create<Namespace::ConstructorName>(m_realm);                                        \
         }                                                                                                                                                \
+        GC::write_barrier(*this, m_##snake_namespace##snake_name##_prototype.ptr());                                                                     \
+        GC::write_barrier(*this, m_##snake_namespace##snake_name##_constructor.ptr());                                                                   \
                                                                                                                                                          \
         /* FIXME: Add these special cases to JS_ENUMERATE_NATIVE_OBJECTS */                                                                              \
         if constexpr (IsSame<Namespace::ConstructorName, BigIntConstructor>)                                                                             \
@@ -426,6 +428,7 @@ GC::Ref<Intl::Collator> Intrinsics::default_collator()
 {
     if (!m_default_collator) {
         m_default_collator = as<Intl::Collator>(*MUST(construct(this->vm(), intl_collator_constructor(), js_undefined(), js_undefined())));
+        GC::write_barrier(*this, m_default_collator.ptr());
     }
     return *m_default_collator;
 }
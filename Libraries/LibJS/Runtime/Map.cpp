@@ -71,7 +71,9 @@ void Map::map_set(Value const& key, Value value)
         auto index = m_next_insertion_id++;
         m_keys.insert(index, key);
         m_entries.set(key, value);
+        GC::write_barrier(*this, key);
     }
+    GC::write_barrier(*this, value);
 }
 
 size_t Map::map_size() const
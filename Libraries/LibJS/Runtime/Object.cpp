@@ -30,11 +30,15 @@ static HashMap<GC::Ptr<Object const>, HashMap<DeprecatedFlyString, Object::Intri
 // 10.1.12 OrdinaryObjectCreate ( proto [ , additionalInternalSlotsList ] ), https://tc39.es/ecma262/#sec-ordinaryobjectcreate
 GC::Ref<Object> Object::create(Realm& realm, Object* prototype)
 {
+    GC::Ptr<Object> object;
     if (!prototype)
-        return realm.create<Object>(realm.intrinsics().empty_object_shape());
-    if (prototype == realm.intrinsics().object_prototype())
-        return realm.create<Object>(realm.intrinsics().new_object_shape());
-    return realm.create<Object>(ConstructWithPrototypeTag::Tag, *prototype);
+        object = realm.create<Object>(realm.intrinsics().empty_object_shape());
+    else if (prototype == realm.intrinsics().object_prototype())
+        object = realm.create<Object>(realm.intrinsics().new_object_shape());
+    else
+        object = realm.create<Object>(ConstructWithPrototypeTag::Tag, *prototype);
+    object->m_is_plain_object = true;
+    return *object;
 }
 
 GC::Ref<Object> Object::create_prototype(Realm& realm, Object* prototype)
@@ -42,12 +46,16 @@ GC::Ref<Object> Object::create_prototype(Realm& realm, Object* prototype)
     auto shape = realm.heap().allocate<Shape>(realm);
     if (prototype)
         shape->set_prototype_without_transition(prototype);
-    return realm.create<Object>(shape);
+    auto object = realm.create<Object>(shape);
+    object->m_is_plain_object = true;
+    return object;
 }
 
 GC::Ref<Object> Object::create_with_premade_shape(Shape& shape)
 {
-    return shape.realm().create<Object>(shape);
+    auto object = shape.realm().create<Object>(shape);
+    object->m_is_plain_object = true;
+    return object;
 }
 
 Object::Object(GlobalObjectTag, Realm& realm, MayInterfereWithIndexedPropertyAccess may_interfere_with_indexed_property_access)
@@ -93,6 +101,23 @@ Object::~Object()
         s_intrinsics.remove(this);
 }
 
+// Object is not standard-layout, but offsetof() works fine for its (non-virtual) data members on every compiler we support.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Winvalid-offsetof"
+
+size_t Object::shape_offset()
+{
+    static_assert(sizeof(m_shape) == sizeof(Shape*));
+    return offsetof(Object, m_shape);
+}
+
+size_t Object::storage_offset()
+{
+    return offsetof(Object, m_storage);
+}
+
+#pragma GCC diagnostic pop
+
 void Object::initialize(Realm&)
 {
 }
@@ -965,7 +990,7 @@ ThrowCompletionOr<bool> Object::ordinary_set_with_own_descriptor(PropertyKey con
         // b. If parent is not null, then
         if (parent) {
             // i. Return ? parent.[[Set]](P, V, Receiver).
-            return TRY(parent->internal_set(property_key, value, receiver));
+            return TRY(parent->internal_set(property_key, value, receiver, cacheable_metadata));
         }
         // c. Else,
         else {
@@ -1007,7 +1032,7 @@ ThrowCompletionOr<bool> Object::ordinary_set_with_own_descriptor(PropertyKey con
             // iii. Let valueDesc be the PropertyDescriptor { [[Value]]: V }.
             auto value_descriptor = PropertyDescriptor { .value = value };
 
-            if (cacheable_metadata && own_descriptor.has_value() && own_descriptor->property_offset.has_value() && shape().is_cacheable()) {
+            if (cacheable_metadata && &receiver_object == this && own_descriptor.has_value() && own_descriptor->property_offset.has_value() && shape().is_cacheable()) {
                 *cacheable_metadata = CacheablePropertyMetadata {
                     .type = CacheablePropertyMetadata::Type::OwnProperty,
                     .property_offset = own_descriptor->property_offset.value(),
@@ -1023,8 +1048,23 @@ ThrowCompletionOr<bool> Object::ordinary_set_with_own_descriptor(PropertyKey con
             // i. Assert: Receiver does not currently have a property P.
             VERIFY(!receiver_object.storage_has(property_key));
 
+            auto& shape_before_put = receiver_object.shape();
+
             // ii. Return ? CreateDataProperty(Receiver, P, V).
-            return TRY(receiver_object.create_data_property(property_key, value));
+            auto created = TRY(receiver_object.create_data_property(property_key, value));
+
+            // NOTE: Only a put transition on a plain object can be replayed by a cache, as that's all CreateDataProperty
+            //       does for those. Whether the set reaches this point at all depends on the receiver's prototype chain,
+            //       which is up to the cache to validate.
+            if (created && cacheable_metadata && receiver_object.is_plain_object() && !property_key.is_number()
+                && !shape_before_put.is_dictionary() && &receiver_object.shape() != &shape_before_put && !receiver_object.shape().is_dictionary()) {
+                *cacheable_metadata = CacheablePropertyMetadata {
+                    .type = CacheablePropertyMetadata::Type::AddedOwnProperty,
+                    .property_offset = shape_before_put.property_count(),
+                    .prototype = nullptr,
+                };
+            }
+            return created;
         }
     }
 
@@ -1154,7 +1194,7 @@ Optional<ValueAndAttributes> Object::storage_get(PropertyKey const& property_key
 
         if (m_has_intrinsic_accessors) {
             if (auto accessor = find_intrinsic_accessor(this, property_key); accessor.has_value())
-                const_cast<Object&>(*this).m_storage[metadata->offset] = (*accessor)(shape().realm());
+                const_cast<Object&>(*this).put_direct(metadata->offset, (*accessor)(shape().realm()));
         }
 
         value = m_storage[metadata->offset];
@@ -1177,8 +1217,7 @@ void Object::storage_set(PropertyKey const& property_key, ValueAndAttributes con
     auto [value, attributes, _] = value_and_attributes;
 
     if (property_key.is_number()) {
-        auto index = property_key.as_number();
-        m_indexed_properties.put(index, value, attributes);
+        put_indexed_direct(property_key.as_number(), value, attributes);
         return;
     }
 
@@ -1200,17 +1239,25 @@ void Object::storage_set(PropertyKey const& property_key, ValueAndAttributes con
         else
             set_shape(*m_shape->create_put_transition(property_key_string_or_symbol, attributes));
         m_storage.append(value);
+        GC::write_barrier(*this, value);
         return;
     }
 
     if (attributes != metadata->attributes) {
+        // NOTE: Inline caches remember cacheable dictionary shapes, and may assume a property that was writable
+        //       stays so while the shape doesn't change, so we give the object a new shape here. The dictionary shape
+        //       is this object's own, so the new one takes over its property table rather than copying it, which
+        //       would make freezing an object with many properties quadratic.
+        if (m_shape->is_cacheable_dictionary())
+            set_shape(m_shape->create_cacheable_dictionary_transition_taking_property_table());
+
         if (m_shape->is_dictionary())
             m_shape->set_property_attributes_without_transition(property_key_string_or_symbol, attributes);
         else
             set_shape(*m_shape->create_configure_transition(property_key_string_or_symbol, attributes));
     }
 
-    m_storage[metadata->offset] = value;
+    put_direct(metadata->offset, value);
 }
 
 void Object::storage_delete(PropertyKey const& property_key)
@@ -1229,14 +1276,14 @@ void Object::storage_delete(PropertyKey const& property_key)
     VERIFY(metadata.has_value());
 
     if (m_shape->is_cacheable_dictionary()) {
-        m_shape = m_shape->create_uncacheable_dictionary_transition();
+        set_shape(m_shape->create_uncacheable_dictionary_transition());
     }
     if (m_shape->is_uncacheable_dictionary()) {
         m_shape->remove_property_without_transition(property_key.to_string_or_symbol(), metadata->offset);
         m_storage.remove(metadata->offset);
         return;
     }
-    m_shape = m_shape->create_delete_transition(property_key.to_string_or_symbol());
+    set_shape(m_shape->create_delete_transition(property_key.to_string_or_symbol()));
     m_storage.remove(metadata->offset);
 }
 
@@ -1244,7 +1291,7 @@ void Object::set_prototype(Object* new_prototype)
 {
     if (prototype() == new_prototype)
         return;
-    m_shape = shape().create_prototype_transition(new_prototype);
+    set_shape(shape().create_prototype_transition(new_prototype));
 }
 
 void Object::define_native_accessor(Realm& realm, PropertyKey const& property_key, Function<ThrowCompletionOr<Value>(VM&)> getter, Function<ThrowCompletionOr<Value>(VM&)> setter, PropertyAttributes attribute)
@@ -45,6 +45,8 @@ struct CacheablePropertyMetadata {
         NotCacheable,
         OwnProperty,
         InPrototypeChain,
+        // The property was missing, and the set added it to the receiver at `property_offset`.
+        AddedOwnProperty,
     };
     Type type { Type::NotCacheable };
     Optional<u32> property_offset;
@@ -54,6 +56,7 @@ struct CacheablePropertyMetadata {
 class Object : public Cell {
     GC_CELL(Object, Cell);
     GC_DECLARE_ALLOCATOR(Object);
+    GC_ALLOW_LAZY_SWEEP(Object);
 
 public:
     static GC::Ref<Object> create_prototype(Realm&, Object* prototype);
@@ -206,12 +209,39 @@ public:
 
     virtual void visit_edges(Cell::Visitor&) override;
 
+    // NOTE: The setters below go through the write barrier (see LibGC/WriteBarrier.h), so use them rather than writing to the storage some other way.
     Value get_direct(size_t index) const { return m_storage[index]; }
-    void put_direct(size_t index, Value value) { m_storage[index] = value; }
+    void put_direct(size_t index, Value value)
+    {
+        m_storage[index] = value;
+        GC::write_barrier(*this, value);
+    }
+
+    // Adds a property that is missing from this object, given the shape that the put transition for it leads to.
+    void put_direct_with_transition(Shape& new_shape, Value value)
+    {
+        set_shape(new_shape);
+        m_storage.append(value);
+        GC::write_barrier(*this, value);
+    }
+
+    void put_indexed_direct(u32 index, Value value, PropertyAttributes attributes = default_attributes)
+    {
+        m_indexed_properties.put(index, value, attributes);
+        GC::write_barrier(*this, value);
+    }
+    void append_indexed_direct(Value value) { put_indexed_direct(m_indexed_properties.array_like_size(), value); }
+
+    // Makes room for this many named properties up front, so that adding them one by one doesn't grow the storage repeatedly.
+    void ensure_storage_capacity(size_t capacity) { m_storage.ensure_capacity(capacity); }
 
     IndexedProperties const& indexed_properties() const { return m_indexed_properties; }
     IndexedProperties& indexed_properties() { return m_indexed_properties; }
-    void set_indexed_property_elements(Vector<Value>&& values) { m_indexed_properties = IndexedProperties(move(values)); }
+    void set_indexed_property_elements(Vector<Value>&& values)
+    {
+        m_indexed_properties = IndexedProperties(move(values));
+        GC::write_barrier(*this);
+    }
 
     Shape& shape() { return *m_shape; }
     Shape const& shape() const { return *m_shape; }
@@ -228,8 +258,17 @@ public:
     [[nodiscard]] bool is_typed_array() const { return m_is_typed_array; }
     void set_is_typed_array() { m_is_typed_array = true; }
 
+    // True for objects that were created by the factory functions above. These are instances of exactly Object, so their
+    // internal methods are the ordinary ones, and inline caches can reason about them using only their shape.
+    [[nodiscard]] bool is_plain_object() const { return m_is_plain_object; }
+    [[nodiscard]] bool is_plain_extensible_object() const { return m_is_plain_object && m_is_extensible; }
+
     Object const* prototype() const { return shape().prototype(); }
 
+    // The JIT compiler reads the shape and named property storage of objects directly.
+    static size_t shape_offset();
+    static size_t storage_offset();
+
 protected:
     enum class GlobalObjectTag { Tag };
     enum class ConstructWithoutPrototypeTag { Tag };
@@ -252,12 +291,18 @@ protected:
     bool m_is_typed_array { false };
 
 private:
-    void set_shape(Shape& shape) { m_shape = &shape; }
+    void set_shape(Shape& shape)
+    {
+        m_shape = &shape;
+        GC::write_barrier(*this, &shape);
+    }
 
     Object* prototype() { return shape().prototype(); }
 
     bool m_may_interfere_with_indexed_property_access { false };
 
+    bool m_is_plain_object { false };
+
     // True if this object has lazily allocated intrinsic properties.
     bool m_has_intrinsic_accessors { false };
 
@@ -5,6 +5,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Array.h>
 #include <AK/CharacterTypes.h>
 #include <AK/FlyString.h>
 #include <AK/StringBuilder.h>
@@ -14,6 +15,7 @@
 #include <LibJS/Runtime/GlobalObject.h>
 #include <LibJS/Runtime/PrimitiveString.h>
 #include <LibJS/Runtime/PropertyKey.h>
+#include <LibJS/Runtime/StringPrototype.h>
 #include <LibJS/Runtime/VM.h>
 #include <LibJS/Runtime/Value.h>
 
@@ -21,8 +23,12 @@ namespace JS {
 
 GC_DEFINE_ALLOCATOR(PrimitiveString);
 
+PrimitiveString::RopeStatistics PrimitiveString::s_rope_statistics;
+
 PrimitiveString::PrimitiveString(PrimitiveString& lhs, PrimitiveString& rhs)
     : m_is_rope(true)
+    , m_rope_depth(max(lhs.m_rope_depth, rhs.m_rope_depth) + 1)
+    , m_length_in_utf16_code_units(lhs.length_in_utf16_code_units() + rhs.length_in_utf16_code_units())
     , m_lhs(&lhs)
     , m_rhs(&rhs)
 {
@@ -43,8 +49,13 @@ PrimitiveString::PrimitiveString(Utf16String string)
 {
 }
 
-PrimitiveString::~PrimitiveString()
+PrimitiveString::~PrimitiveString() = default;
+
+// NOTE: This happens in finalize() rather than in the destructor, since the destruction of dead strings
+//       may be deferred by lazy sweeping, and the caches must never hand out a dead string.
+void PrimitiveString::finalize()
 {
+    Base::finalize();
     if (has_utf8_string())
         vm().string_cache().remove(*m_utf8_string);
     if (has_utf16_string())
@@ -138,24 +149,193 @@ Utf16View PrimitiveString::utf16_string_view() const
     return m_utf16_string->view();
 }
 
+size_t PrimitiveString::length_in_utf16_code_units() const
+{
+    if (!m_length_in_utf16_code_units.has_value()) {
+        if (has_utf16_string())
+            m_length_in_utf16_code_units = m_utf16_string->length_in_code_units();
+        else if (has_utf8_string())
+            m_length_in_utf16_code_units = utf16_code_unit_length_from_utf8(m_utf8_string->bytes_as_string_view());
+        else
+            m_length_in_utf16_code_units = utf16_string().length_in_code_units();
+    }
+    return *m_length_in_utf16_code_units;
+}
+
+u16 PrimitiveString::utf16_code_unit_at(size_t index) const
+{
+    auto const* current = this;
+    while (current->m_is_rope) {
+        auto lhs_length = current->m_lhs->length_in_utf16_code_units();
+        if (index < lhs_length) {
+            current = current->m_lhs;
+        } else {
+            index -= lhs_length;
+            current = current->m_rhs;
+        }
+    }
+
+    // If the UTF-8 string is as long as its UTF-16 form, it's ASCII, and we don't need to convert it.
+    if (current->has_utf8_string() && !current->has_utf16_string()) {
+        auto bytes = current->m_utf8_string->bytes();
+        if (bytes.size() == current->length_in_utf16_code_units())
+            return bytes[index];
+    }
+
+    return current->utf16_string_view().code_unit_at(index);
+}
+
+template<typename Callback>
+void PrimitiveString::for_each_leaf_in_range(size_t start, size_t end, Callback callback) const
+{
+    struct Entry {
+        PrimitiveString const* string;
+        size_t offset;
+    };
+    Vector<Entry, max_rope_depth + 2> stack;
+    stack.append({ this, 0 });
+
+    while (!stack.is_empty()) {
+        auto [current, offset] = stack.take_last();
+        if (!current->m_is_rope) {
+            if (callback(*current, offset) == IterationDecision::Break)
+                return;
+            continue;
+        }
+
+        // Only descend into the sides of the rope that overlap the range.
+        auto rhs_offset = offset + current->m_lhs->length_in_utf16_code_units();
+        if (rhs_offset < end)
+            stack.append({ current->m_rhs, rhs_offset });
+        if (rhs_offset > start)
+            stack.append({ current->m_lhs, offset });
+    }
+}
+
+GC::Ref<PrimitiveString> PrimitiveString::substring(VM& vm, size_t start, size_t length) const
+{
+    if (length == 0)
+        return vm.empty_string();
+
+    // Find the smallest part of the rope that contains the whole substring.
+    auto const* current = this;
+    while (current->m_is_rope && length < current->length_in_utf16_code_units()) {
+        auto lhs_length = current->m_lhs->length_in_utf16_code_units();
+        if (start + length <= lhs_length) {
+            current = current->m_lhs;
+        } else if (start >= lhs_length) {
+            start -= lhs_length;
+            current = current->m_rhs;
+        } else {
+            break;
+        }
+    }
+
+    if (length == current->length_in_utf16_code_units())
+        return const_cast<PrimitiveString&>(*current);
+
+    if (!current->m_is_rope) {
+        if (current->has_utf8_string() && !current->has_utf16_string()) {
+            auto bytes = current->m_utf8_string->bytes();
+            if (bytes.size() == current->length_in_utf16_code_units())
+                return create(vm, String::from_utf8_without_validation(bytes.slice(start, length)));
+        }
+        return create(vm, Utf16String::create(current->utf16_string_view().substring_view(start, length)));
+    }
+
+    // The substring spans several leaves, so we copy just the part of each of them that it covers.
+    auto end = start + length;
+    Utf16Data code_units;
+    code_units.ensure_capacity(length);
+
+    current->for_each_leaf_in_range(start, end, [&](PrimitiveString const& leaf, size_t leaf_offset) {
+        auto view = leaf.utf16_string_view();
+        auto from = max(start, leaf_offset) - leaf_offset;
+        auto to = min(end, leaf_offset + view.length_in_code_units()) - leaf_offset;
+        code_units.append(view.data() + from, to - from);
+        return IterationDecision::Continue;
+    });
+
+    return create(vm, Utf16String::create(move(code_units)));
+}
+
+Optional<size_t> PrimitiveString::index_of(Utf16View const& search_value, size_t from_index) const
+{
+    if (!m_is_rope)
+        return string_index_of(utf16_string_view(), search_value, from_index);
+
+    auto length = length_in_utf16_code_units();
+    auto search_length = search_value.length_in_code_units();
+
+    if (search_length == 0) {
+        if (from_index <= length)
+            return from_index;
+        return {};
+    }
+    if (search_length > length || from_index > length - search_length)
+        return {};
+
+    // We search each leaf on its own. To find matches that straddle leaves, we carry the code units at the end of
+    // the leaves seen so far that could still start a match, and search them joined with the start of the next leaf.
+    Optional<size_t> result;
+    Utf16Data carried;
+
+    for_each_leaf_in_range(from_index, length, [&](PrimitiveString const& leaf, size_t leaf_offset) {
+        auto view = leaf.utf16_string_view();
+        auto leaf_length = view.length_in_code_units();
+        auto carried_offset = leaf_offset - carried.size();
+
+        if (!carried.is_empty()) {
+            Utf16Data joined;
+            joined.ensure_capacity(carried.size() + search_length - 1);
+            joined.extend(carried);
+            joined.append(view.data(), min(leaf_length, search_length - 1));
+
+            // A match that starts within the leaf is found below.
+            if (auto index = string_index_of(Utf16View { joined }, search_value, 0); index.has_value() && *index < carried.size()) {
+                result = carried_offset + *index;
+                return IterationDecision::Break;
+            }
+        }
+
+        auto start_in_leaf = from_index > leaf_offset ? from_index - leaf_offset : 0;
+        if (auto index = string_index_of(view, search_value, start_in_leaf); index.has_value()) {
+            result = leaf_offset + *index;
+            return IterationDecision::Break;
+        }
+
+        auto leaf_end = leaf_offset + leaf_length;
+        auto carry_start = max(from_index, leaf_end - min(leaf_end, search_length - 1));
+
+        Utf16Data next_carried;
+        if (carry_start < leaf_offset)
+            next_carried.append(carried.data() + (carry_start - carried_offset), leaf_offset - carry_start);
+        auto carry_start_in_leaf = max(carry_start, leaf_offset) - leaf_offset;
+        next_carried.append(view.data() + carry_start_in_leaf, leaf_length - carry_start_in_leaf);
+        carried = move(next_carried);
+
+        return IterationDecision::Continue;
+    });
+
+    return result;
+}
+
 ThrowCompletionOr<Optional<Value>> PrimitiveString::get(VM& vm, PropertyKey const& property_key) const
 {
     if (property_key.is_symbol())
         return Optional<Value> {};
     if (property_key.is_string()) {
         if (property_key.as_string() == vm.names.length.as_string()) {
-            auto length = utf16_string().length_in_code_units();
+            auto length = length_in_utf16_code_units();
             return Value(static_cast<double>(length));
         }
     }
     auto index = canonical_numeric_index_string(property_key, CanonicalIndexMode::IgnoreNumericRoundtrip);
     if (!index.is_index())
         return Optional<Value> {};
-    auto str = utf16_string_view();
-    auto length = str.length_in_code_units();
-    if (length <= index.as_index())
+    if (length_in_utf16_code_units() <= index.as_index())
         return Optional<Value> {};
-    return create(vm, Utf16String::create(str.substring_view(index.as_index(), 1)));
+    return substring(vm, index.as_index(), 1);
 }
 
 GC::Ref<PrimitiveString> PrimitiveString::create(VM& vm, Utf16String string)
@@ -251,7 +431,79 @@ GC::Ref<PrimitiveString> PrimitiveString::create(VM& vm, PrimitiveString& lhs, P
     if (rhs_empty)
         return lhs;
 
-    return vm.heap().allocate<PrimitiveString>(lhs, rhs);
+    auto rope = vm.heap().allocate<PrimitiveString>(lhs, rhs);
+    if (rope->m_rope_depth > max_rope_depth)
+        return rebalance(vm, rope);
+    return rope;
+}
+
+// The minimum length of a balanced rope of each depth, as in "Ropes: an Alternative to Strings" by Boehm, Atkinson and Plass.
+static constexpr auto minimum_balanced_rope_length = [] {
+    AK::Array<size_t, PrimitiveString::max_rope_depth + 2> lengths {};
+    lengths[0] = 1;
+    lengths[1] = 2;
+    for (size_t i = 2; i < lengths.size(); ++i)
+        lengths[i] = lengths[i - 1] + lengths[i - 2];
+    return lengths;
+}();
+
+GC::Ref<PrimitiveString> PrimitiveString::rebalance(VM& vm, PrimitiveString& rope)
+{
+    ++s_rope_statistics.rebalanced_rope_count;
+
+    // The pieces of the rope are concatenated, in order, into a forest of balanced ropes where the rope in slot i is
+    // at least minimum_balanced_rope_length[i] long. Subtrees that are already balanced are added as a whole, so
+    // rebalancing a rope that was balanced before a few more concatenations only touches the new parts.
+    // NOTE: The forest lives on the stack, so the ropes we create here are kept alive by conservative stack scanning.
+    AK::Array<GC::Ptr<PrimitiveString>, max_rope_depth + 1> forest {};
+
+    auto concatenate = [&](PrimitiveString& lhs, PrimitiveString& rhs) {
+        return vm.heap().allocate<PrimitiveString>(lhs, rhs);
+    };
+
+    auto add_balanced_rope_to_forest = [&](PrimitiveString& piece) {
+        auto piece_length = piece.length_in_utf16_code_units();
+
+        // Everything in the slots for shorter ropes comes before the piece, so it's concatenated in front of it.
+        size_t slot = 0;
+        GC::Ptr<PrimitiveString> shorter;
+        for (; piece_length >= minimum_balanced_rope_length[slot + 1]; ++slot) {
+            if (forest[slot]) {
+                shorter = shorter ? concatenate(*forest[slot], *shorter) : forest[slot];
+                forest[slot] = nullptr;
+            }
+        }
+
+        GC::Ref<PrimitiveString> insertee = shorter ? concatenate(*shorter, piece) : GC::Ref { piece };
+        for (;; ++slot) {
+            if (forest[slot]) {
+                insertee = concatenate(*forest[slot], insertee);
+                forest[slot] = nullptr;
+            }
+            if (slot == max_rope_depth || insertee->length_in_utf16_code_units() < minimum_balanced_rope_length[slot + 1]) {
+                forest[slot] = insertee;
+                return;
+            }
+        }
+    };
+
+    // NOTE: The recursion here is bounded by the depth of the rope, which is at most max_rope_depth + 1.
+    auto add_to_forest = [&](auto& self, PrimitiveString& piece) -> void {
+        if (!piece.m_is_rope || piece.length_in_utf16_code_units() >= minimum_balanced_rope_length[piece.m_rope_depth]) {
+            add_balanced_rope_to_forest(piece);
+            return;
+        }
+        self(self, *piece.m_lhs);
+        self(self, *piece.m_rhs);
+    };
+    add_to_forest(add_to_forest, rope);
+
+    GC::Ptr<PrimitiveString> result;
+    for (auto& piece : forest) {
+        if (piece)
+            result = result ? concatenate(*piece, *result) : piece;
+    }
+    return *result;
 }
 
 void PrimitiveString::resolve_rope_if_needed(EncodingPreference preference) const
@@ -259,6 +511,8 @@ void PrimitiveString::resolve_rope_if_needed(EncodingPreference preference) cons
     if (!m_is_rope)
         return;
 
+    ++s_rope_statistics.flattened_rope_count;
+
     // This vector will hold all the pieces of the rope that need to be assembled
     // into the resolved string.
     Vector<PrimitiveString const*> pieces;
@@ -290,8 +544,10 @@ void PrimitiveString::resolve_rope_if_needed(EncodingPreference preference) cons
         for (auto const* current : pieces)
             code_units.extend(current->utf16_string().string());
 
+        s_rope_statistics.flattened_bytes += code_units.size() * sizeof(u16);
         m_utf16_string = Utf16String::create(move(code_units));
         m_is_rope = false;
+        m_rope_depth = 0;
         m_lhs = nullptr;
         m_rhs = nullptr;
         return;
@@ -359,8 +615,10 @@ void PrimitiveString::resolve_rope_if_needed(EncodingPreference preference) cons
     }
 
     // NOTE: We've already produced valid UTF-8 above, so there's no need for additional validation.
+    s_rope_statistics.flattened_bytes += builder.length();
     m_utf8_string = builder.to_string_without_validation();
     m_is_rope = false;
+    m_rope_depth = 0;
     m_lhs = nullptr;
     m_rhs = nullptr;
 }
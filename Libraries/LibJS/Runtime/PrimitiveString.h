@@ -23,6 +23,7 @@ namespace JS {
 class PrimitiveString final : public Cell {
     GC_CELL(PrimitiveString, Cell);
     GC_DECLARE_ALLOCATOR(PrimitiveString);
+    GC_ALLOW_LAZY_SWEEP(PrimitiveString);
 
 public:
     [[nodiscard]] static GC::Ref<PrimitiveString> create(VM&, Utf16String);
@@ -33,8 +34,13 @@ public:
     [[nodiscard]] static GC::Ref<PrimitiveString> create(VM&, PrimitiveString&, PrimitiveString&);
     [[nodiscard]] static GC::Ref<PrimitiveString> create(VM&, StringView);
 
+    // Ropes deeper than this are rebalanced when they are created.
+    static constexpr u8 max_rope_depth = 48;
+
     virtual ~PrimitiveString();
 
+    virtual void finalize() override;
+
     PrimitiveString(PrimitiveString const&) = delete;
     PrimitiveString& operator=(PrimitiveString const&) = delete;
 
@@ -51,8 +57,21 @@ public:
     [[nodiscard]] Utf16View utf16_string_view() const;
     bool has_utf16_string() const { return m_utf16_string.has_value(); }
 
+    // These walk the rope rather than flattening it, so repeatedly appending to a string and looking at it stays linear.
+    size_t length_in_utf16_code_units() const;
+    u16 utf16_code_unit_at(size_t index) const;
+    GC::Ref<PrimitiveString> substring(VM&, size_t start, size_t length) const;
+    Optional<size_t> index_of(Utf16View const& search_value, size_t from_index) const;
+
     ThrowCompletionOr<Optional<Value>> get(VM&, PropertyKey const&) const;
 
+    struct RopeStatistics {
+        size_t flattened_rope_count { 0 };
+        size_t flattened_bytes { 0 };
+        size_t rebalanced_rope_count { 0 };
+    };
+    static RopeStatistics const& rope_statistics() { return s_rope_statistics; }
+
 private:
     explicit PrimitiveString(PrimitiveString&, PrimitiveString&);
     explicit PrimitiveString(String);
@@ -67,7 +86,16 @@ private:
     };
     void resolve_rope_if_needed(EncodingPreference) const;
 
+    static GC::Ref<PrimitiveString> rebalance(VM&, PrimitiveString&);
+
+    template<typename Callback>
+    void for_each_leaf_in_range(size_t start, size_t end, Callback) const;
+
+    static RopeStatistics s_rope_statistics;
+
     mutable bool m_is_rope { false };
+    mutable u8 m_rope_depth { 0 };
+    mutable Optional<size_t> m_length_in_utf16_code_units;
 
     mutable GC::Ptr<PrimitiveString> m_lhs;
     mutable GC::Ptr<PrimitiveString> m_rhs;
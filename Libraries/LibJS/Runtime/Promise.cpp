@@ -211,6 +211,7 @@ void Promise::fulfill(Value value)
 
     // 3. Set promise.[[PromiseResult]] to value.
     m_result = value;
+    GC::write_barrier(*this, value);
 
     // 4. Set promise.[[PromiseFulfillReactions]] to undefined.
     // 5. Set promise.[[PromiseRejectReactions]] to undefined.
@@ -242,6 +243,7 @@ void Promise::reject(Value reason)
 
     // 3. Set promise.[[PromiseResult]] to reason.
     m_result = reason;
+    GC::write_barrier(*this, reason);
 
     // 4. Set promise.[[PromiseFulfillReactions]] to undefined.
     // 5. Set promise.[[PromiseRejectReactions]] to undefined.
@@ -333,9 +335,11 @@ Value Promise::perform_then(Value on_fulfilled, Value on_rejected, GC::Ptr<Promi
 
         // a. Append fulfillReaction as the last element of the List that is promise.[[PromiseFulfillReactions]].
         m_fulfill_reactions.append(fulfill_reaction);
+        GC::write_barrier(*this, fulfill_reaction.ptr());
 
         // b. Append rejectReaction as the last element of the List that is promise.[[PromiseRejectReactions]].
         m_reject_reactions.append(reject_reaction);
+        GC::write_barrier(*this, reject_reaction.ptr());
         break;
     // 10. Else if promise.[[PromiseState]] is fulfilled, then
     case Promise::State::Fulfilled: {
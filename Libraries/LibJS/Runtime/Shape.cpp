@@ -13,6 +13,17 @@ namespace JS {
 GC_DEFINE_ALLOCATOR(Shape);
 GC_DEFINE_ALLOCATOR(PrototypeChainValidity);
 
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Winvalid-offsetof"
+
+size_t PrototypeChainValidity::valid_offset()
+{
+    static_assert(sizeof(m_valid) == 1);
+    return offsetof(PrototypeChainValidity, m_valid);
+}
+
+#pragma GCC diagnostic pop
+
 static HashTable<GC::Ptr<Shape>> s_all_prototype_shapes;
 
 Shape::~Shape()
@@ -49,6 +60,20 @@ GC::Ref<Shape> Shape::create_uncacheable_dictionary_transition()
     return new_shape;
 }
 
+GC::Ref<Shape> Shape::create_cacheable_dictionary_transition_taking_property_table()
+{
+    VERIFY(m_dictionary);
+    auto new_shape = heap().allocate<Shape>(m_realm);
+    new_shape->m_dictionary = true;
+    new_shape->m_cacheable = true;
+    new_shape->m_prototype = m_prototype;
+    invalidate_prototype_if_needed_for_new_prototype(new_shape);
+    ensure_property_table();
+    new_shape->m_property_table = move(m_property_table);
+    new_shape->m_property_count = new_shape->m_property_table->size();
+    return new_shape;
+}
+
 GC::Ptr<Shape> Shape::get_or_prune_cached_forward_transition(TransitionKey const& key)
 {
     if (m_is_prototype_shape)
@@ -111,6 +136,8 @@ GC::Ref<Shape> Shape::create_put_transition(StringOrSymbol const& property_key,
         if (!m_forward_transitions)
             m_forward_transitions = make<HashMap<TransitionKey, WeakPtr<Shape>>>();
         m_forward_transitions->set(key, new_shape.ptr());
+        if (property_key.is_symbol())
+            GC::write_barrier(*this, property_key.as_symbol());
     }
     return new_shape;
 }
@@ -126,6 +153,8 @@ GC::Ref<Shape> Shape::create_configure_transition(StringOrSymbol const& property
         if (!m_forward_transitions)
             m_forward_transitions = make<HashMap<TransitionKey, WeakPtr<Shape>>>();
         m_forward_transitions->set(key, new_shape.ptr());
+        if (property_key.is_symbol())
+            GC::write_barrier(*this, property_key.as_symbol());
     }
     return new_shape;
 }
@@ -279,6 +308,8 @@ GC::Ref<Shape> Shape::create_delete_transition(StringOrSymbol const& property_ke
     if (!m_delete_transitions)
         m_delete_transitions = make<HashMap<StringOrSymbol, WeakPtr<Shape>>>();
     m_delete_transitions->set(property_key, new_shape.ptr());
+    if (property_key.is_symbol())
+        GC::write_barrier(*this, property_key.as_symbol());
     return new_shape;
 }
 
@@ -288,6 +319,7 @@ void Shape::add_property_without_transition(StringOrSymbol const& property_key,
     if (m_property_table->set(property_key, { m_property_count, attributes }) == AK::HashSetResult::InsertedNewEntry) {
         VERIFY(m_property_count < NumericLimits<u32>::max());
         ++m_property_count;
+        invalidate_prototype_if_needed_for_change_without_transition();
     }
 }
 
@@ -304,6 +336,7 @@ void Shape::set_property_attributes_without_transition(StringOrSymbol const& pro
     VERIFY(it != m_property_table->end());
     it->value.attributes = attributes;
     m_property_table->set(property_key, it->value);
+    invalidate_prototype_if_needed_for_change_without_transition();
 }
 
 void Shape::remove_property_without_transition(StringOrSymbol const& property_key, u32 offset)
@@ -317,6 +350,7 @@ void Shape::remove_property_without_transition(StringOrSymbol const& property_ke
         if (it.value.offset > offset)
             --it.value.offset;
     }
+    invalidate_prototype_if_needed_for_change_without_transition();
 }
 
 GC::Ref<Shape> Shape::create_for_prototype(GC::Ref<Realm> realm, GC::Ptr<Object> prototype)
@@ -350,6 +384,7 @@ void Shape::set_prototype_without_transition(Object* new_prototype)
     VERIFY(new_prototype);
     new_prototype->convert_to_prototype_if_needed();
     m_prototype = new_prototype;
+    GC::write_barrier(*this, new_prototype);
 }
 
 void Shape::set_prototype_shape()
@@ -358,6 +393,16 @@ void Shape::set_prototype_shape()
     s_all_prototype_shapes.set(this);
     m_is_prototype_shape = true;
     m_prototype_chain_validity = heap().allocate<PrototypeChainValidity>();
+    GC::write_barrier(*this, m_prototype_chain_validity.ptr());
+}
+
+GC::Ptr<PrototypeChainValidity> Shape::observe_prototype_chain_validity()
+{
+    for (auto* shape = this; shape; shape = shape->m_prototype ? &shape->m_prototype->shape() : nullptr) {
+        if (shape->m_prototype_chain_validity)
+            shape->m_prototype_chain_validity->set_has_observers();
+    }
+    return m_prototype_chain_validity;
 }
 
 void Shape::invalidate_prototype_if_needed_for_new_prototype(GC::Ref<Shape> new_prototype_shape)
@@ -367,7 +412,9 @@ void Shape::invalidate_prototype_if_needed_for_new_prototype(GC::Ref<Shape> new_
     new_prototype_shape->set_prototype_shape();
     m_prototype_chain_validity->set_valid(false);
 
-    invalidate_all_prototype_chains_leading_to_this();
+    // NOTE: Every cache that depends on a chain through this shape has marked its validity as observed.
+    if (m_prototype_chain_validity->has_observers())
+        invalidate_all_prototype_chains_leading_to_this();
 }
 
 void Shape::invalidate_all_prototype_chains_leading_to_this()
@@ -389,7 +436,23 @@ void Shape::invalidate_all_prototype_chains_leading_to_this()
     for (auto* shape : shapes_to_invalidate) {
         shape->m_prototype_chain_validity->set_valid(false);
         shape->m_prototype_chain_validity = heap().allocate<PrototypeChainValidity>();
+        GC::write_barrier(*shape, shape->m_prototype_chain_validity.ptr());
     }
 }
 
+// Dictionary shapes are changed in place, so there is no new shape for caches to notice. Instead, we invalidate
+// every cached prototype chain that this shape is part of, just like a transition away from it would.
+// That's only needed once a cache has observed this shape's validity, which keeps adding many properties to a
+// dictionary prototype (e.g. while setting up a global object) linear.
+void Shape::invalidate_prototype_if_needed_for_change_without_transition()
+{
+    if (!m_is_prototype_shape || !m_prototype_chain_validity->has_observers())
+        return;
+    m_prototype_chain_validity->set_valid(false);
+    m_prototype_chain_validity = heap().allocate<PrototypeChainValidity>();
+    GC::write_barrier(*this, m_prototype_chain_validity.ptr());
+
+    invalidate_all_prototype_chains_leading_to_this();
+}
+
 }
@@ -42,8 +42,16 @@ public:
     [[nodiscard]] bool is_valid() const { return m_valid; }
     void set_valid(bool valid) { m_valid = valid; }
 
+    // Set once a cache holds on to this validity. Until then, there is nothing to invalidate.
+    [[nodiscard]] bool has_observers() const { return m_has_observers; }
+    void set_has_observers() { m_has_observers = true; }
+
+    // The JIT compiler checks the validity of cached prototype chains directly.
+    static size_t valid_offset();
+
 private:
     bool m_valid { true };
+    bool m_has_observers { false };
     size_t padding { 0 };
 };
 
@@ -70,6 +78,9 @@ public:
     [[nodiscard]] GC::Ref<Shape> create_delete_transition(StringOrSymbol const&);
     [[nodiscard]] GC::Ref<Shape> create_cacheable_dictionary_transition();
     [[nodiscard]] GC::Ref<Shape> create_uncacheable_dictionary_transition();
+    // Gives a dictionary shape a new identity, by moving its property table to a new shape instead of copying it.
+    // The old shape must not be used by any object afterwards.
+    [[nodiscard]] GC::Ref<Shape> create_cacheable_dictionary_transition_taking_property_table();
     [[nodiscard]] GC::Ref<Shape> clone_for_prototype();
     [[nodiscard]] static GC::Ref<Shape> create_for_prototype(GC::Ref<Realm>, GC::Ptr<Object> prototype);
 
@@ -88,6 +99,9 @@ public:
     void set_prototype_shape();
 
     GC::Ptr<PrototypeChainValidity> prototype_chain_validity() const { return m_prototype_chain_validity; }
+    // Returns the validity for a cache to hold on to, and marks it and those of every shape further up the
+    // prototype chain as observed, so that a change to any of these shapes invalidates it.
+    GC::Ptr<PrototypeChainValidity> observe_prototype_chain_validity();
 
     Realm& realm() const { return m_realm; }
 
@@ -113,6 +127,7 @@ private:
 
     void invalidate_prototype_if_needed_for_new_prototype(GC::Ref<Shape> new_prototype_shape);
     void invalidate_all_prototype_chains_leading_to_this();
+    void invalidate_prototype_if_needed_for_change_without_transition();
 
     virtual void visit_edges(Visitor&) override;
 
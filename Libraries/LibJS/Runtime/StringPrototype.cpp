@@ -48,6 +48,12 @@ static ThrowCompletionOr<Utf16String> utf16_string_from(VM& vm)
     return TRY(this_value.to_utf16_string(vm));
 }
 
+static ThrowCompletionOr<GC::Ref<PrimitiveString>> primitive_string_from(VM& vm)
+{
+    auto this_value = TRY(require_object_coercible(vm, vm.this_value()));
+    return TRY(this_value.to_primitive_string(vm));
+}
+
 // 22.1.3.21.1 SplitMatch ( S, q, R ), https://tc39.es/ecma262/#sec-splitmatch
 // FIXME: This no longer exists in the spec!
 static Optional<size_t> split_match(Utf16View const& haystack, size_t start, Utf16View const& needle)
@@ -266,18 +272,18 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::char_at)
 {
     // 1. Let O be ? RequireObjectCoercible(this value).
     // 2. Let S be ? ToString(O).
-    auto string = TRY(utf16_string_from(vm));
+    auto string = TRY(primitive_string_from(vm));
 
     // 3. Let position be ? ToIntegerOrInfinity(pos).
     auto position = TRY(vm.argument(0).to_integer_or_infinity(vm));
 
     // 4. Let size be the length of S.
     // 5. If position < 0 or position ≥ size, return the empty String.
-    if (position < 0 || position >= string.length_in_code_units())
+    if (position < 0 || position >= string->length_in_utf16_code_units())
         return PrimitiveString::create(vm, String {});
 
     // 6. Return the substring of S from position to position + 1.
-    return PrimitiveString::create(vm, Utf16String::create(string.substring_view(position, 1)));
+    return string->substring(vm, position, 1);
 }
 
 // 22.1.3.3 String.prototype.charCodeAt ( pos ), https://tc39.es/ecma262/#sec-string.prototype.charcodeat
@@ -285,18 +291,18 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::char_code_at)
 {
     // 1. Let O be ? RequireObjectCoercible(this value).
     // 2. Let S be ? ToString(O).
-    auto string = TRY(utf16_string_from(vm));
+    auto string = TRY(primitive_string_from(vm));
 
     // 3. Let position be ? ToIntegerOrInfinity(pos).
     auto position = TRY(vm.argument(0).to_integer_or_infinity(vm));
 
     // 4. Let size be the length of S.
     // 5. If position < 0 or position ≥ size, return NaN.
-    if (position < 0 || position >= string.length_in_code_units())
+    if (position < 0 || position >= string->length_in_utf16_code_units())
         return js_nan();
 
     // 6. Return the Number value for the numeric value of the code unit at index position within the String S.
-    return Value(string.code_unit_at(position));
+    return Value(string->utf16_code_unit_at(position));
 }
 
 // 22.1.3.4 String.prototype.codePointAt ( pos ), https://tc39.es/ecma262/#sec-string.prototype.codepointat
@@ -444,14 +450,11 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::index_of)
 {
     // 1. Let O be ? RequireObjectCoercible(this value).
     // 2. Let S be ? ToString(O).
-    auto string = TRY(utf16_string_from(vm));
+    auto string = TRY(primitive_string_from(vm));
 
     // 3. Let searchStr be ? ToString(searchString).
     auto search_string = TRY(vm.argument(0).to_utf16_string(vm));
 
-    auto utf16_string_view = string.view();
-    auto utf16_search_view = search_string.view();
-
     size_t start = 0;
     if (vm.argument_count() > 1) {
         // 4. Let pos be ? ToIntegerOrInfinity(position).
@@ -460,11 +463,11 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::index_of)
 
         // 6. Let len be the length of S.
         // 7. Let start be the result of clamping pos between 0 and len.
-        start = clamp(position, static_cast<double>(0), static_cast<double>(utf16_string_view.length_in_code_units()));
+        start = clamp(position, static_cast<double>(0), static_cast<double>(string->length_in_utf16_code_units()));
     }
 
     // 8. Return 𝔽(StringIndexOf(S, searchStr, start)).
-    auto index = string_index_of(utf16_string_view, utf16_search_view, start);
+    auto index = string->index_of(search_string.view(), start);
     return index.has_value() ? Value(*index) : Value(-1);
 }
 
@@ -1210,10 +1213,10 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::substring)
 {
     // 1. Let O be ? RequireObjectCoercible(this value).
     // 2. Let S be ? ToString(O).
-    auto string = TRY(utf16_string_from(vm));
+    auto string = TRY(primitive_string_from(vm));
 
     // 3. Let len be the length of S.
-    auto string_length = static_cast<double>(string.length_in_code_units());
+    auto string_length = static_cast<double>(string->length_in_utf16_code_units());
 
     // 4. Let intStart be ? ToIntegerOrInfinity(start).
     auto start = TRY(vm.argument(0).to_integer_or_infinity(vm));
@@ -1236,7 +1239,7 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::substring)
     size_t to = max(final_start, final_end);
 
     // 10. Return the substring of S from from to to.
-    return PrimitiveString::create(vm, Utf16String::create(string.substring_view(from, to - from)));
+    return string->substring(vm, from, to - from);
 }
 
 enum class TargetCase {
@@ -188,7 +188,7 @@ JS_DEFINE_NATIVE_FUNCTION(Uint8ArrayConstructorHelpers::from_base64)
 
     // 13. Set the value at each index of ta.[[ViewedArrayBuffer]].[[ArrayBufferData]] to the value at the corresponding
     //     index of result.[[Bytes]].
-    auto& array_buffer_data = typed_array->viewed_array_buffer()->buffer();
+    auto array_buffer_data = typed_array->viewed_array_buffer()->buffer();
 
     for (size_t index = 0; index < result_length; ++index)
         array_buffer_data[index] = result.bytes[index];
@@ -299,7 +299,7 @@ JS_DEFINE_NATIVE_FUNCTION(Uint8ArrayConstructorHelpers::from_hex)
 
     // 6. Set the value at each index of ta.[[ViewedArrayBuffer]].[[ArrayBufferData]] to the value at the corresponding
     //    index of result.[[Bytes]].
-    auto& array_buffer_data = typed_array->viewed_array_buffer()->buffer();
+    auto array_buffer_data = typed_array->viewed_array_buffer()->buffer();
 
     for (size_t index = 0; index < result_length; ++index)
         array_buffer_data[index] = result.bytes[index];
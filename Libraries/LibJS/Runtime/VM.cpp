@@ -165,7 +165,7 @@ VM::VM(OwnPtr<CustomData> custom_data, ErrorMessages error_messages)
 
         // The default implementation of HostResizeArrayBuffer is to return NormalCompletion(unhandled).
 
-        if (auto result = buffer.buffer().try_resize(new_byte_length, ByteBuffer::ZeroFillNewElements::Yes); result.is_error())
+        if (auto result = buffer.owned_buffer().try_resize(new_byte_length, ByteBuffer::ZeroFillNewElements::Yes); result.is_error())
             return throw_completion<RangeError>(ErrorType::NotEnoughMemoryToAllocate, new_byte_length);
 
         return HandledByHost::Handled;
@@ -273,6 +273,8 @@ void VM::gather_roots(HashMap<GC::Cell*, GC::HeapRoot>& roots)
 
     for (auto& job : m_promise_jobs)
         roots.set(job, GC::HeapRoot { .type = GC::HeapRoot::Type::VM });
+
+    m_bytecode_interpreter->gather_roots(roots);
 }
 
 // 9.1.2.1 GetIdentifierReference ( env, name, strict ), https://tc39.es/ecma262/#sec-getidentifierreference
@@ -477,15 +479,30 @@ void VM::promise_rejection_tracker(Promise& promise, Promise::RejectionOperation
 
 void VM::dump_backtrace() const
 {
+    if (!m_execution_context_stack.is_empty())
+        dbgln("{}", backtrace());
+}
+
+String VM::backtrace() const
+{
+    StringBuilder builder;
     for (ssize_t i = m_execution_context_stack.size() - 1; i >= 0; --i) {
         auto& frame = m_execution_context_stack[i];
+        if (!builder.is_empty())
+            builder.append('\n');
         if (frame->executable && frame->program_counter.has_value()) {
             auto source_range = frame->executable->source_range_at(frame->program_counter.value()).realize();
-            dbgln("-> {} @ {}:{},{}", frame->function_name ? frame->function_name->utf8_string() : ""_string, source_range.filename(), source_range.start.line, source_range.start.column);
+            builder.appendff("-> {} @ {}:{},{}", frame->function_name ? frame->function_name->utf8_string() : ""_string, source_range.filename(), source_range.start.line, source_range.start.column);
         } else {
-            dbgln("-> {}", frame->function_name ? frame->function_name->utf8_string() : ""_string);
+            builder.appendff("-> {}", frame->function_name ? frame->function_name->utf8_string() : ""_string);
         }
     }
+    return builder.to_string_without_validation();
+}
+
+void VM::set_allocation_sampling_interval(size_t interval)
+{
+    m_heap.set_allocation_sampling(interval, [this] { return backtrace(); });
 }
 
 void VM::save_execution_context_stack()
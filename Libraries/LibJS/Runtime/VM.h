@@ -61,6 +61,10 @@ public:
     Bytecode::Interpreter& bytecode_interpreter();
 
     void dump_backtrace() const;
+    String backtrace() const;
+
+    // Records the JS stack for every Nth cell allocated in the heap, for use in heap snapshots. 0 disables sampling.
+    void set_allocation_sampling_interval(size_t);
 
     void gather_roots(HashMap<GC::Cell*, GC::HeapRoot>&);
 
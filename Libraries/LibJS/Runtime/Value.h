@@ -342,6 +342,7 @@ public:
     FunctionObject const& as_function() const;
 
     u64 encoded() const { return m_value.encoded; }
+    static Value from_encoded(u64 encoded) { return Value(0, encoded); }
 
     ThrowCompletionOr<String> to_string(VM&) const;
     ThrowCompletionOr<ByteString> to_byte_string(VM&) const;
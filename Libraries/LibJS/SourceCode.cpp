@@ -6,6 +6,7 @@
 
 #include <AK/BinarySearch.h>
 #include <AK/Utf8View.h>
+#include <LibJS/Bytecode/ExecutableCache.h>
 #include <LibJS/SourceCode.h>
 #include <LibJS/SourceRange.h>
 #include <LibJS/Token.h>
@@ -23,6 +24,15 @@ SourceCode::SourceCode(String filename, String code)
 {
 }
 
+SourceCode::~SourceCode() = default;
+
+Bytecode::ExecutableCacheState& SourceCode::executable_cache_state() const
+{
+    if (!m_executable_cache_state)
+        m_executable_cache_state = make<Bytecode::ExecutableCacheState>();
+    return *m_executable_cache_state;
+}
+
 String const& SourceCode::filename() const
 {
     return m_filename;
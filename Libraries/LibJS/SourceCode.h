@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/OwnPtr.h>
 #include <AK/String.h>
 #include <AK/Vector.h>
 #include <LibJS/Forward.h>
@@ -22,6 +23,10 @@ public:
 
     SourceRange range_from_offsets(u32 start_offset, u32 end_offset) const;
 
+    Bytecode::ExecutableCacheState& executable_cache_state() const;
+
+    ~SourceCode();
+
 private:
     SourceCode(String filename, String code);
 
@@ -33,6 +38,8 @@ private:
     // line:column they map to. This can then be binary-searched.
     void fill_position_cache() const;
     Vector<Position> mutable m_cached_positions;
+
+    mutable OwnPtr<Bytecode::ExecutableCacheState> m_executable_cache_state;
 };
 
 }
@@ -0,0 +1,105 @@
+test("transitions between element kinds keep values intact", () => {
+    const array = [1, 2, 3];
+    array[1] = 2.5;
+    expect(array).toEqual([1, 2.5, 3]);
+    array[2] = "three";
+    expect(array).toEqual([1, 2.5, "three"]);
+    array[5] = {};
+    expect(array.length).toBe(6);
+    expect(3 in array).toBeFalse();
+    array.length = 0;
+    array.push(4, 5);
+    expect(array).toEqual([4, 5]);
+});
+
+test("objects stored into numeric arrays stay alive", () => {
+    const array = [1, 2, 3];
+    for (let i = 0; i < 3; ++i) array[i] = { value: i };
+    gc();
+    expect(array.map(object => object.value)).toEqual([0, 1, 2]);
+});
+
+test("holes read through to the prototype", () => {
+    const array = [1, 2, 3];
+    delete array[1];
+    Array.prototype[1] = "from prototype";
+    try {
+        expect(array[1]).toBe("from prototype");
+        expect(array.indexOf("from prototype")).toBe(1);
+        expect(array.map(value => value)).toEqual([1, "from prototype", 3]);
+    } finally {
+        delete Array.prototype[1];
+    }
+});
+
+test("indexOf and lastIndexOf on numeric arrays", () => {
+    const ints = [0, 1, 2, 1, 0];
+    expect(ints.indexOf(1)).toBe(1);
+    expect(ints.lastIndexOf(1)).toBe(3);
+    expect(ints.indexOf(-0)).toBe(0);
+    expect(ints.lastIndexOf(-0)).toBe(4);
+    expect(ints.indexOf(1.5)).toBe(-1);
+    expect(ints.indexOf("1")).toBe(-1);
+    expect(ints.indexOf(NaN)).toBe(-1);
+    expect(ints.indexOf(Infinity)).toBe(-1);
+    expect(ints.indexOf(1, 2)).toBe(3);
+    expect(ints.indexOf(1, -1)).toBe(-1);
+    expect(ints.lastIndexOf(1, 2)).toBe(1);
+    expect(ints.lastIndexOf(1, -3)).toBe(1);
+    expect(ints.lastIndexOf(1, -10)).toBe(-1);
+
+    const doubles = [0.5, NaN, -0, 2];
+    expect(doubles.indexOf(0.5)).toBe(0);
+    expect(doubles.indexOf(NaN)).toBe(-1);
+    expect(doubles.indexOf(0)).toBe(2);
+    expect(doubles.lastIndexOf(2)).toBe(3);
+    expect(doubles.indexOf(null)).toBe(-1);
+});
+
+test("fill writes through packed arrays", () => {
+    const array = [1, 2, 3, 4];
+    expect(array.fill("x", 1, 3)).toEqual([1, "x", "x", 4]);
+    expect(array.fill(0.5)).toEqual([0.5, 0.5, 0.5, 0.5]);
+
+    const holey = [1, , 3];
+    holey.fill(7);
+    expect(holey).toEqual([7, 7, 7]);
+});
+
+test("map sees changes made by the callback", () => {
+    const array = [1, 2, 3, 4];
+    const mapped = array.map((value, index) => {
+        if (index === 0) array[2] = "changed";
+        if (index === 1) array.length = 3;
+        return value;
+    });
+    expect(mapped.length).toBe(4);
+    expect(mapped.slice(0, 3)).toEqual([1, 2, "changed"]);
+    expect(3 in mapped).toBeFalse();
+});
+
+test("default sort of Int32 arrays compares as strings", () => {
+    expect([10, 9, 1, 100, -1, -10, -2, 0].sort()).toEqual([-1, -10, -2, 0, 1, 10, 100, 9]);
+    expect([2147483647, -2147483648, 214748364, -214748364].sort()).toEqual([
+        -214748364, -2147483648, 214748364, 2147483647,
+    ]);
+    expect([3, 30, 3, 300, 0].sort()).toEqual([0, 3, 3, 30, 300]);
+    expect([5, 1.5, 10].sort()).toEqual([1.5, 10, 5]);
+});
+
+test("holes in searches and iteration", () => {
+    const array = [1, , 3, , "x"];
+    expect(array.includes(undefined)).toBeTrue();
+    expect(array.indexOf(undefined)).toBe(-1);
+    expect(array.lastIndexOf("x")).toBe(4);
+    expect(array.filter(() => true)).toEqual([1, 3, "x"]);
+    expect(array.reduce((accumulator, value) => accumulator + value, "")).toBe("13x");
+
+    const visited = [];
+    array.forEach((value, index) => visited.push(index));
+    expect(visited).toEqual([0, 2, 4]);
+
+    const doubles = [NaN, 0.5];
+    expect(doubles.includes(NaN)).toBeTrue();
+    expect(doubles.indexOf(NaN)).toBe(-1);
+});
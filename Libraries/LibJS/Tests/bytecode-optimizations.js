@@ -0,0 +1,137 @@
+test("constants propagated through locals", () => {
+    function compute() {
+        let a = 6;
+        let b = a * 7;
+        const c = b - 2;
+        a = "x";
+        return [a + c, b, c, -c, ~c, !c];
+    }
+
+    expect(compute()).toEqual(["x40", 42, 40, -40, -41, false]);
+});
+
+test("branches on constants", () => {
+    function branches() {
+        const always = 1;
+        const result = [];
+        if (always < 2) result.push("taken");
+        else result.push("not taken");
+        if (always === "1") result.push("strict");
+        if (always) result.push("truthy");
+        while (0) result.push("never");
+        return result;
+    }
+
+    expect(branches()).toEqual(["taken", "truthy"]);
+});
+
+test("locals are not propagated across blocks", () => {
+    function loop() {
+        let value = 0;
+        for (let i = 0; i < 5; ++i) {
+            if (i % 2) value = 10;
+            else value = value + 1;
+        }
+        return value;
+    }
+
+    expect(loop()).toBe(11);
+});
+
+test("function declarations in blocks overwrite constants", () => {
+    function declarations() {
+        let seen = [];
+        for (let i = 0; i < 2; ++i) {
+            if (i === 1) seen.push(typeof f);
+            {
+                function f() {}
+                seen.push(typeof f);
+            }
+        }
+        return seen;
+    }
+
+    expect(declarations()).toEqual(["function", "function", "function"]);
+});
+
+test("values stay alive across finally blocks", () => {
+    function withFinally() {
+        const values = [];
+        for (let i = 0; i < 3; ++i) {
+            const before = i * 10;
+            try {
+                if (i === 1) continue;
+                if (i === 2) break;
+                values.push(before);
+            } finally {
+                const inFinally = [1, 2, 3].map(x => x + i);
+                values.push(before + inFinally.length);
+            }
+        }
+        return values;
+    }
+
+    expect(withFinally()).toEqual([0, 3, 13, 23]);
+});
+
+test("values stay alive across exception handlers", () => {
+    function withCatch(shouldThrow) {
+        let a = 1 + shouldThrow;
+        let b = a * 2;
+        try {
+            if (shouldThrow) throw b;
+            b = 100;
+        } catch (e) {
+            return [a, b, e];
+        }
+        return [a, b];
+    }
+
+    expect(withCatch(0)).toEqual([1, 100]);
+    expect(withCatch(1)).toEqual([2, 4, 4]);
+});
+
+test("values stay alive across yield and await", () => {
+    function* generator(x) {
+        const before = x + 1;
+        const received = yield before;
+        const temporaries = [before * 2, received * 3];
+        yield temporaries[0] + temporaries[1];
+        return before + received;
+    }
+
+    const iterator = generator(1);
+    expect(iterator.next().value).toBe(2);
+    expect(iterator.next(10).value).toBe(34);
+    expect(iterator.next().value).toBe(12);
+
+    async function asyncFunction(x) {
+        const a = x * 2;
+        const b = await a;
+        return a + b;
+    }
+
+    let result;
+    asyncFunction(5).then(value => {
+        result = value;
+    });
+    runQueuedPromiseJobs();
+    expect(result).toBe(20);
+});
+
+test("many temporaries in one expression", () => {
+    function temporaries(a, b, c) {
+        return [a + b * c, (a - b) * (b - c), [a, b, c].map(x => x * x), { a, b, c, sum: a + b + c }];
+    }
+
+    expect(temporaries(1, 2, 3)).toEqual([7, 1, [1, 4, 9], { a: 1, b: 2, c: 3, sum: 6 }]);
+});
+
+test("code after return is not run", () => {
+    function earlyReturn() {
+        return 1;
+        throw new Error("unreachable");
+    }
+
+    expect(earlyReturn()).toBe(1);
+});
@@ -0,0 +1,210 @@
+// test-js parses lazily, so the bodies of the functions declared here are only checked for syntax errors by the
+// PreParser until they're first called.
+
+var globalVar = 1;
+let globalLet = 2;
+
+test("lazily parsed functions can be called", () => {
+    function add(a, b) {
+        let sum = a + b;
+        return sum;
+    }
+
+    expect(add.length).toBe(2);
+    expect(add(1, 2)).toBe(3);
+    expect(add(3, 4)).toBe(7);
+    expect(new add(1, 2)).toBeInstanceOf(add);
+});
+
+test("closures and globals", () => {
+    let captured = 10;
+
+    function useOuterScope() {
+        captured++;
+        return captured + globalVar + globalLet;
+    }
+
+    expect(useOuterScope()).toBe(14);
+    captured = 20;
+    globalVar = 100;
+    expect(useOuterScope()).toBe(123);
+    expect(captured).toBe(21);
+    globalVar = 1;
+});
+
+test("several closures created from the same function", () => {
+    const closures = [];
+    for (let i = 0; i < 3; ++i) {
+        closures.push(function () {
+            return i * 2;
+        });
+    }
+
+    expect(closures.map(closure => closure())).toEqual([0, 2, 4]);
+});
+
+test("nested lazily parsed functions", () => {
+    function outer(x) {
+        function inner(y) {
+            return x + y + globalLet;
+        }
+        return inner;
+    }
+
+    expect(outer(1)(2)).toBe(5);
+    expect(outer(10)(20)).toBe(32);
+});
+
+test("arguments, this and strict mode", () => {
+    function sloppy() {
+        return [arguments.length, this];
+    }
+
+    function strict() {
+        "use strict";
+        return this;
+    }
+
+    expect(sloppy(1, 2, 3)[0]).toBe(3);
+    expect(sloppy()[1]).toBe(globalThis);
+    expect(strict()).toBeUndefined();
+});
+
+test("generators and async functions", () => {
+    function* generator(n) {
+        for (let i = 0; i < n; ++i) yield i;
+    }
+
+    async function asyncFunction(value) {
+        return await value;
+    }
+
+    expect([...generator(3)]).toEqual([0, 1, 2]);
+
+    let result;
+    asyncFunction(42).then(value => {
+        result = value;
+    });
+    runQueuedPromiseJobs();
+    expect(result).toBe(42);
+});
+
+test("toString returns the whole source text", () => {
+    function withSource() {
+        return "done";
+    }
+
+    const source = withSource.toString();
+    expect(source.startsWith("function withSource() {")).toBeTrue();
+    expect(source.endsWith('return "done";\n    }')).toBeTrue();
+    expect(withSource()).toBe("done");
+});
+
+test("errors thrown from lazily parsed functions", () => {
+    function throwsReferenceError() {
+        return doesNotExist;
+    }
+
+    expect(throwsReferenceError).toThrowWithMessage(ReferenceError, "'doesNotExist' is not defined");
+});
+
+test("syntax errors in function bodies are reported up front", () => {
+    expect("function f() { return 1; }").toEval();
+    expect("function f() { return +; }").not.toEval();
+    expect("function f() { let a; let a; }").not.toEval();
+    expect("function f(a) { let a; }").not.toEval();
+    expect("function f() { let a; { var a; } }").not.toEval();
+    expect("function f() { try {} catch ({ a }) { var a; } }").not.toEval();
+    expect('function f() { "use strict"; with ({}) {} }').not.toEval();
+    expect('function f() { "use strict"; return 010; }').not.toEval();
+    expect("function f() { break; }").not.toEval();
+    expect("function f() { a: { continue a; } }").not.toEval();
+    expect("function f() { a: a: ; }").not.toEval();
+    expect("function f() { return /(/; }").not.toEval();
+    expect("function f() { 1 = 2; }").not.toEval();
+    expect("function f() { a?.b = 1; }").not.toEval();
+    expect("function f() { return a ?? b || c; }").not.toEval();
+    expect("function f() { function g(a, a) { 'use strict'; } }").not.toEval();
+    expect("function f() { return function () { class A extends B { constructor() { super(); super(); } } }; }").toEval();
+    expect("function f() { return function () { class { }; }; }").not.toEval();
+});
+
+test("names used in skipped bodies are captured", () => {
+    function outer() {
+        let a = 1;
+        var b = 2;
+        const c = 3;
+        function inner(d) {
+            let result = [];
+            for (let i = 0; i < 2; ++i) {
+                try {
+                    throw i;
+                } catch (e) {
+                    result.push(a + b + c + d + e);
+                }
+            }
+            label: for (var x of [1, 2]) {
+                if (x === 2) break label;
+                result.push(x);
+            }
+            switch (d) {
+                case 4:
+                    result.push(`${a}${b}`);
+                default:
+                    result.push(typeof arguments);
+            }
+            result.push(((y, { z }) => y + z + a)(1, { z: 2 }));
+            result.push({ a, b, [c]: c, get g() { return b; } }.g);
+            return result;
+        }
+        a = 10;
+        return inner;
+    }
+
+    expect(outer()(4)).toEqual([19, 20, 1, "102", "object", 13, 2]);
+});
+
+test("declarations in skipped bodies shadow outer names", () => {
+    let shadowed = "outer";
+
+    function usesOwnBinding() {
+        var shadowed = "inner";
+        return function () {
+            return shadowed;
+        };
+    }
+
+    function usesBlockBinding() {
+        {
+            let shadowed = "block";
+        }
+        return shadowed;
+    }
+
+    expect(usesOwnBinding()()).toBe("inner");
+    expect(usesBlockBinding()).toBe("outer");
+    shadowed = "changed";
+    expect(usesBlockBinding()).toBe("changed");
+});
+
+test("functions the pre-parser doesn't understand are parsed eagerly", () => {
+    let value = 1;
+
+    function withClass() {
+        class Box {
+            get value() {
+                return value;
+            }
+        }
+        return new Box().value;
+    }
+
+    function withDestructuringAssignment() {
+        let a, b;
+        [a, b] = [value, value + 1];
+        return a + b;
+    }
+
+    expect(withClass()).toBe(1);
+    expect(withDestructuringAssignment()).toBe(3);
+});
@@ -0,0 +1,95 @@
+var globalVar = 0;
+let globalLet = 0;
+const globalConst = 0;
+
+function assignGlobalVar(value) {
+    globalVar = value;
+}
+
+function assignGlobalVarStrict(value) {
+    "use strict";
+    globalVar = value;
+}
+
+function assignGlobalLet(value) {
+    globalLet = value;
+}
+
+function assignGlobalConst(value) {
+    globalConst = value;
+}
+
+function assignUndeclared(value) {
+    undeclaredGlobal = value;
+}
+
+function assignUndeclaredStrict(value) {
+    "use strict";
+    undeclaredGlobal = value;
+}
+
+test("repeated assignments to globals", () => {
+    for (let i = 0; i < 10; ++i) {
+        assignGlobalVar(i);
+        assignGlobalLet(i * 2);
+    }
+    expect(globalVar).toBe(9);
+    expect(globalThis.globalVar).toBe(9);
+    expect(globalLet).toBe(18);
+    expect(globalThis.globalLet).toBeUndefined();
+});
+
+test("assignment to a global const", () => {
+    expect(() => assignGlobalConst(1)).toThrowWithMessage(TypeError, "Invalid assignment to const variable");
+    expect(globalConst).toBe(0);
+});
+
+test("assignment to a global that became non-writable", () => {
+    assignGlobalVar(1);
+    assignGlobalVarStrict(2);
+    expect(globalVar).toBe(2);
+
+    Object.defineProperty(globalThis, "globalVar", { writable: false });
+    assignGlobalVar(3);
+    expect(globalVar).toBe(2);
+    expect(() => assignGlobalVarStrict(3)).toThrowWithMessage(TypeError, "Cannot write to non-writable property 'globalVar'");
+});
+
+test("assignment to a global that became an accessor", () => {
+    function assignConfigurable(value) {
+        configurableGlobal = value;
+    }
+
+    globalThis.configurableGlobal = 0;
+    assignConfigurable(1);
+    assignConfigurable(2);
+    expect(configurableGlobal).toBe(2);
+
+    let stored;
+    Object.defineProperty(globalThis, "configurableGlobal", {
+        get() {
+            return stored;
+        },
+        set(value) {
+            stored = value * 10;
+        },
+        configurable: true,
+    });
+    assignConfigurable(3);
+    expect(configurableGlobal).toBe(30);
+    delete globalThis.configurableGlobal;
+});
+
+test("assignment to an undeclared global", () => {
+    expect(() => assignUndeclaredStrict(1)).toThrowWithMessage(ReferenceError, "'undeclaredGlobal' is not defined");
+    assignUndeclared(1);
+    expect(globalThis.undeclaredGlobal).toBe(1);
+    assignUndeclaredStrict(2);
+    expect(undeclaredGlobal).toBe(2);
+
+    delete globalThis.undeclaredGlobal;
+    expect(() => assignUndeclaredStrict(3)).toThrowWithMessage(ReferenceError, "'undeclaredGlobal' is not defined");
+    assignUndeclared(4);
+    expect(undeclaredGlobal).toBe(4);
+    delete globalThis.undeclaredGlobal;
+});
@@ -16,3 +16,233 @@ test("Inline cache invalidated by deleting property from unique shape", () => {
     expect(first).toBe(2);
     expect(second).toBeUndefined();
 });
+
+test("Polymorphic get site returns the right property for each shape", () => {
+    function get(o) {
+        return o.x;
+    }
+
+    const objects = [{ x: 1 }, { a: 0, x: 2 }, { a: 0, b: 0, x: 3 }, Object.create({ x: 4 })];
+    for (let i = 0; i < 3; ++i) {
+        objects.forEach((o, index) => {
+            expect(get(o)).toBe(index + 1);
+        });
+    }
+});
+
+test("Megamorphic get and put sites keep working with many shapes", () => {
+    function get(o) {
+        return o.x;
+    }
+    function put(o, value) {
+        o.x = value;
+    }
+
+    const objects = [];
+    for (let i = 0; i < 20; ++i) {
+        const o = {};
+        for (let j = 0; j < i; ++j) o["p" + j] = j;
+        o.x = i;
+        objects.push(o);
+    }
+
+    for (let round = 0; round < 3; ++round) {
+        objects.forEach((o, index) => {
+            expect(get(o)).toBe(index + round * 100);
+            put(o, index + (round + 1) * 100);
+        });
+    }
+
+    // A prototype property seen by the megamorphic site must not be returned after the prototype changes.
+    const prototype = { x: "prototype" };
+    const inheriting = Object.create(prototype);
+    expect(get(inheriting)).toBe("prototype");
+    prototype.x = "changed";
+    expect(get(inheriting)).toBe("changed");
+    delete prototype.x;
+    expect(get(inheriting)).toBeUndefined();
+});
+
+test("Prototype chain cache invalidated by shadowing property on an intermediate prototype", () => {
+    const grandparent = { x: "grandparent" };
+    const parent = Object.create(grandparent);
+    const child = Object.create(parent);
+
+    function get(o) {
+        return o.x;
+    }
+
+    expect(get(child)).toBe("grandparent");
+    expect(get(child)).toBe("grandparent");
+    parent.x = "parent";
+    expect(get(child)).toBe("parent");
+    delete parent.x;
+    expect(get(child)).toBe("grandparent");
+});
+
+test("Prototype chain cache invalidated by changes to dictionary prototypes", () => {
+    const grandparent = { x: "grandparent" };
+    const parent = Object.create(grandparent);
+    // Turn the intermediate prototype into a dictionary by adding a huge amount of properties.
+    for (let i = 0; i < 100; ++i) parent["p" + i] = i;
+    const child = Object.create(parent);
+
+    function get(o) {
+        return o.x;
+    }
+
+    expect(get(child)).toBe("grandparent");
+    expect(get(child)).toBe("grandparent");
+    parent.x = "parent";
+    expect(get(child)).toBe("parent");
+});
+
+test("Prototype chain cache invalidated by repeated changes to a dictionary prototype further up the chain", () => {
+    const grandparent = {};
+    // Turn the topmost prototype into a dictionary by adding a huge amount of properties.
+    for (let i = 0; i < 100; ++i) grandparent["p" + i] = i;
+    grandparent.x = "grandparent";
+    const parent = Object.create(grandparent);
+    const child = Object.create(parent);
+
+    function get(o) {
+        return o.x;
+    }
+
+    for (let round = 0; round < 3; ++round) {
+        expect(get(child)).toBe("grandparent");
+        expect(get(child)).toBe("grandparent");
+        delete grandparent.x;
+        expect(get(child)).toBeUndefined();
+        grandparent.x = "grandparent";
+    }
+});
+
+test("Prototype chain cache not used for dictionary receivers that gain a shadowing property", () => {
+    const prototype = { x: "prototype" };
+    const o = Object.create(prototype);
+    for (let i = 0; i < 100; ++i) o["p" + i] = i;
+
+    function get(o) {
+        return o.x;
+    }
+
+    expect(get(o)).toBe("prototype");
+    expect(get(o)).toBe("prototype");
+    o.x = "own";
+    expect(get(o)).toBe("own");
+});
+
+test("Method calls through the prototype chain", () => {
+    function push(array, value) {
+        return array.push(value);
+    }
+
+    const array = [];
+    for (let i = 0; i < 10; ++i) expect(push(array, i)).toBe(i + 1);
+
+    const originalPush = Array.prototype.push;
+    Array.prototype.push = function () {
+        return "patched";
+    };
+    try {
+        expect(push(array, 10)).toBe("patched");
+    } finally {
+        Array.prototype.push = originalPush;
+    }
+    expect(push(array, 10)).toBe(11);
+});
+
+test("Object literals created from a cached shape get all of their own properties", () => {
+    function make(a, b) {
+        return { x: a, y: b, "not an identifier": a + b, x: b, 0: "index" };
+    }
+
+    for (let i = 0; i < 3; ++i) {
+        const o = make(i, i * 2);
+        expect(Object.keys(o)).toEqual(["0", "x", "y", "not an identifier"]);
+        expect(o.x).toBe(i * 2);
+        expect(o.y).toBe(i * 2);
+        expect(o["not an identifier"]).toBe(i * 3);
+        expect(o[0]).toBe("index");
+    }
+
+    function throwing(shouldThrow) {
+        return {
+            a: 1,
+            b: (() => {
+                if (shouldThrow) throw new Error();
+                return 2;
+            })(),
+        };
+    }
+    expect(throwing(false)).toEqual({ a: 1, b: 2 });
+    expect(() => throwing(true)).toThrow(Error);
+    expect(throwing(false)).toEqual({ a: 1, b: 2 });
+});
+
+test("Cached property additions respect the prototype chain", () => {
+    function Point(x, y) {
+        this.x = x;
+        this.y = y;
+    }
+
+    const first = new Point(1, 2);
+    const second = new Point(3, 4);
+    expect(Object.keys(second)).toEqual(["x", "y"]);
+    expect(second.y).toBe(4);
+
+    let setterValue;
+    Object.defineProperty(Point.prototype, "y", {
+        set(value) {
+            setterValue = value;
+        },
+        configurable: true,
+    });
+    const third = new Point(5, 6);
+    expect(setterValue).toBe(6);
+    expect(Object.keys(third)).toEqual(["x"]);
+
+    delete Point.prototype.y;
+    Object.defineProperty(Object.prototype, "y", { value: "read-only", configurable: true });
+    try {
+        const fourth = new Point(7, 8);
+        expect(Object.hasOwn(fourth, "y")).toBeFalse();
+        expect(fourth.y).toBe("read-only");
+    } finally {
+        delete Object.prototype.y;
+    }
+
+    expect(new Point(9, 10).y).toBe(10);
+    expect(first.y).toBe(2);
+});
+
+test("Cached property additions respect non-extensible objects", () => {
+    function add(o) {
+        o.added = true;
+    }
+
+    add({ a: 1 });
+    add({ a: 1 });
+    const sealed = Object.preventExtensions({ a: 1 });
+    add(sealed);
+    expect(Object.hasOwn(sealed, "added")).toBeFalse();
+    expect(() => {
+        "use strict";
+        sealed.added = true;
+    }).toThrow(TypeError);
+
+    const proxied = Object.create(
+        new Proxy(
+            {},
+            {
+                set() {
+                    return true;
+                },
+            }
+        )
+    );
+    add(proxied);
+    add(proxied);
+    expect(Object.hasOwn(proxied, "added")).toBeFalse();
+});
@@ -0,0 +1,99 @@
+// Concatenated strings are kept as ropes, and length, charAt, charCodeAt, indexOf and substring walk them instead of
+// flattening them. These check that they give the same results on a rope as on the equivalent flat string.
+
+function makePieces(count) {
+    const pieces = [];
+    for (let i = 0; i < count; ++i) {
+        if (i % 7 === 3) pieces.push("\ud83d");
+        else if (i % 7 === 4) pieces.push("\ude00");
+        else if (i % 5 === 0) pieces.push("needle");
+        else pieces.push("hay" + String.fromCharCode(0x100 + i) + i);
+    }
+    return pieces;
+}
+
+function appendAll(pieces) {
+    let rope = "";
+    for (const piece of pieces) rope += piece;
+    return rope;
+}
+
+function prependAll(pieces) {
+    let rope = "";
+    for (const piece of pieces) rope = piece + rope;
+    return rope;
+}
+
+// Builds the flat string from code units, so that the surrogate halves in separate pieces come out as one pair.
+function flatten(pieces) {
+    const codeUnits = [];
+    for (const piece of pieces) {
+        for (let i = 0; i < piece.length; ++i) codeUnits.push(piece.charCodeAt(i));
+    }
+    return String.fromCharCode(...codeUnits);
+}
+
+function expectSameString(rope, flat) {
+    expect(rope.length).toBe(flat.length);
+    for (let i = 0; i < flat.length; i += 3) {
+        expect(rope.charCodeAt(i)).toBe(flat.charCodeAt(i));
+        expect(rope.charAt(i)).toBe(flat.charAt(i));
+        expect(rope[i]).toBe(flat[i]);
+    }
+    expect(rope.charCodeAt(flat.length)).toBeNaN();
+    expect(rope.charAt(flat.length)).toBe("");
+    expect(rope[flat.length]).toBeUndefined();
+}
+
+const pieces = makePieces(500);
+const flat = flatten(pieces);
+
+test("length and characters", () => {
+    expectSameString(appendAll(pieces), flat);
+    expectSameString(prependAll(pieces), flatten(pieces.toReversed()));
+});
+
+test("indexOf across the boundaries between pieces", () => {
+    const rope = appendAll(pieces);
+    const searches = ["needle", "hay", "ne", "edlehay", "😀", "3ne", "", "absent", pieces[2] + pieces[3]];
+    for (const search of searches) {
+        for (let from = 0; from <= flat.length + 1; from += 11)
+            expect(rope.indexOf(search, from)).toBe(flat.indexOf(search, from));
+    }
+
+    // A surrogate pair split between two pieces is still found as one code point.
+    expect(appendAll(["abc\ud83d", "\ude00def"]).indexOf("😀")).toBe(3);
+});
+
+test("substring", () => {
+    const rope = appendAll(pieces);
+    for (let start = 0; start < flat.length; start += 13) {
+        expect(rope.substring(start, start + 17)).toBe(flat.substring(start, start + 17));
+        expect(rope.substring(start)).toBe(flat.substring(start));
+    }
+    expect(rope.substring(flat.length - 5, 5)).toBe(flat.substring(5, flat.length - 5));
+});
+
+test("deep concatenation", () => {
+    const count = 100_000;
+    let appended = "";
+    let prepended = "";
+    for (let i = 0; i < count; ++i) {
+        appended += "ab";
+        prepended = "ab" + prepended;
+    }
+    expect(appended.length).toBe(2 * count);
+    expect(prepended.length).toBe(2 * count);
+    expect(appended.charCodeAt(2 * count - 1)).toBe(0x62);
+    expect(prepended.charAt(12345)).toBe("b");
+    expect(appended.indexOf("ba", 2 * count - 4)).toBe(2 * count - 3);
+    expect(prepended.substring(count - 1, count + 3)).toBe("baba");
+    expect(appended === prepended).toBeTrue();
+});
+
+test("ropes of ropes", () => {
+    const left = appendAll(pieces.slice(0, 250));
+    const right = prependAll(pieces.slice(250).toReversed());
+    expectSameString(left + right, flat);
+    expectSameString(right + left, flatten(pieces.slice(250).concat(pieces.slice(0, 250))));
+});
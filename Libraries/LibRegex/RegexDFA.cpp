@@ -0,0 +1,400 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/HashTable.h>
+#include <LibRegex/RegexDFA.h>
+
+namespace regex {
+
+namespace {
+
+struct ClosureItem {
+    u32 node;
+    u64 checkpoints;
+    u64 local_checkpoints;
+
+    bool operator==(ClosureItem const&) const = default;
+};
+
+struct ClosureItemTraits : public DefaultTraits<ClosureItem> {
+    static unsigned hash(ClosureItem const& item)
+    {
+        return pair_int_hash(item.node, pair_int_hash(u64_hash(item.checkpoints), u64_hash(item.local_checkpoints)));
+    }
+};
+
+}
+
+unsigned LazyDFA::StateKeyTraits::hash(StateKey const& key)
+{
+    unsigned hash = key.at_begin;
+    for (auto const& thread : key.threads)
+        hash = pair_int_hash(hash, pair_int_hash(thread.node, u64_hash(thread.checkpoints)));
+    return hash;
+}
+
+LazyDFA::LazyDFA(ByteCode const& bytecode)
+{
+    HashMap<size_t, u32> node_for_instruction_position;
+    HashMap<size_t, size_t> checkpoint_bits;
+    auto bytecode_size = bytecode.size();
+
+    MatchState state;
+    for (state.instruction_position = 0; state.instruction_position < bytecode_size;) {
+        auto& opcode = bytecode.get_opcode(state);
+        node_for_instruction_position.set(state.instruction_position, m_nodes.size());
+        m_nodes.append({ .instruction_position = state.instruction_position });
+        state.instruction_position += opcode.size();
+    }
+    auto opcode_count = m_nodes.size();
+
+    // Running off the end of the bytecode reaches the implicit Exit, which always succeeds.
+    node_for_instruction_position.set(bytecode_size, m_nodes.size());
+    m_nodes.append({ .kind = Node::Kind::Match, .instruction_position = bytecode_size });
+
+    u32 fail_node = m_nodes.size();
+    m_nodes.append({ .kind = Node::Kind::Fail, .instruction_position = bytecode_size });
+
+    auto checkpoint_bit = [&](size_t id) -> u8 {
+        auto bit = checkpoint_bits.ensure(id, [&] { return checkpoint_bits.size(); });
+        if (bit >= max_checkpoints) {
+            m_failed = true;
+            return 0;
+        }
+        return bit;
+    };
+
+    for (size_t i = 0; i < opcode_count; ++i) {
+        auto& node = m_nodes[i];
+        state.instruction_position = node.instruction_position;
+        auto& opcode = bytecode.get_opcode(state);
+
+        auto node_at = [&](size_t instruction_position) {
+            return node_for_instruction_position.get(instruction_position).value_or(fail_node);
+        };
+        auto next = node_at(node.instruction_position + opcode.size());
+        auto target = [&]<typename T>() {
+            return node_at(node.instruction_position + opcode.size() + static_cast<T const&>(opcode).offset());
+        };
+
+        switch (opcode.opcode_id()) {
+        case OpCodeId::Compare:
+            node.kind = Node::Kind::Compare;
+            node.next = next;
+            break;
+        case OpCodeId::Jump:
+            node.kind = Node::Kind::Jump;
+            node.next = target.template operator()<OpCode_Jump>();
+            break;
+        // The ForkReplace forms only prune alternatives that the optimizer proved can't lead to a match,
+        // so they order the threads just like the plain forks do.
+        case OpCodeId::ForkJump:
+        case OpCodeId::ForkReplaceJump:
+            node.kind = Node::Kind::Fork;
+            node.next = target.template operator()<OpCode_ForkJump>();
+            node.alternative = next;
+            break;
+        case OpCodeId::ForkStay:
+        case OpCodeId::ForkReplaceStay:
+            node.kind = Node::Kind::Fork;
+            node.next = next;
+            node.alternative = target.template operator()<OpCode_ForkStay>();
+            break;
+        case OpCodeId::Checkpoint:
+            node.kind = Node::Kind::Checkpoint;
+            node.checkpoint = checkpoint_bit(static_cast<OpCode_Checkpoint const&>(opcode).id());
+            node.next = next;
+            break;
+        case OpCodeId::JumpNonEmpty: {
+            auto const& jump = static_cast<OpCode_JumpNonEmpty const&>(opcode);
+            node.kind = Node::Kind::JumpNonEmpty;
+            node.form = jump.form();
+            node.checkpoint = checkpoint_bit(jump.checkpoint());
+            node.next = next;
+            node.alternative = target.template operator()<OpCode_JumpNonEmpty>();
+            break;
+        }
+        case OpCodeId::CheckBegin:
+            node.kind = Node::Kind::CheckBegin;
+            node.next = next;
+            m_has_anchors = true;
+            break;
+        case OpCodeId::CheckEnd:
+            node.kind = Node::Kind::CheckEnd;
+            node.next = next;
+            m_has_anchors = true;
+            break;
+        case OpCodeId::SaveLeftCaptureGroup:
+        case OpCodeId::SaveRightCaptureGroup:
+        case OpCodeId::SaveRightNamedCaptureGroup:
+        case OpCodeId::ClearCaptureGroup:
+            node.kind = Node::Kind::Jump;
+            node.next = next;
+            break;
+        default:
+            // Regex::can_be_matched_by_lazy_dfa() doesn't let any other opcode through.
+            m_failed = true;
+            break;
+        }
+    }
+}
+
+// Follows the non-consuming opcodes from the given threads in priority order, and collects the compares
+// reached by them. Once a thread reaches the end of the bytecode, every thread after it has a lower priority
+// than that match and is dropped, just like the backtracker would never get to try them.
+LazyDFA::Closure LazyDFA::closure(Vector<Thread> const& threads, bool at_begin, bool at_end) const
+{
+    Closure result;
+    HashTable<ClosureItem, ClosureItemTraits> visited;
+    HashTable<Thread, ThreadTraits> seen_compares;
+    Vector<ClosureItem> stack;
+
+    for (auto const& thread : threads) {
+        stack.append({ thread.node, thread.checkpoints, 0 });
+
+        while (!stack.is_empty()) {
+            auto item = stack.take_last();
+            if (visited.set(item) != HashSetResult::InsertedNewEntry)
+                continue;
+
+            auto const& node = m_nodes[item.node];
+            auto follow = [&](u32 node_index, u64 local_checkpoints) {
+                stack.append({ node_index, item.checkpoints, local_checkpoints });
+            };
+
+            // Forks push their lower priority side first, so that the higher priority side is explored first.
+            switch (node.kind) {
+            case Node::Kind::Compare:
+                if (!at_end) {
+                    Thread compare { item.node, item.checkpoints | item.local_checkpoints };
+                    if (seen_compares.set(compare) == HashSetResult::InsertedNewEntry)
+                        result.compares.append(compare);
+                }
+                break;
+            case Node::Kind::Jump:
+                follow(node.next, item.local_checkpoints);
+                break;
+            case Node::Kind::Fork:
+                follow(node.alternative, item.local_checkpoints);
+                follow(node.next, item.local_checkpoints);
+                break;
+            case Node::Kind::Checkpoint:
+                follow(node.next, item.local_checkpoints | (1ull << node.checkpoint));
+                break;
+            case Node::Kind::JumpNonEmpty: {
+                // The loop body was non-empty if its checkpoint was set, but not at the current position.
+                auto bit = 1ull << node.checkpoint;
+                auto was_set = ((item.checkpoints | item.local_checkpoints) & bit) != 0;
+                auto was_set_here = (item.local_checkpoints & bit) != 0;
+                if (!was_set || was_set_here) {
+                    if (at_end)
+                        follow(node.next, item.local_checkpoints);
+                    break;
+                }
+                switch (node.form) {
+                case OpCodeId::Jump:
+                    follow(node.alternative, item.local_checkpoints);
+                    break;
+                case OpCodeId::ForkJump:
+                case OpCodeId::ForkReplaceJump:
+                    follow(node.next, item.local_checkpoints);
+                    follow(node.alternative, item.local_checkpoints);
+                    break;
+                case OpCodeId::ForkStay:
+                case OpCodeId::ForkReplaceStay:
+                    follow(node.alternative, item.local_checkpoints);
+                    follow(node.next, item.local_checkpoints);
+                    break;
+                default:
+                    break;
+                }
+                break;
+            }
+            case Node::Kind::CheckBegin:
+                if (at_begin)
+                    follow(node.next, item.local_checkpoints);
+                break;
+            case Node::Kind::CheckEnd:
+                if (at_end)
+                    follow(node.next, item.local_checkpoints);
+                break;
+            case Node::Kind::Match:
+                result.matches = true;
+                return result;
+            case Node::Kind::Fail:
+                break;
+            }
+        }
+    }
+
+    return result;
+}
+
+LazyDFA::State* LazyDFA::state_for(Vector<Thread> threads, bool at_begin)
+{
+    StateKey key { move(threads), at_begin && m_has_anchors };
+    if (auto it = m_states.find(key); it != m_states.end())
+        return it->value.ptr();
+
+    if (m_states.size() >= max_states) {
+        m_failed = true;
+        return nullptr;
+    }
+
+    auto state = make<State>();
+    state->threads = key.threads;
+    state->at_begin = key.at_begin;
+
+    auto closure = this->closure(state->threads, state->at_begin, false);
+    state->compares = move(closure.compares);
+    state->matches = closure.matches;
+
+    auto* state_ptr = state.ptr();
+    m_states.set(move(key), move(state));
+    return state_ptr;
+}
+
+// Computes the transition out of a state by running its compares against the character at the given position.
+// The result only depends on that character, so it is cached for every later occurrence of it.
+Optional<LazyDFA::Transition> LazyDFA::compute_transition(State& state, ByteCode const& bytecode, MatchInput const& input, size_t position, size_t position_in_code_units)
+{
+    Vector<Thread> next_threads;
+    HashTable<Thread, ThreadTraits> seen_threads;
+    Optional<size_t> code_units;
+
+    for (auto const& thread : state.compares) {
+        auto const& node = m_nodes[thread.node];
+        m_scratch_state.instruction_position = node.instruction_position;
+        m_scratch_state.string_position = position;
+        m_scratch_state.string_position_in_code_units = position_in_code_units;
+
+        auto& opcode = bytecode.get_opcode(m_scratch_state);
+        if (opcode.execute(input, m_scratch_state) != ExecutionResult::Continue)
+            continue;
+
+        // Every thread has to consume the same single character, or the threads would go out of step.
+        if (m_scratch_state.string_position != position + 1)
+            return {};
+        auto advanced = m_scratch_state.string_position_in_code_units - position_in_code_units;
+        if (advanced == 0 || advanced > 2 || (code_units.has_value() && *code_units != advanced))
+            return {};
+        code_units = advanced;
+
+        Thread next_thread { node.next, thread.checkpoints };
+        if (seen_threads.set(next_thread) == HashSetResult::InsertedNewEntry)
+            next_threads.append(next_thread);
+    }
+
+    auto* next_state = state_for(move(next_threads), false);
+    if (!next_state)
+        return {};
+    return Transition { next_state, static_cast<u8>(code_units.value_or(1)) };
+}
+
+LazyDFA::Result LazyDFA::match(ByteCode const& bytecode, MatchInput const& input, MatchState& state, size_t& operations)
+{
+    if (m_failed)
+        return Result::Unavailable;
+
+    // Transitions are keyed on the code unit and code point at the current position, which only identify the character
+    // there for byte-sized string views and UTF-16 views.
+    if (input.view.is_string_view() ? input.view.unicode() : !input.view.is_u16_view())
+        return Result::Unavailable;
+
+    auto const& options = input.regex_options;
+    if (options.has_flag_set(AllFlags::MatchNotBeginOfLine) || options.has_flag_set(AllFlags::MatchNotEndOfLine))
+        return Result::Unavailable;
+    if (m_has_anchors && options.has_flag_set(AllFlags::Multiline) && options.has_flag_set(AllFlags::Internal_ConsiderNewline))
+        return Result::Unavailable;
+
+    // The compares depend on the options (e.g. case insensitivity), so the cached transitions do too.
+    if (m_options != options.value()) {
+        m_start_states = {};
+        m_states.clear();
+        m_options = options.value();
+    }
+
+    auto position = state.string_position;
+    auto position_in_code_units = state.string_position_in_code_units;
+    auto length = input.view.length();
+
+    // Some compares look at the code point index and others at the code unit index, and the matcher starts with both
+    // set to the same value. Past a surrogate pair, those refer to different characters, which the transitions can't
+    // be keyed on.
+    if (input.view.unicode() && input.view.is_u16_view()) {
+        if (position != position_in_code_units)
+            return Result::Unavailable;
+        for (auto code_unit : input.view.u16_view().span().trim(position_in_code_units)) {
+            if (Utf16View::is_high_surrogate(code_unit))
+                return Result::Unavailable;
+        }
+    }
+
+    auto at_begin = m_has_anchors && position == 0;
+    auto*& start_state = m_start_states[at_begin];
+    if (!start_state) {
+        start_state = state_for({ { 0, 0 } }, at_begin);
+        if (!start_state)
+            return Result::Unavailable;
+    }
+
+    Optional<size_t> match_end;
+    size_t match_end_in_code_units = 0;
+    auto* current = start_state;
+
+    for (;;) {
+        ++operations;
+
+        if (position >= length) {
+            if (!current->matches_at_end.has_value())
+                current->matches_at_end = closure(current->threads, current->at_begin, true).matches;
+            if (*current->matches_at_end) {
+                match_end = position;
+                match_end_in_code_units = position_in_code_units;
+            }
+            break;
+        }
+
+        if (current->matches) {
+            match_end = position;
+            match_end_in_code_units = position_in_code_units;
+        }
+
+        if (current->compares.is_empty())
+            break;
+
+        auto code_unit = input.view.code_unit_at(position_in_code_units);
+        auto code_point = input.view[position_in_code_units];
+
+        Transition* transition;
+        if (code_unit == code_point && code_unit < current->ascii_transitions.size())
+            transition = &current->ascii_transitions[code_unit];
+        else
+            transition = &current->transitions.ensure((static_cast<u64>(code_unit) << 32) | code_point);
+
+        if (!transition->next) {
+            auto computed_transition = compute_transition(*current, bytecode, input, position, position_in_code_units);
+            if (!computed_transition.has_value()) {
+                m_failed = true;
+                return Result::Unavailable;
+            }
+            *transition = computed_transition.release_value();
+        }
+
+        current = transition->next;
+        ++position;
+        position_in_code_units += transition->code_units;
+    }
+
+    if (!match_end.has_value())
+        return Result::NotMatched;
+
+    state.string_position = *match_end;
+    state.string_position_in_code_units = match_end_in_code_units;
+    return Result::Matched;
+}
+
+}
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include "RegexByteCode.h"
+#include "RegexMatch.h"
+
+#include <AK/Array.h>
+#include <AK/HashMap.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Vector.h>
+
+namespace regex {
+
+// A DFA that is built lazily, one state and transition at a time, from the bytecode of a pattern that
+// only uses forks, character compares, anchors and captures (see Regex::can_be_matched_by_lazy_dfa()).
+//
+// Each DFA state is an ordered list of NFA threads, ordered by the priority the backtracker would give
+// them, so that the end position found for a starting position is the same one the backtracker finds.
+// The DFA can't produce captures; when those are needed, it is only used to reject starting positions.
+class LazyDFA {
+public:
+    static constexpr size_t max_checkpoints = 64;
+    static constexpr size_t max_states = 1024;
+
+    explicit LazyDFA(ByteCode const&);
+
+    enum class Result : u8 {
+        Matched,
+        NotMatched,
+        Unavailable,
+    };
+
+    // Runs the DFA from state.string_position. On a match, the state's string positions are moved to the end of the match.
+    Result match(ByteCode const&, MatchInput const&, MatchState&, size_t& operations);
+
+private:
+    struct Node {
+        enum class Kind : u8 {
+            Compare,
+            Jump,
+            Fork,
+            Checkpoint,
+            JumpNonEmpty,
+            CheckBegin,
+            CheckEnd,
+            Match,
+            Fail,
+        };
+
+        Kind kind { Kind::Fail };
+        OpCodeId form { OpCodeId::Jump };
+        u8 checkpoint { 0 };
+        u32 next { 0 };
+        u32 alternative { 0 };
+        size_t instruction_position { 0 };
+    };
+
+    struct Thread {
+        u32 node;
+        u64 checkpoints;
+
+        bool operator==(Thread const&) const = default;
+    };
+
+    struct ThreadTraits : public DefaultTraits<Thread> {
+        static unsigned hash(Thread const& thread) { return pair_int_hash(thread.node, u64_hash(thread.checkpoints)); }
+    };
+
+    struct State;
+
+    struct Transition {
+        State* next { nullptr };
+        u8 code_units { 0 };
+    };
+
+    struct State {
+        Vector<Thread> threads;
+        bool at_begin { false };
+
+        Vector<Thread> compares;
+        bool matches { false };
+        Optional<bool> matches_at_end;
+
+        Array<Transition, 128> ascii_transitions {};
+        HashMap<u64, Transition> transitions;
+    };
+
+    struct StateKey {
+        Vector<Thread> threads;
+        bool at_begin { false };
+
+        bool operator==(StateKey const&) const = default;
+    };
+
+    struct StateKeyTraits : public DefaultTraits<StateKey> {
+        static unsigned hash(StateKey const&);
+    };
+
+    struct Closure {
+        Vector<Thread> compares;
+        bool matches { false };
+    };
+
+    Closure closure(Vector<Thread> const&, bool at_begin, bool at_end) const;
+    State* state_for(Vector<Thread>, bool at_begin);
+    Optional<Transition> compute_transition(State&, ByteCode const&, MatchInput const&, size_t position, size_t position_in_code_units);
+
+    Vector<Node> m_nodes;
+    bool m_has_anchors { false };
+
+    HashMap<StateKey, NonnullOwnPtr<State>, StateKeyTraits> m_states;
+    Array<State*, 2> m_start_states {};
+    Optional<AllFlags> m_options;
+    bool m_failed { false };
+    MatchState m_scratch_state;
+};
+
+}
@@ -66,6 +66,11 @@ public:
         return m_view.has<StringView>();
     }
 
+    bool is_u16_view() const
+    {
+        return m_view.has<Utf16View>();
+    }
+
     StringView string_view() const
     {
         return m_view.get<StringView>();
@@ -547,6 +552,7 @@ struct MatchInput {
     mutable Vector<size_t> saved_code_unit_positions;
     mutable Vector<size_t> saved_forks_since_last_save;
     mutable Optional<size_t> fork_to_replace;
+    mutable bool reached_max_operations { false };
 };
 
 struct MatchState {
@@ -588,6 +594,28 @@ struct MatchState {
 
         return hash;
     }
+
+    // Hashes only what decides whether matching can still succeed from this state, for patterns whose string position
+    // never moves backwards and that don't look at what the capture groups matched. Since later positions can't be
+    // equal to a checkpoint that lies behind the current one, only whether each checkpoint is unset, at the current
+    // position or behind it matters.
+    u64 u64_hash_for_memoization() const
+    {
+        u64 hash = 0xcbf29ce484222325;
+        auto combine = [&hash](auto value) {
+            hash ^= value + 0x9e3779b97f4a7c15 + (hash << 6) + (hash >> 2);
+        };
+
+        combine(string_position);
+        combine(string_position_in_code_units);
+        combine(instruction_position);
+        for (auto mark : repetition_marks)
+            combine(mark);
+        for (auto checkpoint : checkpoints)
+            combine(checkpoint == 0 ? 0u : checkpoint == string_position + 1 ? 1u : 2u);
+
+        return hash;
+    }
 };
 
 }
@@ -7,6 +7,9 @@
 #include <AK/BumpAllocator.h>
 #include <AK/ByteString.h>
 #include <AK/Debug.h>
+#include <AK/MemMem.h>
+#include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
 #include <AK/StringBuilder.h>
 #include <LibRegex/RegexMatcher.h>
 #include <LibRegex/RegexParser.h>
@@ -69,8 +72,11 @@ Regex<Parser>::Regex(ByteString pattern, typename ParserTraits<Parser>::OptionsT
         }
     }
 
-    if (parser_result.error == regex::Error::NoError)
-        matcher = make<Matcher<Parser>>(this, static_cast<decltype(regex_options.value())>(parser_result.options.value()));
+    if (parser_result.error == regex::Error::NoError) {
+        typename ParserTraits<Parser>::OptionsType matcher_options = static_cast<decltype(regex_options.value())>(parser_result.options.value());
+        matcher_options.set_max_operations(regex_options.max_operations());
+        matcher = make<Matcher<Parser>>(this, matcher_options);
+    }
 }
 
 template<class Parser>
@@ -143,6 +149,74 @@ RegexResult Matcher<Parser>::match(RegexStringView view, Optional<typename Parse
     return match(views, regex_options);
 }
 
+// Returns the index of the first code unit at or after start that lies in one of the ranges, comparing a vector's worth
+// of code units at a time.
+template<typename CodeUnit>
+static Optional<size_t> find_code_unit_in_ranges(ReadonlySpan<CodeUnit> code_units, size_t start, ReadonlySpan<StartingCharacterRange> ranges)
+{
+    using VectorType = Conditional<sizeof(CodeUnit) == 1, AK::SIMD::u8x16, AK::SIMD::u16x8>;
+    static constexpr size_t code_units_per_vector = AK::SIMD::vector_length<VectorType>;
+
+    auto index = start;
+    for (; index + code_units_per_vector <= code_units.size(); index += code_units_per_vector) {
+        auto chunk = AK::SIMD::load_unaligned<VectorType>(code_units.data() + index);
+        VectorType in_ranges {};
+        for (auto const& range : ranges)
+            in_ranges |= (VectorType)(chunk - static_cast<CodeUnit>(range.from) <= static_cast<CodeUnit>(range.to - range.from));
+
+        auto halves = bit_cast<AK::SIMD::u64x2>(in_ranges);
+        if ((halves[0] | halves[1]) != 0)
+            break;
+    }
+
+    for (; index < code_units.size(); ++index) {
+        auto code_unit = code_units[index];
+        if (any_of(ranges, [&](auto const& range) { return code_unit >= range.from && code_unit <= range.to; }))
+            return index;
+    }
+    return {};
+}
+
+// Returns the first index at or after start where a match could begin, going by the characters every match starts with.
+static Optional<size_t> find_possible_match_start(RegexStringView const& view, size_t start, ReadonlySpan<StartingCharacterRange> ranges, StringView literal_prefix)
+{
+    if (view.is_string_view()) {
+        auto bytes = view.string_view().bytes();
+        if (start >= bytes.size())
+            return {};
+        if (literal_prefix.length() > 1) {
+            auto offset = AK::memmem_optional(bytes.data() + start, bytes.size() - start, literal_prefix.characters_without_null_termination(), literal_prefix.length());
+            if (!offset.has_value())
+                return {};
+            return start + *offset;
+        }
+        return find_code_unit_in_ranges(bytes, start, ranges);
+    }
+
+    auto code_units = ReadonlySpan<u16> { view.u16_view().data(), view.u16_view().length_in_code_units() };
+    for (auto index = start; index < code_units.size(); ++index) {
+        auto candidate = find_code_unit_in_ranges(code_units, index, ranges);
+        if (!candidate.has_value())
+            return {};
+        index = *candidate;
+
+        auto rest_of_prefix = literal_prefix.substring_view(min<size_t>(literal_prefix.length(), 1));
+        if (index + 1 + rest_of_prefix.length() > code_units.size())
+            return {};
+
+        bool matches_prefix = true;
+        for (size_t i = 0; i < rest_of_prefix.length(); ++i) {
+            if (code_units[index + 1 + i] != static_cast<u8>(rest_of_prefix[i])) {
+                matches_prefix = false;
+                break;
+            }
+        }
+        if (matches_prefix)
+            return index;
+    }
+    return {};
+}
+
 template<typename Parser>
 RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optional<typename ParserTraits<Parser>::OptionsType> regex_options) const
 {
@@ -157,6 +231,7 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
     size_t operations = 0;
 
     input.regex_options = m_regex_options | regex_options.value_or({}).value();
+    input.regex_options.set_max_operations(min(m_regex_options.max_operations(), regex_options.value_or({}).max_operations()));
     input.start_offset = m_pattern->start_offset;
     size_t lines_to_skip = 0;
 
@@ -215,6 +290,16 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
     auto single_match_only = input.regex_options.has_flag_set(AllFlags::SingleMatch);
     auto only_start_of_line = m_pattern->parser_result.optimization_data.only_start_of_line && !input.regex_options.has_flag_set(AllFlags::Multiline);
 
+    // When we'd try every position anyway, skip straight to those that start with a character a match can start with.
+    // The starting characters are only known as code units when each character is a single one, and for byte strings
+    // only ASCII characters are.
+    auto const& starting_ranges = m_pattern->parser_result.optimization_data.starting_ranges;
+    auto can_skip_to_possible_match_start = continue_search
+        && !only_start_of_line
+        && !unicode
+        && !input.regex_options.has_flag_set(AllFlags::Insensitive)
+        && !starting_ranges.is_empty();
+
     for (auto const& view : views) {
         if (lines_to_skip != 0) {
             ++input.line;
@@ -259,10 +344,21 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
             }
         }
 
+        auto skip_to_possible_match_start = can_skip_to_possible_match_start
+            && (view.is_u16_view() || (view.is_string_view() && starting_ranges.last().to < 0x80))
+            && starting_ranges.last().to <= 0xffff;
+
         for (; view_index <= view_length; ++view_index) {
             if (view_index == view_length && input.regex_options.has_flag_set(AllFlags::Multiline))
                 break;
 
+            if (skip_to_possible_match_start) {
+                auto possible_match_start = find_possible_match_start(view, view_index, starting_ranges, m_pattern->parser_result.optimization_data.literal_prefix);
+                if (!possible_match_start.has_value())
+                    break;
+                view_index = *possible_match_start;
+            }
+
             auto& match_length_minimum = m_pattern->parser_result.match_length_minimum;
             // FIXME: More performant would be to know the remaining minimum string
             //        length needed to match from the current position onwards within
@@ -282,6 +378,9 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
             state.repetition_marks.clear();
 
             auto success = execute(input, state, operations);
+            if (input.reached_max_operations)
+                break;
+
             if (success) {
                 succeeded = true;
 
@@ -326,6 +425,9 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
                 break;
         }
 
+        if (input.reached_max_operations)
+            break;
+
         ++input.line;
         input.global_offset += view.length() + 1; // +1 includes the line break character
 
@@ -336,6 +438,13 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
             break;
     }
 
+    if (input.reached_max_operations) {
+        // Matches found before running out of operations are dropped too, the result has to be all or nothing.
+        RegexResult result { false, 0, {}, {}, {}, operations };
+        result.reached_max_operations = true;
+        return result;
+    }
+
     RegexResult result {
         match_count != 0,
         match_count,
@@ -467,8 +576,34 @@ bool Matcher<Parser>::execute(MatchInput const& input, MatchState& state, size_t
         return true;
     }
 
+    if (m_pattern->parser_result.optimization_data.can_be_matched_by_lazy_dfa) {
+        if (!m_lazy_dfa)
+            m_lazy_dfa = make<LazyDFA>(m_pattern->parser_result.bytecode);
+
+        auto start_position = state.string_position;
+        auto start_position_in_code_units = state.string_position_in_code_units;
+        switch (m_lazy_dfa->match(m_pattern->parser_result.bytecode, input, state, operations)) {
+        case LazyDFA::Result::NotMatched:
+            return false;
+        case LazyDFA::Result::Matched:
+            // The DFA finds where the match ends, but only the backtracker knows what the capture groups matched.
+            if (m_pattern->parser_result.capture_groups_count == 0 || input.regex_options.has_flag_set(AllFlags::SkipSubExprResults))
+                return true;
+            state.string_position = start_position;
+            state.string_position_in_code_units = start_position_in_code_units;
+            break;
+        case LazyDFA::Result::Unavailable:
+            break;
+        }
+    }
+
     BumpAllocatedLinkedList<MatchState> states_to_try_next;
     HashTable<u64> seen_state_hashes;
+
+    // Once both sides of a fork have been tried from some state, coming back to the same fork in an equivalent state
+    // can't lead to a match either, so that path fails right away.
+    auto memoize_backtracking = m_pattern->parser_result.optimization_data.memoize_backtracking;
+    HashTable<u64> seen_fork_hashes;
 #if REGEX_DEBUG
     size_t recursion_level = 0;
 #endif
@@ -477,7 +612,10 @@ bool Matcher<Parser>::execute(MatchInput const& input, MatchState& state, size_t
 
     for (;;) {
         auto& opcode = bytecode.get_opcode(state);
-        ++operations;
+        if (++operations > input.regex_options.max_operations()) {
+            input.reached_max_operations = true;
+            return false;
+        }
 
 #if REGEX_DEBUG
         s_regex_dbg.print_opcode("VM", opcode, state, recursion_level, false);
@@ -497,6 +635,14 @@ bool Matcher<Parser>::execute(MatchInput const& input, MatchState& state, size_t
 
         state.instruction_position += opcode.size();
 
+        if (memoize_backtracking && (result == ExecutionResult::Fork_PrioLow || result == ExecutionResult::Fork_PrioHigh)) {
+            if (seen_fork_hashes.set(state.u64_hash_for_memoization()) != HashSetResult::InsertedNewEntry) {
+                dbgln_if(REGEX_DEBUG, "Already tried this fork, failing");
+                input.fork_to_replace.clear();
+                result = ExecutionResult::Failed;
+            }
+        }
+
         switch (result) {
         case ExecutionResult::Fork_PrioLow: {
             bool found = false;
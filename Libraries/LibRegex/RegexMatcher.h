@@ -7,6 +7,7 @@
 #pragma once
 
 #include "RegexByteCode.h"
+#include "RegexDFA.h"
 #include "RegexMatch.h"
 #include "RegexOptions.h"
 #include "RegexParser.h"
@@ -41,6 +42,7 @@ struct RegexResult final {
     size_t n_operations { 0 };
     size_t n_capture_groups { 0 };
     size_t n_named_capture_groups { 0 };
+    bool reached_max_operations { false };
 };
 
 template<class Parser>
@@ -75,6 +77,7 @@ private:
 
     Regex<Parser> const* m_pattern;
     typename ParserTraits<Parser>::OptionsType const m_regex_options;
+    mutable OwnPtr<LazyDFA> m_lazy_dfa;
 };
 
 template<class Parser>
@@ -230,6 +233,10 @@ private:
     void run_optimization_passes();
     void attempt_rewrite_loops_as_atomic_groups(BasicBlockList const&);
     bool attempt_rewrite_entire_match_as_substring_search(BasicBlockList const&);
+    static bool can_be_matched_by_lazy_dfa(ByteCode const&);
+    static bool needs_backtracking_memoization(ByteCode const&);
+    static Vector<StartingCharacterRange> find_starting_ranges(ByteCode const&);
+    static ByteString find_literal_prefix(ByteCode const&);
 };
 
 // free standing functions for match, search and has_match
@@ -6,6 +6,7 @@
 
 #include <AK/Debug.h>
 #include <AK/Function.h>
+#include <AK/HashTable.h>
 #include <AK/QuickSort.h>
 #include <AK/RedBlackTree.h>
 #include <AK/Stack.h>
@@ -43,6 +44,345 @@ void Regex<Parser>::run_optimization_passes()
         parser_result.optimization_data.only_start_of_line = true;
 
     parser_result.bytecode.flatten();
+
+    parser_result.optimization_data.can_be_matched_by_lazy_dfa = can_be_matched_by_lazy_dfa(parser_result.bytecode);
+    parser_result.optimization_data.memoize_backtracking = needs_backtracking_memoization(parser_result.bytecode);
+
+    if (!parser_result.options.has_flag_set(AllFlags::Insensitive)) {
+        parser_result.optimization_data.starting_ranges = find_starting_ranges(parser_result.bytecode);
+        if (!parser_result.optimization_data.starting_ranges.is_empty())
+            parser_result.optimization_data.literal_prefix = find_literal_prefix(parser_result.bytecode);
+    }
+}
+
+// A compare can be part of a DFA transition if it consumes exactly one character, and whether it does only
+// depends on that character.
+static bool compare_consumes_single_character(ByteCode const& bytecode, size_t instruction_position, OpCode_Compare const& compare)
+{
+    size_t offset = instruction_position + 3;
+    for (size_t i = 0; i < compare.arguments_count(); ++i) {
+        auto compare_type = (CharacterCompareType)bytecode.at(offset++);
+        switch (compare_type) {
+        case CharacterCompareType::Reference:
+            return false;
+        case CharacterCompareType::String: {
+            auto length = bytecode.at(offset++);
+            if (length != 1)
+                return false;
+            offset += length;
+            break;
+        }
+        case CharacterCompareType::LookupTable: {
+            auto count = bytecode.at(offset++);
+            offset += count;
+            break;
+        }
+        case CharacterCompareType::Char:
+        case CharacterCompareType::CharClass:
+        case CharacterCompareType::CharRange:
+        case CharacterCompareType::Property:
+        case CharacterCompareType::GeneralCategory:
+        case CharacterCompareType::Script:
+        case CharacterCompareType::ScriptExtension:
+            ++offset;
+            break;
+        case CharacterCompareType::Inverse:
+        case CharacterCompareType::TemporaryInverse:
+        case CharacterCompareType::AnyChar:
+        case CharacterCompareType::And:
+        case CharacterCompareType::Or:
+        case CharacterCompareType::EndAndOr:
+            break;
+        default:
+            return false;
+        }
+    }
+    return true;
+}
+
+template<typename Parser>
+bool Regex<Parser>::can_be_matched_by_lazy_dfa(ByteCode const& bytecode)
+{
+    // Backreferences, lookarounds, atomic groups, word boundaries and counted repetitions need the backtracker;
+    // everything else is a fork, an unconditional jump, a single character compare, an anchor or a capture.
+    HashTable<size_t> checkpoints;
+    MatchState state;
+    auto bytecode_size = bytecode.size();
+    for (state.instruction_position = 0; state.instruction_position < bytecode_size;) {
+        auto& opcode = bytecode.get_opcode(state);
+        switch (opcode.opcode_id()) {
+        case OpCodeId::Compare:
+            if (!compare_consumes_single_character(bytecode, state.instruction_position, static_cast<OpCode_Compare const&>(opcode)))
+                return false;
+            break;
+        case OpCodeId::Checkpoint:
+            checkpoints.set(static_cast<OpCode_Checkpoint const&>(opcode).id());
+            break;
+        case OpCodeId::JumpNonEmpty:
+            checkpoints.set(static_cast<OpCode_JumpNonEmpty const&>(opcode).checkpoint());
+            break;
+        case OpCodeId::Jump:
+        case OpCodeId::ForkJump:
+        case OpCodeId::ForkStay:
+        case OpCodeId::ForkReplaceJump:
+        case OpCodeId::ForkReplaceStay:
+        case OpCodeId::SaveLeftCaptureGroup:
+        case OpCodeId::SaveRightCaptureGroup:
+        case OpCodeId::SaveRightNamedCaptureGroup:
+        case OpCodeId::ClearCaptureGroup:
+        case OpCodeId::CheckBegin:
+        case OpCodeId::CheckEnd:
+            break;
+        default:
+            return false;
+        }
+        state.instruction_position += opcode.size();
+    }
+
+    return checkpoints.size() <= LazyDFA::max_checkpoints;
+}
+
+template<typename Parser>
+bool Regex<Parser>::needs_backtracking_memoization(ByteCode const& bytecode)
+{
+    // A loop whose body can branch, like (a+)+ or (a|aa)+, can split the same input between its iterations in
+    // exponentially many ways, which the backtracker all tries before giving up. Memoizing the forks it has already
+    // been through makes that polynomial, but the memo only describes a state fully if the string position never moves
+    // backwards and nothing looks at what the capture groups matched, which rules out lookarounds and backreferences.
+    struct Loop {
+        size_t start;
+        size_t end;
+    };
+    Vector<Loop> loops;
+    Vector<size_t> forks;
+    auto add_jump = [&](size_t instruction_position, ssize_t target, bool is_fork) {
+        if (target <= static_cast<ssize_t>(instruction_position))
+            loops.append({ static_cast<size_t>(target), instruction_position });
+        if (is_fork)
+            forks.append(instruction_position);
+    };
+
+    MatchState state;
+    auto bytecode_size = bytecode.size();
+    for (state.instruction_position = 0; state.instruction_position < bytecode_size;) {
+        auto& opcode = bytecode.get_opcode(state);
+        auto ip = state.instruction_position;
+        switch (opcode.opcode_id()) {
+        case OpCodeId::Compare: {
+            auto compares = static_cast<OpCode_Compare const&>(opcode).flat_compares();
+            if (any_of(compares, [](auto& compare) { return compare.type == CharacterCompareType::Reference; }))
+                return false;
+            break;
+        }
+        case OpCodeId::Save:
+        case OpCodeId::Restore:
+        case OpCodeId::GoBack:
+        case OpCodeId::FailForks:
+            return false;
+        case OpCodeId::Jump:
+            add_jump(ip, ip + opcode.size() + static_cast<OpCode_Jump const&>(opcode).offset(), false);
+            break;
+        case OpCodeId::JumpNonEmpty: {
+            auto& jump = static_cast<OpCode_JumpNonEmpty const&>(opcode);
+            add_jump(ip, ip + opcode.size() + jump.offset(), jump.form() != OpCodeId::Jump);
+            break;
+        }
+        case OpCodeId::ForkJump:
+        case OpCodeId::ForkReplaceJump:
+            add_jump(ip, ip + opcode.size() + static_cast<OpCode_ForkJump const&>(opcode).offset(), true);
+            break;
+        case OpCodeId::ForkStay:
+        case OpCodeId::ForkReplaceStay:
+            add_jump(ip, ip + opcode.size() + static_cast<OpCode_ForkStay const&>(opcode).offset(), true);
+            break;
+        case OpCodeId::Repeat:
+            add_jump(ip, ip - static_cast<OpCode_Repeat const&>(opcode).offset(), false);
+            break;
+        default:
+            break;
+        }
+        state.instruction_position += opcode.size();
+    }
+
+    for (auto const& loop : loops) {
+        if (any_of(forks, [&](auto fork) { return fork > loop.start && fork < loop.end; }))
+            return true;
+    }
+    return false;
+}
+
+// Adds the characters a compare can match first to the given ranges, or returns false if they can't be described
+// by a few ranges (e.g. for inverted compares or Unicode properties).
+static bool append_starting_ranges_of_compare(ByteCode const& bytecode, size_t instruction_position, OpCode_Compare const& compare, Vector<StartingCharacterRange>& ranges)
+{
+    size_t offset = instruction_position + 3;
+    for (size_t i = 0; i < compare.arguments_count(); ++i) {
+        auto compare_type = (CharacterCompareType)bytecode.at(offset++);
+        switch (compare_type) {
+        case CharacterCompareType::Char: {
+            auto ch = static_cast<u32>(bytecode.at(offset++));
+            ranges.append({ ch, ch });
+            break;
+        }
+        case CharacterCompareType::String: {
+            auto length = bytecode.at(offset++);
+            if (length == 0)
+                return false;
+            auto ch = static_cast<u32>(bytecode.at(offset));
+            ranges.append({ ch, ch });
+            offset += length;
+            break;
+        }
+        case CharacterCompareType::CharRange: {
+            CharRange range { bytecode.at(offset++) };
+            ranges.append({ range.from, range.to });
+            break;
+        }
+        case CharacterCompareType::LookupTable: {
+            auto count = bytecode.at(offset++);
+            for (size_t j = 0; j < count; ++j) {
+                CharRange range { bytecode.at(offset++) };
+                ranges.append({ range.from, range.to });
+            }
+            break;
+        }
+        case CharacterCompareType::CharClass:
+            switch ((CharClass)bytecode.at(offset++)) {
+            case CharClass::Digit:
+                ranges.append({ '0', '9' });
+                break;
+            case CharClass::Word:
+                ranges.append({ '0', '9' });
+                ranges.append({ 'A', 'Z' });
+                ranges.append({ '_', '_' });
+                ranges.append({ 'a', 'z' });
+                break;
+            default:
+                return false;
+            }
+            break;
+        default:
+            return false;
+        }
+    }
+    return compare.arguments_count() != 0;
+}
+
+template<typename Parser>
+Vector<StartingCharacterRange> Regex<Parser>::find_starting_ranges(ByteCode const& bytecode)
+{
+    // More ranges than this make skipping ahead slower than just trying to match.
+    static constexpr size_t max_starting_ranges = 8;
+
+    // Follow every path from the start of the pattern up to the first compare on it. Zero-width assertions only narrow
+    // down where a match can start, but anything that could end the match or move backwards before consuming a
+    // character means we can't tell.
+    Vector<StartingCharacterRange> ranges;
+    Vector<size_t> instruction_positions_to_visit { 0 };
+    HashTable<size_t> visited;
+    MatchState state;
+    auto bytecode_size = bytecode.size();
+    while (!instruction_positions_to_visit.is_empty()) {
+        auto ip = instruction_positions_to_visit.take_last();
+        if (ip >= bytecode_size)
+            return {};
+        if (visited.set(ip) != HashSetResult::InsertedNewEntry)
+            continue;
+
+        state.instruction_position = ip;
+        auto& opcode = bytecode.get_opcode(state);
+        switch (opcode.opcode_id()) {
+        case OpCodeId::Compare:
+            if (!append_starting_ranges_of_compare(bytecode, ip, static_cast<OpCode_Compare const&>(opcode), ranges))
+                return {};
+            break;
+        case OpCodeId::Jump:
+            instruction_positions_to_visit.append(ip + opcode.size() + static_cast<OpCode_Jump const&>(opcode).offset());
+            break;
+        case OpCodeId::ForkJump:
+        case OpCodeId::ForkReplaceJump:
+            instruction_positions_to_visit.append(ip + opcode.size());
+            instruction_positions_to_visit.append(ip + opcode.size() + static_cast<OpCode_ForkJump const&>(opcode).offset());
+            break;
+        case OpCodeId::ForkStay:
+        case OpCodeId::ForkReplaceStay:
+            instruction_positions_to_visit.append(ip + opcode.size());
+            instruction_positions_to_visit.append(ip + opcode.size() + static_cast<OpCode_ForkStay const&>(opcode).offset());
+            break;
+        case OpCodeId::SaveLeftCaptureGroup:
+        case OpCodeId::SaveRightCaptureGroup:
+        case OpCodeId::SaveRightNamedCaptureGroup:
+        case OpCodeId::ClearCaptureGroup:
+        case OpCodeId::Checkpoint:
+        case OpCodeId::CheckBegin:
+        case OpCodeId::CheckBoundary:
+            instruction_positions_to_visit.append(ip + opcode.size());
+            break;
+        default:
+            return {};
+        }
+    }
+
+    quick_sort(ranges, [](auto& a, auto& b) { return a.from < b.from; });
+    Vector<StartingCharacterRange> merged_ranges;
+    for (auto const& range : ranges) {
+        if (!merged_ranges.is_empty() && range.from <= merged_ranges.last().to + 1)
+            merged_ranges.last().to = max(merged_ranges.last().to, range.to);
+        else
+            merged_ranges.append(range);
+    }
+
+    if (merged_ranges.size() > max_starting_ranges)
+        return {};
+    return merged_ranges;
+}
+
+template<typename Parser>
+ByteString Regex<Parser>::find_literal_prefix(ByteCode const& bytecode)
+{
+    // The ASCII characters every match starts with, as long as the pattern doesn't branch before them.
+    StringBuilder prefix;
+    MatchState state;
+    auto bytecode_size = bytecode.size();
+    for (state.instruction_position = 0; state.instruction_position < bytecode_size;) {
+        auto& opcode = bytecode.get_opcode(state);
+        switch (opcode.opcode_id()) {
+        case OpCodeId::Compare: {
+            auto& compare = static_cast<OpCode_Compare const&>(opcode);
+            if (compare.arguments_count() != 1)
+                return prefix.to_byte_string();
+
+            auto offset = state.instruction_position + 3;
+            auto compare_type = (CharacterCompareType)bytecode.at(offset++);
+            size_t length = 1;
+            if (compare_type == CharacterCompareType::String)
+                length = bytecode.at(offset++);
+            else if (compare_type != CharacterCompareType::Char)
+                return prefix.to_byte_string();
+
+            for (size_t i = 0; i < length; ++i) {
+                auto ch = bytecode.at(offset + i);
+                if (!is_ascii(ch))
+                    return prefix.to_byte_string();
+                prefix.append(static_cast<char>(ch));
+            }
+            break;
+        }
+        case OpCodeId::SaveLeftCaptureGroup:
+        case OpCodeId::SaveRightCaptureGroup:
+        case OpCodeId::SaveRightNamedCaptureGroup:
+        case OpCodeId::ClearCaptureGroup:
+        case OpCodeId::Checkpoint:
+        case OpCodeId::CheckBegin:
+        case OpCodeId::CheckBoundary:
+            break;
+        default:
+            return prefix.to_byte_string();
+        }
+        state.instruction_position += opcode.size();
+    }
+
+    return prefix.to_byte_string();
 }
 
 template<typename Parser>
@@ -7,6 +7,7 @@
 #pragma once
 
 #include "RegexDefs.h"
+#include <AK/NumericLimits.h>
 #include <AK/Types.h>
 #include <stdio.h>
 
@@ -88,13 +89,14 @@ public:
     constexpr RegexOptions(RegexOptions<U> other)
         : RegexOptions(static_cast<T>(to_underlying(other.value())))
     {
+        m_max_operations = other.max_operations();
     }
 
     operator bool() const { return !!*this; }
     bool operator!() const { return (FlagsUnderlyingType)m_flags == 0; }
 
-    constexpr RegexOptions<T> operator|(T flag) const { return RegexOptions<T> { (T)((FlagsUnderlyingType)m_flags | (FlagsUnderlyingType)flag) }; }
-    constexpr RegexOptions<T> operator&(T flag) const { return RegexOptions<T> { (T)((FlagsUnderlyingType)m_flags & (FlagsUnderlyingType)flag) }; }
+    constexpr RegexOptions<T> operator|(T flag) const { return with_flags((T)((FlagsUnderlyingType)m_flags | (FlagsUnderlyingType)flag)); }
+    constexpr RegexOptions<T> operator&(T flag) const { return with_flags((T)((FlagsUnderlyingType)m_flags & (FlagsUnderlyingType)flag)); }
 
     constexpr RegexOptions<T>& operator|=(T flag)
     {
@@ -114,8 +116,21 @@ public:
     bool has_flag_set(T flag) const { return (FlagsUnderlyingType)flag == ((FlagsUnderlyingType)m_flags & (FlagsUnderlyingType)flag); }
     constexpr T value() const { return m_flags; }
 
+    // The number of bytecode instructions a single match() may execute before giving up on the match.
+    // Without a limit, a pattern that backtracks badly can keep the matcher busy for a very long time.
+    constexpr size_t max_operations() const { return m_max_operations; }
+    constexpr void set_max_operations(size_t max_operations) { m_max_operations = max_operations; }
+
 private:
+    constexpr RegexOptions<T> with_flags(T flags) const
+    {
+        RegexOptions<T> options { flags };
+        options.m_max_operations = m_max_operations;
+        return options;
+    }
+
     T m_flags { T::Default };
+    size_t m_max_operations { NumericLimits<size_t>::max() };
 };
 
 template<class T>
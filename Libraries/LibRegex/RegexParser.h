@@ -49,6 +49,11 @@ struct NamedCaptureGroup {
     size_t alternative_id;
 };
 
+struct StartingCharacterRange {
+    u32 from;
+    u32 to;
+};
+
 class Parser {
 public:
     struct Result {
@@ -64,6 +69,12 @@ public:
         struct {
             Optional<ByteString> pure_substring_search;
             bool only_start_of_line = false;
+            bool can_be_matched_by_lazy_dfa = false;
+            bool memoize_backtracking = false;
+            // Every match starts with a character in one of these ranges, followed by the rest of literal_prefix if
+            // that isn't empty. Empty if some match could start with anything else, or with nothing at all.
+            Vector<StartingCharacterRange> starting_ranges;
+            ByteString literal_prefix;
         } optimization_data {};
     };
 
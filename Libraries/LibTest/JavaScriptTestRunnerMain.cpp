@@ -8,6 +8,7 @@
 
 #include <LibCore/ArgsParser.h>
 #include <LibFileSystem/FileSystem.h>
+#include <LibJS/JIT/Compiler.h>
 #include <LibTest/JavaScriptTestRunner.h>
 #include <signal.h>
 #include <stdio.h>
@@ -90,6 +91,7 @@ int main(int argc, char** argv)
     StringView specified_test_root;
     ByteString common_path;
     Vector<ByteString> test_globs;
+    Optional<u32> jit_threshold;
 
     Core::ArgsParser args_parser;
     args_parser.add_option(print_times, "Show duration of each test", "show-time", 't');
@@ -114,6 +116,7 @@ int main(int argc, char** argv)
     args_parser.add_option(g_collect_on_every_allocation, "Collect garbage after every allocation", "collect-often", 'g');
     args_parser.add_option(JS::Bytecode::g_dump_bytecode, "Dump the bytecode", "dump-bytecode", 'd');
     args_parser.add_option(test_globs, "Only run tests matching the given glob", "filter", 'f', "glob");
+    args_parser.add_option(jit_threshold, "Compile functions to native code once they have been entered this many times", "jit-threshold", 0, "count");
     for (auto& entry : g_extra_args)
         args_parser.add_option(*entry.key, entry.value.get<0>().characters(), entry.value.get<1>().characters(), entry.value.get<2>());
     args_parser.add_positional_argument(specified_test_root, "Tests root directory", "path", Core::ArgsParser::Required::No);
@@ -123,6 +126,11 @@ int main(int argc, char** argv)
     if (per_file)
         print_json = true;
 
+    if (jit_threshold.has_value()) {
+        JS::JIT::g_jit_enabled = true;
+        JS::JIT::g_compilation_threshold = *jit_threshold;
+    }
+
     for (auto& glob : test_globs)
         glob = ByteString::formatted("*{}*", glob);
     if (test_globs.is_empty())
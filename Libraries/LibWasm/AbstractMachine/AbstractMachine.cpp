@@ -10,7 +10,9 @@
 #include <LibWasm/AbstractMachine/Configuration.h>
 #include <LibWasm/AbstractMachine/Interpreter.h>
 #include <LibWasm/AbstractMachine/Validator.h>
+#include <LibWasm/JIT/Compiler.h>
 #include <LibWasm/Types.h>
+#include <sys/mman.h>
 
 namespace Wasm {
 
@@ -55,6 +57,105 @@ Optional<MemoryAddress> Store::allocate(MemoryType const& type)
     return address;
 }
 
+ErrorOr<MemoryInstance> MemoryInstance::create(MemoryType const& type)
+{
+    MemoryInstance instance { type };
+
+    // If there's no room for the guard region, the memory gets a mapping of its own when it's first grown below.
+    if (auto* base = mmap(nullptr, guarded_reservation_size, PROT_NONE, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0); base != MAP_FAILED) {
+        instance.m_base = static_cast<u8*>(base);
+        instance.m_reserved_size = guarded_reservation_size;
+    }
+
+    if (!instance.grow(type.limits().min() * Constants::page_size, GrowType::No))
+        return Error::from_string_literal("Failed to grow to requested size");
+
+    return { move(instance) };
+}
+
+MemoryInstance::MemoryInstance(MemoryInstance&& other)
+    : successful_grow_hook(move(other.successful_grow_hook))
+    , m_type(other.m_type)
+    , m_base(exchange(other.m_base, nullptr))
+    , m_size(exchange(other.m_size, 0))
+    , m_reserved_size(exchange(other.m_reserved_size, 0))
+{
+}
+
+MemoryInstance& MemoryInstance::operator=(MemoryInstance&& other)
+{
+    swap(successful_grow_hook, other.successful_grow_hook);
+    swap(m_type, other.m_type);
+    swap(m_base, other.m_base);
+    swap(m_size, other.m_size);
+    swap(m_reserved_size, other.m_reserved_size);
+    return *this;
+}
+
+MemoryInstance::~MemoryInstance()
+{
+    if (!m_base)
+        return;
+    if (munmap(m_base, m_reserved_size) < 0) {
+        dbgln("Wasm: munmap failed: {}", Error::from_errno(errno));
+        VERIFY_NOT_REACHED();
+    }
+}
+
+bool MemoryInstance::grow(size_t size_to_grow, GrowType grow_type, InhibitGrowCallback inhibit_callback)
+{
+    if (size_to_grow == 0)
+        return true;
+    u64 new_size = m_size + size_to_grow;
+    // Can't grow past 2^16 pages.
+    if (new_size >= Constants::page_size * 65536)
+        return false;
+    if (auto max = m_type.limits().max(); max.has_value()) {
+        if (max.value() * Constants::page_size < new_size)
+            return false;
+    }
+    if (!commit(new_size))
+        return false;
+    m_size = new_size;
+
+    // NOTE: This exists because wasm-js-api wants to execute code after a successful grow,
+    //       See [this issue](https://github.com/WebAssembly/spec/issues/1635) for more details.
+    if (inhibit_callback == InhibitGrowCallback::No && successful_grow_hook)
+        successful_grow_hook();
+
+    if (grow_type == GrowType::Yes) {
+        // Grow the memory's type. We do this when encountering a `memory.grow`.
+        //
+        // See relevant spec link:
+        // https://www.w3.org/TR/wasm-core-2/#growing-memories%E2%91%A0
+        m_type = MemoryType { Limits(m_type.limits().min() + size_to_grow / Constants::page_size, m_type.limits().max()) };
+    }
+
+    return true;
+}
+
+// The spec requires grown memory to be zeroed. Memories never shrink, so the pages past the old size have never been
+// written to, and read as zero once they are made accessible.
+bool MemoryInstance::commit(size_t new_size)
+{
+    if (new_size <= m_reserved_size)
+        return mprotect(m_base + m_size, new_size - m_size, PROT_READ | PROT_WRITE) == 0;
+
+    auto* base = mmap(nullptr, new_size, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+    if (base == MAP_FAILED)
+        return false;
+    if (m_base) {
+        memcpy(base, m_base, m_size);
+        if (munmap(m_base, m_reserved_size) < 0) {
+            dbgln("Wasm: munmap failed: {}", Error::from_errno(errno));
+            VERIFY_NOT_REACHED();
+        }
+    }
+    m_base = static_cast<u8*>(base);
+    m_reserved_size = new_size;
+    return true;
+}
+
 Optional<GlobalAddress> Store::allocate(GlobalType const& type, Value value)
 {
     GlobalAddress address { m_globals.size() };
@@ -383,6 +484,15 @@ InstantiationResult AbstractMachine::instantiate(Module const& module, Vector<Ex
             return result.release_value();
     }
 
+    // The instruction count limit is only enforced by the interpreter.
+    if (m_should_compile_to_native_code && !m_should_limit_instruction_count) {
+        for (auto address : main_module_instance.functions()) {
+            auto* wasm_function = m_store.get(address)->get_pointer<WasmFunction>();
+            if (wasm_function && &wasm_function->module() == &main_module_instance)
+                wasm_function->set_native_function(JIT::Compiler::compile(m_store, *wasm_function));
+        }
+    }
+
     if (module.start_section().function().has_value()) {
         auto& functions = main_module_instance.functions();
         auto index = module.start_section().function()->index();
@@ -12,6 +12,7 @@
 #include <AK/NonnullOwnPtr.h>
 #include <AK/StackInfo.h>
 #include <AK/UFixedBigInt.h>
+#include <LibWasm/JIT/NativeFunction.h>
 #include <LibWasm/Types.h>
 
 // NOTE: Special case for Wasm::Result.
@@ -353,11 +354,16 @@ public:
     auto& code() const { return m_code; }
     RefPtr<Module const> module_ref() const { return m_module.strong_ref(); }
 
+    // Set at instantiation when native code compilation is enabled and the compiler could handle this function.
+    JIT::NativeFunction const* native_function() const { return m_native_function.ptr(); }
+    void set_native_function(RefPtr<JIT::NativeFunction> native_function) { m_native_function = move(native_function); }
+
 private:
     FunctionType m_type;
     WeakPtr<Module const> m_module;
     ModuleInstance const& m_module_instance;
     CodeSection::Code const& m_code;
+    RefPtr<JIT::NativeFunction> m_native_function;
 };
 
 class HostFunction {
@@ -422,21 +428,29 @@ private:
 };
 
 class MemoryInstance {
+    AK_MAKE_NONCOPYABLE(MemoryInstance);
+
 public:
-    static ErrorOr<MemoryInstance> create(MemoryType const& type)
-    {
-        MemoryInstance instance { type };
+    // A load or store addresses at most a 32-bit index plus a 32-bit offset plus the size of the access, so every
+    // address it can compute lies within this many bytes of the start of the memory. Memories are placed at the start
+    // of an inaccessible reservation of this size where possible, and grow by making more of it accessible. Anything
+    // past the end of such a memory then faults instead of needing a bounds check.
+    static constexpr size_t guarded_reservation_size = 8 * GiB + Constants::page_size;
 
-        if (!instance.grow(type.limits().min() * Constants::page_size, GrowType::No))
-            return Error::from_string_literal("Failed to grow to requested size");
+    static ErrorOr<MemoryInstance> create(MemoryType const&);
 
-        return { move(instance) };
-    }
+    MemoryInstance(MemoryInstance&&);
+    MemoryInstance& operator=(MemoryInstance&&);
+    ~MemoryInstance();
 
     auto& type() const { return m_type; }
     auto size() const { return m_size; }
-    auto& data() const { return m_data; }
-    auto& data() { return m_data; }
+    Bytes data() { return { m_base, m_size }; }
+    ReadonlyBytes data() const { return { m_base, m_size }; }
+
+    // Whether the memory starts a reservation of guarded_reservation_size bytes. If the address space for one can't be
+    // found, the memory is mapped with no room to grow instead, and growing it moves and copies it.
+    bool has_guard_region() const { return m_reserved_size == guarded_reservation_size; }
 
     enum class InhibitGrowCallback {
         No,
@@ -448,40 +462,7 @@ public:
         Yes,
     };
 
-    bool grow(size_t size_to_grow, GrowType grow_type = GrowType::Yes, InhibitGrowCallback inhibit_callback = InhibitGrowCallback::No)
-    {
-        if (size_to_grow == 0)
-            return true;
-        u64 new_size = m_data.size() + size_to_grow;
-        // Can't grow past 2^16 pages.
-        if (new_size >= Constants::page_size * 65536)
-            return false;
-        if (auto max = m_type.limits().max(); max.has_value()) {
-            if (max.value() * Constants::page_size < new_size)
-                return false;
-        }
-        auto previous_size = m_size;
-        if (m_data.try_resize(new_size).is_error())
-            return false;
-        m_size = new_size;
-        // The spec requires that we zero out everything on grow
-        __builtin_memset(m_data.offset_pointer(previous_size), 0, size_to_grow);
-
-        // NOTE: This exists because wasm-js-api wants to execute code after a successful grow,
-        //       See [this issue](https://github.com/WebAssembly/spec/issues/1635) for more details.
-        if (inhibit_callback == InhibitGrowCallback::No && successful_grow_hook)
-            successful_grow_hook();
-
-        if (grow_type == GrowType::Yes) {
-            // Grow the memory's type. We do this when encountering a `memory.grow`.
-            //
-            // See relevant spec link:
-            // https://www.w3.org/TR/wasm-core-2/#growing-memories%E2%91%A0
-            m_type = MemoryType { Limits(m_type.limits().min() + size_to_grow / Constants::page_size, m_type.limits().max()) };
-        }
-
-        return true;
-    }
+    bool grow(size_t size_to_grow, GrowType grow_type = GrowType::Yes, InhibitGrowCallback inhibit_callback = InhibitGrowCallback::No);
 
     Function<void()> successful_grow_hook;
 
@@ -491,9 +472,13 @@ private:
     {
     }
 
+    bool commit(size_t new_size);
+
     MemoryType m_type;
+    u8* m_base { nullptr };
     size_t m_size { 0 };
-    ByteBuffer m_data;
+    // The size of the mapping at m_base, of which only the first m_size bytes are accessible.
+    size_t m_reserved_size { 0 };
 };
 
 class GlobalInstance {
@@ -617,6 +602,8 @@ public:
     auto arity() const { return m_arity; }
     auto label_index() const { return m_label_index; }
     auto& label_index() { return m_label_index; }
+    auto value_stack_base() const { return m_value_stack_base; }
+    auto& value_stack_base() { return m_value_stack_base; }
 
 private:
     ModuleInstance const& m_module;
@@ -624,6 +611,7 @@ private:
     Expression const& m_expression;
     size_t m_arity { 0 };
     size_t m_label_index { 0 };
+    size_t m_value_stack_base { 0 };
 };
 
 using InstantiationResult = AK::ErrorOr<NonnullOwnPtr<ModuleInstance>, InstantiationError>;
@@ -633,7 +621,8 @@ public:
     explicit AbstractMachine() = default;
 
     // Validate a module; permanently sets the module's validity status.
-    ErrorOr<void, ValidationError> validate(Module&);
+    // This doesn't depend on any machine, and may run on any thread.
+    static ErrorOr<void, ValidationError> validate(Module&);
     // Load and instantiate a module, and link it into this interpreter.
     InstantiationResult instantiate(Module const&, Vector<ExternValue>);
     Result invoke(FunctionAddress, Vector<Value>);
@@ -643,6 +632,8 @@ public:
     auto& store() { return m_store; }
 
     void enable_instruction_count_limit() { m_should_limit_instruction_count = true; }
+    // Compile the functions of modules instantiated from now on to native code, where the platform and the functions allow it.
+    void enable_native_code_compilation() { m_should_compile_to_native_code = true; }
 
 private:
     Optional<InstantiationError> allocate_all_initial_phase(Module const&, ModuleInstance&, Vector<ExternValue>&, Vector<Value>& global_values, Vector<FunctionAddress>& own_functions);
@@ -650,6 +641,7 @@ private:
     Store m_store;
     StackInfo m_stack_info;
     bool m_should_limit_instruction_count { false };
+    bool m_should_compile_to_native_code { false };
 };
 
 class Linker {
@@ -56,16 +56,13 @@ void BytecodeInterpreter::interpret(Configuration& configuration)
     }
 }
 
-void BytecodeInterpreter::branch_to_label(Configuration& configuration, LabelIndex index)
+void BytecodeInterpreter::branch_to(Configuration& configuration, Expression::BranchTarget const& target)
 {
-    dbgln_if(WASM_TRACE_DEBUG, "Branch to label with index {}...", index.value());
-    for (size_t i = 0; i < index.value(); ++i)
-        configuration.label_stack().take_last();
-    auto label = configuration.label_stack().last();
-    dbgln_if(WASM_TRACE_DEBUG, "...which is actually IP {}, and has {} result(s)", label.continuation().value(), label.arity());
-
-    configuration.value_stack().remove(label.stack_height(), configuration.value_stack().size() - label.stack_height() - label.arity());
-    configuration.ip() = label.continuation();
+    dbgln_if(WASM_TRACE_DEBUG, "Branch to IP {}, keeping {} result(s) at height {}", target.continuation.value(), target.arity, target.stack_height);
+    auto& value_stack = configuration.value_stack();
+    auto stack_height = configuration.frame().value_stack_base() + target.stack_height;
+    value_stack.remove(stack_height, value_stack.size() - stack_height - target.arity);
+    configuration.ip() = target.continuation;
 }
 
 template<typename ReadType, typename PushType>
@@ -83,7 +80,7 @@ void BytecodeInterpreter::load_and_push(Configuration& configuration, Instructio
         return;
     }
     dbgln_if(WASM_TRACE_DEBUG, "load({} : {}) -> stack", instance_address, sizeof(ReadType));
-    auto slice = memory->data().bytes().slice(instance_address, sizeof(ReadType));
+    auto slice = memory->data().slice(instance_address, sizeof(ReadType));
     entry = Value(static_cast<PushType>(read_value<ReadType>(slice)));
 }
 
@@ -108,7 +105,7 @@ void BytecodeInterpreter::load_and_push_mxn(Configuration& configuration, Instru
         return;
     }
     dbgln_if(WASM_TRACE_DEBUG, "vec-load({} : {}) -> stack", instance_address, M * N / 8);
-    auto slice = memory->data().bytes().slice(instance_address, M * N / 8);
+    auto slice = memory->data().slice(instance_address, M * N / 8);
     using V64 = NativeVectorType<M, N, SetSign>;
     using V128 = NativeVectorType<M * 2, N, SetSign>;
 
@@ -134,7 +131,7 @@ void BytecodeInterpreter::load_and_push_lane_n(Configuration& configuration, Ins
         m_trap = Trap { "Memory access out of bounds" };
         return;
     }
-    auto slice = memory->data().bytes().slice(instance_address, N / 8);
+    auto slice = memory->data().slice(instance_address, N / 8);
     auto dst = bit_cast<u8*>(&vector) + memarg_and_lane.lane * N / 8;
     memcpy(dst, slice.data(), N / 8);
     configuration.value_stack().append(Value(vector));
@@ -152,7 +149,7 @@ void BytecodeInterpreter::load_and_push_zero_n(Configuration& configuration, Ins
         m_trap = Trap { "Memory access out of bounds" };
         return;
     }
-    auto slice = memory->data().bytes().slice(instance_address, N / 8);
+    auto slice = memory->data().slice(instance_address, N / 8);
     u128 vector = 0;
     memcpy(&vector, slice.data(), N / 8);
     configuration.value_stack().append(Value(vector));
@@ -173,7 +170,7 @@ void BytecodeInterpreter::load_and_push_m_splat(Configuration& configuration, In
         return;
     }
     dbgln_if(WASM_TRACE_DEBUG, "vec-splat({} : {}) -> stack", instance_address, M / 8);
-    auto slice = memory->data().bytes().slice(instance_address, M / 8);
+    auto slice = memory->data().slice(instance_address, M / 8);
     auto value = read_value<NativeIntegralType<M>>(slice);
     set_top_m_splat<M, NativeIntegralType>(configuration, value);
 }
@@ -366,7 +363,7 @@ void BytecodeInterpreter::store_to_memory(Configuration& configuration, Instruct
         return;
     }
     dbgln_if(WASM_TRACE_DEBUG, "temporary({}b) -> store({})", data.size(), instance_address);
-    data.copy_to(memory->data().bytes().slice(instance_address, data.size()));
+    data.copy_to(memory->data().slice(instance_address, data.size()));
 }
 
 template<typename T>
@@ -433,98 +430,33 @@ ALWAYS_INLINE void BytecodeInterpreter::interpret_instruction(Configuration& con
     case Instructions::f64_const.value():
         configuration.value_stack().append(Value(instruction.arguments().get<double>()));
         return;
-    case Instructions::block.value(): {
-        size_t arity = 0;
-        size_t param_arity = 0;
-        auto& args = instruction.arguments().get<Instruction::StructuredInstructionArgs>();
-        switch (args.block_type.kind()) {
-        case BlockType::Empty:
-            break;
-        case BlockType::Type:
-            arity = 1;
-            break;
-        case BlockType::Index: {
-            auto& type = configuration.frame().module().types()[args.block_type.type_index().value()];
-            arity = type.results().size();
-            param_arity = type.parameters().size();
-        }
-        }
-
-        configuration.label_stack().append(Label(arity, args.end_ip, configuration.value_stack().size() - param_arity));
-        return;
-    }
-    case Instructions::loop.value(): {
-        auto& args = instruction.arguments().get<Instruction::StructuredInstructionArgs>();
-        size_t arity = 0;
-        if (args.block_type.kind() == BlockType::Index) {
-            auto& type = configuration.frame().module().types()[args.block_type.type_index().value()];
-            arity = type.parameters().size();
-        }
-        configuration.label_stack().append(Label(arity, ip.value() + 1, configuration.value_stack().size() - arity));
+    case Instructions::block.value():
+    case Instructions::loop.value():
+    case Instructions::structured_end.value():
+        // Branches are resolved ahead of time (see Expression::branch_target()), so entering and leaving blocks is free.
         return;
-    }
     case Instructions::if_.value(): {
-        size_t arity = 0;
-        size_t param_arity = 0;
         auto& args = instruction.arguments().get<Instruction::StructuredInstructionArgs>();
-        switch (args.block_type.kind()) {
-        case BlockType::Empty:
-            break;
-        case BlockType::Type:
-            arity = 1;
-            break;
-        case BlockType::Index: {
-            auto& type = configuration.frame().module().types()[args.block_type.type_index().value()];
-            arity = type.results().size();
-            param_arity = type.parameters().size();
-        }
-        }
-
         auto value = configuration.value_stack().take_last().to<i32>();
-        auto end_label = Label(arity, args.end_ip.value(), configuration.value_stack().size() - param_arity);
-        if (value == 0) {
-            if (args.else_ip.has_value()) {
-                configuration.ip() = args.else_ip.value();
-                configuration.label_stack().append(end_label);
-            } else {
-                configuration.ip() = args.end_ip.value() + 1;
-            }
-        } else {
-            configuration.label_stack().append(end_label);
-        }
-        return;
-    }
-    case Instructions::structured_end.value():
-        configuration.label_stack().take_last();
-        return;
-    case Instructions::structured_else.value(): {
-        auto label = configuration.label_stack().take_last();
-        // Jump to the end label
-        configuration.ip() = label.continuation();
-        return;
-    }
-    case Instructions::return_.value(): {
-        while (configuration.label_stack().size() - 1 != configuration.frame().label_index())
-            configuration.label_stack().take_last();
-        configuration.ip() = configuration.frame().expression().instructions().size();
+        if (value == 0)
+            configuration.ip() = args.else_ip.has_value() ? args.else_ip.value() : args.end_ip + 1;
         return;
     }
+    case Instructions::structured_else.value():
     case Instructions::br.value():
-        return branch_to_label(configuration, instruction.arguments().get<LabelIndex>());
+    case Instructions::return_.value():
+        return branch_to(configuration, configuration.frame().expression().branch_target(ip));
     case Instructions::br_if.value(): {
         auto cond = configuration.value_stack().take_last().to<i32>();
         if (cond == 0)
             return;
-        return branch_to_label(configuration, instruction.arguments().get<LabelIndex>());
+        return branch_to(configuration, configuration.frame().expression().branch_target(ip));
     }
     case Instructions::br_table.value(): {
         auto& arguments = instruction.arguments().get<Instruction::TableBranchArgs>();
         auto i = configuration.value_stack().take_last().to<u32>();
-
-        if (i >= arguments.labels.size()) {
-            return branch_to_label(configuration, arguments.default_);
-        }
-        return branch_to_label(configuration, arguments.labels[i]);
+        auto target_index = min<size_t>(i, arguments.labels.size());
+        return branch_to(configuration, configuration.frame().expression().branch_target(ip, target_index));
     }
     case Instructions::call.value(): {
         auto index = instruction.arguments().get<FunctionIndex>();
@@ -46,7 +46,7 @@ struct BytecodeInterpreter : public Interpreter {
 
 protected:
     void interpret_instruction(Configuration&, InstructionPointer&, Instruction const&);
-    void branch_to_label(Configuration&, LabelIndex);
+    void branch_to(Configuration&, Expression::BranchTarget const&);
     template<typename ReadT, typename PushT>
     void load_and_push(Configuration&, Instruction const&);
     template<typename PopT, typename StoreT>
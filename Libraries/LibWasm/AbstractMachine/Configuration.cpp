@@ -24,6 +24,19 @@ Result Configuration::call(Interpreter& interpreter, FunctionAddress address, Ve
     if (!function)
         return Trap {};
     if (auto* wasm_function = function->get_pointer<WasmFunction>()) {
+        if (auto* native_function = wasm_function->native_function(); native_function && !m_should_limit_instruction_count) {
+            // The native code keeps its locals to itself, this frame only keeps the frame stack balanced for CallFrameHandle.
+            set_frame(Frame {
+                wasm_function->module(),
+                {},
+                wasm_function->code().func().body(),
+                wasm_function->type().results().size(),
+            });
+            auto result = native_function->call(*this, interpreter, *wasm_function, arguments);
+            label_stack().take_last();
+            return result;
+        }
+
         Vector<Value> locals = move(arguments);
         locals.ensure_capacity(locals.size() + wasm_function->code().func().locals().size());
         for (auto& local : wasm_function->code().func().locals()) {
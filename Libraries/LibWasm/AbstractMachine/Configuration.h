@@ -21,6 +21,7 @@ public:
     {
         Label label(frame.arity(), frame.expression().instructions().size(), m_value_stack.size());
         frame.label_index() = m_label_stack.size();
+        frame.value_stack_base() = m_value_stack.size();
         m_frame_stack.append(move(frame));
         m_label_stack.append(label);
     }
@@ -57,6 +57,8 @@ struct Divide {
         if constexpr (IsFloatingPoint<Lhs>) {
             return lhs / rhs;
         } else {
+            if (rhs == 0)
+                return AK::ErrorOr<Lhs, StringView>("Division by zero"sv);
             Checked value(lhs);
             value /= rhs;
             if (value.has_overflow())
@@ -73,7 +75,7 @@ struct Modulo {
     auto operator()(Lhs lhs, Rhs rhs) const
     {
         if (rhs == 0)
-            return AK::ErrorOr<Lhs, StringView>("Integer division overflow"sv);
+            return AK::ErrorOr<Lhs, StringView>("Division by zero"sv);
         if constexpr (IsSigned<Lhs>) {
             if (rhs == -1)
                 return AK::ErrorOr<Lhs, StringView>(0); // Spec weirdness right here, signed division overflow is ignored.
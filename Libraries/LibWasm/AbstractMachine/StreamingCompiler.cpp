@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/ConstrainedStream.h>
+#include <AK/LEB128.h>
+#include <AK/MemoryStream.h>
+#include <AK/ScopeGuard.h>
+#include <LibWasm/AbstractMachine/StreamingCompiler.h>
+
+namespace Wasm {
+
+// Reads a LEB128-encoded u32 at the given offset, or nothing if not all of its bytes have arrived yet.
+static ParseResult<Optional<u32>> read_u32(ReadonlyBytes bytes, size_t& offset)
+{
+    // A u32 takes up at most five bytes.
+    static constexpr size_t max_size = 5;
+
+    for (size_t i = offset; i < bytes.size() && i < offset + max_size; ++i) {
+        if ((bytes[i] & 0x80) != 0)
+            continue;
+
+        FixedMemoryStream stream { bytes.slice(offset, i + 1 - offset) };
+        auto value = stream.read_value<LEB128<u32>>();
+        if (value.is_error())
+            return ParseError::ExpectedSize;
+        offset = i + 1;
+        return Optional<u32> { value.release_value() };
+    }
+
+    if (bytes.size() - offset < max_size)
+        return Optional<u32> {};
+    return ParseError::ExpectedSize;
+}
+
+StreamingCompiler::StreamingCompiler()
+    : m_module(make_ref_counted<Module>())
+{
+}
+
+ErrorOr<void, ByteString> StreamingCompiler::append(ReadonlyBytes bytes)
+{
+    if (m_error.has_value())
+        return *m_error;
+    VERIFY(m_module);
+
+    if (m_buffer.try_append(bytes).is_error())
+        return fail(parse_error_to_byte_string(ParseError::OutOfMemory));
+
+    if (auto result = parse_available_bytes(); result.is_error())
+        return fail(result.release_error());
+    return {};
+}
+
+ErrorOr<NonnullRefPtr<Module>, ByteString> StreamingCompiler::finish()
+{
+    if (m_error.has_value())
+        return *m_error;
+    VERIFY(m_module);
+
+    if (!m_has_parsed_header || !m_buffer.is_empty() || m_code_section_remaining_size.has_value())
+        return fail(parse_error_to_byte_string(ParseError::UnexpectedEof));
+
+    // Without a code section, nothing has been validated yet.
+    if (!m_is_validating_function_bodies) {
+        if (auto result = begin_validating_function_bodies(); result.is_error())
+            return fail(result.release_error().error_string);
+    }
+
+    if (auto result = m_validator.finish_validating(*m_module); result.is_error())
+        return fail(result.release_error().error_string);
+
+    // NOTE: The module's reference count isn't atomic, so we don't hold on to it once it's been handed over; the
+    //       compiler may well be destroyed on another thread than the one that uses the module.
+    return m_module.release_nonnull();
+}
+
+ErrorOr<void, ByteString> StreamingCompiler::parse_available_bytes()
+{
+    size_t parsed_size = 0;
+    ScopeGuard drop_parsed_bytes = [&] {
+        if (parsed_size == 0)
+            return;
+        auto remaining_size = m_buffer.size() - parsed_size;
+        memmove(m_buffer.data(), m_buffer.data() + parsed_size, remaining_size);
+        m_buffer.resize(remaining_size);
+    };
+
+    if (!m_has_parsed_header) {
+        auto header_size = Module::wasm_magic.size() + Module::wasm_version.size();
+        if (m_buffer.size() < header_size)
+            return {};
+        if (m_buffer.bytes().slice(0, Module::wasm_magic.size()) != Module::wasm_magic.span())
+            return parse_error_to_byte_string(ParseError::InvalidModuleMagic);
+        if (m_buffer.bytes().slice(Module::wasm_magic.size(), Module::wasm_version.size()) != Module::wasm_version.span())
+            return parse_error_to_byte_string(ParseError::InvalidModuleVersion);
+        parsed_size = header_size;
+        m_has_parsed_header = true;
+    }
+
+    auto function_count = m_module->code_section().functions().size();
+    while (true) {
+        auto bytes = m_buffer.bytes().slice(parsed_size);
+        bool was_in_code_section = m_code_section_remaining_size.has_value();
+
+        auto size_or_error = was_in_code_section ? parse_next_function(bytes) : parse_next_section(bytes);
+        if (size_or_error.is_error())
+            return parse_error_to_byte_string(size_or_error.error());
+        if (size_or_error.value() == 0)
+            break;
+        parsed_size += size_or_error.value();
+
+        // The code section only starts after all of the sections that function bodies depend on.
+        if (!was_in_code_section && m_code_section_remaining_size.has_value()) {
+            if (auto result = begin_validating_function_bodies(); result.is_error())
+                return result.release_error().error_string;
+        }
+    }
+
+    // The function bodies that these bytes completed are validated together, which spreads them over the validation
+    // threads if there are enough of them.
+    if (auto new_function_count = m_module->code_section().functions().size() - function_count; new_function_count != 0) {
+        if (auto result = m_validator.validate_function_bodies(*m_module, function_count, new_function_count); result.is_error())
+            return result.release_error().error_string;
+    }
+    return {};
+}
+
+ParseResult<size_t> StreamingCompiler::parse_next_section(ReadonlyBytes bytes)
+{
+    if (bytes.is_empty())
+        return 0;
+
+    FixedMemoryStream id_stream { bytes.slice(0, 1) };
+    auto section_id = TRY(SectionId::parse(id_stream));
+
+    size_t offset = 1;
+    auto section_size = TRY(read_u32(bytes, offset));
+    if (!section_size.has_value())
+        return 0;
+
+    if (section_id.kind() == SectionId::SectionIdKind::Code) {
+        // The function bodies are parsed one by one as they arrive, once the number of them is in.
+        auto count_offset = offset;
+        auto function_count = TRY(read_u32(bytes, offset));
+        if (!function_count.has_value())
+            return 0;
+        if (offset - count_offset > *section_size)
+            return ParseError::SectionSizeMismatch;
+
+        TRY(Module::check_section_order(section_id.kind(), m_last_section_id));
+        m_code_section_remaining_size = *section_size - (offset - count_offset);
+        m_remaining_function_count = *function_count;
+        return offset;
+    }
+
+    if (bytes.size() - offset < *section_size)
+        return 0;
+
+    FixedMemoryStream stream { bytes.slice(offset, *section_size) };
+    auto section_stream = ConstrainedStream { MaybeOwned<Stream>(stream), *section_size };
+    TRY(Module::check_section_order(section_id.kind(), m_last_section_id));
+    TRY(m_module->parse_section_contents(section_id.kind(), section_stream));
+    if (section_stream.remaining() != 0)
+        return ParseError::SectionSizeMismatch;
+
+    return offset + *section_size;
+}
+
+ParseResult<size_t> StreamingCompiler::parse_next_function(ReadonlyBytes bytes)
+{
+    if (m_remaining_function_count == 0) {
+        if (*m_code_section_remaining_size != 0)
+            return ParseError::SectionSizeMismatch;
+        // That was the end of the code section; carry on with whatever follows it.
+        m_code_section_remaining_size.clear();
+        return parse_next_section(bytes);
+    }
+
+    size_t offset = 0;
+    auto function_size = TRY(read_u32(bytes, offset));
+    if (!function_size.has_value())
+        return 0;
+
+    auto size = offset + *function_size;
+    if (size > *m_code_section_remaining_size)
+        return ParseError::SectionSizeMismatch;
+    if (bytes.size() < size)
+        return 0;
+
+    FixedMemoryStream stream { bytes.slice(0, size) };
+    auto code = TRY(CodeSection::Code::parse(stream));
+    if (!stream.is_eof())
+        return ParseError::InvalidSize;
+
+    m_module->code_section().functions().append(move(code));
+    *m_code_section_remaining_size -= size;
+    --m_remaining_function_count;
+    return size;
+}
+
+ErrorOr<void, ValidationError> StreamingCompiler::begin_validating_function_bodies()
+{
+    m_is_validating_function_bodies = true;
+    return m_validator.begin_validating_function_bodies(*m_module);
+}
+
+ByteString StreamingCompiler::fail(ByteString error)
+{
+    m_error = error;
+    return error;
+}
+
+}
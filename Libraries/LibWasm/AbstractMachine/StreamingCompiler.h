@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/AtomicRefCounted.h>
+#include <AK/ByteBuffer.h>
+#include <AK/ByteString.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/Optional.h>
+#include <AK/RefPtr.h>
+#include <LibWasm/AbstractMachine/Validator.h>
+#include <LibWasm/Types.h>
+
+namespace Wasm {
+
+// Parses and validates a module whose bytes arrive in pieces, such as the body of a network response.
+//
+// Sections are parsed as soon as all of their bytes are in. The code section is parsed one function at a time
+// instead, and the function bodies in each piece are validated right after it's parsed (on the validation threads,
+// if there are enough of them); so by the time the last piece arrives, there is little left to do.
+//
+// The compiler isn't thread-safe, but it doesn't care which thread it's used on, so the pieces can be handed to a
+// background thread one after the other as they arrive.
+class StreamingCompiler : public AtomicRefCounted<StreamingCompiler> {
+    AK_MAKE_NONCOPYABLE(StreamingCompiler);
+    AK_MAKE_NONMOVABLE(StreamingCompiler);
+
+public:
+    StreamingCompiler();
+
+    // Fails as soon as the bytes so far can't be the start of a valid module, after which nothing more can be appended.
+    ErrorOr<void, ByteString> append(ReadonlyBytes);
+
+    // Gives the module once all of its bytes have been appended.
+    ErrorOr<NonnullRefPtr<Module>, ByteString> finish();
+
+private:
+    ErrorOr<void, ByteString> parse_available_bytes();
+    // These return how many of the bytes they parsed, which is zero until enough of them have arrived.
+    ParseResult<size_t> parse_next_section(ReadonlyBytes);
+    ParseResult<size_t> parse_next_function(ReadonlyBytes);
+    ErrorOr<void, ValidationError> begin_validating_function_bodies();
+
+    // Returns the error that the module failed with, and remembers it for any further calls.
+    ByteString fail(ByteString error);
+
+    // Handed over by finish().
+    RefPtr<Module> m_module;
+    Validator m_validator;
+
+    // The bytes that have arrived but haven't been parsed yet.
+    ByteBuffer m_buffer;
+    bool m_has_parsed_header { false };
+    SectionId::SectionIdKind m_last_section_id { SectionId::SectionIdKind::Custom };
+    bool m_is_validating_function_bodies { false };
+
+    // While in the code section, the number of bytes of it that are left, and the number of functions still to come.
+    Optional<size_t> m_code_section_remaining_size;
+    size_t m_remaining_function_count { 0 };
+
+    Optional<ByteString> m_error;
+};
+
+}
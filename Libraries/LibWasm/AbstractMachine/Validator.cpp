@@ -4,21 +4,111 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Atomic.h>
 #include <AK/HashTable.h>
+#include <AK/ScopeGuard.h>
 #include <AK/SourceLocation.h>
 #include <AK/TemporaryChange.h>
 #include <AK/Try.h>
+#include <LibCore/System.h>
+#include <LibThreading/WorkerThread.h>
 #include <LibWasm/AbstractMachine/Validator.h>
 #include <LibWasm/Printer/Printer.h>
 
 namespace Wasm {
 
+// Below this many instructions, validating the code section takes less time than starting the threads would.
+static constexpr size_t MIN_INSTRUCTION_COUNT_FOR_PARALLEL_VALIDATION = 64 * KiB;
+static constexpr size_t MAX_VALIDATION_THREADS = 8;
+
+// The threads that help validate large code sections. They're started the first time they're needed and kept for every
+// module after that; only one validation uses them at a time, and any other runs on the calling thread alone.
+static Vector<NonnullOwnPtr<Threading::WorkerThread<Error>>>& validation_threads()
+{
+    // NOTE: These are leaked on purpose, so that exiting doesn't wait for the threads to be joined.
+    static auto& threads = *[] {
+        auto* threads = new Vector<NonnullOwnPtr<Threading::WorkerThread<Error>>>;
+
+        // NOTE: The calling thread validates functions as well, so it's one less than the number of threads.
+        auto thread_count = min<size_t>(Core::System::hardware_concurrency(), MAX_VALIDATION_THREADS);
+        for (size_t i = 1; i < thread_count; ++i) {
+            auto thread = Threading::WorkerThread<Error>::create("Wasm validation"sv);
+            if (thread.is_error()) {
+                dbgln("Failed to create WebAssembly validation thread: {}", thread.error());
+                break;
+            }
+            threads->append(thread.release_value());
+        }
+        return threads;
+    }();
+    return threads;
+}
+
+static Atomic<bool> s_validation_threads_in_use { false };
+
 ErrorOr<void, ValidationError> Validator::validate(Module& module)
 {
     // Pre-emptively make invalid. The module will be set to `Valid` at the end
     // of validation.
     module.set_validation_status(Module::ValidationStatus::Invalid, {});
 
+    if (module.code_section().functions().size() != module.function_section().types().size())
+        return Errors::invalid("FunctionSection"sv);
+
+    TRY(build_context(module));
+
+    TRY(validate(module.import_section()));
+    TRY(validate(module.export_section()));
+    TRY(validate(module.start_section()));
+    TRY(validate(module.data_section()));
+    TRY(validate(module.element_section()));
+    TRY(validate(module.global_section()));
+    TRY(validate(module.memory_section()));
+    TRY(validate(module.table_section()));
+    TRY(validate(module.code_section()));
+
+    module.set_validation_status(Module::ValidationStatus::Valid, {});
+    return {};
+}
+
+ErrorOr<void, ValidationError> Validator::begin_validating_function_bodies(Module& module)
+{
+    module.set_validation_status(Module::ValidationStatus::Invalid, {});
+
+    TRY(build_context(module));
+
+    // Everything but the data section comes before the code section.
+    TRY(validate(module.import_section()));
+    TRY(validate(module.export_section()));
+    TRY(validate(module.start_section()));
+    TRY(validate(module.element_section()));
+    TRY(validate(module.global_section()));
+    TRY(validate(module.memory_section()));
+    TRY(validate(module.table_section()));
+    return {};
+}
+
+ErrorOr<void, ValidationError> Validator::validate_function_bodies(Module& module, size_t first_index, size_t count)
+{
+    if (first_index + count > module.function_section().types().size())
+        return Errors::invalid("FunctionSection"sv);
+
+    return validate_functions(module.code_section().functions().span().slice(first_index, count), first_index);
+}
+
+ErrorOr<void, ValidationError> Validator::finish_validating(Module& module)
+{
+    if (module.code_section().functions().size() != module.function_section().types().size())
+        return Errors::invalid("FunctionSection"sv);
+
+    TRY(validate(module.data_section()));
+
+    module.set_validation_status(Module::ValidationStatus::Valid, {});
+    return {};
+}
+
+ErrorOr<void, ValidationError> Validator::build_context(Module const& module)
+{
     // Note: The spec performs this after populating the context, but there's no real reason to do so,
     //       as this has no dependency.
     HashTable<StringView> seen_export_names;
@@ -61,9 +151,6 @@ ErrorOr<void, ValidationError> Validator::validate(Module& module)
             }));
     }
 
-    if (module.code_section().functions().size() != module.function_section().types().size())
-        return Errors::invalid("FunctionSection"sv);
-
     m_context.functions.ensure_capacity(module.function_section().types().size() + m_context.functions.size());
     for (auto& index : module.function_section().types())
         if (m_context.types.size() > index.value())
@@ -87,7 +174,10 @@ ErrorOr<void, ValidationError> Validator::validate(Module& module)
     for (auto& segment : module.element_section().segments())
         m_context.elements.append(segment.type);
 
-    m_context.datas.resize(module.data_section().data().size());
+    // NOTE: When a module is validated while it's being parsed, the data section isn't in yet when the function bodies
+    //       are validated. Instructions that refer to data segments are only valid with a data count section, which
+    //       comes before the code section and has to match the data section.
+    m_context.datas.resize(module.data_count_section().count().value_or(module.data_section().data().size()));
 
     // We need to build the set of declared functions to check that `ref.func` uses a specific set of predetermined functions, found in:
     // - Element initializer expressions
@@ -114,17 +204,6 @@ ErrorOr<void, ValidationError> Validator::validate(Module& module)
     for (auto& segment : module.global_section().entries())
         scan_expression_for_function_indices(segment.expression());
 
-    TRY(validate(module.import_section()));
-    TRY(validate(module.export_section()));
-    TRY(validate(module.start_section()));
-    TRY(validate(module.data_section()));
-    TRY(validate(module.element_section()));
-    TRY(validate(module.global_section()));
-    TRY(validate(module.memory_section()));
-    TRY(validate(module.table_section()));
-    TRY(validate(module.code_section()));
-
-    module.set_validation_status(Module::ValidationStatus::Valid, {});
     return {};
 }
 
@@ -241,26 +320,117 @@ ErrorOr<void, ValidationError> Validator::validate(TableSection const& section)
 
 ErrorOr<void, ValidationError> Validator::validate(CodeSection const& section)
 {
-    size_t index = m_context.imported_function_count;
-    for (auto& entry : section.functions()) {
-        auto function_index = index++;
-        TRY(validate(FunctionIndex { function_index }));
-        auto& function_type = m_context.functions[function_index];
-        auto& function = entry.func();
+    return validate_functions(section.functions(), 0);
+}
 
+ErrorOr<void, ValidationError> Validator::validate_functions(ReadonlySpan<CodeSection::Code> functions, size_t first_index)
+{
+    size_t instruction_count = 0;
+    for (auto& entry : functions)
+        instruction_count += entry.func().body().instructions().size();
+    if (instruction_count >= MIN_INSTRUCTION_COUNT_FOR_PARALLEL_VALIDATION && Core::System::hardware_concurrency() > 1)
+        return validate_functions_in_parallel(functions, first_index);
+
+    size_t index = m_context.imported_function_count + first_index;
+    for (auto& entry : functions) {
         auto function_validator = fork();
         function_validator.m_context.locals = {};
-        function_validator.m_context.locals.extend(function_type.parameters());
-        for (auto& local : function.locals()) {
-            for (size_t i = 0; i < local.n(); ++i)
-                function_validator.m_context.locals.append(local.type());
+        TRY(function_validator.validate_function(index++, entry));
+    }
+
+    return {};
+}
+
+ErrorOr<void, ValidationError> Validator::validate_function(size_t function_index, CodeSection::Code const& entry)
+{
+    TRY(validate(FunctionIndex { function_index }));
+    auto& function_type = m_context.functions[function_index];
+    auto& function = entry.func();
+
+    m_context.locals.clear();
+    m_context.locals.extend(function_type.parameters());
+    for (auto& local : function.locals()) {
+        for (size_t i = 0; i < local.n(); ++i)
+            m_context.locals.append(local.type());
+    }
+
+    m_frames.clear();
+    m_frames.empend(function_type, FrameKind::Function, (size_t)0);
+
+    auto results = TRY(validate(function.body(), function_type.results()));
+    if (results.result_types.size() != function_type.results().size())
+        return Errors::invalid("function result"sv, function_type.results(), results.result_types);
+
+    return {};
+}
+
+ErrorOr<void, ValidationError> Validator::validate_functions_in_parallel(ReadonlySpan<CodeSection::Code> functions, size_t first_index)
+{
+    // NOTE: The calling thread validates functions as well, as worker 0.
+    Span<NonnullOwnPtr<Threading::WorkerThread<Error>>> threads;
+    bool threads_were_in_use = false;
+    if (s_validation_threads_in_use.compare_exchange_strong(threads_were_in_use, true))
+        threads = validation_threads().span();
+    ScopeGuard release_threads = [&] {
+        if (!threads_were_in_use)
+            s_validation_threads_in_use.store(false);
+    };
+
+    struct Worker {
+        NonnullOwnPtr<Validator> validator;
+        size_t failed_function { 0 };
+        Optional<ValidationError> error;
+    };
+
+    // The forks share the context's vectors, whose reference counts aren't atomic; so they are all created (and
+    // given locals of their own) here, before any of them runs on another thread.
+    Vector<Worker> workers;
+    workers.ensure_capacity(threads.size() + 1);
+    for (size_t i = 0; i <= threads.size(); ++i) {
+        auto validator = adopt_own(*new Validator(m_context));
+        validator->m_context.locals = {};
+        workers.unchecked_append({ move(validator) });
+    }
+
+    Atomic<size_t> next_function { 0 };
+    Atomic<size_t> first_failed_function { NumericLimits<size_t>::max() };
+
+    auto validate_functions = [&](Worker& worker) {
+        while (true) {
+            auto index = next_function.fetch_add(1);
+
+            // Only the first error in the code section is reported, so there's no point in going past a failure.
+            if (index >= functions.size() || index > first_failed_function.load())
+                return;
+
+            auto result = worker.validator->validate_function(m_context.imported_function_count + first_index + index, functions[index]);
+            if (result.is_error()) {
+                worker.failed_function = index;
+                worker.error = result.release_error();
+
+                auto first_failure = first_failed_function.load();
+                while (index < first_failure && !first_failed_function.compare_exchange_strong(first_failure, index)) { }
+                return;
+            }
         }
+    };
+
+    for (size_t i = 0; i < threads.size(); ++i) {
+        bool started = threads[i]->start_task([&validate_functions, &worker = workers[i + 1]]() -> ErrorOr<void> {
+            validate_functions(worker);
+            return {};
+        });
+        VERIFY(started);
+    }
 
-        function_validator.m_frames.empend(function_type, FrameKind::Function, (size_t)0);
+    validate_functions(workers[0]);
 
-        auto results = TRY(function_validator.validate(function.body(), function_type.results()));
-        if (results.result_types.size() != function_type.results().size())
-            return Errors::invalid("function result"sv, function_type.results(), results.result_types);
+    for (auto& thread : threads)
+        MUST(thread->wait_until_task_is_finished());
+
+    for (auto& worker : workers) {
+        if (worker.error.has_value() && worker.failed_function == first_failed_function.load())
+            return worker.error.release_value();
     }
 
     return {};
@@ -3703,16 +3873,77 @@ ErrorOr<Validator::ExpressionTypeResult, ValidationError> Validator::validate(Ex
 {
     if (m_frames.is_empty())
         m_frames.empend(FunctionType { {}, result_types }, FrameKind::Function, (size_t)0);
+    auto& instructions = expression.instructions();
+    m_frames.last().continuation = instructions.size();
     auto stack = Stack(m_frames);
     bool is_constant_expression = true;
 
-    for (auto& instruction : expression.instructions()) {
+    Vector<Expression::BranchTarget> branch_targets;
+    Vector<u32> first_branch_target_index;
+    auto add_branch_target = [&](size_t ip, Frame const& frame) {
+        if (first_branch_target_index.is_empty())
+            first_branch_target_index.resize(instructions.size());
+        if (first_branch_target_index[ip] == 0)
+            first_branch_target_index[ip] = branch_targets.size();
+        branch_targets.append({ frame.continuation, static_cast<u32>(frame.labels().size()), static_cast<u32>(frame.initial_size) });
+    };
+    auto frame_for_label = [&](LabelIndex label) -> Frame const& { return m_frames[(m_frames.size() - 1) - label.value()]; };
+
+    // Index 0 of the target list is never a valid first index, as that marks instructions without any targets.
+    branch_targets.append({});
+
+    for (size_t ip = 0; ip < instructions.size(); ++ip) {
+        auto& instruction = instructions[ip];
         bool is_constant = false;
         TRY(validate(instruction, stack, is_constant));
 
         is_constant_expression &= is_constant;
+
+        // Resolve every branch to the frame it targets. The stack heights are only exact in reachable code, but
+        // branches in unreachable code are never taken.
+        switch (instruction.opcode().value()) {
+        case Instructions::block.value():
+            m_frames.last().continuation = instruction.arguments().get<Instruction::StructuredInstructionArgs>().end_ip + 1;
+            break;
+        case Instructions::loop.value():
+            // The loop instruction itself doesn't do anything, and jumping back to it rather than past it means
+            // that a branch is never to itself.
+            m_frames.last().continuation = ip;
+            break;
+        case Instructions::if_.value(): {
+            // The end_ip of an if with an else arm already points past its end.
+            auto& args = instruction.arguments().get<Instruction::StructuredInstructionArgs>();
+            m_frames.last().continuation = args.else_ip.has_value() ? args.end_ip : args.end_ip + 1;
+            break;
+        }
+        case Instructions::structured_else.value():
+            // Falling through to the else means the true arm is done, continue after the end.
+            add_branch_target(ip, m_frames.last());
+            break;
+        case Instructions::br.value():
+        case Instructions::br_if.value():
+            add_branch_target(ip, frame_for_label(instruction.arguments().get<LabelIndex>()));
+            break;
+        case Instructions::br_table.value(): {
+            auto& args = instruction.arguments().get<Instruction::TableBranchArgs>();
+            for (auto label : args.labels)
+                add_branch_target(ip, frame_for_label(label));
+            add_branch_target(ip, frame_for_label(args.default_));
+            break;
+        }
+        case Instructions::return_.value():
+            add_branch_target(ip, m_frames.first());
+            break;
+        default:
+            break;
+        }
     }
 
+    // NOTE: Validation is the one pass over the expression that knows the stack height at every label, so this is
+    //       where the expression is annotated with its branch targets.
+    if (!first_branch_target_index.is_empty())
+        const_cast<Expression&>(expression).set_branch_targets(move(branch_targets), move(first_branch_target_index));
+
     auto expected_result_types = result_types;
     while (!expected_result_types.is_empty())
         TRY(stack.take(expected_result_types.take_last()));
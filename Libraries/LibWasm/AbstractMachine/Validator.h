@@ -59,6 +59,12 @@ public:
 
     // Module
     ErrorOr<void, ValidationError> validate(Module&);
+
+    // Validating a module while it's being parsed: once every section before the code section is in, the function
+    // bodies can be validated a few at a time as they arrive, and the rest of the module once it's complete.
+    ErrorOr<void, ValidationError> begin_validating_function_bodies(Module&);
+    ErrorOr<void, ValidationError> validate_function_bodies(Module&, size_t first_index, size_t count);
+    ErrorOr<void, ValidationError> finish_validating(Module&);
     ErrorOr<void, ValidationError> validate(ImportSection const&);
     ErrorOr<void, ValidationError> validate(ExportSection const&);
     ErrorOr<void, ValidationError> validate(StartSection const&);
@@ -150,6 +156,8 @@ public:
         size_t initial_size;
         // Stack polymorphism is handled with this field
         bool unreachable { false };
+        // Where branches to this frame's label continue
+        InstructionPointer continuation { 0 };
 
         Vector<ValueType> const& labels() const
         {
@@ -283,6 +291,15 @@ private:
     {
     }
 
+    ErrorOr<void, ValidationError> build_context(Module const&);
+
+    // Function bodies only read the module's context, so a forked validator can check any number of them, and
+    // forked validators can run on separate threads.
+    ErrorOr<void, ValidationError> validate_function(size_t function_index, CodeSection::Code const&);
+    // Validates the given bodies of the functions starting at the given index into the code section.
+    ErrorOr<void, ValidationError> validate_functions(ReadonlySpan<CodeSection::Code>, size_t first_index);
+    ErrorOr<void, ValidationError> validate_functions_in_parallel(ReadonlySpan<CodeSection::Code>, size_t first_index);
+
     struct Errors {
         static ValidationError invalid(StringView name) { return ByteString::formatted("Invalid {}", name); }
 
@@ -0,0 +1,1006 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/BuiltinWrappers.h>
+#include <AK/Debug.h>
+#include <AK/Error.h>
+#include <AK/Platform.h>
+#include <AK/StackInfo.h>
+#include <LibWasm/AbstractMachine/Configuration.h>
+#include <LibWasm/Constants.h>
+#include <LibWasm/JIT/Compiler.h>
+#include <LibWasm/JIT/TrapHandler.h>
+#include <LibWasm/Opcode.h>
+#include <LibWasm/Printer/Printer.h>
+#include <sys/mman.h>
+
+namespace Wasm::JIT {
+
+using Reg = Assembler::Reg;
+using Condition = Assembler::Condition;
+using Memory = Assembler::Memory;
+
+// The state of the running function lives in callee-saved registers, so it survives calls to helpers.
+static constexpr auto SLOTS = Reg::RBX;
+static constexpr auto CONTEXT = Reg::R12;
+static constexpr auto MEMORY_BASE = Reg::R13;
+static constexpr auto MEMORY_SIZE = Reg::R14;
+
+static NativeResult fail(NativeContext& context, Result result)
+{
+    *context.failure = move(result);
+    return NativeResult::Failed;
+}
+
+// Native code recurses on the C++ stack, so calls check that there is room left the same way the interpreter does.
+static StackInfo const& stack_info()
+{
+    static thread_local StackInfo stack_info;
+    return stack_info;
+}
+
+static NativeResult call_through_configuration(NativeContext& context, FunctionAddress address, u64* operands)
+{
+    auto& configuration = *context.configuration;
+    auto* function = configuration.store().get(address);
+    auto const& type = function->visit([](auto const& function) -> FunctionType const& { return function.type(); });
+    auto is_wasm_function = function->has<WasmFunction>();
+
+    Vector<Value> arguments;
+    arguments.ensure_capacity(type.parameters().size());
+    for (size_t i = 0; i < type.parameters().size(); ++i)
+        arguments.unchecked_append(slot_to_value(operands[i], type.parameters()[i]));
+
+    auto result = [&]() -> Result {
+        if (is_wasm_function) {
+            Configuration::CallFrameHandle handle { configuration };
+            return configuration.call(*context.interpreter, address, move(arguments));
+        }
+        return configuration.call(*context.interpreter, address, move(arguments));
+    }();
+    if (result.is_trap() || result.is_completion())
+        return fail(context, move(result));
+
+    // The results are given in the order they are popped off the stack.
+    auto& values = result.values();
+    for (size_t i = 0; i < values.size(); ++i)
+        operands[values.size() - i - 1] = value_to_slot(values[i]);
+    return NativeResult::Returned;
+}
+
+static u64 call_function(NativeContext& context, u64* operands, u64 address)
+{
+    if (stack_info().size_free() < Constants::minimum_stack_space_to_keep_free)
+        return to_underlying(fail(context, Trap { "Call stack exhausted" }));
+
+    auto& configuration = *context.configuration;
+    auto* function = configuration.store().get(FunctionAddress { address });
+    auto* wasm_function = function->get_pointer<WasmFunction>();
+
+    NativeResult result;
+    if (wasm_function && wasm_function->native_function() && !configuration.should_limit_instruction_count()) {
+        auto& native_function = *wasm_function->native_function();
+        auto operand_count = max(native_function.parameter_count(), native_function.result_count());
+        result = native_function.run(configuration, *context.interpreter, { operands, operand_count }, *context.failure);
+    } else {
+        result = call_through_configuration(context, FunctionAddress { address }, operands);
+    }
+
+    // The callee may have grown the memory, or a host function may have allocated more of them.
+    context.refresh_memory();
+    return to_underlying(result);
+}
+
+static u64 call_indirect(NativeContext& context, u64* operands, u64 table_and_type)
+{
+    auto& module = *context.module;
+    auto& type = module.types()[table_and_type & 0xffffffff];
+    auto* table = context.configuration->store().get(module.tables()[table_and_type >> 32]);
+
+    auto index = static_cast<u32>(operands[type.parameters().size()]);
+    if (index >= table->elements().size())
+        return to_underlying(fail(context, Trap { "Indirect call to an element outside of the table" }));
+    auto* function_reference = table->elements()[index].ref().get_pointer<Reference::Func>();
+    if (!function_reference)
+        return to_underlying(fail(context, Trap { "Indirect call to a null element" }));
+
+    auto address = function_reference->address;
+    auto const& callee_type = context.configuration->store().get(address)->visit([](auto const& function) -> FunctionType const& { return function.type(); });
+    if (callee_type.parameters() != type.parameters() || callee_type.results() != type.results())
+        return to_underlying(fail(context, Trap { "Indirect call type mismatch" }));
+
+    return call_function(context, operands, address.value());
+}
+
+static u64 global_get(NativeContext& context, u64* operands, u64 index)
+{
+    auto* global = context.configuration->store().get(context.module->globals()[index]);
+    operands[0] = value_to_slot(global->value());
+    return to_underlying(NativeResult::Returned);
+}
+
+static u64 global_set(NativeContext& context, u64* operands, u64 index)
+{
+    auto* global = context.configuration->store().get(context.module->globals()[index]);
+    global->set_value(slot_to_value(operands[0], global->type().type()));
+    return to_underlying(NativeResult::Returned);
+}
+
+static u64 memory_grow(NativeContext& context, u64* operands, u64)
+{
+    auto* memory = context.configuration->store().get(context.module->memories().first());
+    auto old_pages = memory->size() / Constants::page_size;
+    auto pages = static_cast<u32>(operands[0]);
+    if (memory->grow(static_cast<size_t>(pages) * Constants::page_size))
+        operands[0] = old_pages;
+    else
+        operands[0] = static_cast<u32>(-1);
+    context.refresh_memory();
+    return to_underlying(NativeResult::Returned);
+}
+
+template<Integral T>
+static u64 divide(NativeContext&, u64* operands, u64)
+{
+    auto lhs = static_cast<T>(operands[0]);
+    auto rhs = static_cast<T>(operands[1]);
+    if (rhs == 0)
+        return to_underlying(NativeResult::DivisionByZero);
+    if constexpr (IsSigned<T>) {
+        if (lhs == NumericLimits<T>::min() && rhs == -1)
+            return to_underlying(NativeResult::IntegerDivisionOverflow);
+    }
+    operands[0] = static_cast<MakeUnsigned<T>>(lhs / rhs);
+    return to_underlying(NativeResult::Returned);
+}
+
+template<Integral T>
+static u64 remainder(NativeContext&, u64* operands, u64)
+{
+    auto lhs = static_cast<T>(operands[0]);
+    auto rhs = static_cast<T>(operands[1]);
+    if (rhs == 0)
+        return to_underlying(NativeResult::DivisionByZero);
+    if constexpr (IsSigned<T>) {
+        // The remainder of dividing the minimum value by -1 is 0, even though the division overflows.
+        if (rhs == -1) {
+            operands[0] = 0;
+            return to_underlying(NativeResult::Returned);
+        }
+    }
+    operands[0] = static_cast<MakeUnsigned<T>>(lhs % rhs);
+    return to_underlying(NativeResult::Returned);
+}
+
+template<Unsigned T>
+static u64 leading_zeroes(NativeContext&, u64* operands, u64)
+{
+    operands[0] = count_leading_zeroes_safe(static_cast<T>(operands[0]));
+    return to_underlying(NativeResult::Returned);
+}
+
+template<Unsigned T>
+static u64 trailing_zeroes(NativeContext&, u64* operands, u64)
+{
+    operands[0] = count_trailing_zeroes_safe(static_cast<T>(operands[0]));
+    return to_underlying(NativeResult::Returned);
+}
+
+template<Unsigned T>
+static u64 population_count(NativeContext&, u64* operands, u64)
+{
+    operands[0] = popcount(static_cast<T>(operands[0]));
+    return to_underlying(NativeResult::Returned);
+}
+
+Compiler::Compiler(Store& store, WasmFunction const& function)
+    : m_store(store)
+    , m_function(function)
+    , m_body(function.code().func().body())
+    , m_assembler(m_output)
+{
+}
+
+RefPtr<NativeFunction> Compiler::compile([[maybe_unused]] Store& store, [[maybe_unused]] WasmFunction const& function)
+{
+#if ARCH(X86_64)
+    Compiler compiler { store, function };
+    return compiler.compile_function();
+#else
+    return nullptr;
+#endif
+}
+
+RefPtr<NativeFunction> Compiler::compile_function()
+{
+    auto& type = m_function.type();
+    auto& instructions = m_body.instructions();
+
+    for (auto& parameter : type.parameters()) {
+        if (!parameter.is_numeric())
+            return nullptr;
+    }
+    for (auto& result : type.results()) {
+        if (!result.is_numeric())
+            return nullptr;
+    }
+    m_local_count = type.parameters().size();
+    for (auto& locals : m_function.code().func().locals()) {
+        if (!locals.type().is_numeric())
+            return nullptr;
+        m_local_count += locals.n();
+    }
+
+    auto& memories = m_function.module().memories();
+    if (!memories.is_empty() && m_store.get(memories.first())->has_guard_region() && install_trap_handler())
+        m_checks_memory_accesses = false;
+
+    // The entry point is called as:
+    //     entry(u64* slots, NativeContext*)
+    // Pushing rbp and the four registers we use keeps the stack 16-byte aligned for calls.
+    m_assembler.push(Reg::RBP);
+    m_assembler.mov(Reg::RBP, Reg::RSP);
+    m_assembler.push(SLOTS);
+    m_assembler.push(CONTEXT);
+    m_assembler.push(MEMORY_BASE);
+    m_assembler.push(MEMORY_SIZE);
+    m_assembler.mov(SLOTS, Reg::RDI);
+    m_assembler.mov(CONTEXT, Reg::RSI);
+    reload_memory();
+
+    m_control_frames.append({ .height = 0, .parameter_count = 0, .result_count = type.results().size(), .end_index = instructions.size() - 1, .else_index = {} });
+
+    for (size_t ip = 0; ip < instructions.size(); ++ip) {
+        if (m_is_unreachable && ip < m_resume_at)
+            continue;
+        if (auto label = m_labels.get(ip); label.has_value())
+            m_assembler.bind(**label);
+        if (!compile_instruction(instructions[ip], ip))
+            return nullptr;
+    }
+
+    // Returns end up here with their results at the bottom of the operand stack, and the end of the body falls through.
+    m_assembler.bind(label_for(instructions.size()));
+    for (size_t i = 0; i < type.results().size() && m_local_count != 0; ++i) {
+        m_assembler.mov(Reg::RAX, operand(i));
+        m_assembler.mov(slot(i), Reg::RAX);
+    }
+    m_assembler.mov32(Reg::RAX, static_cast<u32>(to_underlying(NativeResult::Returned)));
+
+    // Every way out of the native code goes through here, with a NativeResult in rax.
+    m_assembler.bind(m_exit_label);
+    m_assembler.pop(MEMORY_SIZE);
+    m_assembler.pop(MEMORY_BASE);
+    m_assembler.pop(CONTEXT);
+    m_assembler.pop(SLOTS);
+    m_assembler.pop(Reg::RBP);
+    m_assembler.ret();
+
+    exit_with(NativeResult::Unreachable, m_unreachable_label);
+    exit_with(NativeResult::MemoryAccessOutOfBounds, m_out_of_bounds_label);
+
+    for (auto& it : m_labels) {
+        if (!it.value->is_bound()) {
+            dbgln("Wasm JIT: Branch to {} does not land on a compiled instruction", it.key);
+            return nullptr;
+        }
+    }
+
+    // Slots are addressed with 32-bit displacements.
+    auto slot_count = max(m_local_count + m_max_height, type.results().size());
+    if (slot_count * sizeof(u64) > NumericLimits<i32>::max())
+        return nullptr;
+
+    auto* code = mmap(nullptr, m_output.size(), PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+    if (code == MAP_FAILED) {
+        dbgln("Wasm JIT: mmap failed: {}", Error::from_errno(errno));
+        return nullptr;
+    }
+    memcpy(code, m_output.data(), m_output.size());
+    if (mprotect(code, m_output.size(), PROT_READ | PROT_EXEC) < 0) {
+        dbgln("Wasm JIT: mprotect failed: {}", Error::from_errno(errno));
+        munmap(code, m_output.size());
+        return nullptr;
+    }
+
+    Optional<size_t> out_of_bounds_exit_offset;
+    if (!m_checks_memory_accesses)
+        out_of_bounds_exit_offset = m_out_of_bounds_label.offset();
+    return adopt_ref(*new NativeFunction(code, m_output.size(), m_function.module(), slot_count, type.parameters().size(), type.results().size(), out_of_bounds_exit_offset));
+}
+
+bool Compiler::compile_instruction(Instruction const& instruction, size_t ip)
+{
+    auto& module = m_function.module();
+
+    switch (instruction.opcode().value()) {
+    case Instructions::unreachable.value():
+        m_assembler.jump(m_unreachable_label);
+        unreachable_from_here();
+        return true;
+    case Instructions::nop.value():
+        return true;
+    case Instructions::block.value():
+    case Instructions::loop.value():
+    case Instructions::if_.value(): {
+        auto& arguments = instruction.arguments().get<Instruction::StructuredInstructionArgs>();
+        auto frame = control_frame_for(arguments, instruction.opcode() == Instructions::if_);
+        if (!frame.has_value())
+            return false;
+        if (instruction.opcode() == Instructions::loop) {
+            auto& label = label_for(ip);
+            if (!label.is_bound())
+                m_assembler.bind(label);
+        } else if (instruction.opcode() == Instructions::if_) {
+            // The frame's height already excludes the condition.
+            m_assembler.mov(Reg::RAX, operand(--m_height));
+            m_assembler.test32(Reg::RAX, Reg::RAX);
+            auto false_ip = arguments.else_ip.has_value() ? arguments.else_ip->value() : arguments.end_ip.value() + 1;
+            m_assembler.jump_if(Condition::EqualTo, label_for(false_ip));
+        }
+        m_control_frames.append(frame.release_value());
+        return true;
+    }
+    case Instructions::structured_else.value(): {
+        auto& frame = m_control_frames.last();
+        if (!m_is_unreachable)
+            branch_to(m_body.branch_target(ip));
+        m_height = frame.height + frame.parameter_count;
+        frame.else_index.clear();
+        m_is_unreachable = false;
+        return true;
+    }
+    case Instructions::structured_end.value(): {
+        auto frame = m_control_frames.take_last();
+        if (m_control_frames.is_empty() && !m_is_unreachable)
+            move_operands(m_height - frame.result_count, 0, frame.result_count);
+        m_height = frame.height + frame.result_count;
+        m_is_unreachable = false;
+        return true;
+    }
+    case Instructions::br.value():
+    case Instructions::return_.value():
+        branch_to(m_body.branch_target(ip));
+        unreachable_from_here();
+        return true;
+    case Instructions::br_if.value(): {
+        Assembler::Label not_taken;
+        m_assembler.mov(Reg::RAX, operand(--m_height));
+        m_assembler.test32(Reg::RAX, Reg::RAX);
+        m_assembler.jump_if(Condition::EqualTo, not_taken);
+        branch_to(m_body.branch_target(ip));
+        m_assembler.bind(not_taken);
+        return true;
+    }
+    case Instructions::br_table.value(): {
+        auto& arguments = instruction.arguments().get<Instruction::TableBranchArgs>();
+        auto& default_target = m_body.branch_target(ip, arguments.labels.size());
+        // Branching moves values through rax, so the index is kept in rdx.
+        m_assembler.mov(Reg::RDX, operand(--m_height));
+        for (size_t i = 0; i < arguments.labels.size(); ++i) {
+            auto& target = m_body.branch_target(ip, i);
+            if (target.continuation == default_target.continuation)
+                continue;
+            Assembler::Label next;
+            m_assembler.cmp32(Reg::RDX, static_cast<u32>(i));
+            m_assembler.jump_if(Condition::NotEqualTo, next);
+            branch_to(target);
+            m_assembler.bind(next);
+        }
+        branch_to(default_target);
+        unreachable_from_here();
+        return true;
+    }
+    case Instructions::call.value(): {
+        auto address = module.functions()[instruction.arguments().get<FunctionIndex>().value()];
+        auto const& type = m_store.get(address)->visit([](auto const& function) -> FunctionType const& { return function.type(); });
+        return compile_call(type, reinterpret_cast<FlatPtr>(&call_function), address.value(), 0);
+    }
+    case Instructions::call_indirect.value(): {
+        auto& arguments = instruction.arguments().get<Instruction::IndirectCallArgs>();
+        auto& type = module.types()[arguments.type.value()];
+        auto table_and_type = (static_cast<u64>(arguments.table.value()) << 32) | arguments.type.value();
+        return compile_call(type, reinterpret_cast<FlatPtr>(&call_indirect), table_and_type, 1);
+    }
+    case Instructions::drop.value():
+        --m_height;
+        return true;
+    case Instructions::select_typed.value():
+        for (auto& type : instruction.arguments().get<Vector<ValueType>>()) {
+            if (!type.is_numeric())
+                return false;
+        }
+        [[fallthrough]];
+    case Instructions::select.value(): {
+        Assembler::Label keep_first;
+        m_height -= 2;
+        m_assembler.mov(Reg::RAX, operand(m_height + 1));
+        m_assembler.test32(Reg::RAX, Reg::RAX);
+        m_assembler.jump_if(Condition::NotEqualTo, keep_first);
+        m_assembler.mov(Reg::RAX, operand(m_height));
+        m_assembler.mov(operand(m_height - 1), Reg::RAX);
+        m_assembler.bind(keep_first);
+        return true;
+    }
+    case Instructions::local_get.value():
+        m_assembler.mov(Reg::RAX, slot(instruction.arguments().get<LocalIndex>().value()));
+        m_assembler.mov(operand(m_height), Reg::RAX);
+        push_operand();
+        return true;
+    case Instructions::local_set.value():
+        m_assembler.mov(Reg::RAX, operand(--m_height));
+        m_assembler.mov(slot(instruction.arguments().get<LocalIndex>().value()), Reg::RAX);
+        return true;
+    case Instructions::local_tee.value():
+        m_assembler.mov(Reg::RAX, operand(m_height - 1));
+        m_assembler.mov(slot(instruction.arguments().get<LocalIndex>().value()), Reg::RAX);
+        return true;
+    case Instructions::global_get.value():
+    case Instructions::global_set.value(): {
+        auto index = instruction.arguments().get<GlobalIndex>().value();
+        if (!m_store.get(module.globals()[index])->type().type().is_numeric())
+            return false;
+        if (instruction.opcode() == Instructions::global_get) {
+            call_helper(reinterpret_cast<FlatPtr>(&global_get), m_height, index);
+            push_operand();
+        } else {
+            call_helper(reinterpret_cast<FlatPtr>(&global_set), --m_height, index);
+        }
+        return true;
+    }
+    case Instructions::i32_load.value():
+    case Instructions::i64_load.value():
+    case Instructions::f32_load.value():
+    case Instructions::f64_load.value():
+    case Instructions::i32_load8_s.value():
+    case Instructions::i32_load8_u.value():
+    case Instructions::i32_load16_s.value():
+    case Instructions::i32_load16_u.value():
+    case Instructions::i64_load8_s.value():
+    case Instructions::i64_load8_u.value():
+    case Instructions::i64_load16_s.value():
+    case Instructions::i64_load16_u.value():
+    case Instructions::i64_load32_s.value():
+    case Instructions::i64_load32_u.value():
+    case Instructions::i32_store.value():
+    case Instructions::i64_store.value():
+    case Instructions::f32_store.value():
+    case Instructions::f64_store.value():
+    case Instructions::i32_store8.value():
+    case Instructions::i32_store16.value():
+    case Instructions::i64_store8.value():
+    case Instructions::i64_store16.value():
+    case Instructions::i64_store32.value():
+        return compile_memory_access(instruction);
+    case Instructions::memory_size.value():
+        if (instruction.arguments().get<Instruction::MemoryIndexArgument>().memory_index.value() != 0)
+            return false;
+        m_assembler.mov(Reg::RAX, MEMORY_SIZE);
+        m_assembler.shift_right(Reg::RAX, 16);
+        m_assembler.mov(operand(m_height), Reg::RAX);
+        push_operand();
+        return true;
+    case Instructions::memory_grow.value():
+        if (instruction.arguments().get<Instruction::MemoryIndexArgument>().memory_index.value() != 0)
+            return false;
+        call_helper(reinterpret_cast<FlatPtr>(&memory_grow), m_height - 1, 0);
+        reload_memory();
+        return true;
+    case Instructions::i32_const.value():
+        m_assembler.mov(operand(m_height), instruction.arguments().get<i32>());
+        push_operand();
+        return true;
+    case Instructions::f32_const.value():
+        m_assembler.mov(operand(m_height), bit_cast<i32>(instruction.arguments().get<float>()));
+        push_operand();
+        return true;
+    case Instructions::i64_const.value():
+    case Instructions::f64_const.value(): {
+        auto value = instruction.opcode() == Instructions::i64_const
+            ? instruction.arguments().get<i64>()
+            : bit_cast<i64>(instruction.arguments().get<double>());
+        if (value >= NumericLimits<i32>::min() && value <= NumericLimits<i32>::max()) {
+            m_assembler.mov(operand(m_height), static_cast<i32>(value));
+        } else {
+            m_assembler.mov(Reg::RAX, static_cast<u64>(value));
+            m_assembler.mov(operand(m_height), Reg::RAX);
+        }
+        push_operand();
+        return true;
+    }
+    case Instructions::i32_eqz.value():
+    case Instructions::i64_eqz.value():
+        m_assembler.mov(Reg::RAX, operand(m_height - 1));
+        if (instruction.opcode() == Instructions::i64_eqz)
+            m_assembler.test(Reg::RAX, Reg::RAX);
+        else
+            m_assembler.test32(Reg::RAX, Reg::RAX);
+        m_assembler.set(Condition::EqualTo, Reg::RAX);
+        m_assembler.movzx8(Reg::RAX, Reg::RAX);
+        m_assembler.mov(operand(m_height - 1), Reg::RAX);
+        return true;
+    case Instructions::i32_eq.value():
+        comparison(Condition::EqualTo, false);
+        return true;
+    case Instructions::i32_ne.value():
+        comparison(Condition::NotEqualTo, false);
+        return true;
+    case Instructions::i32_lts.value():
+        comparison(Condition::SignedLessThan, false);
+        return true;
+    case Instructions::i32_ltu.value():
+        comparison(Condition::UnsignedLessThan, false);
+        return true;
+    case Instructions::i32_gts.value():
+        comparison(Condition::SignedGreaterThan, false);
+        return true;
+    case Instructions::i32_gtu.value():
+        comparison(Condition::UnsignedGreaterThan, false);
+        return true;
+    case Instructions::i32_les.value():
+        comparison(Condition::SignedLessThanOrEqualTo, false);
+        return true;
+    case Instructions::i32_leu.value():
+        comparison(Condition::UnsignedLessThanOrEqualTo, false);
+        return true;
+    case Instructions::i32_ges.value():
+        comparison(Condition::SignedGreaterThanOrEqualTo, false);
+        return true;
+    case Instructions::i32_geu.value():
+        comparison(Condition::UnsignedGreaterThanOrEqualTo, false);
+        return true;
+    case Instructions::i64_eq.value():
+        comparison(Condition::EqualTo, true);
+        return true;
+    case Instructions::i64_ne.value():
+        comparison(Condition::NotEqualTo, true);
+        return true;
+    case Instructions::i64_lts.value():
+        comparison(Condition::SignedLessThan, true);
+        return true;
+    case Instructions::i64_ltu.value():
+        comparison(Condition::UnsignedLessThan, true);
+        return true;
+    case Instructions::i64_gts.value():
+        comparison(Condition::SignedGreaterThan, true);
+        return true;
+    case Instructions::i64_gtu.value():
+        comparison(Condition::UnsignedGreaterThan, true);
+        return true;
+    case Instructions::i64_les.value():
+        comparison(Condition::SignedLessThanOrEqualTo, true);
+        return true;
+    case Instructions::i64_leu.value():
+        comparison(Condition::UnsignedLessThanOrEqualTo, true);
+        return true;
+    case Instructions::i64_ges.value():
+        comparison(Condition::SignedGreaterThanOrEqualTo, true);
+        return true;
+    case Instructions::i64_geu.value():
+        comparison(Condition::UnsignedGreaterThanOrEqualTo, true);
+        return true;
+    case Instructions::i32_clz.value():
+        call_helper(reinterpret_cast<FlatPtr>(&leading_zeroes<u32>), m_height - 1, 0);
+        return true;
+    case Instructions::i32_ctz.value():
+        call_helper(reinterpret_cast<FlatPtr>(&trailing_zeroes<u32>), m_height - 1, 0);
+        return true;
+    case Instructions::i32_popcnt.value():
+        call_helper(reinterpret_cast<FlatPtr>(&population_count<u32>), m_height - 1, 0);
+        return true;
+    case Instructions::i64_clz.value():
+        call_helper(reinterpret_cast<FlatPtr>(&leading_zeroes<u64>), m_height - 1, 0);
+        return true;
+    case Instructions::i64_ctz.value():
+        call_helper(reinterpret_cast<FlatPtr>(&trailing_zeroes<u64>), m_height - 1, 0);
+        return true;
+    case Instructions::i64_popcnt.value():
+        call_helper(reinterpret_cast<FlatPtr>(&population_count<u64>), m_height - 1, 0);
+        return true;
+    case Instructions::i32_add.value():
+        binary_operation(&Assembler::add32);
+        return true;
+    case Instructions::i32_sub.value():
+        binary_operation(&Assembler::sub32);
+        return true;
+    case Instructions::i32_mul.value():
+        binary_operation(&Assembler::multiply32);
+        return true;
+    case Instructions::i32_and.value():
+        binary_operation(&Assembler::bitwise_and32);
+        return true;
+    case Instructions::i32_or.value():
+        binary_operation(&Assembler::bitwise_or32);
+        return true;
+    case Instructions::i32_xor.value():
+        binary_operation(&Assembler::bitwise_xor32);
+        return true;
+    case Instructions::i32_shl.value():
+        shift_operation(&Assembler::shift_left32_by_cl);
+        return true;
+    case Instructions::i32_shrs.value():
+        shift_operation(&Assembler::arithmetic_shift_right32_by_cl);
+        return true;
+    case Instructions::i32_shru.value():
+        shift_operation(&Assembler::shift_right32_by_cl);
+        return true;
+    case Instructions::i32_rotl.value():
+        shift_operation(&Assembler::rotate_left32_by_cl);
+        return true;
+    case Instructions::i32_rotr.value():
+        shift_operation(&Assembler::rotate_right32_by_cl);
+        return true;
+    case Instructions::i64_add.value():
+        binary_operation(&Assembler::add);
+        return true;
+    case Instructions::i64_sub.value():
+        binary_operation(&Assembler::sub);
+        return true;
+    case Instructions::i64_mul.value():
+        binary_operation(&Assembler::multiply);
+        return true;
+    case Instructions::i64_and.value():
+        binary_operation(&Assembler::bitwise_and);
+        return true;
+    case Instructions::i64_or.value():
+        binary_operation(&Assembler::bitwise_or);
+        return true;
+    case Instructions::i64_xor.value():
+        binary_operation(&Assembler::bitwise_xor);
+        return true;
+    case Instructions::i64_shl.value():
+        shift_operation(&Assembler::shift_left_by_cl);
+        return true;
+    case Instructions::i64_shrs.value():
+        shift_operation(&Assembler::arithmetic_shift_right_by_cl);
+        return true;
+    case Instructions::i64_shru.value():
+        shift_operation(&Assembler::shift_right_by_cl);
+        return true;
+    case Instructions::i64_rotl.value():
+        shift_operation(&Assembler::rotate_left_by_cl);
+        return true;
+    case Instructions::i64_rotr.value():
+        shift_operation(&Assembler::rotate_right_by_cl);
+        return true;
+    case Instructions::i32_divs.value():
+    case Instructions::i32_divu.value():
+    case Instructions::i32_rems.value():
+    case Instructions::i32_remu.value():
+    case Instructions::i64_divs.value():
+    case Instructions::i64_divu.value():
+    case Instructions::i64_rems.value():
+    case Instructions::i64_remu.value(): {
+        auto helper = [&] {
+            switch (instruction.opcode().value()) {
+            case Instructions::i32_divs.value():
+                return reinterpret_cast<FlatPtr>(&divide<i32>);
+            case Instructions::i32_divu.value():
+                return reinterpret_cast<FlatPtr>(&divide<u32>);
+            case Instructions::i32_rems.value():
+                return reinterpret_cast<FlatPtr>(&remainder<i32>);
+            case Instructions::i32_remu.value():
+                return reinterpret_cast<FlatPtr>(&remainder<u32>);
+            case Instructions::i64_divs.value():
+                return reinterpret_cast<FlatPtr>(&divide<i64>);
+            case Instructions::i64_divu.value():
+                return reinterpret_cast<FlatPtr>(&divide<u64>);
+            case Instructions::i64_rems.value():
+                return reinterpret_cast<FlatPtr>(&remainder<i64>);
+            default:
+                return reinterpret_cast<FlatPtr>(&remainder<u64>);
+            }
+        }();
+        m_height -= 2;
+        call_helper(helper, m_height, 0);
+        exit_if_helper_failed();
+        ++m_height;
+        return true;
+    }
+    case Instructions::i32_wrap_i64.value():
+    case Instructions::i32_reinterpret_f32.value():
+    case Instructions::i64_reinterpret_f64.value():
+    case Instructions::f32_reinterpret_i32.value():
+    case Instructions::f64_reinterpret_i64.value():
+        // These don't change the bits that matter.
+        return true;
+    case Instructions::i64_extend_si32.value():
+    case Instructions::i64_extend32_s.value():
+        m_assembler.mov(Reg::RAX, operand(m_height - 1));
+        m_assembler.movsx32(Reg::RAX, Reg::RAX);
+        m_assembler.mov(operand(m_height - 1), Reg::RAX);
+        return true;
+    case Instructions::i64_extend_ui32.value():
+        m_assembler.mov32(Reg::RAX, operand(m_height - 1));
+        m_assembler.mov(operand(m_height - 1), Reg::RAX);
+        return true;
+    case Instructions::i32_extend8_s.value():
+    case Instructions::i64_extend8_s.value():
+        m_assembler.mov(Reg::RAX, operand(m_height - 1));
+        m_assembler.movsx8(Reg::RAX, Reg::RAX);
+        m_assembler.mov(operand(m_height - 1), Reg::RAX);
+        return true;
+    case Instructions::i32_extend16_s.value():
+    case Instructions::i64_extend16_s.value():
+        m_assembler.mov(Reg::RAX, operand(m_height - 1));
+        m_assembler.movsx16(Reg::RAX, Reg::RAX);
+        m_assembler.mov(operand(m_height - 1), Reg::RAX);
+        return true;
+    default:
+        dbgln_if(WASM_TRACE_DEBUG, "Wasm JIT: Can't compile {}", instruction_name(instruction.opcode()));
+        return false;
+    }
+}
+
+bool Compiler::compile_memory_access(Instruction const& instruction)
+{
+    auto& argument = instruction.arguments().get<Instruction::MemoryArgument>();
+    if (argument.memory_index.value() != 0)
+        return false;
+
+    struct Access {
+        u8 size;
+        bool is_store { false };
+        bool sign_extends { false };
+    };
+    auto access = [&]() -> Access {
+        switch (instruction.opcode().value()) {
+        case Instructions::i32_load8_s.value():
+        case Instructions::i64_load8_s.value():
+            return { 1, false, true };
+        case Instructions::i32_load8_u.value():
+        case Instructions::i64_load8_u.value():
+            return { 1 };
+        case Instructions::i32_load16_s.value():
+        case Instructions::i64_load16_s.value():
+            return { 2, false, true };
+        case Instructions::i32_load16_u.value():
+        case Instructions::i64_load16_u.value():
+            return { 2 };
+        case Instructions::i64_load32_s.value():
+            return { 4, false, true };
+        case Instructions::i32_load.value():
+        case Instructions::f32_load.value():
+        case Instructions::i64_load32_u.value():
+            return { 4 };
+        case Instructions::i64_load.value():
+        case Instructions::f64_load.value():
+            return { 8 };
+        case Instructions::i32_store8.value():
+        case Instructions::i64_store8.value():
+            return { 1, true };
+        case Instructions::i32_store16.value():
+        case Instructions::i64_store16.value():
+            return { 2, true };
+        case Instructions::i32_store.value():
+        case Instructions::f32_store.value():
+        case Instructions::i64_store32.value():
+            return { 4, true };
+        default:
+            return { 8, true };
+        }
+    }();
+
+    // The effective address is the zero-extended 32-bit base plus the offset, which can't overflow 64 bits.
+    auto address_index = m_height - (access.is_store ? 2 : 1);
+    m_assembler.mov32(Reg::RAX, operand(address_index));
+    if (argument.offset <= static_cast<u32>(NumericLimits<i32>::max())) {
+        if (argument.offset != 0)
+            m_assembler.add(Reg::RAX, static_cast<i32>(argument.offset));
+    } else {
+        m_assembler.mov(Reg::RCX, static_cast<u64>(argument.offset));
+        m_assembler.add(Reg::RAX, Reg::RCX);
+    }
+    // Without a check, an access past the end of the memory lands in its guard region, and the trap handler resumes
+    // at the out-of-bounds exit.
+    if (m_checks_memory_accesses) {
+        m_assembler.mov(Reg::RCX, Reg::RAX);
+        m_assembler.add(Reg::RCX, static_cast<i32>(access.size));
+        m_assembler.cmp(Reg::RCX, MEMORY_SIZE);
+        m_assembler.jump_if(Condition::UnsignedGreaterThan, m_out_of_bounds_label);
+    }
+    m_assembler.add(Reg::RAX, MEMORY_BASE);
+
+    Memory address { Reg::RAX };
+    if (access.is_store) {
+        m_assembler.mov(Reg::RCX, operand(m_height - 1));
+        switch (access.size) {
+        case 1:
+            m_assembler.mov8(address, Reg::RCX);
+            break;
+        case 2:
+            m_assembler.mov16(address, Reg::RCX);
+            break;
+        case 4:
+            m_assembler.mov32(address, Reg::RCX);
+            break;
+        default:
+            m_assembler.mov(address, Reg::RCX);
+            break;
+        }
+        m_height -= 2;
+        return true;
+    }
+
+    switch (access.size) {
+    case 1:
+        if (access.sign_extends)
+            m_assembler.movsx8(Reg::RCX, address);
+        else
+            m_assembler.movzx8(Reg::RCX, address);
+        break;
+    case 2:
+        if (access.sign_extends)
+            m_assembler.movsx16(Reg::RCX, address);
+        else
+            m_assembler.movzx16(Reg::RCX, address);
+        break;
+    case 4:
+        if (access.sign_extends)
+            m_assembler.movsx32(Reg::RCX, address);
+        else
+            m_assembler.mov32(Reg::RCX, address);
+        break;
+    default:
+        m_assembler.mov(Reg::RCX, address);
+        break;
+    }
+    m_assembler.mov(operand(address_index), Reg::RCX);
+    return true;
+}
+
+bool Compiler::compile_call(FunctionType const& type, FlatPtr helper, u64 immediate, size_t extra_operands)
+{
+    for (auto& parameter : type.parameters()) {
+        if (!parameter.is_numeric())
+            return false;
+    }
+    for (auto& result : type.results()) {
+        if (!result.is_numeric())
+            return false;
+    }
+
+    // The arguments are replaced by the results, which may take up more slots than the operand stack had so far.
+    auto base = m_height - extra_operands - type.parameters().size();
+    call_helper(helper, base, immediate);
+    exit_if_helper_failed();
+    reload_memory();
+    m_height = base + type.results().size();
+    m_max_height = max(m_max_height, m_height);
+    return true;
+}
+
+Optional<Compiler::ControlFrame> Compiler::control_frame_for(Instruction::StructuredInstructionArgs const& arguments, bool is_if) const
+{
+    ControlFrame frame;
+    switch (arguments.block_type.kind()) {
+    case BlockType::Empty:
+        break;
+    case BlockType::Type:
+        frame.result_count = 1;
+        break;
+    case BlockType::Index: {
+        auto& type = m_function.module().types()[arguments.block_type.type_index().value()];
+        frame.parameter_count = type.parameters().size();
+        frame.result_count = type.results().size();
+        break;
+    }
+    }
+
+    // An if's height doesn't include its condition.
+    auto height = m_height - (is_if ? 1 : 0);
+    if (height < frame.parameter_count)
+        return {};
+    frame.height = height - frame.parameter_count;
+
+    // An if with an else arm has its end_ip just past its end (see Expression::parse()).
+    if (is_if && arguments.else_ip.has_value()) {
+        frame.else_index = arguments.else_ip->value() - 1;
+        frame.end_index = arguments.end_ip.value() - 1;
+    } else {
+        frame.end_index = arguments.end_ip.value();
+    }
+    return frame;
+}
+
+void Compiler::move_operands(size_t from, size_t to, size_t count)
+{
+    if (from == to)
+        return;
+    for (size_t i = 0; i < count; ++i) {
+        m_assembler.mov(Reg::RAX, operand(from + i));
+        m_assembler.mov(operand(to + i), Reg::RAX);
+    }
+}
+
+void Compiler::branch_to(Expression::BranchTarget const& target)
+{
+    move_operands(m_height - target.arity, target.stack_height, target.arity);
+    m_assembler.jump(label_for(target.continuation.value()));
+}
+
+void Compiler::unreachable_from_here()
+{
+    // Nothing can fall through to the rest of the block, so compilation picks up at its else or end.
+    auto& frame = m_control_frames.last();
+    m_is_unreachable = true;
+    m_resume_at = frame.else_index.value_or(frame.end_index);
+}
+
+void Compiler::binary_operation(void (Assembler::*operation)(Reg, Reg))
+{
+    --m_height;
+    m_assembler.mov(Reg::RAX, operand(m_height - 1));
+    m_assembler.mov(Reg::RCX, operand(m_height));
+    (m_assembler.*operation)(Reg::RAX, Reg::RCX);
+    m_assembler.mov(operand(m_height - 1), Reg::RAX);
+}
+
+void Compiler::shift_operation(void (Assembler::*operation)(Reg))
+{
+    // The processor masks the shift amount just like Wasm does.
+    --m_height;
+    m_assembler.mov(Reg::RAX, operand(m_height - 1));
+    m_assembler.mov(Reg::RCX, operand(m_height));
+    (m_assembler.*operation)(Reg::RAX);
+    m_assembler.mov(operand(m_height - 1), Reg::RAX);
+}
+
+void Compiler::comparison(Condition condition, bool is_64_bit)
+{
+    --m_height;
+    m_assembler.mov(Reg::RAX, operand(m_height - 1));
+    m_assembler.mov(Reg::RCX, operand(m_height));
+    if (is_64_bit)
+        m_assembler.cmp(Reg::RAX, Reg::RCX);
+    else
+        m_assembler.cmp32(Reg::RAX, Reg::RCX);
+    m_assembler.set(condition, Reg::RAX);
+    m_assembler.movzx8(Reg::RAX, Reg::RAX);
+    m_assembler.mov(operand(m_height - 1), Reg::RAX);
+}
+
+void Compiler::call_helper(FlatPtr helper, size_t operand_index, u64 immediate)
+{
+    // Every helper is called as helper(NativeContext&, u64* operands, u64 immediate).
+    m_assembler.mov(Reg::RDI, CONTEXT);
+    m_assembler.mov(Reg::RSI, SLOTS);
+    m_assembler.add(Reg::RSI, static_cast<i32>((m_local_count + operand_index) * sizeof(u64)));
+    m_assembler.mov(Reg::RDX, immediate);
+    m_assembler.mov(Reg::RAX, helper);
+    m_assembler.call(Reg::RAX);
+}
+
+void Compiler::exit_if_helper_failed()
+{
+    m_assembler.test(Reg::RAX, Reg::RAX);
+    m_assembler.jump_if(Condition::NotEqualTo, m_exit_label);
+}
+
+void Compiler::reload_memory()
+{
+    m_assembler.mov(MEMORY_BASE, Memory { CONTEXT, static_cast<i32>(offsetof(NativeContext, memory_base)) });
+    m_assembler.mov(MEMORY_SIZE, Memory { CONTEXT, static_cast<i32>(offsetof(NativeContext, memory_size)) });
+}
+
+void Compiler::exit_with(NativeResult result, Assembler::Label& label)
+{
+    m_assembler.bind(label);
+    m_assembler.mov32(Reg::RAX, static_cast<u32>(to_underlying(result)));
+    m_assembler.jump(m_exit_label);
+}
+
+Memory Compiler::slot(size_t index) const
+{
+    return Memory { SLOTS, static_cast<i32>(index * sizeof(u64)) };
+}
+
+Assembler::Label& Compiler::label_for(size_t ip)
+{
+    return *m_labels.ensure(ip, [] { return make<Assembler::Label>(); });
+}
+
+}
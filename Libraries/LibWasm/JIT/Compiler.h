@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/RefPtr.h>
+#include <AK/Vector.h>
+#include <LibJIT/Assembler.h>
+#include <LibWasm/AbstractMachine/AbstractMachine.h>
+#include <LibWasm/JIT/NativeFunction.h>
+
+namespace Wasm::JIT {
+
+using ::JIT::Assembler;
+
+// A single-pass compiler that translates a validated function body into x86-64 code.
+//
+// Values live in the slots of the function's frame rather than in registers; the height of the operand stack at
+// every instruction is known statically, and branches use the targets the validator resolved for the interpreter.
+// Integer arithmetic, comparisons, memory accesses and control flow are emitted inline. Calls, globals and the
+// instructions with more involved semantics go through helpers, and calls to host functions or to functions that
+// weren't compiled go back through the Configuration.
+class Compiler {
+public:
+    // Returns null if this platform has no native code generator, or if the function uses something the compiler
+    // can't handle (floating-point arithmetic, SIMD, references, tables and bulk memory instructions), in which case
+    // it keeps being interpreted.
+    static RefPtr<NativeFunction> compile(Store&, WasmFunction const&);
+
+private:
+    Compiler(Store&, WasmFunction const&);
+
+    struct ControlFrame {
+        // The height of the operand stack below the block's parameters.
+        size_t height { 0 };
+        size_t parameter_count { 0 };
+        size_t result_count { 0 };
+        // Where compilation picks up again after the rest of the block turns out to be unreachable.
+        size_t end_index { 0 };
+        Optional<size_t> else_index;
+    };
+
+    RefPtr<NativeFunction> compile_function();
+    bool compile_instruction(Instruction const&, size_t ip);
+    bool compile_memory_access(Instruction const&);
+    bool compile_call(FunctionType const&, FlatPtr helper, u64 immediate, size_t extra_operands);
+
+    Optional<ControlFrame> control_frame_for(Instruction::StructuredInstructionArgs const&, bool is_if) const;
+    void move_operands(size_t from, size_t to, size_t count);
+    void branch_to(Expression::BranchTarget const&);
+    void unreachable_from_here();
+
+    void binary_operation(void (Assembler::*)(Assembler::Reg, Assembler::Reg));
+    void shift_operation(void (Assembler::*)(Assembler::Reg));
+    void comparison(Assembler::Condition, bool is_64_bit);
+    void call_helper(FlatPtr helper, size_t operand_index, u64 immediate);
+    void exit_if_helper_failed();
+    void reload_memory();
+    void exit_with(NativeResult, Assembler::Label&);
+
+    Assembler::Memory slot(size_t index) const;
+    Assembler::Memory operand(size_t index) const { return slot(m_local_count + index); }
+    void push_operand() { m_max_height = max(m_max_height, ++m_height); }
+
+    Assembler::Label& label_for(size_t ip);
+
+    Store& m_store;
+    WasmFunction const& m_function;
+    Expression const& m_body;
+    Vector<u8> m_output;
+    Assembler m_assembler;
+    Assembler::Label m_exit_label;
+    Assembler::Label m_unreachable_label;
+    Assembler::Label m_out_of_bounds_label;
+    HashMap<size_t, NonnullOwnPtr<Assembler::Label>> m_labels;
+    Vector<ControlFrame> m_control_frames;
+    size_t m_local_count { 0 };
+    size_t m_height { 0 };
+    size_t m_max_height { 0 };
+    // Set once compilation reaches code that can't be executed, which is skipped up to the else or end of its block.
+    bool m_is_unreachable { false };
+    size_t m_resume_at { 0 };
+    // Accesses to a memory with a guard region are left to fault instead.
+    bool m_checks_memory_accesses { true };
+};
+
+}
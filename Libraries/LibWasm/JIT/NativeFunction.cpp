@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Error.h>
+#include <AK/TemporaryChange.h>
+#include <LibWasm/AbstractMachine/AbstractMachine.h>
+#include <LibWasm/AbstractMachine/Configuration.h>
+#include <LibWasm/JIT/NativeFunction.h>
+#include <LibWasm/JIT/TrapHandler.h>
+#include <sys/mman.h>
+
+namespace Wasm::JIT {
+
+u64 value_to_slot(Value const& value)
+{
+    return value.to<u64>();
+}
+
+Value slot_to_value(u64 slot, ValueType type)
+{
+    switch (type.kind()) {
+    case ValueType::I32:
+    case ValueType::F32:
+        return Value(static_cast<u32>(slot));
+    case ValueType::I64:
+    case ValueType::F64:
+        return Value(slot);
+    default:
+        VERIFY_NOT_REACHED();
+    }
+}
+
+void NativeContext::refresh_memory()
+{
+    if (module->memories().is_empty())
+        return;
+    auto* memory = configuration->store().get(module->memories().first());
+    memory_base = memory->data().data();
+    memory_size = memory->size();
+}
+
+NativeFunction::NativeFunction(void* code, size_t size, ModuleInstance const& module, size_t slot_count, size_t parameter_count, size_t result_count, Optional<size_t> out_of_bounds_exit_offset)
+    : m_code(code)
+    , m_size(size)
+    , m_module(module)
+    , m_slot_count(slot_count)
+    , m_parameter_count(parameter_count)
+    , m_result_count(result_count)
+    , m_out_of_bounds_exit_offset(out_of_bounds_exit_offset)
+{
+}
+
+NativeFunction::~NativeFunction()
+{
+    if (munmap(m_code, m_size) < 0) {
+        dbgln("Wasm JIT: munmap failed: {}", Error::from_errno(errno));
+        VERIFY_NOT_REACHED();
+    }
+}
+
+NativeResult NativeFunction::run(Configuration& configuration, Interpreter& interpreter, Span<u64> arguments_and_results, Optional<Result>& failure) const
+{
+    // The locals that aren't parameters start out as zero.
+    Vector<u64, 64> slots;
+    slots.resize(m_slot_count);
+    for (size_t i = 0; i < m_parameter_count; ++i)
+        slots[i] = arguments_and_results[i];
+
+    NativeContext context {
+        .configuration = &configuration,
+        .interpreter = &interpreter,
+        .module = &m_module,
+        .failure = &failure,
+        .function = this,
+    };
+    context.refresh_memory();
+    TemporaryChange running_context_change { running_native_context(), &context };
+
+    auto entry_function = reinterpret_cast<EntryFunction>(m_code);
+    auto result = static_cast<NativeResult>(entry_function(slots.data(), &context));
+    if (result == NativeResult::Returned) {
+        for (size_t i = 0; i < m_result_count; ++i)
+            arguments_and_results[i] = slots[i];
+    }
+    return result;
+}
+
+Result NativeFunction::call(Configuration& configuration, Interpreter& interpreter, WasmFunction const& function, Vector<Value> const& arguments) const
+{
+    Vector<u64, 8> arguments_and_results;
+    arguments_and_results.resize(max(m_parameter_count, m_result_count));
+    for (size_t i = 0; i < arguments.size(); ++i)
+        arguments_and_results[i] = value_to_slot(arguments[i]);
+
+    Optional<Result> failure;
+    switch (run(configuration, interpreter, arguments_and_results, failure)) {
+    case NativeResult::Returned:
+        break;
+    case NativeResult::Failed:
+        return failure.release_value();
+    case NativeResult::Unreachable:
+        return Trap { "Unreachable" };
+    case NativeResult::MemoryAccessOutOfBounds:
+        return Trap { "Memory access out of bounds" };
+    case NativeResult::IntegerDivisionOverflow:
+        return Trap { "Integer division overflow" };
+    case NativeResult::DivisionByZero:
+        return Trap { "Division by zero" };
+    }
+
+    // Like Configuration::execute(), this gives the results in the order they are popped off the stack.
+    auto& result_types = function.type().results();
+    Vector<Value> results;
+    results.ensure_capacity(m_result_count);
+    for (size_t i = m_result_count; i > 0; --i)
+        results.unchecked_append(slot_to_value(arguments_and_results[i - 1], result_types[i - 1]));
+    return Result { move(results) };
+}
+
+Optional<FlatPtr> NativeFunction::out_of_bounds_exit_for(FlatPtr faulting_instruction) const
+{
+    auto code = bit_cast<FlatPtr>(m_code);
+    if (!m_out_of_bounds_exit_offset.has_value() || faulting_instruction - code >= m_size)
+        return {};
+    return code + m_out_of_bounds_exit_offset.value();
+}
+
+}
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Noncopyable.h>
+#include <AK/Optional.h>
+#include <AK/RefCounted.h>
+#include <AK/Span.h>
+#include <AK/Types.h>
+#include <AK/Vector.h>
+
+namespace Wasm {
+
+class Configuration;
+class ModuleInstance;
+class Result;
+class Value;
+class ValueType;
+class WasmFunction;
+struct Interpreter;
+
+}
+
+namespace Wasm::JIT {
+
+class NativeFunction;
+
+// Why native code (or a helper it called) stopped running.
+enum class NativeResult : u64 {
+    Returned = 0,
+    // A helper has stored a trap, or the completion of a host function, in the context.
+    Failed = 1,
+    Unreachable = 2,
+    MemoryAccessOutOfBounds = 3,
+    IntegerDivisionOverflow = 4,
+    DivisionByZero = 5,
+};
+
+// What native code and its helpers need to get at while running a function.
+struct NativeContext {
+    // The native code keeps these in registers, and reloads them after every helper that may have moved or grown the memory.
+    u8* memory_base { nullptr };
+    u64 memory_size { 0 };
+
+    Configuration* configuration { nullptr };
+    Interpreter* interpreter { nullptr };
+    ModuleInstance const* module { nullptr };
+    Optional<Result>* failure { nullptr };
+    NativeFunction const* function { nullptr };
+
+    void refresh_memory();
+};
+
+// The native code generated for a WasmFunction by the compiler.
+//
+// Every value is kept in a 64-bit slot: the function's locals (starting with its parameters) come first, followed
+// by its operand stack. The results are left in the first slots.
+class NativeFunction : public RefCounted<NativeFunction> {
+    AK_MAKE_NONCOPYABLE(NativeFunction);
+    AK_MAKE_NONMOVABLE(NativeFunction);
+
+public:
+    using EntryFunction = u64 (*)(u64* slots, NativeContext*);
+
+    NativeFunction(void* code, size_t size, ModuleInstance const&, size_t slot_count, size_t parameter_count, size_t result_count, Optional<size_t> out_of_bounds_exit_offset);
+    ~NativeFunction();
+
+    size_t parameter_count() const { return m_parameter_count; }
+    size_t result_count() const { return m_result_count; }
+
+    // Runs the function with the arguments taken from, and the results put into, the given slots.
+    NativeResult run(Configuration&, Interpreter&, Span<u64> arguments_and_results, Optional<Result>& failure) const;
+
+    // Runs the function on behalf of Configuration::call().
+    Result call(Configuration&, Interpreter&, WasmFunction const&, Vector<Value> const& arguments) const;
+
+    // Where to resume after an access at the given address faulted on the guard region of the memory, if this
+    // function left that access unchecked.
+    Optional<FlatPtr> out_of_bounds_exit_for(FlatPtr faulting_instruction) const;
+
+private:
+    void* m_code { nullptr };
+    size_t m_size { 0 };
+    ModuleInstance const& m_module;
+    size_t m_slot_count { 0 };
+    size_t m_parameter_count { 0 };
+    size_t m_result_count { 0 };
+    // Only set if the memory accesses aren't checked.
+    Optional<size_t> m_out_of_bounds_exit_offset;
+};
+
+// Numeric values are kept in slots as their bits; the upper half of the slot of a 32-bit value is unspecified.
+u64 value_to_slot(Value const&);
+Value slot_to_value(u64 slot, ValueType);
+
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Format.h>
+#include <AK/Platform.h>
+#include <LibCore/System.h>
+#include <LibWasm/AbstractMachine/AbstractMachine.h>
+#include <LibWasm/JIT/NativeFunction.h>
+#include <LibWasm/JIT/TrapHandler.h>
+#include <signal.h>
+
+#if ARCH(X86_64) && (defined(AK_OS_LINUX) || defined(AK_OS_MACOS))
+#    include <ucontext.h>
+#    define WASM_JIT_CAN_HANDLE_TRAPS
+#endif
+
+namespace Wasm::JIT {
+
+NativeContext*& running_native_context()
+{
+    static thread_local NativeContext* context { nullptr };
+    return context;
+}
+
+#ifdef WASM_JIT_CAN_HANDLE_TRAPS
+
+static struct sigaction s_previous_segv_action;
+static struct sigaction s_previous_bus_action;
+
+static FlatPtr& program_counter(ucontext_t& context)
+{
+#    if defined(AK_OS_LINUX)
+    return reinterpret_cast<FlatPtr&>(context.uc_mcontext.gregs[REG_RIP]);
+#    else
+    return reinterpret_cast<FlatPtr&>(context.uc_mcontext->__ss.__rip);
+#    endif
+}
+
+// Faults that aren't ours go to whoever handled them before us.
+static void forward_to_previous_handler(int signal_number, siginfo_t* info, void* ucontext)
+{
+    auto& previous_action = signal_number == SIGSEGV ? s_previous_segv_action : s_previous_bus_action;
+    if (previous_action.sa_flags & SA_SIGINFO) {
+        previous_action.sa_sigaction(signal_number, info, ucontext);
+        return;
+    }
+    if (previous_action.sa_handler != SIG_DFL && previous_action.sa_handler != SIG_IGN) {
+        previous_action.sa_handler(signal_number);
+        return;
+    }
+    // Returning runs the faulting instruction again, which now gets the default action.
+    signal(signal_number, SIG_DFL);
+}
+
+static void handle_fault(int signal_number, siginfo_t* info, void* ucontext)
+{
+    auto& pc = program_counter(*static_cast<ucontext_t*>(ucontext));
+    if (auto* context = running_native_context(); context && context->function) {
+        auto fault_address = bit_cast<FlatPtr>(info->si_addr);
+        auto memory_base = bit_cast<FlatPtr>(context->memory_base);
+        auto out_of_bounds_exit = context->function->out_of_bounds_exit_for(pc);
+        if (out_of_bounds_exit.has_value() && fault_address - memory_base < MemoryInstance::guarded_reservation_size) {
+            pc = out_of_bounds_exit.value();
+            return;
+        }
+    }
+    forward_to_previous_handler(signal_number, info, ucontext);
+}
+
+bool install_trap_handler()
+{
+    static bool const installed = [] {
+        struct sigaction action {};
+        action.sa_sigaction = handle_fault;
+        action.sa_flags = SA_SIGINFO | SA_ONSTACK;
+        sigemptyset(&action.sa_mask);
+
+        if (auto result = Core::System::sigaction(SIGSEGV, &action, &s_previous_segv_action); result.is_error()) {
+            dbgln("Wasm JIT: Couldn't install the trap handler: {}", result.error());
+            return false;
+        }
+        // Some platforms report accesses to inaccessible pages as bus errors.
+        if (auto result = Core::System::sigaction(SIGBUS, &action, &s_previous_bus_action); result.is_error()) {
+            dbgln("Wasm JIT: Couldn't install the trap handler: {}", result.error());
+            MUST(Core::System::sigaction(SIGSEGV, &s_previous_segv_action, nullptr));
+            return false;
+        }
+        return true;
+    }();
+    return installed;
+}
+
+#else
+
+bool install_trap_handler()
+{
+    return false;
+}
+
+#endif
+
+}
@@ -0,0 +1,23 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+namespace Wasm::JIT {
+
+struct NativeContext;
+
+// Native code doesn't check its accesses to a memory with a guard region. An access past the end of the memory faults
+// instead, and the handler installed here resumes the faulting function at its out-of-bounds exit.
+//
+// Returns false if faults can't be recovered from on this platform, in which case native code has to check its
+// memory accesses itself.
+bool install_trap_handler();
+
+// The context of the innermost native code running on this thread, whose faults the handler looks at.
+NativeContext*& running_native_context();
+
+}
@@ -706,10 +706,33 @@ public:
 
     auto& instructions() const { return m_instructions; }
 
+    // Where a branch (br, br_if, br_table, return, or the else at the end of an if's true arm) continues, resolved
+    // by the validator so the interpreter doesn't need to keep a stack of labels.
+    // The stack height is relative to the start of the frame's value stack, and the top `arity` values are kept.
+    struct BranchTarget {
+        InstructionPointer continuation;
+        u32 arity { 0 };
+        u32 stack_height { 0 };
+    };
+
+    // br_table has one target per label, followed by the default one.
+    BranchTarget const& branch_target(InstructionPointer ip, size_t index = 0) const
+    {
+        return m_branch_targets[m_first_branch_target_index[ip.value()] + index];
+    }
+
+    void set_branch_targets(Vector<BranchTarget> targets, Vector<u32> first_target_index)
+    {
+        m_branch_targets = move(targets);
+        m_first_branch_target_index = move(first_target_index);
+    }
+
     static ParseResult<Expression> parse(Stream& stream, Optional<size_t> size_hint = {});
 
 private:
     Vector<Instruction> m_instructions;
+    Vector<BranchTarget> m_branch_targets;
+    Vector<u32> m_first_branch_target_index;
 };
 
 class GlobalSection {
@@ -916,6 +939,7 @@ public:
     {
     }
 
+    auto& functions() { return m_functions; }
     auto& functions() const { return m_functions; }
 
     static ParseResult<CodeSection> parse(Stream& stream);
@@ -1031,6 +1055,10 @@ public:
 
     static ParseResult<NonnullRefPtr<Module>> parse(Stream& stream);
 
+    // The steps of parse() for a single section, for parsing a module whose bytes arrive in pieces.
+    static ParseResult<void> check_section_order(SectionId::SectionIdKind, SectionId::SectionIdKind& last_section_id);
+    ParseResult<void> parse_section_contents(SectionId::SectionIdKind, Stream&);
+
 private:
     void set_validation_status(ValidationStatus status) { m_validation_status = status; }
 
@@ -68,7 +68,7 @@ WebIDL::ExceptionOr<GC::Root<WebIDL::ArrayBufferView>> Crypto::get_random_values
     // FIXME: Handle SharedArrayBuffers
 
     // 3. Overwrite all elements of array with cryptographically strong random values of the appropriate type.
-    ::Crypto::fill_with_secure_random(array->viewed_array_buffer()->buffer().bytes().slice(array->byte_offset(), array->byte_length()));
+    ::Crypto::fill_with_secure_random(array->viewed_array_buffer()->buffer().slice(array->byte_offset(), array->byte_length()));
 
     // 4. Return array.
     return array;
@@ -719,7 +719,7 @@ GC::Ref<WebIDL::Promise> SubtleCrypto::derive_key(AlgorithmIdentifier algorithm,
         }
 
         // 15. Let result be the result of performing the import key operation specified by normalizedDerivedKeyAlgorithmImport using "raw" as format, secret as keyData, derivedKeyType as algorithm and using extractable and usages.
-        auto result_or_error = normalized_derived_key_algorithm_import.methods->import_key(*normalized_derived_key_algorithm_import.parameter, Bindings::KeyFormat::Raw, secret.release_value()->buffer(), extractable, key_usages);
+        auto result_or_error = normalized_derived_key_algorithm_import.methods->import_key(*normalized_derived_key_algorithm_import.parameter, Bindings::KeyFormat::Raw, MUST(ByteBuffer::copy(secret.release_value()->buffer())), extractable, key_usages);
         if (result_or_error.is_error()) {
             WebIDL::reject_promise(realm, promise, Bindings::exception_to_throw_completion(realm.vm(), result_or_error.release_error()).release_value().value());
             return;
@@ -827,7 +827,7 @@ GC::Ref<WebIDL::Promise> SubtleCrypto::wrap_key(Bindings::KeyFormat format, GC::
         // 13. If format is equal to the strings "raw", "pkcs8", or "spki":
         if (format == Bindings::KeyFormat::Raw || format == Bindings::KeyFormat::Pkcs8 || format == Bindings::KeyFormat::Spki) {
             // Set bytes be set to key.
-            bytes = as<JS::ArrayBuffer>(*key_data).buffer();
+            bytes = MUST(ByteBuffer::copy(as<JS::ArrayBuffer>(*key_data).buffer()));
         }
 
         // If format is equal to the string "jwk":
@@ -986,7 +986,7 @@ GC::Ref<WebIDL::Promise> SubtleCrypto::unwrap_key(Bindings::KeyFormat format, Ke
         // 14. If format is equal to the strings "raw", "pkcs8", or "spki":
         if (format == Bindings::KeyFormat::Raw || format == Bindings::KeyFormat::Pkcs8 || format == Bindings::KeyFormat::Spki) {
             // Set bytes be set to key.
-            bytes = key->buffer();
+            bytes = MUST(ByteBuffer::copy(key->buffer()));
         }
 
         // If format is equal to the string "jwk":
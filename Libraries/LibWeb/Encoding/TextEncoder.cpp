@@ -53,7 +53,7 @@ GC::Ref<JS::Uint8Array> TextEncoder::encode(String const& input) const
 // https://encoding.spec.whatwg.org/#dom-textencoder-encodeinto
 TextEncoderEncodeIntoResult TextEncoder::encode_into(String const& source, GC::Root<WebIDL::BufferSource> const& destination) const
 {
-    auto data = destination->viewed_array_buffer()->buffer().bytes().slice(destination->byte_offset(), destination->byte_length());
+    auto data = destination->viewed_array_buffer()->buffer().slice(destination->byte_offset(), destination->byte_length());
 
     // 1. Let read be 0.
     WebIDL::UnsignedLongLong read = 0;
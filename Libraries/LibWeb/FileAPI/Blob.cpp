@@ -388,7 +388,7 @@ GC::Ref<WebIDL::Promise> Blob::text()
     return WebIDL::upon_fulfillment(*promise, GC::create_function(heap(), [&vm](JS::Value first_argument) -> WebIDL::ExceptionOr<JS::Value> {
         auto const& object = first_argument.as_object();
         VERIFY(is<JS::ArrayBuffer>(object));
-        auto const& buffer = static_cast<const JS::ArrayBuffer&>(object).buffer();
+        auto buffer = static_cast<const JS::ArrayBuffer&>(object).buffer();
 
         auto decoder = TextCodec::decoder_for("UTF-8"sv);
         auto utf8_text = TRY_OR_THROW_OOM(vm, TextCodec::convert_input_to_utf8_using_given_decoder_unless_there_is_a_byte_order_mark(*decoder, buffer));
@@ -417,9 +417,9 @@ GC::Ref<WebIDL::Promise> Blob::array_buffer()
     return WebIDL::upon_fulfillment(*promise, GC::create_function(heap(), [&realm](JS::Value first_argument) -> WebIDL::ExceptionOr<JS::Value> {
         auto const& object = first_argument.as_object();
         VERIFY(is<JS::ArrayBuffer>(object));
-        auto const& buffer = static_cast<const JS::ArrayBuffer&>(object).buffer();
+        auto buffer = TRY_OR_THROW_OOM(realm.vm(), ByteBuffer::copy(static_cast<const JS::ArrayBuffer&>(object).buffer()));
 
-        return JS::ArrayBuffer::create(realm, buffer);
+        return JS::ArrayBuffer::create(realm, move(buffer));
     }));
 }
 
@@ -216,8 +216,19 @@ void EventLoop::process()
         }
     }
 
+    // NOTE: If the heap is in the middle of an incremental marking cycle, advance it by one bounded step
+    //       between tasks, and keep the event loop spinning until the cycle is done.
+    bool has_pending_incremental_marking = false;
+    if (heap().is_incremental_marking_in_progress()) {
+        heap().perform_incremental_marking_step();
+        has_pending_incremental_marking = heap().is_incremental_marking_in_progress();
+    } else if (!m_task_queue->has_runnable_tasks()) {
+        // Use idle time to destroy dead cells left behind by lazy sweeping.
+        heap().sweep_pending_blocks(GC::Heap::DEFAULT_INCREMENTAL_MARKING_STEP_BUDGET);
+    }
+
     // If there are eligible tasks in the queue, schedule a new round of processing. :^)
-    if (m_task_queue->has_runnable_tasks() || (!m_microtask_queue->is_empty() && !m_performing_a_microtask_checkpoint)) {
+    if (m_task_queue->has_runnable_tasks() || (!m_microtask_queue->is_empty() && !m_performing_a_microtask_checkpoint) || has_pending_incremental_marking) {
         schedule();
     }
 }
@@ -586,14 +586,14 @@ WebIDL::ExceptionOr<void> serialize_array_buffer(JS::VM& vm, Vector<u32>& vector
             //           [[ArrayBufferMaxByteLength]]: value.[[ArrayBufferMaxByteLength]],
             //           FIXME: [[AgentCluster]]: the surrounding agent's agent cluster }.
             serialize_enum(vector, ValueTag::GrowableSharedArrayBuffer);
-            TRY(serialize_bytes(vm, vector, array_buffer.buffer().bytes()));
+            TRY(serialize_bytes(vm, vector, array_buffer.buffer()));
             serialize_primitive_type(vector, array_buffer.max_byte_length());
         } else {
             // 4. Otherwise, set serialized to { [[Type]]: "SharedArrayBuffer", [[ArrayBufferData]]: value.[[ArrayBufferData]],
             //           [[ArrayBufferByteLength]]: value.[[ArrayBufferByteLength]],
             //           FIXME: [[AgentCluster]]: the surrounding agent's agent cluster }.
             serialize_enum(vector, ValueTag::SharedArrayBuffer);
-            TRY(serialize_bytes(vm, vector, array_buffer.buffer().bytes()));
+            TRY(serialize_bytes(vm, vector, array_buffer.buffer()));
         }
     }
 
@@ -617,13 +617,13 @@ WebIDL::ExceptionOr<void> serialize_array_buffer(JS::VM& vm, Vector<u32>& vector
         //    [[ArrayBufferData]]: dataCopy, [[ArrayBufferByteLength]]: size, [[ArrayBufferMaxByteLength]]: value.[[ArrayBufferMaxByteLength]] }.
         if (!array_buffer.is_fixed_length()) {
             serialize_enum(vector, ValueTag::ResizeableArrayBuffer);
-            TRY(serialize_bytes(vm, vector, data_copy.buffer().bytes()));
+            TRY(serialize_bytes(vm, vector, data_copy.buffer()));
             serialize_primitive_type(vector, array_buffer.max_byte_length());
         }
         // 6. Otherwise, set serialized to { [[Type]]: "ArrayBuffer", [[ArrayBufferData]]: dataCopy, [[ArrayBufferByteLength]]: size }.
         else {
             serialize_enum(vector, ValueTag::ArrayBuffer);
-            TRY(serialize_bytes(vm, vector, data_copy.buffer().bytes()));
+            TRY(serialize_bytes(vm, vector, data_copy.buffer()));
         }
     }
     return {};
@@ -805,7 +805,7 @@ public:
                 return WebIDL::DataCloneError::create(*realm, "out of memory"_string);
             auto bytes = bytes_or_error.release_value();
             JS::ArrayBuffer* buffer = TRY(JS::allocate_shared_array_buffer(m_vm, realm->intrinsics().shared_array_buffer_constructor(), bytes.size()));
-            bytes.span().copy_to(buffer->buffer().span());
+            bytes.span().copy_to(buffer->buffer());
             value = buffer;
             break;
         }
@@ -822,7 +822,7 @@ public:
             size_t max_byte_length = deserialize_primitive_type<size_t>(m_serialized, m_position);
             auto bytes = bytes_or_error.release_value();
             JS::ArrayBuffer* buffer = TRY(JS::allocate_shared_array_buffer(m_vm, realm->intrinsics().shared_array_buffer_constructor(), bytes.size()));
-            bytes.span().copy_to(buffer->buffer().span());
+            bytes.span().copy_to(buffer->buffer());
             buffer->set_max_byte_length(max_byte_length);
             value = buffer;
             break;
@@ -1239,7 +1239,7 @@ WebIDL::ExceptionOr<SerializedTransferRecord> structured_serialize_with_transfer
                 // 3. Set dataHolder.[[ArrayBufferByteLength]] to transferable.[[ArrayBufferByteLength]].
                 // 4. Set dataHolder.[[ArrayBufferMaxByteLength]] to transferable.[[ArrayBufferMaxByteLength]].
                 serialize_enum<TransferType>(data_holder.data, TransferType::ResizableArrayBuffer);
-                MUST(serialize_bytes(vm, data_holder.data, array_buffer->buffer().bytes())); // serializes both byte length and bytes
+                MUST(serialize_bytes(vm, data_holder.data, array_buffer->buffer())); // serializes both byte length and bytes
                 serialize_primitive_type<size_t>(data_holder.data, array_buffer->max_byte_length());
             }
 
@@ -1249,7 +1249,7 @@ WebIDL::ExceptionOr<SerializedTransferRecord> structured_serialize_with_transfer
                 // 2. Set dataHolder.[[ArrayBufferData]] to transferable.[[ArrayBufferData]].
                 // 3. Set dataHolder.[[ArrayBufferByteLength]] to transferable.[[ArrayBufferByteLength]].
                 serialize_enum<TransferType>(data_holder.data, TransferType::ArrayBuffer);
-                MUST(serialize_bytes(vm, data_holder.data, array_buffer->buffer().bytes())); // serializes both byte length and bytes
+                MUST(serialize_bytes(vm, data_holder.data, array_buffer->buffer())); // serializes both byte length and bytes
             }
 
             // 3. Perform ? DetachArrayBuffer(transferable).
@@ -1346,7 +1346,7 @@ WebIDL::ExceptionOr<DeserializedTransferRecord> structured_deserialize_with_tran
         if (type == TransferType::ArrayBuffer) {
             auto bytes = TRY(deserialize_bytes(vm, transfer_data_holder.data, data_holder_position));
             JS::ArrayBuffer* data = TRY(JS::allocate_array_buffer(vm, target_realm.intrinsics().array_buffer_constructor(), bytes.size()));
-            bytes.span().copy_to(data->buffer().span());
+            bytes.span().copy_to(data->buffer());
             value = JS::Value(data);
         }
 
@@ -1360,7 +1360,7 @@ WebIDL::ExceptionOr<DeserializedTransferRecord> structured_deserialize_with_tran
             auto max_byte_length = deserialize_primitive_type<size_t>(transfer_data_holder.data, data_holder_position);
             JS::ArrayBuffer* data = TRY(JS::allocate_array_buffer(vm, target_realm.intrinsics().array_buffer_constructor(), bytes.size()));
             data->set_max_byte_length(max_byte_length);
-            bytes.span().copy_to(data->buffer().span());
+            bytes.span().copy_to(data->buffer());
             value = JS::Value(data);
         }
 
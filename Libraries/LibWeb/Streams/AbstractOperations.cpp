@@ -3402,7 +3402,7 @@ WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> transfer_array_buffer(JS::Realm& r
 
     // 2. Let arrayBufferData be O.[[ArrayBufferData]].
     // 3. Let arrayBufferByteLength be O.[[ArrayBufferByteLength]].
-    auto array_buffer = buffer.buffer();
+    auto array_buffer = TRY_OR_THROW_OOM(vm, ByteBuffer::copy(buffer.buffer()));
 
     // 4. Perform ? DetachArrayBuffer(O).
     TRY(JS::detach_array_buffer(vm, buffer));
@@ -139,7 +139,7 @@ WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> Memory::create_a_fixed_length_memo
 
         // 2. Let buffer be a new SharedArrayBuffer with the internal slots [[ArrayBufferData]] and [[ArrayBufferByteLength]].
         array_buffer = TRY(JS::allocate_shared_array_buffer(vm, realm.intrinsics().shared_array_buffer_constructor(), bytes.size()));
-        bytes.span().copy_to(array_buffer->buffer().span());
+        bytes.copy_to(array_buffer->buffer());
         // 3. FIXME: Set buffer.[[ArrayBufferData]] to block.
         // 4. FIXME: Set buffer.[[ArrayBufferByteLength]] to the length of block.
 
@@ -149,7 +149,7 @@ WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> Memory::create_a_fixed_length_memo
 
     // 4. Otherwise,
     else {
-        array_buffer = JS::ArrayBuffer::create(realm, &memory->data());
+        array_buffer = JS::ArrayBuffer::create_with_external_storage(realm, memory->data());
         array_buffer->set_detach_key(JS::PrimitiveString::create(vm, "WebAssembly.Memory"_string));
     }
 
@@ -16,11 +16,13 @@
 #include <LibJS/Runtime/NativeFunction.h>
 #include <LibJS/Runtime/Object.h>
 #include <LibJS/Runtime/VM.h>
+#include <LibThreading/BackgroundAction.h>
+#include <LibWasm/AbstractMachine/StreamingCompiler.h>
 #include <LibWasm/AbstractMachine/Validator.h>
 #include <LibWeb/Bindings/ResponsePrototype.h>
+#include <LibWeb/Fetch/Infrastructure/HTTP/Bodies.h>
 #include <LibWeb/Fetch/Response.h>
 #include <LibWeb/HTML/Scripting/TemporaryExecutionContext.h>
-#include <LibWeb/Platform/EventLoopPlugin.h>
 #include <LibWeb/WebAssembly/Global.h>
 #include <LibWeb/WebAssembly/Instance.h>
 #include <LibWeb/WebAssembly/Memory.h>
@@ -33,7 +35,10 @@
 
 namespace Web::WebAssembly {
 
+bool g_jit_enabled = false;
+
 static GC::Ref<WebIDL::Promise> asynchronously_compile_webassembly_module(JS::VM&, ByteBuffer, HTML::Task::Source = HTML::Task::Source::Unspecified);
+static void settle_promise_with_compiled_module(JS::VM&, JS::Realm&, GC::Ref<WebIDL::Promise>, HTML::Task::Source, ErrorOr<NonnullRefPtr<Wasm::Module>, ByteString>);
 static GC::Ref<WebIDL::Promise> instantiate_promise_of_module(JS::VM&, GC::Ref<WebIDL::Promise>, GC::Ptr<JS::Object> import_object);
 static GC::Ref<WebIDL::Promise> asynchronously_instantiate_webassembly_module(JS::VM&, GC::Ref<Module>, GC::Ptr<JS::Object> import_object);
 static GC::Ref<WebIDL::Promise> compile_potential_webassembly_response(JS::VM&, GC::Ref<WebIDL::Promise>);
@@ -341,6 +346,9 @@ JS::ThrowCompletionOr<NonnullOwnPtr<Wasm::ModuleInstance>> instantiate_module(JS
         return vm.throw_completion<JS::TypeError>(MUST(builder.to_string()));
     }
 
+    if (g_jit_enabled)
+        cache.abstract_machine().enable_native_code_compilation();
+
     auto instance_result = cache.abstract_machine().instantiate(module, link_result.release_value());
     if (instance_result.is_error()) {
         // FIXME: Throw a LinkError instead.
@@ -353,19 +361,31 @@ JS::ThrowCompletionOr<NonnullOwnPtr<Wasm::ModuleInstance>> instantiate_module(JS
 // // https://webassembly.github.io/spec/js-api/#compile-a-webassembly-module
 JS::ThrowCompletionOr<NonnullRefPtr<CompiledWebAssemblyModule>> compile_a_webassembly_module(JS::VM& vm, ByteBuffer data)
 {
-    FixedMemoryStream stream { data.bytes() };
+    return finish_compiling_a_webassembly_module(vm, parse_and_validate_a_webassembly_module(data));
+}
+
+ErrorOr<NonnullRefPtr<Wasm::Module>, ByteString> parse_and_validate_a_webassembly_module(ReadonlyBytes data)
+{
+    FixedMemoryStream stream { data };
     auto module_result = Wasm::Module::parse(stream);
-    if (module_result.is_error()) {
+    if (module_result.is_error())
+        return Wasm::parse_error_to_byte_string(module_result.error());
+
+    if (auto validation_result = Wasm::AbstractMachine::validate(module_result.value()); validation_result.is_error())
+        return validation_result.release_error().error_string;
+
+    return module_result.release_value();
+}
+
+JS::ThrowCompletionOr<NonnullRefPtr<CompiledWebAssemblyModule>> finish_compiling_a_webassembly_module(JS::VM& vm, ErrorOr<NonnullRefPtr<Wasm::Module>, ByteString> module_or_error)
+{
+    if (module_or_error.is_error()) {
         // FIXME: Throw CompileError instead.
-        return vm.throw_completion<JS::TypeError>(Wasm::parse_error_to_byte_string(module_result.error()));
+        return vm.throw_completion<JS::TypeError>(module_or_error.release_error());
     }
 
     auto& cache = get_cache(*vm.current_realm());
-    if (auto validation_result = cache.abstract_machine().validate(module_result.value()); validation_result.is_error()) {
-        // FIXME: Throw CompileError instead.
-        return vm.throw_completion<JS::TypeError>(validation_result.error().error_string);
-    }
-    auto compiled_module = make_ref_counted<CompiledWebAssemblyModule>(module_result.release_value());
+    auto compiled_module = make_ref_counted<CompiledWebAssemblyModule>(module_or_error.release_value());
     cache.add_compiled_module(compiled_module);
     return compiled_module;
 }
@@ -564,6 +584,29 @@ JS::Value to_js_value(JS::VM& vm, Wasm::Value& wasm_value, Wasm::ValueType type)
 
 }
 
+// The realms and promises of the compilations running in the background. Only the event loop's thread touches these, so
+// that the roots are never created or destroyed on the background thread, which may well hold on to the action last.
+struct PendingCompilation {
+    GC::Root<JS::Realm> realm;
+    GC::Root<WebIDL::Promise> promise;
+    HTML::Task::Source task_source;
+};
+static HashMap<u64, PendingCompilation> s_pending_compilations;
+static u64 s_next_compilation_id = 0;
+
+static u64 begin_pending_compilation(JS::Realm& realm, GC::Ref<WebIDL::Promise> promise, HTML::Task::Source task_source)
+{
+    auto compilation_id = s_next_compilation_id++;
+    s_pending_compilations.set(compilation_id, { GC::make_root(realm), GC::make_root(promise), task_source });
+    return compilation_id;
+}
+
+static void finish_pending_compilation(JS::VM& vm, u64 compilation_id, ErrorOr<NonnullRefPtr<Wasm::Module>, ByteString> parse_result)
+{
+    auto compilation = s_pending_compilations.take(compilation_id).release_value();
+    settle_promise_with_compiled_module(vm, *compilation.realm, *compilation.promise, compilation.task_source, move(parse_result));
+}
+
 // https://webassembly.github.io/spec/js-api/#asynchronously-compile-a-webassembly-module
 GC::Ref<WebIDL::Promise> asynchronously_compile_webassembly_module(JS::VM& vm, ByteBuffer bytes, HTML::Task::Source task_source)
 {
@@ -573,35 +616,51 @@ GC::Ref<WebIDL::Promise> asynchronously_compile_webassembly_module(JS::VM& vm, B
     auto promise = WebIDL::create_promise(realm);
 
     // 2. Run the following steps in parallel:
-    Platform::EventLoopPlugin::the().deferred_invoke(GC::create_function(vm.heap(), [&vm, &realm, bytes = move(bytes), promise, task_source]() mutable {
-        HTML::TemporaryExecutionContext context(realm, HTML::TemporaryExecutionContext::CallbacksEnabled::Yes);
-        // 1. Compile the WebAssembly module bytes and store the result as module.
-        auto module_or_error = Detail::compile_a_webassembly_module(vm, move(bytes));
+    // NOTE: The module is parsed and validated on a background thread, which validates large code sections on a pool
+    //       of threads of its own. The rest happens back on the event loop once that's done.
+    auto compilation_id = begin_pending_compilation(realm, promise, task_source);
 
-        // 2. Queue a task to perform the following steps. If taskSource was provided, queue the task on that task source.
-        HTML::queue_a_task(task_source, nullptr, nullptr, GC::create_function(vm.heap(), [&realm, promise, module_or_error = move(module_or_error)]() mutable {
-            HTML::TemporaryExecutionContext context(realm, HTML::TemporaryExecutionContext::CallbacksEnabled::Yes);
-            auto& realm = HTML::relevant_realm(*promise->promise());
+    (void)Threading::BackgroundAction<ErrorOr<NonnullRefPtr<Wasm::Module>, ByteString>>::construct(
+        [bytes = move(bytes)](auto&) -> ErrorOr<ErrorOr<NonnullRefPtr<Wasm::Module>, ByteString>> {
+            return Detail::parse_and_validate_a_webassembly_module(bytes);
+        },
+        [&vm, compilation_id](ErrorOr<NonnullRefPtr<Wasm::Module>, ByteString> parse_result) -> ErrorOr<void> {
+            finish_pending_compilation(vm, compilation_id, move(parse_result));
+            return {};
+        });
 
-            // 1. If module is error, reject promise with a CompileError exception.
-            if (module_or_error.is_error()) {
-                WebIDL::reject_promise(realm, promise, module_or_error.error_value());
-            }
+    // 3. Return promise.
+    return promise;
+}
 
-            // 2. Otherwise,
-            else {
-                // 1. Construct a WebAssembly module object from module and bytes, and let moduleObject be the result.
-                // FIXME: Save bytes to the Module instance instead of moving into compile_a_webassembly_module
-                auto module_object = realm.create<Module>(realm, module_or_error.release_value());
+// Steps 2.1 and 2.2 of https://webassembly.github.io/spec/js-api/#asynchronously-compile-a-webassembly-module, given
+// the outcome of parsing and validating the module bytes.
+void settle_promise_with_compiled_module(JS::VM& vm, JS::Realm& realm, GC::Ref<WebIDL::Promise> promise, HTML::Task::Source task_source, ErrorOr<NonnullRefPtr<Wasm::Module>, ByteString> parse_result)
+{
+    HTML::TemporaryExecutionContext context(realm, HTML::TemporaryExecutionContext::CallbacksEnabled::Yes);
+    // 1. Compile the WebAssembly module bytes and store the result as module.
+    auto module_or_error = Detail::finish_compiling_a_webassembly_module(vm, move(parse_result));
 
-                // 2. Resolve promise with moduleObject.
-                WebIDL::resolve_promise(realm, promise, module_object);
-            }
-        }));
-    }));
+    // 2. Queue a task to perform the following steps. If taskSource was provided, queue the task on that task source.
+    HTML::queue_a_task(task_source, nullptr, nullptr, GC::create_function(vm.heap(), [&realm, promise, module_or_error = move(module_or_error)]() mutable {
+        HTML::TemporaryExecutionContext context(realm, HTML::TemporaryExecutionContext::CallbacksEnabled::Yes);
+        auto& realm = HTML::relevant_realm(*promise->promise());
 
-    // 3. Return promise.
-    return promise;
+        // 1. If module is error, reject promise with a CompileError exception.
+        if (module_or_error.is_error()) {
+            WebIDL::reject_promise(realm, promise, module_or_error.error_value());
+        }
+
+        // 2. Otherwise,
+        else {
+            // 1. Construct a WebAssembly module object from module and bytes, and let moduleObject be the result.
+            // FIXME: Save bytes to the Module instance instead of moving into compile_a_webassembly_module
+            auto module_object = realm.create<Module>(realm, module_or_error.release_value());
+
+            // 2. Resolve promise with moduleObject.
+            WebIDL::resolve_promise(realm, promise, module_object);
+        }
+    }));
 }
 
 // https://webassembly.github.io/spec/js-api/#asynchronously-instantiate-a-webassembly-module
@@ -764,42 +823,60 @@ GC::Ref<WebIDL::Promise> compile_potential_webassembly_response(JS::VM& vm, GC::
         }
 
         // 8. Consume response’s body as an ArrayBuffer, and let bodyPromise be the result.
-        auto body_promise_or_error = response_object.array_buffer();
-        if (body_promise_or_error.is_error()) {
-            auto throw_completion = Bindings::exception_to_throw_completion(realm.vm(), body_promise_or_error.release_error());
-            WebIDL::reject_promise(realm, return_value, *throw_completion.value());
+        // 9. Upon fulfillment of bodyPromise with value bodyArrayBuffer:
+        //     1. Let stableBytes be a copy of the bytes held by the buffer bodyArrayBuffer.
+        //     2. Asynchronously compile the WebAssembly module stableBytes using the networking task source and resolve returnValue with the result.
+        // 10. Upon rejection of bodyPromise with reason reason:
+        //     1. Reject returnValue with reason.
+        // NOTE: Rather than waiting for the whole body, the module is parsed and its function bodies are validated as the
+        //       chunks of the body come in, so that compiling it overlaps with downloading it. The chunks are handed to
+        //       the background thread, which works through them in the order they arrived; only the promise is settled
+        //       back on the event loop, once the compiler has seen the end of the body.
+        if (response_object.is_unusable()) {
+            WebIDL::reject_promise(realm, return_value, *vm.throw_completion<JS::TypeError>("Body is unusable"sv).value());
             return JS::js_undefined();
         }
-        auto body_promise = body_promise_or_error.release_value();
 
-        // 9. Upon fulfillment of bodyPromise with value bodyArrayBuffer:
-        auto body_fulfillment_steps = GC::create_function(vm.heap(), [&vm, return_value](JS::Value body_array_buffer) -> WebIDL::ExceptionOr<JS::Value> {
-            // 1. Let stableBytes be a copy of the bytes held by the buffer bodyArrayBuffer.
-            VERIFY(body_array_buffer.is_object());
-            auto stable_bytes = WebIDL::get_buffer_source_copy(body_array_buffer.as_object());
-            if (stable_bytes.is_error()) {
-                VERIFY(stable_bytes.error().code() == ENOMEM);
-                WebIDL::reject_promise(HTML::relevant_realm(*return_value->promise()), return_value, *vm.throw_completion<JS::InternalError>(vm.error_message(JS::VM::ErrorMessage::OutOfMemory)).value());
-                return JS::js_undefined();
-            }
+        auto compiler = make_ref_counted<Wasm::StreamingCompiler>();
+        auto compilation_id = begin_pending_compilation(realm, return_value, HTML::Task::Source::Networking);
 
-            // 2. Asynchronously compile the WebAssembly module stableBytes using the networking task source and resolve returnValue with the result.
-            auto result = asynchronously_compile_webassembly_module(vm, stable_bytes.release_value(), HTML::Task::Source::Networking);
-
-            // Need to manually convert WebIDL promise to an ECMAScript value here to resolve
-            WebIDL::resolve_promise(HTML::relevant_realm(*return_value->promise()), return_value, result->promise());
+        auto finish_compiling = [&vm, compiler, compilation_id] {
+            (void)Threading::BackgroundAction<ErrorOr<NonnullRefPtr<Wasm::Module>, ByteString>>::construct(
+                [compiler](auto&) -> ErrorOr<ErrorOr<NonnullRefPtr<Wasm::Module>, ByteString>> {
+                    return compiler->finish();
+                },
+                [&vm, compilation_id](ErrorOr<NonnullRefPtr<Wasm::Module>, ByteString> parse_result) -> ErrorOr<void> {
+                    finish_pending_compilation(vm, compilation_id, move(parse_result));
+                    return {};
+                });
+        };
 
+        auto body = response_object.body_impl();
+        if (!body) {
+            finish_compiling();
             return JS::js_undefined();
+        }
+
+        auto process_body_chunk = GC::create_function(vm.heap(), [compiler](ByteBuffer chunk) {
+            (void)Threading::BackgroundAction<Empty>::construct(
+                [compiler, chunk = move(chunk)](auto&) -> ErrorOr<Empty> {
+                    // NOTE: Once the module is known to be invalid, the rest of the body is skipped over, and the error
+                    //       is reported at the end of it.
+                    (void)compiler->append(chunk.bytes());
+                    return Empty {};
+                },
+                nullptr);
         });
 
-        // 10. Upon rejection of bodyPromise with reason reason:
-        auto body_rejection_steps = GC::create_function(vm.heap(), [return_value](JS::Value reason) -> WebIDL::ExceptionOr<JS::Value> {
-            // 1. Reject returnValue with reason.
-            WebIDL::reject_promise(HTML::relevant_realm(*return_value->promise()), return_value, reason);
-            return JS::js_undefined();
+        auto process_end_of_body = GC::create_function(vm.heap(), move(finish_compiling));
+
+        auto process_body_error = GC::create_function(vm.heap(), [compilation_id](JS::Value reason) {
+            // NOTE: Whatever chunks are still queued up are parsed to no end, since nothing asks for the module anymore.
+            auto compilation = s_pending_compilations.take(compilation_id).release_value();
+            WebIDL::reject_promise(*compilation.realm, *compilation.promise, reason);
         });
 
-        WebIDL::react_to_promise(body_promise, body_fulfillment_steps, body_rejection_steps);
+        body->incrementally_read(process_body_chunk, process_end_of_body, process_body_error, GC::Ref<JS::Object> { HTML::relevant_global_object(response_object) });
 
         return JS::js_undefined();
     });
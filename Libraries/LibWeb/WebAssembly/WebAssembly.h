@@ -18,6 +18,9 @@
 
 namespace Web::WebAssembly {
 
+// Whether the functions of instantiated modules are compiled to native code.
+extern bool g_jit_enabled;
+
 void visit_edges(JS::Object&, JS::Cell::Visitor&);
 void finalize(JS::Object&);
 
@@ -87,6 +90,10 @@ WebAssemblyCache& get_cache(JS::Realm&);
 
 JS::ThrowCompletionOr<NonnullOwnPtr<Wasm::ModuleInstance>> instantiate_module(JS::VM&, Wasm::Module const&, GC::Ptr<JS::Object> import_object);
 JS::ThrowCompletionOr<NonnullRefPtr<CompiledWebAssemblyModule>> compile_a_webassembly_module(JS::VM&, ByteBuffer);
+// Parsing and validation don't touch the JS heap, so they may run off the main thread; the module is then added to
+// the realm's cache on the main thread.
+ErrorOr<NonnullRefPtr<Wasm::Module>, ByteString> parse_and_validate_a_webassembly_module(ReadonlyBytes);
+JS::ThrowCompletionOr<NonnullRefPtr<CompiledWebAssemblyModule>> finish_compiling_a_webassembly_module(JS::VM&, ErrorOr<NonnullRefPtr<Wasm::Module>, ByteString>);
 JS::NativeFunction* create_native_function(JS::VM&, Wasm::FunctionAddress address, ByteString const& name, Instance* instance = nullptr);
 JS::ThrowCompletionOr<Wasm::Value> to_webassembly_value(JS::VM&, JS::Value value, Wasm::ValueType const& type);
 Wasm::Value default_webassembly_value(JS::VM&, Wasm::ValueType type);
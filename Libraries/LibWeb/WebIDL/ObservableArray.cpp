@@ -62,7 +62,7 @@ JS::ThrowCompletionOr<void> ObservableArray::append(JS::Value value)
 {
     if (m_on_set_an_indexed_value)
         TRY(Bindings::throw_dom_exception_if_needed(vm(), [&] { return m_on_set_an_indexed_value->function()(value); }));
-    indexed_properties().append(value);
+    append_indexed_direct(value);
     return {};
 }
 
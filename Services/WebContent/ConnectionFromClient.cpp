@@ -11,7 +11,10 @@
 
 #include <AK/JsonObject.h>
 #include <AK/QuickSort.h>
+#include <LibCore/DateTime.h>
 #include <LibCore/EventLoop.h>
+#include <LibCore/File.h>
+#include <LibCore/StandardPaths.h>
 #include <LibGC/Heap.h>
 #include <LibGfx/Bitmap.h>
 #include <LibGfx/Font/FontDatabase.h>
@@ -324,6 +327,37 @@ void ConnectionFromClient::debug_request(u64 page_id, ByteString request, ByteSt
         return;
     }
 
+    if (request == "dump-gc-heap-snapshot") {
+        // NOTE: Like above, we collect garbage first so that the snapshot only contains cells that are actually live.
+        Core::deferred_invoke([path = argument]() mutable {
+            auto& heap = Web::Bindings::main_thread_vm().heap();
+            heap.collect_garbage();
+
+            auto result = [&]() -> ErrorOr<void> {
+                if (path.is_empty()) {
+                    auto file_name = TRY(Core::DateTime::now().to_string("gc-heap-snapshot-%Y-%m-%d-%H-%M-%S.bin"sv));
+                    path = LexicalPath::join(Core::StandardPaths::tempfile_directory(), file_name).string();
+                }
+                auto file = TRY(Core::File::open(path, Core::File::OpenMode::Write));
+                auto buffered_file = TRY(Core::OutputBufferedFile::create(move(file)));
+                TRY(heap.write_snapshot(*buffered_file));
+                TRY(buffered_file->flush_buffer());
+                return {};
+            }();
+            if (result.is_error())
+                dbgln("Failed to write GC heap snapshot to {}: {}", path, result.error());
+            else
+                dbgln("Wrote GC heap snapshot to {}", path);
+        });
+        return;
+    }
+
+    if (request == "sample-gc-allocations") {
+        auto interval = argument.to_number<size_t>().value_or(0);
+        Web::Bindings::main_thread_vm().set_allocation_sampling_interval(interval);
+        return;
+    }
+
     if (request == "set-line-box-borders") {
         bool state = argument == "on";
         page->set_should_show_line_box_borders(state);
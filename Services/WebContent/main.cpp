@@ -14,7 +14,9 @@
 #include <LibGfx/Font/FontDatabase.h>
 #include <LibGfx/Font/PathFontProvider.h>
 #include <LibIPC/ConnectionFromClient.h>
+#include <LibJS/Bytecode/ExecutableCache.h>
 #include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/JIT/Compiler.h>
 #include <LibMain/Main.h>
 #include <LibMedia/Audio/Loader.h>
 #include <LibRequests/RequestClient.h>
@@ -28,6 +30,7 @@
 #include <LibWeb/PermissionsPolicy/AutoplayAllowlist.h>
 #include <LibWeb/Platform/AudioCodecPluginAgnostic.h>
 #include <LibWeb/Platform/EventLoopPluginSerenity.h>
+#include <LibWeb/WebAssembly/WebAssembly.h>
 #include <LibWebView/Plugins/FontPlugin.h>
 #include <LibWebView/Plugins/ImageCodecPlugin.h>
 #include <LibWebView/Utilities.h>
@@ -105,10 +108,15 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     bool force_cpu_painting = false;
     bool force_fontconfig = false;
     bool collect_garbage_on_every_allocation = false;
+    bool parallel_gc_marking = false;
+    bool incremental_gc_marking = false;
+    bool generational_gc = false;
+    bool measure_conservative_roots = false;
     bool is_headless = false;
     bool disable_scrollbar_painting = false;
     bool devtools = false;
     StringView echo_server_port_string_view {};
+    StringView bytecode_cache_directory {};
 
     Core::ArgsParser args_parser;
     args_parser.add_option(command_line, "Chrome process command line", "command-line", 0, "command_line");
@@ -127,6 +135,13 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     args_parser.add_option(force_cpu_painting, "Force CPU painting", "force-cpu-painting");
     args_parser.add_option(force_fontconfig, "Force using fontconfig for font loading", "force-fontconfig");
     args_parser.add_option(collect_garbage_on_every_allocation, "Collect garbage after every JS heap allocation", "collect-garbage-on-every-allocation");
+    args_parser.add_option(parallel_gc_marking, "Mark the JS heap on multiple threads", "parallel-gc-marking");
+    args_parser.add_option(incremental_gc_marking, "Mark the JS heap incrementally between event loop tasks", "incremental-gc-marking");
+    args_parser.add_option(generational_gc, "Collect short-lived JS cells in a GC nursery", "generational-gc");
+    args_parser.add_option(measure_conservative_roots, "Report how many JS cells each GC retains only through conservative roots", "measure-conservative-roots");
+    args_parser.add_option(JS::JIT::g_jit_enabled, "Compile hot JS functions to native code", "enable-jit");
+    args_parser.add_option(Web::WebAssembly::g_jit_enabled, "Compile WebAssembly functions to native code", "enable-wasm-jit");
+    args_parser.add_option(bytecode_cache_directory, "Cache the bytecode of scripts in this directory", "bytecode-cache-directory", 0, "path");
     args_parser.add_option(disable_scrollbar_painting, "Don't paint horizontal or vertical viewport scrollbars", "disable-scrollbar-painting");
     args_parser.add_option(echo_server_port_string_view, "Echo server port used in test internals", "echo-server-port", 0, "echo_server_port");
     args_parser.add_option(is_headless, "Report that the browser is running in headless mode", "headless");
@@ -165,6 +180,9 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
 
     Web::Painting::g_paint_viewport_scrollbars = !disable_scrollbar_painting;
 
+    if (!bytecode_cache_directory.is_empty())
+        JS::Bytecode::ExecutableCache::set_directory(bytecode_cache_directory);
+
     if (!echo_server_port_string_view.is_empty()) {
         if (auto maybe_echo_server_port = echo_server_port_string_view.to_number<u16>(); maybe_echo_server_port.has_value())
             Web::Internals::Internals::set_echo_server_port(maybe_echo_server_port.value());
@@ -195,6 +213,16 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     if (collect_garbage_on_every_allocation)
         Web::Bindings::main_thread_vm().heap().set_should_collect_on_every_allocation(true);
 
+    if (parallel_gc_marking)
+        Web::Bindings::main_thread_vm().heap().set_parallel_marking_enabled(true);
+
+    if (incremental_gc_marking)
+        Web::Bindings::main_thread_vm().heap().set_incremental_marking_enabled(true);
+    if (generational_gc)
+        Web::Bindings::main_thread_vm().heap().set_generational_collection_enabled(true);
+    if (measure_conservative_roots)
+        Web::Bindings::main_thread_vm().heap().set_conservative_retention_measurement_enabled(true);
+
     TRY(initialize_resource_loader(Web::Bindings::main_thread_vm().heap(), request_server_socket));
 
     if (log_all_js_exceptions) {
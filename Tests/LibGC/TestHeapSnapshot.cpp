@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Endian.h>
+#include <AK/HashMap.h>
+#include <AK/HashTable.h>
+#include <AK/Memory.h>
+#include <AK/MemoryStream.h>
+#include <AK/String.h>
+#include <AK/Vector.h>
+#include <LibGC/Cell.h>
+#include <LibGC/CellAllocator.h>
+#include <LibGC/Heap.h>
+#include <LibGC/HeapRoot.h>
+#include <LibGC/Root.h>
+#include <LibTest/TestCase.h>
+
+namespace {
+
+class SnapshotCell final : public GC::Cell {
+    GC_CELL(SnapshotCell, GC::Cell);
+    GC_DECLARE_ALLOCATOR(SnapshotCell);
+
+public:
+    GC::Ptr<GC::Cell> first;
+    GC::Ptr<GC::Cell> second;
+
+    virtual void visit_edges(Visitor& visitor) override
+    {
+        Base::visit_edges(visitor);
+        visitor.visit(first);
+        visitor.visit(second);
+    }
+};
+
+GC_DEFINE_ALLOCATOR(SnapshotCell);
+
+class LargeSnapshotCell final : public GC::Cell {
+    GC_CELL(LargeSnapshotCell, GC::Cell);
+    GC_DECLARE_ALLOCATOR(LargeSnapshotCell);
+
+public:
+    u8 payload[200] {};
+};
+
+GC_DEFINE_ALLOCATOR(LargeSnapshotCell);
+
+struct SnapshotRecord {
+    ByteString class_name;
+    u32 cell_size { 0 };
+    u8 root_type { 0 };
+    Optional<ByteString> allocation_site;
+    HashTable<FlatPtr> edges;
+};
+
+constexpr u32 no_allocation_site = 0xffffffff;
+
+}
+
+static GC::Heap& heap()
+{
+    static GC::Heap heap(nullptr, [](auto&) {});
+    return heap;
+}
+
+// Cells are found by scanning the stack conservatively, so pointers to them left behind in dead stack
+// frames would keep them alive.
+NEVER_INLINE static void clear_stack()
+{
+    u8 buffer[16 * KiB];
+    secure_zero(buffer, sizeof(buffer));
+}
+
+// Reads a snapshot back in, keyed by cell address.
+static HashMap<FlatPtr, SnapshotRecord> take_snapshot()
+{
+    AllocatingMemoryStream stream;
+    MUST(heap().write_snapshot(stream));
+
+    auto read_u32 = [&] { return static_cast<u32>(MUST(stream.read_value<LittleEndian<u32>>())); };
+    auto read_u64 = [&] { return static_cast<u64>(MUST(stream.read_value<LittleEndian<u64>>())); };
+
+    u8 magic[4];
+    MUST(stream.read_until_filled({ magic, sizeof(magic) }));
+    EXPECT_EQ(StringView(magic, sizeof(magic)), "LGCS"sv);
+    EXPECT_EQ(read_u32(), 1u);
+
+    Vector<ByteString> strings;
+    auto string_count = read_u32();
+    for (u32 i = 0; i < string_count; ++i) {
+        auto length = read_u32();
+        auto bytes = MUST(ByteBuffer::create_uninitialized(length));
+        MUST(stream.read_until_filled(bytes));
+        strings.append(ByteString(bytes.bytes()));
+    }
+
+    HashMap<FlatPtr, SnapshotRecord> records;
+    auto cell_count = read_u64();
+    for (u64 i = 0; i < cell_count; ++i) {
+        auto address = static_cast<FlatPtr>(read_u64());
+        SnapshotRecord record;
+        record.class_name = strings[read_u32()];
+        record.cell_size = read_u32();
+        record.root_type = MUST(stream.read_value<u8>());
+        if (auto site = read_u32(); site != no_allocation_site)
+            record.allocation_site = strings[site];
+        auto edge_count = read_u32();
+        for (u32 j = 0; j < edge_count; ++j)
+            record.edges.set(static_cast<FlatPtr>(read_u64()));
+        records.set(address, move(record));
+    }
+    EXPECT(stream.is_eof());
+    return records;
+}
+
+static FlatPtr address_of(GC::Cell const& cell)
+{
+    return bit_cast<FlatPtr>(&cell);
+}
+
+TEST_CASE(snapshot_contains_cells_with_their_class_names_sizes_and_edges)
+{
+    clear_stack();
+    heap().collect_garbage();
+
+    // root -> middle -> (leaf, large), and leaf -> root to close a cycle.
+    auto root = GC::make_root(heap().allocate<SnapshotCell>());
+    auto middle = heap().allocate<SnapshotCell>();
+    auto leaf = heap().allocate<SnapshotCell>();
+    auto large = heap().allocate<LargeSnapshotCell>();
+    root->first = middle;
+    middle->first = leaf;
+    middle->second = large;
+    leaf->first = root.ptr();
+
+    auto records = take_snapshot();
+    EXPECT_EQ(records.size(), 4u);
+
+    auto root_record = records.get(address_of(*root));
+    auto middle_record = records.get(address_of(*middle));
+    auto leaf_record = records.get(address_of(*leaf));
+    auto large_record = records.get(address_of(*large));
+    VERIFY(root_record.has_value() && middle_record.has_value() && leaf_record.has_value() && large_record.has_value());
+
+    EXPECT_EQ(root_record->class_name, "SnapshotCell"sv);
+    EXPECT_EQ(large_record->class_name, "LargeSnapshotCell"sv);
+    EXPECT_EQ(root_record->cell_size, sizeof(SnapshotCell));
+    EXPECT_EQ(large_record->cell_size, sizeof(LargeSnapshotCell));
+
+    EXPECT_EQ(root_record->root_type, to_underlying(GC::HeapRoot::Type::Root));
+
+    EXPECT_EQ(root_record->edges.size(), 1u);
+    EXPECT(root_record->edges.contains(address_of(*middle)));
+    EXPECT_EQ(middle_record->edges.size(), 2u);
+    EXPECT(middle_record->edges.contains(address_of(*leaf)));
+    EXPECT(middle_record->edges.contains(address_of(*large)));
+    EXPECT_EQ(leaf_record->edges.size(), 1u);
+    EXPECT(leaf_record->edges.contains(address_of(*root)));
+    EXPECT(large_record->edges.is_empty());
+
+    EXPECT(!root_record->allocation_site.has_value());
+}
+
+NEVER_INLINE static void allocate_sampled_cells(Vector<GC::Root<SnapshotCell>>& cells, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+        cells.append(GC::make_root(heap().allocate<SnapshotCell>()));
+}
+
+TEST_CASE(every_nth_allocation_is_sampled_until_the_cell_dies)
+{
+    clear_stack();
+    heap().collect_garbage();
+
+    size_t captured_sites = 0;
+    heap().set_allocation_sampling(3, [&] {
+        return MUST(String::formatted("site {}", ++captured_sites));
+    });
+
+    Vector<GC::Root<SnapshotCell>> cells;
+    allocate_sampled_cells(cells, 10);
+    EXPECT_EQ(captured_sites, 3u);
+
+    auto records = take_snapshot();
+    for (size_t i = 0; i < cells.size(); ++i) {
+        auto record = records.get(address_of(*cells[i]));
+        VERIFY(record.has_value());
+        if ((i + 1) % 3 == 0)
+            EXPECT_EQ(record->allocation_site, ByteString::formatted("site {}", (i + 1) / 3));
+        else
+            EXPECT(!record->allocation_site.has_value());
+    }
+
+    // Samples are dropped along with their cells.
+    cells.clear();
+    clear_stack();
+    heap().collect_garbage();
+    for (auto const& it : take_snapshot())
+        EXPECT(!it.value.allocation_site.has_value());
+
+    heap().set_allocation_sampling(0, {});
+}
@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/HashTable.h>
+#include <AK/Memory.h>
+#include <AK/Vector.h>
+#include <AK/WeakPtr.h>
+#include <LibGC/Cell.h>
+#include <LibGC/CellAllocator.h>
+#include <LibGC/Heap.h>
+#include <LibGC/HeapBlock.h>
+#include <LibGC/Root.h>
+#include <LibGC/WeakContainer.h>
+#include <LibTest/TestCase.h>
+
+namespace {
+
+size_t s_destroyed_cells = 0;
+
+class LazilySweptCell final : public GC::Cell {
+    GC_CELL(LazilySweptCell, GC::Cell);
+    GC_DECLARE_ALLOCATOR(LazilySweptCell);
+    GC_ALLOW_LAZY_SWEEP(LazilySweptCell);
+
+public:
+    virtual ~LazilySweptCell() override { ++s_destroyed_cells; }
+
+    GC::Ptr<LazilySweptCell> next;
+
+    virtual void visit_edges(Visitor& visitor) override
+    {
+        Base::visit_edges(visitor);
+        visitor.visit(next);
+    }
+};
+
+GC_DEFINE_ALLOCATOR(LazilySweptCell);
+
+class TestWeakSet final : public GC::WeakContainer {
+public:
+    explicit TestWeakSet(GC::Heap& heap)
+        : WeakContainer(heap)
+    {
+    }
+
+    virtual void remove_dead_cells(Badge<GC::Heap>) override
+    {
+        cells.remove_all_matching([](auto* cell) { return cell->state() != GC::Cell::State::Live; });
+    }
+
+    HashTable<GC::Cell*> cells;
+};
+
+}
+
+static GC::Heap& heap()
+{
+    static GC::Heap heap(nullptr, [](auto&) {});
+    return heap;
+}
+
+// Cells are found by scanning the stack conservatively, so pointers to them left behind in dead stack
+// frames would keep them alive.
+NEVER_INLINE static void clear_stack()
+{
+    u8 buffer[16 * KiB];
+    secure_zero(buffer, sizeof(buffer));
+}
+
+// Starts a test case with lazy sweeping enabled, and without cells from earlier test cases left pending sweep.
+NEVER_INLINE static void start_with_nothing_pending_sweep()
+{
+    clear_stack();
+    heap().set_lazy_sweeping_enabled(true);
+    heap().collect_garbage();
+    heap().sweep_pending_blocks(AK::Duration::from_seconds(1));
+    s_destroyed_cells = 0;
+}
+
+// Allocates cells that are only kept alive by the given roots, one for every block the cells end up in.
+NEVER_INLINE static void allocate_cells(HashTable<FlatPtr>& blocks, Vector<GC::Root<LazilySweptCell>>* survivors, size_t cell_count)
+{
+    for (size_t i = 0; i < cell_count; ++i) {
+        auto cell = heap().allocate<LazilySweptCell>();
+        auto result = blocks.set(bit_cast<FlatPtr>(GC::HeapBlock::from_cell(cell.ptr())));
+        if (survivors && result == HashSetResult::InsertedNewEntry)
+            survivors->append(GC::make_root(cell));
+    }
+}
+
+// Leaves every block of LazilySweptCells pending sweep, with nothing but dead cells in it apart from the survivors.
+NEVER_INLINE static void leave_blocks_pending_sweep(HashTable<FlatPtr>& blocks, Vector<GC::Root<LazilySweptCell>>* survivors, size_t cell_count)
+{
+    allocate_cells(blocks, survivors, cell_count);
+    clear_stack();
+    heap().collect_garbage();
+}
+
+// Stale pointers left on the stack by earlier test cases may keep a few of the cells alive, so tests count the dead ones.
+static size_t count_cells_pending_sweep(HashTable<FlatPtr> const& blocks)
+{
+    size_t count = 0;
+    for (auto block : blocks)
+        bit_cast<GC::HeapBlock*>(block)->for_each_cell_in_state<GC::Cell::State::PendingSweep>([&](auto*) { ++count; });
+    return count;
+}
+
+TEST_CASE(allocation_reuses_blocks_pending_sweep)
+{
+    start_with_nothing_pending_sweep();
+
+    HashTable<FlatPtr> blocks;
+    Vector<GC::Root<LazilySweptCell>> survivors;
+    leave_blocks_pending_sweep(blocks, &survivors, 1000);
+    EXPECT(blocks.size() > 1);
+    EXPECT(heap().may_have_blocks_pending_sweep());
+    EXPECT_EQ(s_destroyed_cells, 0u);
+
+    // The allocator sweeps a pending block and allocates into the space freed up there instead of creating a new block.
+    auto cell = heap().allocate<LazilySweptCell>();
+    EXPECT(blocks.contains(bit_cast<FlatPtr>(GC::HeapBlock::from_cell(cell.ptr()))));
+    EXPECT(s_destroyed_cells > 0);
+    EXPECT(s_destroyed_cells < 1000 - survivors.size());
+
+    heap().collect_garbage();
+}
+
+NEVER_INLINE static WeakPtr<LazilySweptCell> allocate_weakly_held_cell(TestWeakSet& weak_set)
+{
+    auto cell = heap().allocate<LazilySweptCell>();
+    weak_set.cells.set(cell);
+    return cell->make_weak_ptr<LazilySweptCell>();
+}
+
+TEST_CASE(weak_references_are_cleared_before_the_cell_is_swept)
+{
+    start_with_nothing_pending_sweep();
+
+    TestWeakSet weak_set(heap());
+    auto weak_cell = allocate_weakly_held_cell(weak_set);
+    clear_stack();
+
+    heap().collect_garbage();
+    EXPECT_EQ(s_destroyed_cells, 0u);
+    EXPECT(heap().may_have_blocks_pending_sweep());
+    EXPECT(!weak_cell);
+    EXPECT(weak_set.cells.is_empty());
+
+    heap().sweep_pending_blocks(AK::Duration::from_seconds(1));
+    EXPECT(s_destroyed_cells >= 1u);
+    EXPECT(!heap().may_have_blocks_pending_sweep());
+}
+
+// Returns the cell's address inverted, so that it doesn't look like a pointer to the conservative scan.
+NEVER_INLINE static FlatPtr allocate_unreachable_cell()
+{
+    return ~bit_cast<FlatPtr>(heap().allocate<LazilySweptCell>().ptr());
+}
+
+TEST_CASE(conservative_roots_into_blocks_pending_sweep_are_ignored)
+{
+    heap().set_generational_collection_enabled(true);
+    start_with_nothing_pending_sweep();
+
+    auto inverted_address = allocate_unreachable_cell();
+    clear_stack();
+    heap().collect_garbage();
+    EXPECT_EQ(s_destroyed_cells, 0u);
+
+    // The dead cell's address is on the stack from here on, and must not bring it back to life.
+    FlatPtr volatile address = ~inverted_address;
+
+    // A minor collection gathers conservative roots while the cell is still pending sweep.
+    heap().collect_young_garbage();
+    EXPECT_EQ(bit_cast<GC::Cell*>(static_cast<FlatPtr>(address))->state(), GC::Cell::State::PendingSweep);
+
+    // So does a major collection, which only sweeps pending blocks after marking.
+    heap().collect_garbage();
+    EXPECT_EQ(s_destroyed_cells, 1u);
+
+    heap().set_generational_collection_enabled(false);
+}
+
+TEST_CASE(full_collection_sweeps_pending_blocks_first)
+{
+    start_with_nothing_pending_sweep();
+
+    auto survivor = GC::make_root(heap().allocate<LazilySweptCell>());
+    HashTable<FlatPtr> blocks;
+    leave_blocks_pending_sweep(blocks, nullptr, 1000);
+    EXPECT(heap().may_have_blocks_pending_sweep());
+    EXPECT_EQ(s_destroyed_cells, 0u);
+    auto dead_cells = count_cells_pending_sweep(blocks);
+    EXPECT(dead_cells > 900u);
+
+    // Cells that only died in this collection would be left pending sweep again.
+    heap().collect_garbage();
+    EXPECT(!heap().may_have_blocks_pending_sweep());
+    EXPECT(s_destroyed_cells >= dead_cells);
+    EXPECT_EQ(survivor->state(), GC::Cell::State::Live);
+}
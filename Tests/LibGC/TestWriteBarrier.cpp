@@ -0,0 +1,323 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/HashMap.h>
+#include <AK/Memory.h>
+#include <AK/Vector.h>
+#include <AK/WeakPtr.h>
+#include <LibGC/Cell.h>
+#include <LibGC/CellAllocator.h>
+#include <LibGC/Heap.h>
+#include <LibGC/HeapRoot.h>
+#include <LibGC/NanBoxedValue.h>
+#include <LibGC/Root.h>
+#include <LibGC/WriteBarrier.h>
+#include <LibThreading/Thread.h>
+#include <LibTest/TestCase.h>
+
+namespace {
+
+// A minimal NaN-boxed value that can only hold a cell, like a JS::Value holding an object.
+class TestValue : public GC::NanBoxedValue {
+public:
+    explicit TestValue(GC::Cell& cell)
+    {
+        m_value.encoded = GC::SHIFTED_IS_CELL_PATTERN | (bit_cast<u64>(&cell) & 0x0000ffffffffffffULL);
+    }
+};
+
+class TestCell final : public GC::Cell {
+    GC_CELL(TestCell, GC::Cell);
+    GC_DECLARE_ALLOCATOR(TestCell);
+
+public:
+    // Stores into a cell that may have been around for a while go through the write barrier.
+    void set_other(TestCell& cell)
+    {
+        other = cell;
+        GC::write_barrier(*this, &cell);
+    }
+
+    void append_child(TestCell& cell)
+    {
+        children.append(cell);
+        GC::write_barrier(*this, &cell);
+    }
+
+    void set_child(u32 id, TestCell& cell)
+    {
+        children_by_id.set(id, cell);
+        GC::write_barrier(*this, &cell);
+    }
+
+    void append_value(TestValue value)
+    {
+        values.append(value);
+        GC::write_barrier(*this, value);
+    }
+
+    void append_values_without_barrier(TestCell& cell, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+            values.append(TestValue { cell });
+    }
+
+    // Overwriting or removing pointers never needs the write barrier.
+    void clear_stored_cells()
+    {
+        other = nullptr;
+        children.clear();
+        children_by_id.clear();
+        values.clear();
+    }
+
+    GC::Ptr<TestCell> next;
+    GC::Ptr<TestCell> other;
+    Vector<GC::Ref<TestCell>> children;
+    HashMap<u32, GC::Ptr<TestCell>> children_by_id;
+    Vector<TestValue> values;
+
+    virtual void visit_edges(Visitor& visitor) override
+    {
+        Base::visit_edges(visitor);
+        visitor.visit(next);
+        visitor.visit(other);
+        visitor.visit(children);
+        visitor.visit(children_by_id);
+        for (auto const& value : values)
+            visitor.visit(value);
+    }
+};
+
+GC_DEFINE_ALLOCATOR(TestCell);
+
+enum class StoreKind {
+    PtrMember,
+    VectorAppend,
+    HashMapSet,
+    NanBoxedValueAppend,
+    // Several stores followed by a single barrier for the whole cell, like when saving a suspended function's registers.
+    WholeCell,
+};
+
+constexpr StoreKind all_store_kinds[] = { StoreKind::PtrMember, StoreKind::VectorAppend, StoreKind::HashMapSet, StoreKind::NanBoxedValueAppend, StoreKind::WholeCell };
+
+}
+
+// Stands in for the registers of a running function, which the embedder gathers as roots on every collection.
+static Vector<GC::Ptr<TestCell>> s_registers;
+
+static GC::Heap& heap()
+{
+    static GC::Heap heap(nullptr, [](auto& roots) {
+        for (auto cell : s_registers) {
+            if (cell)
+                roots.set(cell, GC::HeapRoot { .type = GC::HeapRoot::Type::VM });
+        }
+    });
+    return heap;
+}
+
+NEVER_INLINE static void store(TestCell& holder, TestCell& cell, StoreKind kind)
+{
+    switch (kind) {
+    case StoreKind::PtrMember:
+        holder.set_other(cell);
+        break;
+    case StoreKind::VectorAppend:
+        holder.append_child(cell);
+        break;
+    case StoreKind::HashMapSet:
+        holder.set_child(1, cell);
+        break;
+    case StoreKind::NanBoxedValueAppend:
+        holder.append_value(TestValue { cell });
+        break;
+    case StoreKind::WholeCell:
+        holder.append_values_without_barrier(cell, 3);
+        GC::write_barrier(holder);
+        break;
+    }
+}
+
+// Cells are found by scanning the stack conservatively, so pointers to them left behind in dead stack
+// frames would keep them alive, and hide a missing write barrier.
+NEVER_INLINE static void clear_stack()
+{
+    u8 buffer[16 * KiB];
+    secure_zero(buffer, sizeof(buffer));
+}
+
+// Links a chain of cells to the holder's next pointer, and returns a weak pointer to its last cell.
+NEVER_INLINE static WeakPtr<TestCell> build_chain(TestCell& holder, size_t length)
+{
+    auto* last = &holder;
+    for (size_t i = 0; i < length; ++i) {
+        auto cell = heap().allocate<TestCell>();
+        last->next = cell;
+        last = cell;
+    }
+    return last->make_weak_ptr<TestCell>();
+}
+
+// Moves the last cell of the chain into the holder with the given kind of store, and cuts it off the chain.
+NEVER_INLINE static void move_last_cell_in_chain(TestCell& holder, StoreKind kind)
+{
+    auto* tail = &holder;
+    while (tail->next->next)
+        tail = tail->next;
+    store(holder, *tail->next, kind);
+    tail->next = nullptr;
+}
+
+NEVER_INLINE static void start_incremental_marking()
+{
+    while (!heap().is_incremental_marking_in_progress())
+        (void)heap().allocate<TestCell>();
+}
+
+TEST_CASE(incremental_marking_sees_every_kind_of_store_into_visited_cells)
+{
+    heap().set_incremental_marking_enabled(true);
+
+    for (auto kind : all_store_kinds) {
+        auto holder = GC::make_root(heap().allocate<TestCell>());
+
+        // The chain is long enough that a single marking step can't reach its end.
+        auto weak_cell = build_chain(*holder, 10'000);
+        clear_stack();
+
+        start_incremental_marking();
+        heap().perform_incremental_marking_step(AK::Duration::zero());
+        EXPECT(heap().is_incremental_marking_in_progress());
+        EXPECT(holder->is_marked());
+
+        // The cell is now only reachable through a cell that has already been visited.
+        move_last_cell_in_chain(*holder, kind);
+        clear_stack();
+
+        heap().collect_garbage();
+        EXPECT(weak_cell);
+    }
+
+    heap().set_incremental_marking_enabled(false);
+}
+
+NEVER_INLINE static WeakPtr<TestCell> store_young_cell_into(TestCell& holder, StoreKind kind)
+{
+    auto cell = heap().allocate<TestCell>();
+    EXPECT(cell->is_young());
+    store(holder, cell, kind);
+    return cell->make_weak_ptr<TestCell>();
+}
+
+TEST_CASE(minor_collection_sees_every_kind_of_store_into_old_cells)
+{
+    heap().set_generational_collection_enabled(true);
+
+    for (auto kind : all_store_kinds) {
+        auto holder = GC::make_root(heap().allocate<TestCell>());
+        heap().collect_garbage();
+        EXPECT(!holder->is_young());
+
+        auto weak_cell = store_young_cell_into(*holder, kind);
+        clear_stack();
+
+        heap().collect_young_garbage();
+        EXPECT(weak_cell && !weak_cell->is_young());
+    }
+
+    heap().set_generational_collection_enabled(false);
+}
+
+NEVER_INLINE static WeakPtr<TestCell> allocate_unreachable_young_cell()
+{
+    return heap().allocate<TestCell>()->make_weak_ptr<TestCell>();
+}
+
+TEST_CASE(minor_collection_frees_unreachable_young_cells)
+{
+    heap().set_generational_collection_enabled(true);
+
+    auto weak_cell = allocate_unreachable_young_cell();
+    clear_stack();
+
+    heap().collect_young_garbage();
+    EXPECT(!weak_cell);
+
+    heap().set_generational_collection_enabled(false);
+}
+
+TEST_CASE(minor_collection_frees_young_cells_that_are_no_longer_stored_in_old_cells)
+{
+    heap().set_generational_collection_enabled(true);
+
+    for (auto kind : all_store_kinds) {
+        auto holder = GC::make_root(heap().allocate<TestCell>());
+        heap().collect_garbage();
+
+        // The old cell is remembered, rather than the young cell that was stored into it.
+        auto weak_cell = store_young_cell_into(*holder, kind);
+        holder->clear_stored_cells();
+        clear_stack();
+
+        heap().collect_young_garbage();
+        EXPECT(!weak_cell);
+    }
+
+    heap().set_generational_collection_enabled(false);
+}
+
+NEVER_INLINE static WeakPtr<TestCell> store_young_cell_into_register(size_t index)
+{
+    auto cell = heap().allocate<TestCell>();
+    s_registers[index] = cell;
+    return cell->make_weak_ptr<TestCell>();
+}
+
+TEST_CASE(minor_collection_only_keeps_young_cells_that_are_still_in_a_register)
+{
+    heap().set_generational_collection_enabled(true);
+    s_registers.resize(2);
+
+    auto weak_live_cell = store_young_cell_into_register(0);
+    auto weak_dead_cell = store_young_cell_into_register(1);
+    s_registers[1] = nullptr;
+    clear_stack();
+
+    heap().collect_young_garbage();
+    EXPECT(weak_live_cell && !weak_live_cell->is_young());
+    EXPECT(!weak_dead_cell);
+
+    s_registers.clear();
+    heap().set_generational_collection_enabled(false);
+}
+
+TEST_CASE(destroying_another_heap_keeps_the_write_barrier_enabled)
+{
+    heap().set_generational_collection_enabled(true);
+
+    // Like a worker's heap, which lives on its own thread and may come and go at any time.
+    auto thread = Threading::Thread::construct([] {
+        GC::Heap other_heap(nullptr, [](auto&) {});
+        other_heap.set_generational_collection_enabled(true);
+        (void)other_heap.allocate<TestCell>();
+        return 0;
+    });
+    thread->start();
+    MUST(thread->join());
+
+    auto holder = GC::make_root(heap().allocate<TestCell>());
+    heap().collect_garbage();
+
+    auto weak_cell = store_young_cell_into(*holder, StoreKind::PtrMember);
+    clear_stack();
+
+    heap().collect_young_garbage();
+    EXPECT(weak_cell && !weak_cell->is_young());
+
+    heap().set_generational_collection_enabled(false);
+}
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Vector.h>
+#include <LibJIT/Assembler.h>
+#include <LibTest/TestCase.h>
+
+using JIT::Assembler;
+using Reg = Assembler::Reg;
+using Memory = Assembler::Memory;
+using Condition = Assembler::Condition;
+
+// The expected bytes come from GNU as, except where it would pick a shorter encoding than ours (e.g. imm8 forms),
+// in which case they have been checked with objdump instead.
+template<typename Callback>
+static Vector<u8> assemble(Callback callback)
+{
+    Vector<u8> output;
+    Assembler assembler(output);
+    callback(assembler);
+    return output;
+}
+
+#define EXPECT_ENCODING(instruction, ...) \
+    EXPECT_EQ(assemble([](Assembler& assembler) { assembler.instruction; }), (Vector<u8> { __VA_ARGS__ }))
+
+TEST_CASE(register_moves)
+{
+    EXPECT_ENCODING(mov(Reg::RAX, Reg::RBX), 0x48, 0x89, 0xd8);
+    EXPECT_ENCODING(mov(Reg::R8, Reg::R15), 0x4d, 0x89, 0xf8);
+    EXPECT_ENCODING(mov32(Reg::RAX, Reg::R9), 0x44, 0x89, 0xc8);
+    EXPECT_ENCODING(movzx8(Reg::RAX, Reg::RSI), 0x40, 0x0f, 0xb6, 0xc6);
+    EXPECT_ENCODING(movsx8(Reg::RAX, Reg::RDI), 0x48, 0x0f, 0xbe, 0xc7);
+    EXPECT_ENCODING(movsx16(Reg::R9, Reg::RCX), 0x4c, 0x0f, 0xbf, 0xc9);
+    EXPECT_ENCODING(movsx32(Reg::RAX, Reg::R10), 0x49, 0x63, 0xc2);
+}
+
+TEST_CASE(immediate_moves)
+{
+    EXPECT_ENCODING(mov32(Reg::RDX, 0x12345678u), 0xba, 0x78, 0x56, 0x34, 0x12);
+    EXPECT_ENCODING(mov32(Reg::R11, 42u), 0x41, 0xbb, 0x2a, 0x00, 0x00, 0x00);
+
+    // 64-bit immediates that fit in 32 bits use the shorter, zero-extending form.
+    EXPECT_ENCODING(mov(Reg::R11, static_cast<u64>(42)), 0x41, 0xbb, 0x2a, 0x00, 0x00, 0x00);
+    EXPECT_ENCODING(mov(Reg::RAX, static_cast<u64>(0x123456789abcdef0)), 0x48, 0xb8, 0xf0, 0xde, 0xbc, 0x9a, 0x78, 0x56, 0x34, 0x12);
+
+    EXPECT_ENCODING(mov(Memory { Reg::RBX, 16 }, -1), 0x48, 0xc7, 0x43, 0x10, 0xff, 0xff, 0xff, 0xff);
+}
+
+TEST_CASE(memory_operands)
+{
+    EXPECT_ENCODING(mov(Reg::RCX, Memory { Reg::RDI }), 0x48, 0x8b, 0x0f);
+
+    // rsp and r12 need a SIB byte.
+    EXPECT_ENCODING(mov(Reg::RCX, Memory { Reg::RSP }), 0x48, 0x8b, 0x0c, 0x24);
+    EXPECT_ENCODING(mov(Reg::RCX, Memory { Reg::R12, 8 }), 0x49, 0x8b, 0x4c, 0x24, 0x08);
+    EXPECT_ENCODING(movsx32(Reg::RDX, Memory { Reg::RSP, 8 }), 0x48, 0x63, 0x54, 0x24, 0x08);
+
+    // rbp and r13 always need a displacement.
+    EXPECT_ENCODING(mov(Reg::RCX, Memory { Reg::RBP }), 0x48, 0x8b, 0x4d, 0x00);
+    EXPECT_ENCODING(mov(Reg::RCX, Memory { Reg::R13 }), 0x49, 0x8b, 0x4d, 0x00);
+
+    // Displacements outside of [-128, 127] need 32 bits.
+    EXPECT_ENCODING(mov(Memory { Reg::R14, -128 }, Reg::R10), 0x4d, 0x89, 0x56, 0x80);
+    EXPECT_ENCODING(mov(Memory { Reg::RDI, 0x1000 }, Reg::RAX), 0x48, 0x89, 0x87, 0x00, 0x10, 0x00, 0x00);
+
+    EXPECT_ENCODING(mov32(Memory { Reg::RDI, 4 }, Reg::RSI), 0x89, 0x77, 0x04);
+    EXPECT_ENCODING(mov16(Memory { Reg::RDX, 2 }, Reg::RCX), 0x66, 0x89, 0x4a, 0x02);
+    EXPECT_ENCODING(movzx8(Reg::RCX, Memory { Reg::R8, 1 }), 0x41, 0x0f, 0xb6, 0x48, 0x01);
+    EXPECT_ENCODING(movzx16(Reg::RDX, Memory { Reg::RAX }), 0x0f, 0xb7, 0x10);
+}
+
+TEST_CASE(byte_registers)
+{
+    // Without a REX prefix, sil and dil would be dh and bh.
+    EXPECT_ENCODING(mov8(Memory { Reg::RDI }, Reg::RSI), 0x40, 0x88, 0x37);
+    EXPECT_ENCODING(mov8(Memory { Reg::RDI }, Reg::RAX), 0x88, 0x07);
+    EXPECT_ENCODING(mov8(Memory { Reg::RAX }, Reg::R9), 0x44, 0x88, 0x08);
+    EXPECT_ENCODING(set(Condition::EqualTo, Reg::RAX), 0x0f, 0x94, 0xc0);
+    EXPECT_ENCODING(set(Condition::SignedLessThan, Reg::RSI), 0x40, 0x0f, 0x9c, 0xc6);
+    EXPECT_ENCODING(set(Condition::SignedGreaterThan, Reg::R8), 0x41, 0x0f, 0x9f, 0xc0);
+}
+
+TEST_CASE(arithmetic)
+{
+    EXPECT_ENCODING(add(Reg::RAX, Reg::RCX), 0x48, 0x01, 0xc8);
+    EXPECT_ENCODING(add(Reg::RSI, Memory { Reg::RBP, 24 }), 0x48, 0x03, 0x75, 0x18);
+    EXPECT_ENCODING(add(Reg::RSP, 32), 0x48, 0x81, 0xc4, 0x20, 0x00, 0x00, 0x00);
+    EXPECT_ENCODING(sub(Reg::RSP, 0x100), 0x48, 0x81, 0xec, 0x00, 0x01, 0x00, 0x00);
+    EXPECT_ENCODING(sub(Reg::R8, Reg::R9), 0x4d, 0x29, 0xc8);
+    EXPECT_ENCODING(sub32(Reg::RAX, Reg::RCX), 0x29, 0xc8);
+    EXPECT_ENCODING(multiply(Reg::RAX, Reg::R11), 0x49, 0x0f, 0xaf, 0xc3);
+    EXPECT_ENCODING(multiply32(Reg::R10, Reg::RCX), 0x44, 0x0f, 0xaf, 0xd1);
+    EXPECT_ENCODING(bitwise_or(Reg::RAX, Reg::RDX), 0x48, 0x09, 0xd0);
+    EXPECT_ENCODING(bitwise_and32(Reg::RCX, 0xffffu), 0x81, 0xe1, 0xff, 0xff, 0x00, 0x00);
+    EXPECT_ENCODING(bitwise_xor32(Reg::R15, Reg::R15), 0x45, 0x31, 0xff);
+}
+
+TEST_CASE(shifts)
+{
+    EXPECT_ENCODING(shift_left(Reg::RAX, 16), 0x48, 0xc1, 0xe0, 0x10);
+    EXPECT_ENCODING(shift_right(Reg::RDX, 48), 0x48, 0xc1, 0xea, 0x30);
+    EXPECT_ENCODING(arithmetic_shift_right(Reg::R12, 3), 0x49, 0xc1, 0xfc, 0x03);
+    EXPECT_ENCODING(shift_left32_by_cl(Reg::RAX), 0xd3, 0xe0);
+    EXPECT_ENCODING(arithmetic_shift_right32_by_cl(Reg::R8), 0x41, 0xd3, 0xf8);
+    EXPECT_ENCODING(rotate_left_by_cl(Reg::RAX), 0x48, 0xd3, 0xc0);
+    EXPECT_ENCODING(rotate_right32_by_cl(Reg::R9), 0x41, 0xd3, 0xc9);
+}
+
+TEST_CASE(comparisons)
+{
+    EXPECT_ENCODING(cmp(Reg::RAX, Memory { Reg::RCX, 8 }), 0x48, 0x3b, 0x41, 0x08);
+    EXPECT_ENCODING(cmp(Reg::RDI, Reg::RSI), 0x48, 0x39, 0xf7);
+    EXPECT_ENCODING(cmp32(Reg::RAX, 0xfff9u), 0x81, 0xf8, 0xf9, 0xff, 0x00, 0x00);
+    EXPECT_ENCODING(cmp8(Memory { Reg::R10, 5 }, 7), 0x41, 0x80, 0x7a, 0x05, 0x07);
+    EXPECT_ENCODING(test(Reg::RAX, Reg::RAX), 0x48, 0x85, 0xc0);
+    EXPECT_ENCODING(test32(Reg::RCX, 1u), 0xf7, 0xc1, 0x01, 0x00, 0x00, 0x00);
+}
+
+TEST_CASE(calls_and_stack)
+{
+    EXPECT_ENCODING(jump(Reg::RAX), 0xff, 0xe0);
+    EXPECT_ENCODING(call(Reg::R11), 0x41, 0xff, 0xd3);
+    EXPECT_ENCODING(push(Reg::RBP), 0x55);
+    EXPECT_ENCODING(push(Reg::R15), 0x41, 0x57);
+    EXPECT_ENCODING(pop(Reg::R12), 0x41, 0x5c);
+    EXPECT_ENCODING(pop(Reg::RBX), 0x5b);
+    EXPECT_ENCODING(ret(), 0xc3);
+}
+
+TEST_CASE(jumps_to_labels)
+{
+    // A forward jump is patched when its label is bound.
+    auto forward = assemble([](Assembler& assembler) {
+        Assembler::Label label;
+        assembler.jump(label);
+        assembler.ret();
+        assembler.bind(label);
+        assembler.ret();
+    });
+    EXPECT_EQ(forward, (Vector<u8> { 0xe9, 0x01, 0x00, 0x00, 0x00, 0xc3, 0xc3 }));
+
+    // A backward jump is encoded right away, relative to the end of the instruction.
+    auto backward = assemble([](Assembler& assembler) {
+        Assembler::Label label;
+        assembler.bind(label);
+        assembler.ret();
+        assembler.jump_if(Condition::NotEqualTo, label);
+    });
+    EXPECT_EQ(backward, (Vector<u8> { 0xc3, 0x0f, 0x85, 0xf9, 0xff, 0xff, 0xff }));
+
+    // Every unresolved jump to a label gets patched.
+    auto several = assemble([](Assembler& assembler) {
+        Assembler::Label label;
+        assembler.jump_if(Condition::Overflow, label);
+        assembler.jump(label);
+        assembler.bind(label);
+    });
+    EXPECT_EQ(several, (Vector<u8> { 0x0f, 0x80, 0x05, 0x00, 0x00, 0x00, 0xe9, 0x00, 0x00, 0x00, 0x00 }));
+}
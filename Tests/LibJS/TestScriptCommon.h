@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/Runtime/GlobalObject.h>
+#include <LibJS/Runtime/VM.h>
+#include <LibJS/Script.h>
+
+// Runs scripts one after the other in the same realm, which first runs a prelude that defines what the scripts share.
+class ScriptEvaluator {
+public:
+    explicit ScriptEvaluator(StringView prelude)
+        : m_vm(MUST(JS::VM::create()))
+        , m_execution_context(JS::create_simple_execution_context<JS::GlobalObject>(*m_vm))
+    {
+        (void)evaluate(prelude);
+    }
+
+    JS::Value evaluate(StringView source)
+    {
+        auto script = JS::Script::parse(source, *m_execution_context->realm);
+        VERIFY(!script.is_error());
+        auto result = m_vm->bytecode_interpreter().run(*script.value());
+        VERIFY(!result.is_error());
+        return result.value();
+    }
+
+private:
+    NonnullRefPtr<JS::VM> m_vm;
+    NonnullOwnPtr<JS::ExecutionContext> m_execution_context;
+};
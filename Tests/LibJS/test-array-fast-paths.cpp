@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "TestScriptCommon.h"
+#include <LibTest/TestCase.h>
+
+// Array.prototype.forEach, map, filter, reduce, indexOf and includes read the elements of arrays directly when that
+// can't be observed. These tests run them over plain arrays, which take that fast path, and over array-like objects
+// with the same elements, which don't, and the benchmarks compare the two.
+
+static constexpr auto prelude = R"~~~(
+function makeArray(length, holey) {
+    const array = [];
+    for (let i = 0; i < length; ++i) array.push(i);
+    if (holey) {
+        for (let i = 1; i < length; i += 16) delete array[i];
+    }
+    return array;
+}
+
+function makeArrayLike(array) {
+    const arrayLike = { length: array.length };
+    for (let i = 0; i < array.length; ++i) {
+        if (i in array) arrayLike[i] = array[i];
+    }
+    return arrayLike;
+}
+
+function runBuiltins(target) {
+    const results = [];
+    let sum = 0;
+    Array.prototype.forEach.call(target, x => {
+        sum += x;
+    });
+    results.push(sum);
+    results.push(Array.prototype.map.call(target, x => x * 2).join());
+    results.push(Array.prototype.filter.call(target, x => x & 1).join());
+    results.push(Array.prototype.reduce.call(target, (accumulator, x) => accumulator + x, 0));
+    results.push(Array.prototype.indexOf.call(target, target.length - 1));
+    results.push(Array.prototype.indexOf.call(target, 1));
+    results.push(Array.prototype.includes.call(target, undefined));
+    results.push(Array.prototype.includes.call(target, -1));
+    return results.join("|");
+}
+
+function benchmark(target, iterations) {
+    let result;
+    for (let i = 0; i < iterations; ++i) result = runBuiltins(target);
+    return result;
+}
+
+var packed = makeArray(10000, false);
+var holey = makeArray(10000, true);
+var packedArrayLike = makeArrayLike(packed);
+var holeyArrayLike = makeArrayLike(holey);
+)~~~"sv;
+
+static JS::Value evaluate(StringView source)
+{
+    static ScriptEvaluator evaluator { prelude };
+    return evaluator.evaluate(source);
+}
+
+TEST_CASE(fast_paths_match_generic_paths)
+{
+    EXPECT(evaluate("runBuiltins(packed) === runBuiltins(packedArrayLike)"sv).as_bool());
+    EXPECT(evaluate("runBuiltins(holey) === runBuiltins(holeyArrayLike)"sv).as_bool());
+}
+
+TEST_CASE(fast_paths_see_mutations_from_callbacks)
+{
+    EXPECT(evaluate(R"~~~(
+        function mutate(target) {
+            const seen = [];
+            Array.prototype.forEach.call(target, (x, i) => {
+                seen.push(x);
+                if (i === 0) delete target[2];
+                if (i === 3) {
+                    for (let j = 6; j < 10; ++j) delete target[j];
+                    target.length = 6;
+                }
+                if (i === 4) {
+                    const prototype = Object.create(Object.getPrototypeOf(target));
+                    prototype[7] = "from prototype";
+                    Object.setPrototypeOf(target, prototype);
+                }
+            });
+            return seen.join();
+        }
+        mutate(makeArray(10)) === mutate(makeArrayLike(makeArray(10)))
+    )~~~"sv)
+            .as_bool());
+}
+
+BENCHMARK_CASE(packed_array)
+{
+    evaluate("benchmark(packed, 100)"sv);
+}
+
+BENCHMARK_CASE(packed_array_like)
+{
+    evaluate("benchmark(packedArrayLike, 100)"sv);
+}
+
+BENCHMARK_CASE(holey_array)
+{
+    evaluate("benchmark(holey, 100)"sv);
+}
+
+BENCHMARK_CASE(holey_array_like)
+{
+    evaluate("benchmark(holeyArrayLike, 100)"sv);
+}
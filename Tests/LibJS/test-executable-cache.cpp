@@ -0,0 +1,349 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/OwnPtr.h>
+#include <LibCore/File.h>
+#include <LibFileSystem/TempFile.h>
+#include <LibJS/AST.h>
+#include <LibJS/Bytecode/Executable.h>
+#include <LibJS/Bytecode/ExecutableCache.h>
+#include <LibJS/Bytecode/Instruction.h>
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Parser.h>
+#include <LibJS/Runtime/ECMAScriptFunctionObject.h>
+#include <LibJS/Runtime/GlobalObject.h>
+#include <LibJS/Runtime/VM.h>
+#include <LibJS/Script.h>
+#include <LibJS/SourceCode.h>
+#include <LibTest/TestCase.h>
+
+// Every test case uses its own script, and so its own cache file, since the files are named after a hash of the source.
+
+using JS::Bytecode::ExecutableCache;
+using JS::Bytecode::ExecutableCacheState;
+
+static JS::VM& vm()
+{
+    static auto vm = MUST(JS::VM::create());
+    return *vm;
+}
+
+static ByteString const& cache_directory()
+{
+    static OwnPtr<FileSystem::TempFile> directory;
+    static ByteString path;
+    if (!directory) {
+        directory = MUST(FileSystem::TempFile::create_temp_directory());
+        path = directory->path().to_byte_string();
+        ExecutableCache::set_directory(path);
+        VERIFY(ExecutableCache::is_enabled());
+    }
+    return path;
+}
+
+// Scripts shorter than 1 KiB aren't cached, so they are padded with a comment.
+static ByteString padded(StringView source)
+{
+    return ByteString::formatted("{}\n/*{}*/\n", source, ByteString::repeated('.', 1024));
+}
+
+// A script parsed in a fresh realm, like a page that is loaded again.
+struct Session {
+    OwnPtr<JS::ExecutionContext> execution_context;
+    GC::Root<JS::Script> script;
+    ByteString result;
+
+    ExecutableCacheState const& state() const { return script->parse_node().source_code().executable_cache_state(); }
+    ByteString cache_file_path() const { return ByteString::formatted("{}/{}.jsbc", cache_directory(), state().source_hash); }
+
+    JS::ECMAScriptFunctionObject& function(StringView name) const
+    {
+        auto value = script->realm().global_object().get_without_side_effects(ByteString { name });
+        return as<JS::ECMAScriptFunctionObject>(value.as_object());
+    }
+};
+
+static Session parse(ByteString const& source)
+{
+    (void)cache_directory();
+
+    Session session;
+    session.execution_context = JS::create_simple_execution_context<JS::GlobalObject>(vm());
+    vm().pop_execution_context();
+    auto script = JS::Script::parse(source, *session.execution_context->realm);
+    VERIFY(!script.is_error());
+    session.script = GC::make_root(script.value());
+    return session;
+}
+
+static void run(Session& session)
+{
+    vm().push_execution_context(*session.execution_context);
+    auto result = vm().bytecode_interpreter().run(*session.script);
+    VERIFY(!result.is_error());
+    session.result = result.value().to_string_without_side_effects().to_byte_string();
+    vm().pop_execution_context();
+}
+
+static Session run(ByteString const& source)
+{
+    auto session = parse(source);
+    run(session);
+    return session;
+}
+
+// Counts the instructions that refer to the AST, and checks that they refer to nodes of the session's own parse.
+static size_t count_links(JS::Bytecode::Executable const& executable, Session const& session)
+{
+    using LinkKind = ExecutableCache::LinkKind;
+    auto const& state = session.state();
+
+    size_t links = 0;
+    for (JS::Bytecode::InstructionStreamIterator it(executable.bytecode); !it.at_end(); ++it) {
+        auto const& instruction = *it;
+        switch (instruction.type()) {
+        case JS::Bytecode::Instruction::Type::NewFunction: {
+            auto const& function_node = static_cast<JS::Bytecode::Op::NewFunction const&>(instruction).function_node();
+            auto const& body = function_node.body();
+            EXPECT(state.find_linkable_node(LinkKind::Function, body.start_offset(), body.end_offset()) == &function_node);
+            ++links;
+            break;
+        }
+        case JS::Bytecode::Instruction::Type::NewClass: {
+            auto const& class_expression = static_cast<JS::Bytecode::Op::NewClass const&>(instruction).class_expression();
+            EXPECT(state.find_linkable_node(LinkKind::Class, class_expression.start_offset(), class_expression.end_offset()) == &class_expression);
+            ++links;
+            break;
+        }
+        case JS::Bytecode::Instruction::Type::BlockDeclarationInstantiation: {
+            auto const& scope_node = static_cast<JS::Bytecode::Op::BlockDeclarationInstantiation const&>(instruction).scope_node();
+            EXPECT(state.find_linkable_node(LinkKind::Scope, scope_node.start_offset(), scope_node.end_offset()) == &scope_node);
+            ++links;
+            break;
+        }
+        default:
+            break;
+        }
+    }
+    return links;
+}
+
+static GC::Ptr<JS::Bytecode::Executable> load_script(Session const& session)
+{
+    return ExecutableCache::load(vm(), session.script->parse_node(), ExecutableCache::CompilationKind::ASTNode, JS::FunctionKind::Normal);
+}
+
+static GC::Ptr<JS::Bytecode::Executable> load_function(Session const& session, StringView name)
+{
+    auto const& function = session.function(name);
+    return ExecutableCache::load(vm(), function.ecmascript_code(), ExecutableCache::CompilationKind::Function, function.kind());
+}
+
+static ByteBuffer read_file(ByteString const& path)
+{
+    auto file = MUST(Core::File::open(path, Core::File::OpenMode::Read));
+    return MUST(file->read_until_eof());
+}
+
+static void write_file(ByteString const& path, ReadonlyBytes contents)
+{
+    auto file = MUST(Core::File::open(path, Core::File::OpenMode::Write | Core::File::OpenMode::Truncate));
+    MUST(file->write_until_depleted(contents));
+}
+
+static constexpr auto nested_functions_and_classes = R"~~~(
+var makeCounter = function (start) {
+    let count = start;
+    return { next: () => ++count };
+};
+var Shape = class {
+    constructor(sides) { this.sides = sides; }
+    describe() { return `shape with ${this.sides} sides`; }
+};
+var Square = class extends Shape {
+    constructor() { super(4); }
+    describe() { return "square, " + super.describe(); }
+};
+var results = [];
+{
+    let counter = makeCounter(41);
+    function twice(f) { return [f(), f()]; }
+    results.push(twice(counter.next).join());
+}
+for (let i = 0; i < 2; ++i) {
+    class Local { value() { return i * 10; } }
+    results.push(new Local().value());
+}
+results.push(new Square().describe());
+results.push(12345678901234567890n * 2n);
+results.push(/b+/g.exec("abbbc")[0]);
+results.join("|");
+)~~~"sv;
+
+TEST_CASE(round_trip_of_script_with_nested_functions_and_classes)
+{
+    auto source = padded(nested_functions_and_classes);
+
+    auto first = run(source);
+    EXPECT_EQ(first.result, "42,43|0|10|square, shape with 4 sides|24691357802469135780|bbb"sv);
+    EXPECT(first.state().records.size() > 1);
+
+    // The second run reads the executables the first one stored.
+    auto second = parse(source);
+    EXPECT(load_script(second));
+    EXPECT_EQ(second.state().records.size(), first.state().records.size());
+    run(second);
+    EXPECT_EQ(second.result, first.result);
+}
+
+TEST_CASE(loaded_executables_are_relinked_to_the_new_parse)
+{
+    auto source = padded(ByteString::formatted("// Relinking\n{}", nested_functions_and_classes));
+    (void)run(source);
+    auto second = run(source);
+
+    // NewFunction, NewClass and BlockDeclarationInstantiation must refer to the nodes of the second parse, as the
+    // first one's may be gone by now.
+    auto script_executable = load_script(second);
+    EXPECT(script_executable);
+    if (script_executable)
+        EXPECT(count_links(*script_executable, second) >= 5);
+
+    auto function_executable = load_function(second, "makeCounter"sv);
+    EXPECT(function_executable);
+    if (function_executable)
+        EXPECT_EQ(count_links(*function_executable, second), 1u);
+}
+
+// The header is the magic number, the version, and the length and characters of the build identity.
+static size_t header_size(ReadonlyBytes contents)
+{
+    return 3 * sizeof(u32) + *bit_cast<u32 const*>(contents.offset(2 * sizeof(u32)));
+}
+
+TEST_CASE(truncated_file_is_rewritten)
+{
+    auto source = padded(ByteString::formatted("// Truncated\n{}", nested_functions_and_classes));
+    auto first = run(source);
+    auto path = first.cache_file_path();
+    auto contents = read_file(path);
+    write_file(path, contents.bytes().trim(contents.size() - 10));
+
+    // The records before the broken one are still used, and the rest are compiled again.
+    auto second = parse(source);
+    EXPECT(load_script(second));
+    EXPECT_EQ(second.state().records.size(), first.state().records.size() - 1);
+    run(second);
+    EXPECT_EQ(second.result, first.result);
+
+    // The file was rewritten, so appending the record compiled again wasn't in vain.
+    auto third = parse(source);
+    EXPECT(load_script(third));
+    EXPECT_EQ(third.state().records.size(), first.state().records.size());
+}
+
+TEST_CASE(corrupted_file_is_rejected)
+{
+    auto source = padded(ByteString::formatted("// Corrupted\n{}", nested_functions_and_classes));
+    auto first = run(source);
+    auto path = first.cache_file_path();
+    auto contents = read_file(path);
+
+    // Flip a byte in the first record, past its size and checksum.
+    contents[header_size(contents) + 2 * sizeof(u32) + 16] ^= 0xff;
+    write_file(path, contents);
+
+    auto second = parse(source);
+    EXPECT(!load_script(second));
+    EXPECT(second.state().records.is_empty());
+    run(second);
+    EXPECT_EQ(second.result, first.result);
+
+    auto third = parse(source);
+    EXPECT(load_script(third));
+    EXPECT_EQ(third.state().records.size(), first.state().records.size());
+}
+
+TEST_CASE(file_from_a_different_build_is_rejected)
+{
+    auto source = padded(ByteString::formatted("// Different build\n{}", nested_functions_and_classes));
+    auto first = run(source);
+    auto path = first.cache_file_path();
+    auto contents = read_file(path);
+
+    contents[3 * sizeof(u32)] ^= 0xff;
+    write_file(path, contents);
+
+    auto second = parse(source);
+    EXPECT(!load_script(second));
+    EXPECT(second.state().records.is_empty());
+    EXPECT(!second.state().cache_file_is_valid);
+    run(second);
+    EXPECT_EQ(second.result, first.result);
+
+    // The second run replaced the file with one of its own.
+    auto third = parse(source);
+    EXPECT(load_script(third));
+    EXPECT_EQ(third.state().records.size(), first.state().records.size());
+}
+
+static constexpr auto lazily_parsed_function = R"~~~(
+// Lazy bodies
+var big = function (n) {
+    var makeAdder = function (x) {
+        return y => x + y;
+    };
+    var Point = function (x) {
+        this.x = x;
+    };
+    Point.prototype.doubled = function () { return this.x * 2; };
+    let total = 0;
+    {
+        let add = makeAdder(n);
+        function square(v) { return v * v; }
+        total += add(square(3));
+    }
+    total += new Point(n).doubled();
+    return total;
+};
+big(1);
+)~~~"sv;
+
+TEST_CASE(lazily_parsed_function_bodies)
+{
+    auto was_lazy_parsing_enabled = JS::Parser::is_lazy_parsing_enabled();
+    JS::Parser::set_lazy_parsing_enabled(true);
+
+    auto source = padded(lazily_parsed_function);
+    auto skipped_function_count = JS::Parser::lazy_parsing_statistics().skipped_function_count;
+    auto first = run(source);
+    EXPECT_EQ(first.result, "12"sv);
+    EXPECT(JS::Parser::lazy_parsing_statistics().skipped_function_count > skipped_function_count);
+
+    // The function's executable was compiled from its reparsed body, and links to the nodes of the reparse.
+    auto second = run(source);
+    EXPECT_EQ(second.result, first.result);
+    EXPECT_EQ(second.state().records.size(), first.state().records.size());
+    auto script_executable = load_script(second);
+    EXPECT(script_executable);
+    if (script_executable)
+        EXPECT_EQ(count_links(*script_executable, second), 1u);
+    auto function_executable = load_function(second, "big"sv);
+    EXPECT(function_executable);
+    if (function_executable)
+        EXPECT_EQ(count_links(*function_executable, second), 4u);
+
+    // A placeholder covers the same source range as the body it stands in for, so the same records work without lazy parsing.
+    JS::Parser::set_lazy_parsing_enabled(false);
+    auto third = run(source);
+    EXPECT_EQ(third.result, first.result);
+    EXPECT_EQ(third.state().records.size(), first.state().records.size());
+    EXPECT(load_script(third));
+    EXPECT(load_function(third, "big"sv));
+
+    JS::Parser::set_lazy_parsing_enabled(was_lazy_parsing_enabled);
+}
@@ -19,6 +19,12 @@ TEST_ROOT("Libraries/LibJS/Tests");
 
 TESTJS_PROGRAM_FLAG(test262_parser_tests, "Run test262 parser tests", "test262-parser-tests", 0);
 
+TESTJS_MAIN_HOOK()
+{
+    // Lazy parsing is off by default, so make sure the tests cover it.
+    JS::Parser::set_lazy_parsing_enabled(true);
+}
+
 TESTJS_GLOBAL_FUNCTION(is_strict_mode, isStrictMode, 0)
 {
     return JS::Value(vm.in_strict_mode());
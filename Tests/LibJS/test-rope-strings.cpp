@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "TestScriptCommon.h"
+#include <LibTest/TestCase.h>
+
+// Appending to a string builds a rope, and length, charCodeAt, indexOf and substring read the rope without flattening it.
+// These benchmarks would take quadratic time if they flattened the growing string on every read.
+// Libraries/LibJS/Tests/string-ropes.js checks that the results match those on flat strings.
+
+static JS::Value evaluate(StringView source)
+{
+    static ScriptEvaluator evaluator { ""sv };
+    return evaluator.evaluate(source);
+}
+
+BENCHMARK_CASE(append_and_read_length)
+{
+    evaluate(R"~~~(
+        {
+            let string = "";
+            for (let i = 0; i < 100000; ++i) {
+                string += "chunk";
+                if (string.length % 1000 === 0) string.charCodeAt(string.length - 1);
+            }
+        }
+    )~~~"sv);
+}
+
+BENCHMARK_CASE(append_and_search)
+{
+    evaluate(R"~~~(
+        {
+            let string = "";
+            for (let i = 0; i < 20000; ++i) {
+                string += "chunk" + i;
+                string.indexOf("chunk", string.length - 20);
+                string.substring(string.length - 10);
+            }
+        }
+    )~~~"sv);
+}
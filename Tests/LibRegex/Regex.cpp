@@ -1285,3 +1285,143 @@ TEST_CASE(mismatching_brackets)
         EXPECT_EQ(re.parser_result.error, regex::Error::MismatchingBracket);
     }
 }
+
+TEST_CASE(lazy_dfa)
+{
+    struct EligibilityTest {
+        StringView pattern;
+        bool can_be_matched_by_lazy_dfa;
+    };
+    auto const eligibility = Array {
+        EligibilityTest { "(\\w+)@(\\w+)\\.com"sv, true },
+        EligibilityTest { "^[a-z]*(?:foo|bar)+\\d+$"sv, true },
+        EligibilityTest { "\\d{2,4}"sv, false },
+        EligibilityTest { "(?:a|ab)(?:c|bcd)(?:d*)"sv, true },
+        EligibilityTest { "(a)\\1"sv, false },
+        EligibilityTest { "a(?=b)"sv, false },
+        EligibilityTest { "\\bword\\b"sv, false },
+    };
+
+    for (auto const& test_case : eligibility) {
+        Regex<ECMA262> re(test_case.pattern);
+        EXPECT_EQ(re.parser_result.optimization_data.can_be_matched_by_lazy_dfa, test_case.can_be_matched_by_lazy_dfa);
+    }
+
+    // The DFA has to find the same match as the backtracker, including which alternative wins.
+    auto const patterns = Array {
+        "(?:a|ab)(?:c|bcd)(?:d*)"sv,
+        "a*?b"sv,
+        "(?:a+)+b"sv,
+        "^abc|bc$"sv,
+        "(?:x*)*y"sv,
+        "[^a]+a{2,3}"sv,
+        "(\\w+)@(\\w+)\\.com"sv,
+    };
+    auto const subjects = Array {
+        "abcd"sv,
+        "xxaab"sv,
+        "aaaa"sv,
+        "zabc"sv,
+        "xxxy"sv,
+        "bbaaaa"sv,
+        "mail alice@example.com or bob@test.com"sv,
+    };
+
+    for (auto pattern : patterns) {
+        Regex<ECMA262> with_dfa(pattern, ECMAScriptFlags::Global);
+        Regex<ECMA262> without_dfa(pattern, ECMAScriptFlags::Global);
+        without_dfa.parser_result.optimization_data.can_be_matched_by_lazy_dfa = false;
+
+        for (auto subject : subjects) {
+            auto expected = without_dfa.match(subject);
+            auto result = with_dfa.match(subject);
+            EXPECT_EQ(result.success, expected.success);
+            EXPECT_EQ(result.matches.size(), expected.matches.size());
+            for (size_t i = 0; i < min(result.matches.size(), expected.matches.size()); ++i) {
+                EXPECT_EQ(result.matches[i].global_offset, expected.matches[i].global_offset);
+                EXPECT_EQ(result.matches[i].view.to_byte_string(), expected.matches[i].view.to_byte_string());
+            }
+        }
+    }
+
+    // Captures still come from the backtracker.
+    Regex<ECMA262> re("(\\w+)@(\\w+)\\.com"sv, ECMAScriptFlags::Global);
+    auto result = re.match("mail alice@example.com"sv);
+    EXPECT_EQ(result.success, true);
+    EXPECT_EQ(result.capture_group_matches.first()[0].view.to_byte_string(), "alice"sv);
+    EXPECT_EQ(result.capture_group_matches.first()[1].view.to_byte_string(), "example"sv);
+}
+
+TEST_CASE(backtracking_memoization)
+{
+    // \b keeps the DFA out of the way, so these run on the backtracker.
+    Regex<ECMA262> re("^(a+)+\\b$"sv);
+    EXPECT_EQ(re.parser_result.optimization_data.memoize_backtracking, true);
+
+    auto subject = ByteString::repeated('a', 64);
+    auto result = re.match(subject);
+    EXPECT_EQ(result.success, true);
+    EXPECT_EQ(result.capture_group_matches.first()[0].view.to_byte_string(), subject);
+
+    result = re.match(ByteString::formatted("{}!", subject));
+    EXPECT_EQ(result.success, false);
+    EXPECT(result.n_operations < 100'000);
+
+    EXPECT_EQ(Regex<ECMA262>("(a|aa)+\\b"sv).parser_result.optimization_data.memoize_backtracking, true);
+    EXPECT_EQ(Regex<ECMA262>("(?:ab)+\\b"sv).parser_result.optimization_data.memoize_backtracking, false);
+    EXPECT_EQ(Regex<ECMA262>("(a+)+\\1"sv).parser_result.optimization_data.memoize_backtracking, false);
+    EXPECT_EQ(Regex<ECMA262>("(a+)+(?=b)"sv).parser_result.optimization_data.memoize_backtracking, false);
+}
+
+TEST_CASE(max_operations)
+{
+    ECMAScriptOptions options { ECMAScriptFlags::Global };
+    options.set_max_operations(10'000);
+
+    // The lookahead rules out memoization, so this backtracks until it runs out of operations.
+    Regex<ECMA262> re("(a+)+(?!a)b"sv, options);
+    auto result = re.match(ByteString::formatted("{}!", ByteString::repeated('a', 64)));
+    EXPECT_EQ(result.success, false);
+    EXPECT_EQ(result.reached_max_operations, true);
+    EXPECT(result.n_operations <= 10'001);
+
+    result = re.match("aaab"sv);
+    EXPECT_EQ(result.success, true);
+    EXPECT_EQ(result.reached_max_operations, false);
+}
+
+TEST_CASE(skip_to_possible_match_start)
+{
+    {
+        Regex<ECMA262> re("(?:foo|bar)\\d"sv);
+        auto const& ranges = re.parser_result.optimization_data.starting_ranges;
+        EXPECT_EQ(ranges.size(), 2u);
+        EXPECT_EQ(ranges[0].from, static_cast<u32>('b'));
+        EXPECT_EQ(ranges[1].from, static_cast<u32>('f'));
+        EXPECT(re.parser_result.optimization_data.literal_prefix.is_empty());
+    }
+    EXPECT_EQ(Regex<ECMA262>("^foo\\d+"sv).parser_result.optimization_data.literal_prefix, "foo"sv);
+    EXPECT_EQ(Regex<ECMA262>("\\w+@"sv).parser_result.optimization_data.starting_ranges.size(), 4u);
+    EXPECT(Regex<ECMA262>("a*"sv).parser_result.optimization_data.starting_ranges.is_empty());
+    EXPECT(Regex<ECMA262>(".x"sv).parser_result.optimization_data.starting_ranges.is_empty());
+    EXPECT(Regex<ECMA262>("[^a]x"sv).parser_result.optimization_data.starting_ranges.is_empty());
+    EXPECT(Regex<ECMA262>("foo"sv, ECMAScriptFlags::Insensitive).parser_result.optimization_data.starting_ranges.is_empty());
+
+    StringBuilder builder;
+    for (size_t i = 0; i < 100; ++i)
+        builder.append("fo fox f00 bar"sv);
+    builder.append(" foo1 bar2 foo"sv);
+    auto subject = builder.to_byte_string();
+    auto utf16_subject = MUST(AK::utf8_to_utf16(subject));
+
+    Regex<ECMA262> re("(?:foo|bar)\\d"sv, ECMAScriptFlags::Global);
+    for (auto const& view : { RegexStringView { subject.view() }, RegexStringView { Utf16View { utf16_subject } } }) {
+        re.start_offset = 0;
+        auto result = re.match(view);
+        EXPECT_EQ(result.success, true);
+        EXPECT_EQ(result.count, 2u);
+        EXPECT_EQ(result.matches[0].view.to_byte_string(), "foo1"sv);
+        EXPECT_EQ(result.matches[0].global_offset, subject.length() - 13);
+        EXPECT_EQ(result.matches[1].view.to_byte_string(), "bar2"sv);
+    }
+}
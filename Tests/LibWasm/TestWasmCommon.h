@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/MemoryStream.h>
+#include <AK/StringView.h>
+#include <AK/Vector.h>
+#include <LibWasm/Types.h>
+
+// Helpers for writing out small modules byte by byte.
+
+static constexpr u8 i32_type = 0x7f;
+static constexpr u8 i64_type = 0x7e;
+
+static inline Vector<u8> module_header()
+{
+    return { 0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00 };
+}
+
+static inline void append_leb128(Vector<u8>& bytes, size_t value)
+{
+    do {
+        u8 byte = value & 0x7f;
+        value >>= 7;
+        if (value != 0)
+            byte |= 0x80;
+        bytes.append(byte);
+    } while (value != 0);
+}
+
+static inline void append_name(Vector<u8>& bytes, StringView name)
+{
+    append_leb128(bytes, name.length());
+    bytes.append(name.bytes().data(), name.length());
+}
+
+static inline void append_section(Vector<u8>& bytes, u8 id, Vector<u8> const& contents)
+{
+    bytes.append(id);
+    append_leb128(bytes, contents.size());
+    bytes.extend(contents);
+}
+
+static inline NonnullRefPtr<Wasm::Module> parse_module(ReadonlyBytes bytes)
+{
+    FixedMemoryStream stream { bytes };
+    auto module = Wasm::Module::parse(stream);
+    VERIFY(!module.is_error());
+    return module.release_value();
+}
+
+struct TestFunction {
+    StringView name;
+    u8 type_index { 0 };
+    // The locals declaration and the body, including the final end.
+    Vector<u8> code;
+};
+
+// The contents of the function, export and code sections for the given functions, each exported under its name.
+struct FunctionSections {
+    Vector<u8> functions;
+    Vector<u8> exports;
+    Vector<u8> code;
+};
+
+static inline FunctionSections make_function_sections(ReadonlySpan<TestFunction> test_functions, size_t first_function_index = 0)
+{
+    FunctionSections sections;
+    append_leb128(sections.functions, test_functions.size());
+    append_leb128(sections.exports, test_functions.size());
+    append_leb128(sections.code, test_functions.size());
+    for (size_t i = 0; i < test_functions.size(); ++i) {
+        auto& function = test_functions[i];
+        sections.functions.append(function.type_index);
+
+        append_name(sections.exports, function.name);
+        sections.exports.append(0x00);
+        append_leb128(sections.exports, first_function_index + i);
+
+        append_leb128(sections.code, function.code.size());
+        sections.code.extend(function.code);
+    }
+    return sections;
+}
+
+// (func (param $n i32) (result i32) (local $i i32) (local $sum i32)
+//   (block (loop
+//     (br_if 1 (i32.ge_s (local.get $i) (local.get $n)))
+//     (local.set $sum (i32.add (local.get $sum) (local.get $i)))
+//     (local.set $i (i32.add (local.get $i) (i32.const 1)))
+//     (br 0)))
+//   (local.get $sum))
+static inline TestFunction sum_to_function(u8 type_index)
+{
+    return {
+        "sum_to"sv,
+        type_index,
+        { 0x01, 0x02, i32_type,
+            0x02, 0x40, 0x03, 0x40,
+            0x20, 0x01, 0x20, 0x00, 0x4e, 0x0d, 0x01,
+            0x20, 0x02, 0x20, 0x01, 0x6a, 0x21, 0x02,
+            0x20, 0x01, 0x41, 0x01, 0x6a, 0x21, 0x01,
+            0x0c, 0x00, 0x0b, 0x0b,
+            0x20, 0x02, 0x0b },
+    };
+}
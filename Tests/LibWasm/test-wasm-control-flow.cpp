@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "TestWasmCommon.h"
+#include <LibTest/TestCase.h>
+#include <LibWasm/AbstractMachine/AbstractMachine.h>
+
+// Branches are resolved to a continuation and a stack height by the validator, and the interpreter doesn't keep a
+// stack of labels. These check that branches out of blocks, loops and functions leave the value stack as they should.
+
+static TestFunction const s_functions[] = {
+    sum_to_function(0),
+    // (func (param $x i32) (result i32)
+    //   (block (result i32)
+    //     (i32.const 7)
+    //     (block
+    //       (block
+    //         (block (br_table 0 1 2 (local.get $x)))
+    //         (br 2 (i32.const 10)))
+    //       (br 1 (i32.const 20)))
+    //     (br 0 (i32.const 99))))
+    {
+        "classify"sv,
+        0,
+        { 0x00,
+            0x02, i32_type, 0x41, 0x07,
+            0x02, 0x40, 0x02, 0x40, 0x02, 0x40, 0x20, 0x00, 0x0e, 0x02, 0x00, 0x01, 0x02, 0x0b,
+            0x41, 0x0a, 0x0c, 0x02, 0x0b,
+            0x41, 0x14, 0x0c, 0x01, 0x0b,
+            0x41, 0xe3, 0x00, 0x0c, 0x00, 0x0b,
+            0x0b },
+    },
+    // (func (param $x i32) (result i32)
+    //   (i32.const 1)
+    //   (block (i32.const 2) (loop (return (local.get $x))) (drop)))
+    {
+        "early_return"sv,
+        0,
+        { 0x00,
+            0x41, 0x01, 0x02, 0x40, 0x41, 0x02, 0x03, 0x40, 0x20, 0x00, 0x0f, 0x0b, 0x1a, 0x0b,
+            0x0b },
+    },
+    // (func (param $x i32) (result i32)
+    //   (i32.add (i32.const 5) (call $early_return (local.get $x))))
+    {
+        "call_early_return"sv,
+        0,
+        { 0x00,
+            0x41, 0x05, 0x20, 0x00, 0x10, 0x02, 0x6a,
+            0x0b },
+    },
+    // (func (param $x i32) (result i32)
+    //   (local.get $x)
+    //   (loop (param i32) (result i32)
+    //     (i32.const 1) (i32.sub) (local.tee $x)
+    //     (br_if 0 (i32.gt_s (local.get $x) (i32.const 0)))))
+    {
+        "count_down"sv,
+        0,
+        { 0x00,
+            0x20, 0x00, 0x03, 0x00,
+            0x41, 0x01, 0x6b, 0x22, 0x00,
+            0x20, 0x00, 0x41, 0x00, 0x4a, 0x0d, 0x00, 0x0b,
+            0x0b },
+    },
+};
+
+// Every function is (i32) -> i32.
+static NonnullRefPtr<Wasm::Module> make_module()
+{
+    auto bytes = module_header();
+    append_section(bytes, 0x01, { 0x01, 0x60, 0x01, i32_type, 0x01, i32_type });
+
+    auto sections = make_function_sections(s_functions);
+    append_section(bytes, 0x03, sections.functions);
+    append_section(bytes, 0x07, sections.exports);
+    append_section(bytes, 0x0a, sections.code);
+    return parse_module(bytes);
+}
+
+struct Instance {
+    Wasm::AbstractMachine machine;
+    NonnullRefPtr<Wasm::Module> module;
+    OwnPtr<Wasm::ModuleInstance> module_instance;
+
+    Instance()
+        : module(make_module())
+    {
+        auto result = machine.instantiate(*module, {});
+        VERIFY(!result.is_error());
+        module_instance = result.release_value();
+    }
+
+    i32 call(StringView name, i32 argument)
+    {
+        auto it = module_instance->exports().find_if([&](auto& export_) { return export_.name() == name; });
+        VERIFY(!it.is_end());
+        auto result = machine.invoke(it->value().get<Wasm::FunctionAddress>(), { Wasm::Value(argument) });
+        VERIFY(!result.is_trap() && !result.is_completion());
+        VERIFY(result.values().size() == 1);
+        return result.values().first().to<i32>();
+    }
+};
+
+TEST_CASE(branch_out_of_nested_blocks)
+{
+    Instance instance;
+    EXPECT_EQ(instance.call("sum_to"sv, 0), 0);
+    EXPECT_EQ(instance.call("sum_to"sv, 1000), 499500);
+
+    EXPECT_EQ(instance.call("classify"sv, 0), 10);
+    EXPECT_EQ(instance.call("classify"sv, 1), 20);
+    EXPECT_EQ(instance.call("classify"sv, 2), 99);
+    EXPECT_EQ(instance.call("classify"sv, -1), 99);
+}
+
+TEST_CASE(loop_parameters_are_kept_on_branch)
+{
+    Instance instance;
+    EXPECT_EQ(instance.call("count_down"sv, 5), 0);
+    EXPECT_EQ(instance.call("count_down"sv, -3), -4);
+}
+
+TEST_CASE(return_drops_values_below_the_results)
+{
+    Instance instance;
+    EXPECT_EQ(instance.call("early_return"sv, 42), 42);
+    EXPECT_EQ(instance.call("call_early_return"sv, 42), 47);
+}
+
+BENCHMARK_CASE(loop_with_branches)
+{
+    Instance instance;
+    EXPECT_EQ(instance.call("sum_to"sv, 2'000'000), static_cast<i32>(1'999'999ull * 2'000'000ull / 2));
+}
+
+BENCHMARK_CASE(calls_with_early_returns)
+{
+    Instance instance;
+    for (i32 i = 0; i < 200'000; ++i)
+        EXPECT_EQ(instance.call("call_early_return"sv, i), i + 5);
+}
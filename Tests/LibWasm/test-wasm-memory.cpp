@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+#include <LibWasm/AbstractMachine/AbstractMachine.h>
+
+static Wasm::MemoryInstance create_memory(u32 initial_pages, Optional<u32> maximum_pages = {})
+{
+    return MUST(Wasm::MemoryInstance::create(Wasm::MemoryType { Wasm::Limits(initial_pages, maximum_pages) }));
+}
+
+TEST_CASE(memories_grow_in_place)
+{
+    auto memory = create_memory(1);
+    EXPECT(memory.has_guard_region());
+    EXPECT_EQ(memory.size(), Wasm::Constants::page_size);
+
+    auto* base = memory.data().data();
+    memory.data()[0] = 1;
+    memory.data()[Wasm::Constants::page_size - 1] = 2;
+
+    EXPECT(memory.grow(3 * Wasm::Constants::page_size));
+    EXPECT_EQ(memory.size(), 4 * Wasm::Constants::page_size);
+    EXPECT_EQ(memory.data().data(), base);
+    EXPECT_EQ(memory.data()[0], 1);
+    EXPECT_EQ(memory.data()[Wasm::Constants::page_size - 1], 2);
+
+    // The grown pages start out zeroed.
+    for (auto byte : memory.data().slice(Wasm::Constants::page_size))
+        EXPECT_EQ(byte, 0);
+    memory.data()[memory.size() - 1] = 3;
+    EXPECT_EQ(memory.data()[memory.size() - 1], 3);
+}
+
+TEST_CASE(memories_grow_up_to_their_maximum)
+{
+    auto memory = create_memory(0, 2);
+    EXPECT(memory.data().is_empty());
+
+    EXPECT(memory.grow(2 * Wasm::Constants::page_size));
+    EXPECT(!memory.grow(Wasm::Constants::page_size));
+    EXPECT_EQ(memory.size(), 2 * Wasm::Constants::page_size);
+    EXPECT_EQ(memory.type().limits().min(), 2u);
+}
+
+TEST_CASE(moving_a_memory_keeps_its_contents)
+{
+    auto memory = create_memory(1);
+    memory.data()[42] = 42;
+    auto* base = memory.data().data();
+
+    Vector<Wasm::MemoryInstance> memories;
+    memories.append(move(memory));
+    for (size_t i = 0; i < 16; ++i)
+        memories.append(create_memory(1));
+
+    EXPECT_EQ(memories.first().data().data(), base);
+    EXPECT_EQ(memories.first().data()[42], 42);
+}
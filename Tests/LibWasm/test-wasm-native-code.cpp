@@ -0,0 +1,330 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "TestWasmCommon.h"
+#include <AK/Platform.h>
+#include <LibTest/TestCase.h>
+#include <LibWasm/AbstractMachine/AbstractMachine.h>
+
+// With native code compilation enabled, the functions of this module are compiled to native code at instantiation.
+// These check that they give the same results as the interpreter, including when they trap or call back into it.
+
+// Types: 0 is (i32) -> i32, 1 is (i64) -> i64, 2 is (i32, i32) -> i32.
+// Function 0 is the imported (func $double (param i32) (result i32)), the ones below start at 1.
+static TestFunction const s_functions[] = {
+    sum_to_function(0),
+    // (func $factorial (param $n i64) (result i64)
+    //   (if (result i64) (i64.le_s (local.get $n) (i64.const 1))
+    //     (then (i64.const 1))
+    //     (else (i64.mul (local.get $n) (call $factorial (i64.sub (local.get $n) (i64.const 1)))))))
+    {
+        "factorial"sv,
+        1,
+        { 0x00,
+            0x20, 0x00, 0x42, 0x01, 0x57, 0x04, i64_type,
+            0x42, 0x01,
+            0x05, 0x20, 0x00, 0x20, 0x00, 0x42, 0x01, 0x7d, 0x10, 0x02, 0x7e,
+            0x0b,
+            0x0b },
+    },
+    // (func (param $a i32) (param $b i32) (result i32)
+    //   (i32.div_s (local.get $a) (local.get $b)))
+    {
+        "divide"sv,
+        2,
+        { 0x00, 0x20, 0x00, 0x20, 0x01, 0x6d, 0x0b },
+    },
+    // (func (param $address i32) (param $value i32) (result i32)
+    //   (i32.store8 (local.get $address) (local.get $value))
+    //   (i32.load8_s (local.get $address)))
+    {
+        "store_and_load"sv,
+        2,
+        { 0x00, 0x20, 0x00, 0x20, 0x01, 0x3a, 0x00, 0x00, 0x20, 0x00, 0x2c, 0x00, 0x00, 0x0b },
+    },
+    // (func (param $x i32) (result i32)
+    //   (i32.add (call $double (local.get $x)) (i32.const 1)))
+    {
+        "call_host"sv,
+        0,
+        { 0x00, 0x20, 0x00, 0x10, 0x00, 0x41, 0x01, 0x6a, 0x0b },
+    },
+    // (func (param $index i32) (param $x i32) (result i32)
+    //   (call_indirect (type 0) (local.get $x) (local.get $index)))
+    {
+        "indirect"sv,
+        2,
+        { 0x00, 0x20, 0x01, 0x20, 0x00, 0x11, 0x00, 0x00, 0x0b },
+    },
+    // (func (param $pages i32) (result i32)
+    //   (drop (memory.grow (local.get $pages)))
+    //   (memory.size))
+    {
+        "grow"sv,
+        0,
+        { 0x00, 0x20, 0x00, 0x40, 0x00, 0x1a, 0x3f, 0x00, 0x0b },
+    },
+    // (func (param i32) (result i32) (unreachable))
+    {
+        "unreachable"sv,
+        0,
+        { 0x00, 0x00, 0x0b },
+    },
+    // (func (param $x i32) (param $amount i32) (result i32)
+    //   (i32.rotl (local.get $x) (local.get $amount)))
+    {
+        "rotate"sv,
+        2,
+        { 0x00, 0x20, 0x00, 0x20, 0x01, 0x77, 0x0b },
+    },
+    // (func (param $x i32) (result i32)
+    //   (block (result i32)
+    //     (i32.const 7)
+    //     (block
+    //       (block
+    //         (block (br_table 0 1 2 (local.get $x)))
+    //         (br 2 (i32.const 10)))
+    //       (br 1 (i32.const 20)))
+    //     (br 0 (i32.const 99))))
+    {
+        "classify"sv,
+        0,
+        { 0x00,
+            0x02, i32_type, 0x41, 0x07,
+            0x02, 0x40, 0x02, 0x40, 0x02, 0x40, 0x20, 0x00, 0x0e, 0x02, 0x00, 0x01, 0x02, 0x0b,
+            0x41, 0x0a, 0x0c, 0x02, 0x0b,
+            0x41, 0x14, 0x0c, 0x01, 0x0b,
+            0x41, 0xe3, 0x00, 0x0c, 0x00, 0x0b,
+            0x0b },
+    },
+    // (func (param $x i32) (result i32)
+    //   (i32.const 1)
+    //   (block (i32.const 2) (loop (return (local.get $x))) (drop)))
+    {
+        "early_return"sv,
+        0,
+        { 0x00,
+            0x41, 0x01, 0x02, 0x40, 0x41, 0x02, 0x03, 0x40, 0x20, 0x00, 0x0f, 0x0b, 0x1a, 0x0b,
+            0x0b },
+    },
+    // (func (param $x i64) (result i64)
+    //   (i64.add
+    //     (i64.xor (i64.shl (local.get $x) (i64.const 7)) (i64.shr_u (local.get $x) (i64.const 3)))
+    //     (i64.extend_i32_s (i32.wrap_i64 (local.get $x)))))
+    {
+        "mix"sv,
+        1,
+        { 0x00,
+            0x20, 0x00, 0x42, 0x07, 0x86, 0x20, 0x00, 0x42, 0x03, 0x88, 0x85,
+            0x20, 0x00, 0xa7, 0xac, 0x7c,
+            0x0b },
+    },
+    // (func (param $address i32) (result i32)
+    //   (i32.load offset=0xffff0000 (local.get $address)))
+    {
+        "load_far"sv,
+        0,
+        { 0x00, 0x20, 0x00, 0x28, 0x02, 0x80, 0x80, 0xfc, 0xff, 0x0f, 0x0b },
+    },
+};
+
+static NonnullRefPtr<Wasm::Module> make_module()
+{
+    auto bytes = module_header();
+    append_section(bytes, 0x01, { 0x03, 0x60, 0x01, i32_type, 0x01, i32_type, 0x60, 0x01, i64_type, 0x01, i64_type, 0x60, 0x02, i32_type, i32_type, 0x01, i32_type });
+
+    Vector<u8> imports { 0x01 };
+    append_name(imports, "env"sv);
+    append_name(imports, "double"sv);
+    imports.extend({ 0x00, 0x00 });
+    append_section(bytes, 0x02, imports);
+
+    auto sections = make_function_sections(s_functions, 1);
+    append_section(bytes, 0x03, sections.functions);
+    // A table of two funcrefs, and a memory of one page that can grow to two.
+    append_section(bytes, 0x04, { 0x01, 0x70, 0x00, 0x02 });
+    append_section(bytes, 0x05, { 0x01, 0x01, 0x01, 0x02 });
+    append_section(bytes, 0x07, sections.exports);
+    // The table holds sum_to and call_host.
+    append_section(bytes, 0x09, { 0x01, 0x00, 0x41, 0x00, 0x0b, 0x02, 0x01, 0x05 });
+    append_section(bytes, 0x0a, sections.code);
+    return parse_module(bytes);
+}
+
+struct Instance {
+    Wasm::AbstractMachine machine;
+    NonnullRefPtr<Wasm::Module> module;
+    OwnPtr<Wasm::ModuleInstance> module_instance;
+
+    explicit Instance(bool compile_to_native_code)
+        : module(make_module())
+    {
+        if (compile_to_native_code)
+            machine.enable_native_code_compilation();
+
+        Wasm::FunctionType type { { Wasm::ValueType(Wasm::ValueType::I32) }, { Wasm::ValueType(Wasm::ValueType::I32) } };
+        auto double_function = machine.store().allocate(Wasm::HostFunction {
+            [](auto&, auto& arguments) -> Wasm::Result {
+                return Wasm::Result { Vector { Wasm::Value(arguments.first().template to<i32>() * 2) } };
+            },
+            type,
+            "double" });
+        VERIFY(double_function.has_value());
+
+        auto result = machine.instantiate(*module, { *double_function });
+        VERIFY(!result.is_error());
+        module_instance = result.release_value();
+    }
+
+    Wasm::FunctionAddress address_of(StringView name) const
+    {
+        auto it = module_instance->exports().find_if([&](auto& export_) { return export_.name() == name; });
+        VERIFY(!it.is_end());
+        return it->value().get<Wasm::FunctionAddress>();
+    }
+
+    bool is_compiled(StringView name)
+    {
+        return machine.store().get(address_of(name))->get<Wasm::WasmFunction>().native_function();
+    }
+
+    Wasm::Result invoke(StringView name, Vector<Wasm::Value> arguments)
+    {
+        return machine.invoke(address_of(name), move(arguments));
+    }
+
+    i32 call(StringView name, i32 argument)
+    {
+        auto result = invoke(name, { Wasm::Value(argument) });
+        VERIFY(!result.is_trap() && !result.is_completion());
+        return result.values().first().to<i32>();
+    }
+
+    i32 call(StringView name, i32 first_argument, i32 second_argument)
+    {
+        auto result = invoke(name, { Wasm::Value(first_argument), Wasm::Value(second_argument) });
+        VERIFY(!result.is_trap() && !result.is_completion());
+        return result.values().first().to<i32>();
+    }
+
+    i64 call(StringView name, i64 argument)
+    {
+        auto result = invoke(name, { Wasm::Value(argument) });
+        VERIFY(!result.is_trap() && !result.is_completion());
+        return result.values().first().to<i64>();
+    }
+
+    ByteString trap_reason(StringView name, Vector<Wasm::Value> arguments)
+    {
+        auto result = invoke(name, move(arguments));
+        VERIFY(result.is_trap());
+        return result.trap().reason;
+    }
+};
+
+TEST_CASE(functions_are_compiled)
+{
+    Instance instance { true };
+#if ARCH(X86_64)
+    for (auto& function : s_functions)
+        EXPECT(instance.is_compiled(function.name));
+#endif
+
+    Instance interpreted_instance { false };
+    for (auto& function : s_functions)
+        EXPECT(!interpreted_instance.is_compiled(function.name));
+}
+
+TEST_CASE(native_code_matches_the_interpreter)
+{
+    Instance native { true };
+    Instance interpreted { false };
+
+    for (i32 i : { 0, 1, 2, 3, -1, 1000 }) {
+        EXPECT_EQ(native.call("sum_to"sv, i), interpreted.call("sum_to"sv, i));
+        EXPECT_EQ(native.call("classify"sv, i), interpreted.call("classify"sv, i));
+        EXPECT_EQ(native.call("early_return"sv, i), interpreted.call("early_return"sv, i));
+        EXPECT_EQ(native.call("call_host"sv, i), interpreted.call("call_host"sv, i));
+        EXPECT_EQ(native.call("rotate"sv, i, 37), interpreted.call("rotate"sv, i, 37));
+        EXPECT_EQ(native.call("divide"sv, i, -7), interpreted.call("divide"sv, i, -7));
+        EXPECT_EQ(native.call("indirect"sv, 0, i), interpreted.call("indirect"sv, 0, i));
+        EXPECT_EQ(native.call("indirect"sv, 1, i), interpreted.call("indirect"sv, 1, i));
+        EXPECT_EQ(native.call("store_and_load"sv, i & 0xffff, i * 100), interpreted.call("store_and_load"sv, i & 0xffff, i * 100));
+    }
+
+    for (i64 i : { 0ll, 1ll, 5ll, 20ll, 0x123456789abcdefll, -0x7edcba9876543210ll }) {
+        EXPECT_EQ(native.call("mix"sv, i), interpreted.call("mix"sv, i));
+        if (i <= 20)
+            EXPECT_EQ(native.call("factorial"sv, i), interpreted.call("factorial"sv, i));
+    }
+
+    EXPECT_EQ(native.call("factorial"sv, static_cast<i64>(20)), 2432902008176640000ll);
+    EXPECT_EQ(native.call("classify"sv, 1), 20);
+    EXPECT_EQ(native.call("call_host"sv, 20), 41);
+    EXPECT_EQ(native.call("indirect"sv, 1, 20), 41);
+    EXPECT_EQ(native.call("store_and_load"sv, 100, 200), -56);
+}
+
+TEST_CASE(native_code_traps_like_the_interpreter)
+{
+    Instance native { true };
+    Instance interpreted { false };
+
+    auto expect_same_trap = [&](StringView name, Vector<Wasm::Value> arguments) {
+        EXPECT_EQ(native.trap_reason(name, arguments), interpreted.trap_reason(name, arguments));
+    };
+    expect_same_trap("divide"sv, { Wasm::Value(1), Wasm::Value(0) });
+    expect_same_trap("divide"sv, { Wasm::Value(NumericLimits<i32>::min()), Wasm::Value(-1) });
+    expect_same_trap("store_and_load"sv, { Wasm::Value(65536), Wasm::Value(1) });
+    expect_same_trap("store_and_load"sv, { Wasm::Value(-1), Wasm::Value(1) });
+    expect_same_trap("unreachable"sv, { Wasm::Value(0) });
+
+    EXPECT_EQ(native.trap_reason("indirect"sv, { Wasm::Value(2), Wasm::Value(0) }), "Indirect call to an element outside of the table");
+    EXPECT_EQ(native.trap_reason("divide"sv, { Wasm::Value(1), Wasm::Value(0) }), "Division by zero");
+    EXPECT_EQ(native.trap_reason("divide"sv, { Wasm::Value(NumericLimits<i32>::min()), Wasm::Value(-1) }), "Integer division overflow");
+}
+
+TEST_CASE(accesses_past_the_guard_region_of_the_memory_trap)
+{
+    Instance native { true };
+    Instance interpreted { false };
+    EXPECT(native.machine.store().get(native.module_instance->memories().first())->has_guard_region());
+
+    // The furthest address an access can compute is still inside the guard region.
+    for (i32 address : { 0, 0xffff, -1, -4 }) {
+        EXPECT_EQ(native.trap_reason("load_far"sv, { Wasm::Value(address) }), "Memory access out of bounds");
+        EXPECT_EQ(interpreted.trap_reason("load_far"sv, { Wasm::Value(address) }), native.trap_reason("load_far"sv, { Wasm::Value(address) }));
+    }
+
+    // Native code keeps working after a trap.
+    EXPECT_EQ(native.call("store_and_load"sv, 100, 200), -56);
+}
+
+TEST_CASE(memory_accesses_see_the_grown_memory)
+{
+    Instance instance { true };
+    EXPECT_EQ(instance.trap_reason("store_and_load"sv, { Wasm::Value(65536), Wasm::Value(1) }), "Memory access out of bounds");
+
+    EXPECT_EQ(instance.call("grow"sv, 1), 2);
+    EXPECT_EQ(instance.call("store_and_load"sv, 65536, 1), 1);
+    EXPECT_EQ(instance.call("store_and_load"sv, 131071, -1), -1);
+
+    EXPECT_EQ(instance.call("grow"sv, 1), 2);
+    EXPECT_EQ(instance.trap_reason("store_and_load"sv, { Wasm::Value(131072), Wasm::Value(1) }), "Memory access out of bounds");
+}
+
+BENCHMARK_CASE(loop_in_native_code)
+{
+    Instance instance { true };
+    EXPECT_EQ(instance.call("sum_to"sv, 20'000'000), static_cast<i32>(19'999'999ull * 20'000'000ull / 2));
+}
+
+BENCHMARK_CASE(recursive_calls_in_native_code)
+{
+    Instance instance { true };
+    for (size_t i = 0; i < 20'000; ++i)
+        EXPECT_EQ(instance.call("factorial"sv, static_cast<i64>(20)), 2432902008176640000ll);
+}
@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "TestWasmCommon.h"
+#include <LibTest/TestCase.h>
+#include <LibWasm/AbstractMachine/AbstractMachine.h>
+#include <LibWasm/AbstractMachine/StreamingCompiler.h>
+#include <LibWasm/AbstractMachine/Validator.h>
+
+// The streaming compiler parses and validates a module as its bytes arrive. However the bytes are split up, it has to
+// come to the same conclusion as parsing and validating the whole module at once.
+
+// A module with a memory, a global, a passive data segment and `function_count` functions of type (i32) -> i32 that
+// add up their argument, the global and a byte loaded from memory; the last one is exported as "last".
+// It ends with a custom section, after the data section.
+static Vector<u8> make_module(size_t function_count, Optional<size_t> invalid_function = {})
+{
+    auto bytes = module_header();
+    append_section(bytes, 0x00, { 0x05, 'f', 'i', 'r', 's', 't', 0x01, 0x02 });
+    append_section(bytes, 0x01, { 0x01, 0x60, 0x01, i32_type, 0x01, i32_type });
+
+    Vector<u8> functions;
+    append_leb128(functions, function_count);
+    for (size_t i = 0; i < function_count; ++i)
+        functions.append(0x00);
+    append_section(bytes, 0x03, functions);
+
+    append_section(bytes, 0x05, { 0x01, 0x00, 0x01 });
+    append_section(bytes, 0x06, { 0x01, i32_type, 0x00, 0x41, 0x2a, 0x0b });
+
+    Vector<u8> exports { 0x01, 0x04, 'l', 'a', 's', 't', 0x00 };
+    append_leb128(exports, function_count - 1);
+    append_section(bytes, 0x07, exports);
+
+    // There's one data segment, which the functions copy into memory.
+    append_section(bytes, 0x0c, { 0x01 });
+
+    Vector<u8> code;
+    append_leb128(code, function_count);
+    for (size_t i = 0; i < function_count; ++i) {
+        // (func (param $x i32) (result i32) (local i32)
+        //   (memory.init 0 (i32.const 0) (i32.const 0) (i32.const 4))
+        //   (i32.add (i32.add (local.get $x) (global.get 0)) (i32.load8_u (i32.const <i % 4>))))
+        Vector<u8> body { 0x01, 0x01, i32_type,
+            0x41, 0x00, 0x41, 0x00, 0x41, 0x04, 0xfc, 0x08, 0x00, 0x00,
+            0x20, 0x00, 0x23, 0x00, 0x6a, 0x41, static_cast<u8>(i % 4), 0x2d, 0x00, 0x00, 0x6a,
+            0x0b };
+        // Adding them up as i64s instead.
+        if (invalid_function == i)
+            body[17] = 0x7c;
+        append_leb128(code, body.size());
+        code.extend(body);
+    }
+    append_section(bytes, 0x0a, code);
+
+    append_section(bytes, 0x0b, { 0x01, 0x01, 0x04, 0x0a, 0x14, 0x1e, 0x28 });
+    append_section(bytes, 0x00, { 0x04, 'l', 'a', 's', 't' });
+
+    return bytes;
+}
+
+static ErrorOr<NonnullRefPtr<Wasm::Module>, ByteString> compile_in_pieces(ReadonlyBytes bytes, size_t piece_size)
+{
+    auto compiler = make_ref_counted<Wasm::StreamingCompiler>();
+    for (size_t offset = 0; offset < bytes.size(); offset += piece_size)
+        TRY(compiler->append(bytes.slice(offset, min(piece_size, bytes.size() - offset))));
+    return compiler->finish();
+}
+
+static ErrorOr<NonnullRefPtr<Wasm::Module>, ByteString> compile_at_once(ReadonlyBytes bytes)
+{
+    FixedMemoryStream stream { bytes };
+    auto module = Wasm::Module::parse(stream);
+    if (module.is_error())
+        return Wasm::parse_error_to_byte_string(module.error());
+    if (auto result = Wasm::AbstractMachine::validate(module.value()); result.is_error())
+        return result.release_error().error_string;
+    return module.release_value();
+}
+
+static i32 call_last(Wasm::Module const& module, i32 argument)
+{
+    Wasm::AbstractMachine machine;
+    auto instance = machine.instantiate(module, {});
+    VERIFY(!instance.is_error());
+    auto& export_ = instance.value()->exports().first();
+    auto result = machine.invoke(export_.value().get<Wasm::FunctionAddress>(), { Wasm::Value(argument) });
+    VERIFY(!result.is_trap());
+    return result.values().first().to<i32>();
+}
+
+TEST_CASE(valid_module_in_pieces)
+{
+    auto bytes = make_module(20);
+    for (size_t piece_size : { 1, 2, 3, 7, 64, 1000, 100000 }) {
+        auto module = compile_in_pieces(bytes, piece_size);
+        EXPECT(!module.is_error());
+        if (module.is_error())
+            continue;
+
+        auto& compiled_module = *module.value();
+        EXPECT(compiled_module.validation_status() == Wasm::Module::ValidationStatus::Valid);
+        EXPECT_EQ(compiled_module.code_section().functions().size(), 20u);
+        EXPECT_EQ(compiled_module.custom_sections().size(), 2u);
+        EXPECT_EQ(compiled_module.data_section().data().size(), 1u);
+
+        // The 20th function loads the fourth byte of the data segment: 1 + 42 + 40.
+        EXPECT_EQ(call_last(compiled_module, 1), 83);
+    }
+}
+
+TEST_CASE(invalid_function_is_rejected)
+{
+    auto bytes = make_module(20, 5);
+    auto expected_error = compile_at_once(bytes);
+    EXPECT(expected_error.is_error());
+
+    for (size_t piece_size : { 1, 5, 64, 100000 }) {
+        auto compiler = make_ref_counted<Wasm::StreamingCompiler>();
+        bool failed_before_the_end = false;
+        for (size_t offset = 0; offset < bytes.size(); offset += piece_size) {
+            auto result = compiler->append(bytes.span().slice(offset, min(piece_size, bytes.size() - offset)));
+            if (result.is_error()) {
+                EXPECT_EQ(result.error(), expected_error.error());
+                // The function is rejected as soon as its bytes are in, before the rest of the module.
+                EXPECT(offset + piece_size < bytes.size() || offset == 0);
+                failed_before_the_end = true;
+                break;
+            }
+        }
+        EXPECT(failed_before_the_end);
+        EXPECT(compiler->finish().is_error());
+    }
+}
+
+TEST_CASE(invalid_function_in_a_large_piece_is_rejected)
+{
+    // Enough functions for a piece to be validated on several threads, where that's possible.
+    auto bytes = make_module(20'000, 15'000);
+    auto expected_error = compile_at_once(bytes);
+    EXPECT(expected_error.is_error());
+
+    for (size_t piece_size : { 64 * KiB, 256 * KiB, bytes.size() }) {
+        auto module = compile_in_pieces(bytes, piece_size);
+        EXPECT(module.is_error());
+        if (module.is_error())
+            EXPECT_EQ(module.error(), expected_error.error());
+    }
+}
+
+TEST_CASE(malformed_modules_are_rejected)
+{
+    auto bytes = make_module(3);
+    for (size_t size = 0; size < bytes.size(); ++size) {
+        // Cutting the module off between sections that come before the function section leaves a valid module.
+        auto truncated = bytes.span().trim(size);
+        auto is_valid = !compile_at_once(truncated).is_error();
+        EXPECT_EQ(!compile_in_pieces(truncated, 1).is_error(), is_valid);
+        EXPECT_EQ(!compile_in_pieces(truncated, 1000).is_error(), is_valid);
+    }
+
+    auto bad_magic = bytes;
+    bad_magic[1] = 'b';
+    EXPECT_EQ(compile_in_pieces(bad_magic, 3).error(), compile_at_once(bad_magic).error());
+
+    // The memory section comes after the global section.
+    auto module = module_header();
+    append_section(module, 0x06, { 0x01, i32_type, 0x00, 0x41, 0x2a, 0x0b });
+    append_section(module, 0x05, { 0x01, 0x00, 0x01 });
+    EXPECT_EQ(compile_in_pieces(module, 1).error(), compile_at_once(module).error());
+}
+
+TEST_CASE(empty_module)
+{
+    auto module = compile_in_pieces(module_header(), 1);
+    EXPECT(!module.is_error());
+}
+
+BENCHMARK_CASE(large_module_in_pieces)
+{
+    auto bytes = make_module(200'000);
+    for (size_t i = 0; i < 3; ++i)
+        EXPECT(!compile_in_pieces(bytes, 64 * KiB).is_error());
+}
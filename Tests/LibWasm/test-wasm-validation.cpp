@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "TestWasmCommon.h"
+#include <LibTest/TestCase.h>
+#include <LibWasm/AbstractMachine/AbstractMachine.h>
+#include <LibWasm/AbstractMachine/Validator.h>
+
+// The function bodies of large modules are validated on several threads. These check that the outcome doesn't
+// depend on how many functions there are, or on which thread finds an error first.
+
+// (func (result i32) (i32.add (i32.const 1) (i32.add (i32.const 1) ...))), with `count` constants.
+static Vector<u8> make_sum_of_ones(size_t count)
+{
+    Vector<u8> code { 0x00 };
+    for (size_t i = 0; i < count; ++i)
+        code.extend({ 0x41, 0x01 });
+    for (size_t i = 1; i < count; ++i)
+        code.append(0x6a);
+    code.append(0x0b);
+    return code;
+}
+
+// (func (result i32) (local.get 5))
+static Vector<u8> const s_invalid_local { 0x00, 0x20, 0x05, 0x0b };
+
+// (func (result i32) (call 100000))
+static Vector<u8> const s_invalid_call { 0x00, 0x10, 0xa0, 0x8d, 0x06, 0x0b };
+
+// A module with functions of type () -> i32, the last of which is exported as "last".
+static NonnullRefPtr<Wasm::Module> make_module(Vector<Vector<u8>> const& functions)
+{
+    auto bytes = module_header();
+    append_section(bytes, 0x01, { 0x01, 0x60, 0x00, 0x01, i32_type });
+
+    Vector<u8> function_section;
+    Vector<u8> code_section;
+    append_leb128(function_section, functions.size());
+    append_leb128(code_section, functions.size());
+    for (auto& code : functions) {
+        function_section.append(0x00);
+        append_leb128(code_section, code.size());
+        code_section.extend(code);
+    }
+    append_section(bytes, 0x03, function_section);
+
+    Vector<u8> exports { 0x01 };
+    append_name(exports, "last"sv);
+    exports.append(0x00);
+    append_leb128(exports, functions.size() - 1);
+    append_section(bytes, 0x07, exports);
+
+    append_section(bytes, 0x0a, code_section);
+    return parse_module(bytes);
+}
+
+// Enough functions for their bodies to be validated in parallel.
+static Vector<Vector<u8>> make_functions(size_t count = 2000)
+{
+    Vector<Vector<u8>> functions;
+    for (size_t i = 0; i < count; ++i)
+        functions.append(make_sum_of_ones(50 + i % 7));
+    return functions;
+}
+
+static ByteString validation_error(Vector<Vector<u8>> const& functions)
+{
+    auto module = make_module(functions);
+    auto result = Wasm::AbstractMachine::validate(*module);
+    VERIFY(result.is_error());
+    return result.error().error_string;
+}
+
+TEST_CASE(large_module_is_valid)
+{
+    auto module = make_module(make_functions());
+    EXPECT(!Wasm::AbstractMachine::validate(*module).is_error());
+    EXPECT(module->validation_status() == Wasm::Module::ValidationStatus::Valid);
+
+    Wasm::AbstractMachine machine;
+    auto instance = machine.instantiate(*module, {});
+    EXPECT(!instance.is_error());
+    auto& export_ = instance.value()->exports().first();
+    auto result = machine.invoke(export_.value().get<Wasm::FunctionAddress>(), {});
+    EXPECT(!result.is_trap());
+    // The last of the 2000 functions adds up 50 + 1999 % 7 ones.
+    EXPECT_EQ(result.values().first().to<i32>(), 54);
+}
+
+TEST_CASE(first_invalid_function_is_reported)
+{
+    auto small_module_error = validation_error({ s_invalid_local, s_invalid_call });
+    EXPECT_EQ(validation_error({ s_invalid_call, s_invalid_local }), validation_error({ s_invalid_call }));
+    EXPECT_NE(small_module_error, validation_error({ s_invalid_call }));
+
+    for (size_t iteration = 0; iteration < 10; ++iteration) {
+        auto functions = make_functions();
+        functions[1500] = s_invalid_call;
+        functions[300] = s_invalid_local;
+        functions[1999] = s_invalid_call;
+        EXPECT_EQ(validation_error(functions), small_module_error);
+    }
+
+    auto functions = make_functions();
+    functions[1999] = s_invalid_local;
+    EXPECT_EQ(validation_error(functions), small_module_error);
+}
+
+BENCHMARK_CASE(validate_large_module)
+{
+    auto functions = make_functions(20'000);
+    for (size_t i = 0; i < 5; ++i) {
+        auto module = make_module(functions);
+        EXPECT(!Wasm::AbstractMachine::validate(*module).is_error());
+    }
+}
@@ -473,6 +473,12 @@ BrowserWindow::BrowserWindow(Vector<URL::URL> const& initial_urls, IsPopupWindow
         }
     });
 
+    auto* dump_gc_heap_snapshot_action = new QAction("Dump GC Heap Snapshot", this);
+    debug_menu->addAction(dump_gc_heap_snapshot_action);
+    QObject::connect(dump_gc_heap_snapshot_action, &QAction::triggered, this, [this] {
+        debug_request("dump-gc-heap-snapshot");
+    });
+
     auto* clear_cache_action = new QAction("Clear &Cache", this);
     clear_cache_action->setIcon(load_icon_from_uri("resource://icons/browser/clear-cache.png"sv));
     debug_menu->addAction(clear_cache_action);
@@ -13,14 +13,18 @@
 #include <LibCore/ConfigFile.h>
 #include <LibCore/StandardPaths.h>
 #include <LibJS/Bytecode/BasicBlock.h>
+#include <LibJS/Bytecode/ExecutableCache.h>
 #include <LibJS/Bytecode/Generator.h>
 #include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/Bytecode/Optimizer.h>
 #include <LibJS/Console.h>
 #include <LibJS/Contrib/Test262/GlobalObject.h>
+#include <LibJS/JIT/Compiler.h>
 #include <LibJS/Parser.h>
 #include <LibJS/Print.h>
 #include <LibJS/Runtime/ConsoleObject.h>
 #include <LibJS/Runtime/DeclarativeEnvironment.h>
+#include <LibJS/Runtime/ECMAScriptFunctionObject.h>
 #include <LibJS/Runtime/GlobalEnvironment.h>
 #include <LibJS/Runtime/JSONObject.h>
 #include <LibJS/Runtime/StringPrototype.h>
@@ -57,6 +61,7 @@ private:
     JS_DECLARE_NATIVE_FUNCTION(load_json);
     JS_DECLARE_NATIVE_FUNCTION(last_value_getter);
     JS_DECLARE_NATIVE_FUNCTION(print);
+    JS_DECLARE_NATIVE_FUNCTION(inline_cache_statistics);
 };
 
 class ScriptObject final : public JS::GlobalObject {
@@ -331,6 +336,7 @@ void ReplObject::initialize(JS::Realm& realm)
     define_native_function(realm, "loadINI", load_ini, 1, attr);
     define_native_function(realm, "loadJSON", load_json, 1, attr);
     define_native_function(realm, "print", print, 1, attr);
+    define_native_function(realm, "inlineCacheStatistics", inline_cache_statistics, 1, attr);
 
     define_native_accessor(
         realm,
@@ -381,6 +387,7 @@ JS_DEFINE_NATIVE_FUNCTION(ReplObject::repl_help)
     warnln("    loadINI(file): load the given file as INI.");
     warnln("    loadJSON(file): load the given file as JSON.");
     warnln("    print(value): pretty-print the given JS value.");
+    warnln("    inlineCacheStatistics(function): show the hits and misses of the function's property lookup caches.");
     warnln("    save(file): write REPL input history to the given file. For example: save(\"foo.txt\")");
     return JS::js_undefined();
 }
@@ -406,6 +413,24 @@ JS_DEFINE_NATIVE_FUNCTION(ReplObject::print)
     return JS::js_undefined();
 }
 
+JS_DEFINE_NATIVE_FUNCTION(ReplObject::inline_cache_statistics)
+{
+    auto function = vm.argument(0);
+    if (!function.is_object() || !is<JS::ECMAScriptFunctionObject>(function.as_object()))
+        return vm.throw_completion<JS::TypeError>(JS::ErrorType::NotAnObjectOfType, "ECMAScriptFunctionObject");
+
+    auto executable = static_cast<JS::ECMAScriptFunctionObject&>(function.as_object()).bytecode_executable();
+    if (!executable) {
+        warnln("Function has not been compiled to bytecode yet.");
+        return JS::js_undefined();
+    }
+    executable->dump_property_lookup_cache_statistics();
+
+    auto const& megamorphic_cache = vm.bytecode_interpreter().megamorphic_property_cache();
+    warnln("Megamorphic cache: hits: {} misses: {}", megamorphic_cache.hit_count(), megamorphic_cache.miss_count());
+    return JS::js_undefined();
+}
+
 void ScriptObject::initialize(JS::Realm& realm)
 {
     Base::initialize(realm);
@@ -532,21 +557,38 @@ private:
 ErrorOr<int> serenity_main(Main::Arguments arguments)
 {
     bool gc_on_every_allocation = false;
+    bool parallel_gc_marking = false;
+    bool incremental_gc_marking = false;
+    bool generational_gc = false;
+    bool measure_conservative_roots = false;
+    bool enable_lazy_parsing = false;
+    Optional<u8> bytecode_optimization_level;
+    bool print_lazy_parsing_statistics = false;
     bool disable_syntax_highlight = false;
     bool disable_debug_printing = false;
     bool use_test262_global = false;
     StringView evaluate_script;
+    StringView bytecode_cache_directory;
     Vector<StringView> script_paths;
 
     Core::ArgsParser args_parser;
     args_parser.set_general_help("This is a JavaScript interpreter.");
     args_parser.add_option(s_dump_ast, "Dump the AST", "dump-ast", 'A');
     args_parser.add_option(JS::Bytecode::g_dump_bytecode, "Dump the bytecode", "dump-bytecode", 'd');
+    args_parser.add_option(JS::JIT::g_jit_enabled, "Compile hot functions to native code", "jit", {});
+    args_parser.add_option(bytecode_optimization_level, "Optimize bytecode at this level (0: none, 1: basic, 2: full)", "bytecode-optimization-level", {}, "level");
+    args_parser.add_option(bytecode_cache_directory, "Cache the bytecode of scripts in this directory", "bytecode-cache", {}, "path");
+    args_parser.add_option(enable_lazy_parsing, "Only check function bodies for syntax errors until they are called", "lazy-parsing", {});
+    args_parser.add_option(print_lazy_parsing_statistics, "Print how much code was parsed lazily", "lazy-parsing-stats", {});
     args_parser.add_option(s_as_module, "Treat as module", "as-module", 'm');
     args_parser.add_option(s_print_last_result, "Print last result", "print-last-result", 'l');
     args_parser.add_option(s_strip_ansi, "Disable ANSI colors", "disable-ansi-colors", 'i');
     args_parser.add_option(s_disable_source_location_hints, "Disable source location hints", "disable-source-location-hints", 'h');
     args_parser.add_option(gc_on_every_allocation, "GC on every allocation", "gc-on-every-allocation", 'g');
+    args_parser.add_option(parallel_gc_marking, "Mark the GC heap on multiple threads", "parallel-gc-marking", {});
+    args_parser.add_option(incremental_gc_marking, "Mark the GC heap incrementally", "incremental-gc-marking", {});
+    args_parser.add_option(generational_gc, "Collect short-lived cells in a GC nursery", "generational-gc", {});
+    args_parser.add_option(measure_conservative_roots, "Report how many cells each GC retains only through conservative roots", "measure-conservative-roots", {});
     args_parser.add_option(disable_syntax_highlight, "Disable live syntax highlighting", "no-syntax-highlight", 's');
     args_parser.add_option(disable_debug_printing, "Disable debug output", "disable-debug-output", {});
     args_parser.add_option(evaluate_script, "Evaluate argument as a script", "evaluate", 'c', "script");
@@ -557,10 +599,26 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     bool syntax_highlight = !disable_syntax_highlight;
 
     AK::set_debug_enabled(!disable_debug_printing);
+    if (bytecode_optimization_level.has_value()) {
+        if (*bytecode_optimization_level > to_underlying(JS::Bytecode::OptimizationLevel::Full)) {
+            warnln("Bytecode optimization level must be between 0 and {}", to_underlying(JS::Bytecode::OptimizationLevel::Full));
+            return 1;
+        }
+        JS::Bytecode::g_optimization_level = static_cast<JS::Bytecode::OptimizationLevel>(*bytecode_optimization_level);
+    }
+    if (!bytecode_cache_directory.is_empty())
+        JS::Bytecode::ExecutableCache::set_directory(bytecode_cache_directory);
+    // The AST dump should show every function body.
+    if (enable_lazy_parsing && !s_dump_ast)
+        JS::Parser::set_lazy_parsing_enabled(true);
     s_history_path = TRY(String::formatted("{}/.js-history", Core::StandardPaths::home_directory()));
 
     g_vm_storage.get() = TRY(JS::VM::create());
     g_vm = g_vm_storage->ptr();
+    g_vm->heap().set_parallel_marking_enabled(parallel_gc_marking);
+    g_vm->heap().set_incremental_marking_enabled(incremental_gc_marking);
+    g_vm->heap().set_generational_collection_enabled(generational_gc);
+    g_vm->heap().set_conservative_retention_measurement_enabled(measure_conservative_roots);
     g_vm->set_dynamic_imports_allowed(true);
 
     if (!disable_debug_printing) {
@@ -857,6 +915,13 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
 
         if (!TRY(parse_and_run(realm, builder.string_view(), source_name)))
             return 1;
+
+        if (print_lazy_parsing_statistics) {
+            auto const& statistics = JS::Parser::lazy_parsing_statistics();
+            warnln("Lazy parsing: skipped {} function bodies ({} bytes), parsed {} of them later ({} bytes)",
+                statistics.skipped_function_count, statistics.skipped_bytes,
+                statistics.reparsed_function_count, statistics.reparsed_bytes);
+        }
     }
 
     return s_exit_code;